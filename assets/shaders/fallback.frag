@@ -0,0 +1,9 @@
+#version 330 core
+
+out vec4 fragColor;
+
+// Drawn while the actual shader program of an object is still being built
+void main()
+{
+    fragColor = vec4(0.5, 0.5, 0.5, 1.0);
+}
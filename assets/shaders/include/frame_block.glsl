@@ -0,0 +1,6 @@
+// Bound to FRAME_UNIFORM_BLOCK_BINDING, see rendering/uniform_blocks.h
+layout (std140) uniform FrameBlock
+{
+    mat4 view;
+    mat4 projection;
+};
@@ -0,0 +1,30 @@
+// Vertex stage transforming mesh vertices by the model matrix and the frame's view and projection,
+// passing the remaining attributes on. Define WORLD_POSITION_OUTPUT to output the world position as well.
+
+#include "include/frame_block.glsl"
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aRgb;
+layout (location = 2) in vec2 aTextureUv;
+layout (location = 3) in vec3 aNormal;
+
+#ifdef WORLD_POSITION_OUTPUT
+out vec3 worldPos;
+#endif
+out vec3 rgb;
+out vec2 textureUv;
+out vec3 normal;
+
+uniform mat4 model;
+
+void main()
+{
+#ifdef WORLD_POSITION_OUTPUT
+    worldPos  = vec3(model * vec4(aPos, 1.0));
+#endif
+    rgb       = aRgb;
+    textureUv = aTextureUv;
+    normal    = aNormal;
+
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+}
@@ -5,12 +5,14 @@ in vec3 normal;
 
 out vec4 fragColor;
 
-uniform vec3 lightSourcePosition;
-
-uniform vec3 objectRgb;
-uniform vec3 lightRgb;
-
-uniform float ambientStrength;
+// Bound to MATERIAL_UNIFORM_BLOCK_BINDING, mirrored by LitMaterialUniformBlock, see rendering/uniform_blocks.h
+layout (std140) uniform MaterialBlock
+{
+    vec3  objectRgb;
+    float ambientStrength;
+    vec3  lightRgb;
+    vec3  lightSourcePosition;
+};
 
 void main()
 {
@@ -2,7 +2,11 @@
 
 out vec4 fragColor;
 
-uniform vec3 lightRgb;
+// Bound to MATERIAL_UNIFORM_BLOCK_BINDING, mirrored by LightSourceMaterialUniformBlock, see rendering/uniform_blocks.h
+layout (std140) uniform MaterialBlock
+{
+    vec3 lightRgb;
+};
 
 void main()
 {
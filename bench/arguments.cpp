@@ -0,0 +1,171 @@
+#include "arguments.h"
+
+#include <string_view>
+#include <charconv>
+#include <cmath>
+
+#include "config.h"
+
+//
+// Forward declarations
+//
+
+static std::string_view GetArgumentValue(const int argc, const char * const * const argv, int & argIdx);
+
+static uint64_t ParseCount(const std::string_view value, const bool isZeroAllowed);
+
+static float ParsePositiveFloat(const std::string_view value);
+
+//
+// Utilities
+//
+
+BenchArguments ParseBenchArguments(const int argc, const char * const * const argv)
+{
+    BenchArguments arguments;
+
+    for (int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        const std::string_view arg(argv[argIdx]);
+
+        if (arg == "--scene")
+            arguments.SceneName = GetArgumentValue(argc, argv, argIdx);
+        else if (arg == "--warmup")
+            arguments.WarmupFrameCount = ParseCount(GetArgumentValue(argc, argv, argIdx), true);
+        else if (arg == "--frames")
+            arguments.FrameCount = ParseCount(GetArgumentValue(argc, argv, argIdx), false);
+        else if (arg == "--dt")
+            arguments.DeltaTimeSeconds = ParsePositiveFloat(GetArgumentValue(argc, argv, argIdx));
+        else if (arg == "--camera-path")
+            arguments.CameraPathFilePath = GetArgumentValue(argc, argv, argIdx);
+        else if (arg == "--headless")
+            arguments.IsHeadless = true;
+        else if (arg == "--context-api")
+        {
+            try
+            {
+                arguments.ContextCreationApi = ParseContextApi(GetArgumentValue(argc, argv, argIdx));
+            }
+            catch (const AppOptionsException & e)
+            {
+                throw BenchArgumentsException(e.what());
+            }
+        }
+        else if (arg == "--gl-backend")
+        {
+            try
+            {
+                arguments.Backend = ParseGlBackend(GetArgumentValue(argc, argv, argIdx));
+            }
+            catch (const AppOptionsException & e)
+            {
+                throw BenchArgumentsException(e.what());
+            }
+        }
+        else if (arg == "--gl-capture")
+        {
+            arguments.Backend           = GlBackend::Recording;
+            arguments.GlCaptureFilePath = GetArgumentValue(argc, argv, argIdx);
+        }
+        else if (arg == "--report-json")
+            arguments.JsonReportFilePath = GetArgumentValue(argc, argv, argIdx);
+        else if (arg == "--report-csv")
+            arguments.CsvReportFilePath = GetArgumentValue(argc, argv, argIdx);
+        else if (arg == "--baseline")
+            arguments.BaselineFilePath = GetArgumentValue(argc, argv, argIdx);
+        else if (arg == "--tolerance")
+            arguments.RegressionTolerance = ParsePositiveFloat(GetArgumentValue(argc, argv, argIdx));
+        else
+            throw BenchArgumentsException("Unrecognized argument " + std::string(arg));
+    }
+
+    // Without a context there's nothing to present.
+    if (arguments.Backend == GlBackend::Null)
+        arguments.IsHeadless = true;
+
+    if (arguments.Backend == GlBackend::Recording && arguments.GlCaptureFilePath.empty())
+        arguments.GlCaptureFilePath = DEFAULT_GL_CAPTURE_FILE_PATH;
+
+    return arguments;
+}
+
+std::string GetBenchUsage(const std::string & executableName)
+{
+    return "Usage: " + executableName + " [--scene <name>] [--warmup <count>] [--frames <count>] [--dt <seconds>]\n"
+        "    [--camera-path <file>] [--headless] [--context-api native|egl|osmesa]\n"
+        "    [--gl-backend native|null|recording] [--gl-capture <file>]\n"
+        "    [--report-json <file>] [--report-csv <file>] [--baseline <report json>] [--tolerance <fraction>]\n"
+        "    --scene        scene to render, \"" + DEFAULT_BENCH_SCENE_NAME + "\" by default,\n"
+        "                   or a generated grid|city|hierarchy:<object count>[:<seed>] stress scene,\n"
+        "                   hierarchy ones taking a branching factor after the seed, 1 for a single chain\n"
+        "    --warmup       frames rendered before measuring\n"
+        "    --frames       frames measured\n"
+        "    --dt           simulated seconds per frame, independent of the wall clock\n"
+        "    --camera-path  keyframe file, an orbit around the scene origin by default\n"
+        "    --headless     render offscreen into an invisible window's framebuffer object\n"
+        "    --context-api  GL context creation API, e.g. osmesa for machines without a GPU\n"
+        "    --gl-backend   null measures CPU costs without any GL context and implies --headless,\n"
+        "                   recording captures GL calls for learnopengl_replay\n"
+        "    --gl-capture   capture file of the recording backend, implies --gl-backend recording\n"
+        "    --report-json  write summary and per-frame records as JSON, usable as a baseline later\n"
+        "    --report-csv   write per-frame records as CSV\n"
+        "    --baseline     compare the summary against an earlier JSON report, failing on regressions\n"
+        "    --tolerance    relative slowdown over the baseline still accepted, 0.05 by default";
+}
+
+//
+// Exceptions
+//
+
+BenchArgumentsException::BenchArgumentsException(const std::string & message):
+    std::runtime_error(message)
+{
+    // Empty
+}
+
+//
+// Service
+//
+
+static std::string_view GetArgumentValue(const int argc, const char * const * const argv, int & argIdx)
+{
+    if (argIdx + 1 >= argc)
+        throw BenchArgumentsException("Missing value for argument " + std::string(argv[argIdx]));
+
+    return argv[++argIdx];
+}
+
+static uint64_t ParseCount(const std::string_view value, const bool isZeroAllowed)
+{
+    uint64_t count = 0;
+
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+
+    if (error != std::errc() || end != value.data() + value.size() || (count == 0 && !isZeroAllowed))
+        throw BenchArgumentsException("Invalid frame count " + std::string(value));
+
+    return count;
+}
+
+static float ParsePositiveFloat(const std::string_view value)
+{
+    // std::from_chars for floating point types is missing from some standard libraries still.
+    const std::string valueString(value);
+
+    size_t parsedLength = 0;
+    float  result       = 0.0f;
+
+    try
+    {
+        result = std::stof(valueString, &parsedLength);
+    }
+    catch (const std::logic_error &)
+    {
+        throw BenchArgumentsException("Invalid number " + valueString);
+    }
+
+    if (parsedLength != valueString.size() || !std::isfinite(result) || result <= 0.0f)
+        throw BenchArgumentsException("Invalid number " + valueString);
+
+    return result;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <stdexcept>
+
+#include "app/options.h"
+
+//
+// Constants
+//
+
+constexpr uint64_t DEFAULT_BENCH_WARMUP_FRAME_COUNT = 60;
+constexpr uint64_t DEFAULT_BENCH_FRAME_COUNT        = 600;
+constexpr float    DEFAULT_BENCH_DELTA_TIME_SECONDS = 1.0f / 60.0f;
+
+// Maximum relative increase of a compared metric over its baseline value not reported as a regression
+constexpr float DEFAULT_BENCH_REGRESSION_TOLERANCE = 0.05f;
+
+const std::string DEFAULT_BENCH_SCENE_NAME = "demo";
+
+//
+// Interface types
+//
+
+struct BenchArguments final
+{
+    std::string SceneName        = DEFAULT_BENCH_SCENE_NAME;
+    uint64_t    WarmupFrameCount = DEFAULT_BENCH_WARMUP_FRAME_COUNT;
+    uint64_t    FrameCount       = DEFAULT_BENCH_FRAME_COUNT;
+    float       DeltaTimeSeconds = DEFAULT_BENCH_DELTA_TIME_SECONDS;
+
+    // Scripted orbit around the scene origin if not set
+    std::optional<std::string> CameraPathFilePath = std::nullopt;
+
+    bool       IsHeadless         = false;
+    ContextApi ContextCreationApi = ContextApi::Native;
+    GlBackend  Backend            = GlBackend::Native;
+
+    // Only used with the recording backend
+    std::string GlCaptureFilePath;
+
+    std::optional<std::string> JsonReportFilePath = std::nullopt;
+    std::optional<std::string> CsvReportFilePath  = std::nullopt;
+    std::optional<std::string> BaselineFilePath   = std::nullopt;
+    float                      RegressionTolerance = DEFAULT_BENCH_REGRESSION_TOLERANCE;
+};
+
+//
+// Utilities
+//
+
+BenchArguments ParseBenchArguments(const int argc, const char * const * const argv);
+
+std::string GetBenchUsage(const std::string & executableName);
+
+//
+// Exceptions
+//
+
+class BenchArgumentsException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit BenchArgumentsException(const std::string & message);
+};
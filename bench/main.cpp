@@ -0,0 +1,360 @@
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <chrono>
+#include <optional>
+#include <vector>
+#include <algorithm>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+
+#include "app/options.h"
+#include "app/window.h"
+#include "gl/utils.h"
+#include "gl/debug.h"
+#include "gl/program_binary_cache.h"
+#include "gl/shader_pack.h"
+#include "gl/shaders.h"
+#include "gl/statistics.h"
+#include "gl/backends/backend.h"
+#include "threading/ThreadPool.h"
+#include "rendering/RenderThread.h"
+#include "rendering/recording.h"
+#include "scene/registry.h"
+#include "textures/TextureLoader.h"
+#include "camera/Camera.h"
+#include "camera/CameraPath.h"
+#include "utils/boost_utils.h"
+#include "utils/glfw_utils.h"
+#include "config.h"
+#include "logging.h"
+
+#include "arguments.h"
+#include "report.h"
+
+//
+// Constants
+//
+
+static constexpr int BENCH_ERR_NONE         = 0;
+static constexpr int BENCH_ERR_UNKNOWN      = -1;
+static constexpr int BENCH_ERR_INIT_FAILED  = -2;
+static constexpr int BENCH_ERR_INVALID_ARGS = -3;
+static constexpr int BENCH_ERR_REGRESSION   = -4;
+
+static const char * const BENCH_WINDOW_TITLE = "learnopengl-cpp benchmark";
+
+static const std::string ORBIT_CAMERA_PATH_NAME = "orbit";
+
+static const glm::vec3 ORBIT_CAMERA_PATH_TARGET(0.0f);
+
+// Orbit radius is the scene's overview radius, height is relative to it.
+static constexpr float  ORBIT_CAMERA_PATH_HEIGHT_FACTOR    = 0.35f;
+static constexpr float  ORBIT_CAMERA_PATH_DURATION_SECONDS = 10.0f;
+static constexpr size_t ORBIT_CAMERA_PATH_KEYFRAME_COUNT   = 64;
+
+static constexpr float CAMERA_NEAR_PLANE    = 0.1f;
+static constexpr float MIN_CAMERA_FAR_PLANE = 100.0f;
+
+//
+// Forward declarations
+//
+
+static CameraPath CreateCameraPath(const BenchArguments & arguments, const Scene & scene);
+
+//
+// Main
+//
+
+int main(int argc, char * argv[])
+{
+    InitLogger();
+    LogBoostVersion();
+
+    BenchArguments arguments;
+
+    try
+    {
+        arguments = ParseBenchArguments(argc, argv);
+    }
+    catch (const BenchArgumentsException & e)
+    {
+        LOG_FATAL<< e.what() << '\n' << GetBenchUsage(argv[0]);
+
+        return BENCH_ERR_INVALID_ARGS;
+    }
+
+    try
+    {
+        AppOptions appOptions;
+        appOptions.IsHeadless         = arguments.IsHeadless;
+        appOptions.ContextCreationApi = arguments.ContextCreationApi;
+        appOptions.Backend            = arguments.Backend;
+
+        SetGlfwInitHints(appOptions);
+
+        ScopedGLFW scopedGlfw;
+
+        glfwSetErrorCallback(
+            [] (auto errorCode, auto description)
+            {
+                LOG_ERROR<< "GLFW error " << errorCode << ": " << description;
+            }
+        );
+
+        const UniqueWindow window = CreateGlWindow(WindowSettings{
+            WINDOW_WIDTH,
+            WINDOW_HEIGHT,
+            BENCH_WINDOW_TITLE,
+            !arguments.IsHeadless,
+            arguments.ContextCreationApi,
+            arguments.Backend,
+            arguments.GlCaptureFilePath
+        });
+
+        InitGlDebugOutput(GetDefaultGlDebugSettings());
+
+        LogGlInfo();
+
+        InitProgramBinaryCache(PROGRAM_BINARY_CACHE_DIR);
+        InitParallelShaderCompilation(MAX_SHADER_COMPILER_THREADS);
+        LoadShaderPack(SHADER_PACK_PATH);
+
+        // No vsync, frame times would measure the display refresh rate otherwise.
+        if (arguments.Backend != GlBackend::Null)
+            glfwSwapInterval(0);
+
+        ThreadPool    threadPool(ThreadPool::GetDefaultThreadCount());
+        TextureLoader textureLoader(threadPool);
+
+        Scene scene = CreateNamedScene(arguments.SceneName, textureLoader);
+
+        // Frames drawn with fallback programs or placeholder textures would skew the measurements.
+        WaitForSceneShaderPrograms(scene);
+        textureLoader.WaitForPendingLoads();
+
+        const CameraPath cameraPath = CreateCameraPath(arguments, scene);
+
+        // Stress scenes span far beyond the interactive demo's view distance.
+        const PerspectiveProjection cameraProjection{
+            0.5f * std::numbers::pi_v<float>,
+            static_cast<float>(WINDOW_WIDTH) / static_cast<float>(WINDOW_HEIGHT),
+            CAMERA_NEAR_PLANE,
+            std::max(MIN_CAMERA_FAR_PLANE, 4.0f*scene.OverviewRadius)
+        };
+
+        Camera camera(cameraPath.Sample(0.0f), cameraProjection);
+
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        glEnable(GL_DEPTH_TEST);
+
+        // Setup GL calls aren't part of any measured frame.
+        TakeRenderStatistics();
+
+        BenchRun run{
+            arguments.SceneName,
+            arguments.CameraPathFilePath.value_or(ORBIT_CAMERA_PATH_NAME),
+            arguments.WarmupFrameCount,
+            arguments.DeltaTimeSeconds,
+            std::vector<BenchFrameRecord>(arguments.FrameCount)
+        };
+
+        const uint64_t measuredBeginFrameIdx = arguments.WarmupFrameCount;
+        const uint64_t measuredEndFrameIdx   = measuredBeginFrameIdx + arguments.FrameCount;
+
+        // Rows are numbered by the frame they measure, warmup frames included.
+        for (size_t recordIdx = 0; recordIdx < run.Frames.size(); recordIdx++)
+            run.Frames[recordIdx].FrameIndex = measuredBeginFrameIdx + recordIdx;
+
+        // GPU timings arrive a few frames late, so extra unmeasured frames let them drain.
+        const uint64_t totalFrameCount = measuredEndFrameIdx + GPU_PROFILER_FRAME_LATENCY;
+
+        const auto isMeasuredFrame = [measuredBeginFrameIdx, measuredEndFrameIdx] (const uint64_t frameIdx) {
+            return frameIdx >= measuredBeginFrameIdx && frameIdx < measuredEndFrameIdx;
+        };
+
+        RenderThread renderThread(window.get(), RENDER_FRAMES_IN_FLIGHT, arguments.IsHeadless);
+
+        // Records are preallocated and written field-wise by either thread, so no locking is needed.
+        renderThread.SetFrameReportCallback(
+            [&run, &isMeasuredFrame, measuredBeginFrameIdx] (const RenderFrameReport & report)
+            {
+                if (isMeasuredFrame(report.FrameIndex))
+                {
+                    BenchFrameRecord & record = run.Frames[report.FrameIndex - measuredBeginFrameIdx];
+
+                    record.RenderCpuMs           = 1000.0f*report.CpuSeconds;
+                    record.DrawCalls             = report.Statistics.Get(RenderCounter::DrawCalls);
+                    record.Triangles             = report.Statistics.Get(RenderCounter::Triangles);
+                    record.ShaderProgramSwitches = report.Statistics.Get(RenderCounter::ShaderProgramSwitches);
+                    record.UniformUploads        = report.Statistics.Get(RenderCounter::UniformUploads);
+                }
+
+                if (report.GpuFrameIndex.has_value() && isMeasuredFrame(*report.GpuFrameIndex))
+                {
+                    uint64_t gpuFrameNs = 0;
+                    for (const GpuScopeTiming & timing : report.GpuTimings)
+                    {
+                        if (timing.Depth == 0)
+                            gpuFrameNs += timing.DurationNs;
+                    }
+
+                    run.Frames[*report.GpuFrameIndex - measuredBeginFrameIdx].GpuMs = 1.0e-6f*static_cast<float>(gpuFrameNs);
+                }
+            }
+        );
+
+        LOG_INFO<< "Benchmarking scene " << run.SceneName << " along camera path " << run.CameraPathName
+            << " for " << arguments.WarmupFrameCount << " warmup and " << arguments.FrameCount << " measured frames";
+
+        auto lastFrameStartTime = std::chrono::steady_clock::now();
+
+        for (uint64_t frameIdx = 0; frameIdx < totalFrameCount && !glfwWindowShouldClose(window.get()); frameIdx++)
+        {
+            const auto frameStartTime = std::chrono::steady_clock::now();
+
+            // Time of the previous frame is only known once this one starts.
+            if (frameIdx > 0 && isMeasuredFrame(frameIdx - 1))
+            {
+                run.Frames[frameIdx - 1 - measuredBeginFrameIdx].FrameMs
+                    = std::chrono::duration<float, std::milli>(frameStartTime - lastFrameStartTime).count();
+            }
+
+            lastFrameStartTime = frameStartTime;
+
+            // Simulated time only depends on the frame index, so every run renders the same frames.
+            const float simulatedSeconds = arguments.DeltaTimeSeconds*static_cast<float>(frameIdx);
+            const float pathSeconds      = cameraPath.GetDurationSeconds() > 0.0f
+                ? std::fmod(simulatedSeconds, cameraPath.GetDurationSeconds())
+                : 0.0f;
+
+            camera.GetLookAtSettings() = cameraPath.Sample(pathSeconds);
+
+            RenderSnapshot & snapshot = renderThread.AcquireSnapshot();
+
+            BuildRenderSnapshot(scene, camera, snapshot);
+
+            snapshot.FrameIndex  = frameIdx;
+            snapshot.PolygonMode = GL_FILL;
+            glfwGetFramebufferSize(window.get(), &snapshot.FramebufferWidth, &snapshot.FramebufferHeight);
+
+            RecordRenderSnapshotCommands(snapshot, &threadPool);
+
+            renderThread.SubmitSnapshot();
+
+            glfwPollEvents();
+        }
+
+        renderThread.WaitIdle();
+
+        LogGlDebugSummary();
+        LogProgramBinaryCacheSummary();
+        scene.ShaderPermutations->LogSummary();
+        textureLoader.LogSummary();
+        LogGlBackendSummary();
+
+        const BenchSummary summary = SummarizeBenchRun(run);
+
+        LogBenchSummary(summary);
+
+        if (arguments.JsonReportFilePath.has_value())
+        {
+            WriteBenchJsonReport(run, summary, *arguments.JsonReportFilePath);
+
+            LOG_INFO<< "Wrote JSON report to " << *arguments.JsonReportFilePath;
+        }
+
+        if (arguments.CsvReportFilePath.has_value())
+        {
+            WriteBenchCsvReport(run, *arguments.CsvReportFilePath);
+
+            LOG_INFO<< "Wrote CSV report to " << *arguments.CsvReportFilePath;
+        }
+
+        if (arguments.BaselineFilePath.has_value())
+        {
+            const BenchSummary baseline = LoadBenchBaseline(*arguments.BaselineFilePath);
+
+            const std::vector<BenchRegression> regressions
+                = FindBenchRegressions(summary, baseline, arguments.RegressionTolerance);
+
+            if (!regressions.empty())
+            {
+                for (const BenchRegression & regression : regressions)
+                {
+                    // There is no relative change to report from a baseline of 0.
+                    if (regression.BaselineValue > 0.0)
+                    {
+                        LOG_ERROR<< "Regression in " << regression.Metric << ": "
+                            << regression.BaselineValue << " -> " << regression.CurrentValue << " ("
+                            << 100.0*(regression.CurrentValue / regression.BaselineValue - 1.0) << "%)";
+                    }
+                    else
+                    {
+                        LOG_ERROR<< "Regression in " << regression.Metric << ": " << regression.CurrentValue
+                            << " (was 0)";
+                    }
+                }
+
+                return BENCH_ERR_REGRESSION;
+            }
+
+            LOG_INFO<< "No regressions against baseline " << *arguments.BaselineFilePath
+                << " with tolerance " << arguments.RegressionTolerance;
+        }
+    }
+    catch (const ScopedGLFW::GLFWInitFailedException & e)
+    {
+        LOG_FATAL<< "Failed to init GLFW: " << e.what();
+
+        return BENCH_ERR_INIT_FAILED;
+    }
+    catch (const WindowCreationException & e)
+    {
+        LOG_FATAL<< "Failed to create window: " << e.what();
+
+        return BENCH_ERR_INIT_FAILED;
+    }
+    catch (const UnknownSceneException & e)
+    {
+        LOG_FATAL<< e.what();
+
+        return BENCH_ERR_INVALID_ARGS;
+    }
+    catch (const std::exception & e)
+    {
+        LOG_FATAL<< "Fatal error: " << e.what();
+
+        return BENCH_ERR_UNKNOWN;
+    }
+    catch (...)
+    {
+        LOG_FATAL<< "Unknown error";
+
+        return BENCH_ERR_UNKNOWN;
+    }
+
+    return BENCH_ERR_NONE;
+}
+
+//
+// Service
+//
+
+static CameraPath CreateCameraPath(const BenchArguments & arguments, const Scene & scene)
+{
+    if (arguments.CameraPathFilePath.has_value())
+        return LoadCameraPathFromFile(*arguments.CameraPathFilePath);
+
+    return MakeOrbitCameraPath(
+        ORBIT_CAMERA_PATH_TARGET,
+        scene.OverviewRadius,
+        ORBIT_CAMERA_PATH_HEIGHT_FACTOR*scene.OverviewRadius,
+        ORBIT_CAMERA_PATH_DURATION_SECONDS,
+        ORBIT_CAMERA_PATH_KEYFRAME_COUNT
+    );
+}
@@ -0,0 +1,297 @@
+#include "report.h"
+
+#include <algorithm>
+#include <fstream>
+#include <regex>
+#include <functional>
+
+#include "utils/file_utils.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+static const std::string MIN_METRIC_SUFFIX = "_min";
+static const std::string MAX_METRIC_SUFFIX = "_max";
+static const std::string TIME_METRIC_INFIX = "_ms_";
+
+// Smallest increases counted as regressions, so that metrics with a baseline at or near 0, e.g. GPU times without
+// timer queries or counters a change brought down to 0, aren't flagged for any noise above it.
+static constexpr double MIN_TIME_REGRESSION_DELTA_MS = 0.01;
+static constexpr double MIN_COUNTER_REGRESSION_DELTA = 1.0;
+
+//
+// Forward declarations
+//
+
+static void AddDistributionMetrics(const std::string & name, std::vector<double> values, BenchSummary & summary);
+
+static void AddAverageMetric(
+    const std::string &                                     name,
+    const std::vector<BenchFrameRecord> &                   frames,
+    const std::function<uint64_t(const BenchFrameRecord &)> getValue,
+    BenchSummary &                                          summary
+);
+
+static std::string EscapeJsonString(const std::string & string);
+
+static bool EndsWith(const std::string & string, const std::string & suffix);
+
+//
+// Utilities
+//
+
+BenchSummary SummarizeBenchRun(const BenchRun & run)
+{
+    BenchSummary summary;
+
+    std::vector<double> frameMs;
+    std::vector<double> renderCpuMs;
+    std::vector<double> gpuMs;
+
+    for (const BenchFrameRecord & frame : run.Frames)
+    {
+        frameMs.push_back(frame.FrameMs);
+        renderCpuMs.push_back(frame.RenderCpuMs);
+
+        if (frame.GpuMs.has_value())
+            gpuMs.push_back(*frame.GpuMs);
+    }
+
+    AddDistributionMetrics("frame_ms", std::move(frameMs), summary);
+    AddDistributionMetrics("render_cpu_ms", std::move(renderCpuMs), summary);
+    AddDistributionMetrics("gpu_ms", std::move(gpuMs), summary);
+
+    AddAverageMetric("draw_calls_avg", run.Frames, [] (const auto & frame) { return frame.DrawCalls; }, summary);
+    AddAverageMetric("triangles_avg", run.Frames, [] (const auto & frame) { return frame.Triangles; }, summary);
+    AddAverageMetric(
+        "shader_program_switches_avg",
+        run.Frames,
+        [] (const auto & frame) { return frame.ShaderProgramSwitches; },
+        summary
+    );
+    AddAverageMetric("uniform_uploads_avg", run.Frames, [] (const auto & frame) { return frame.UniformUploads; }, summary);
+
+    return summary;
+}
+
+void LogBenchSummary(const BenchSummary & summary)
+{
+    LOG_INFO<< "Benchmark summary:";
+
+    for (const auto & [metric, value] : summary)
+        LOG_INFO<< "    " << metric << ": " << value;
+}
+
+void WriteBenchJsonReport(const BenchRun & run, const BenchSummary & summary, const std::string & filePath)
+{
+    std::ofstream file(filePath);
+    if (!file)
+        throw BenchReportException("Failed to open " + filePath + " for writing");
+
+    file<< "{\n"
+        << "  \"scene\": \"" << EscapeJsonString(run.SceneName) << "\",\n"
+        << "  \"camera_path\": \"" << EscapeJsonString(run.CameraPathName) << "\",\n"
+        << "  \"warmup_frames\": " << run.WarmupFrameCount << ",\n"
+        << "  \"dt\": " << run.DeltaTimeSeconds << ",\n"
+        << "  \"summary\": {";
+
+    bool isFirst = true;
+    for (const auto & [metric, value] : summary)
+    {
+        file<< (isFirst ? "\n" : ",\n") << "    \"" << metric << "\": " << value;
+        isFirst = false;
+    }
+
+    file<< "\n  },\n"
+        << "  \"frames\": [";
+
+    isFirst = true;
+    for (const BenchFrameRecord & frame : run.Frames)
+    {
+        file<< (isFirst ? "\n" : ",\n")
+            << "    {\"frame\": " << frame.FrameIndex
+            << ", \"frame_ms\": " << frame.FrameMs
+            << ", \"render_cpu_ms\": " << frame.RenderCpuMs
+            << ", \"gpu_ms\": ";
+
+        if (frame.GpuMs.has_value())
+            file<< *frame.GpuMs;
+        else
+            file<< "null";
+
+        file<< ", \"draw_calls\": " << frame.DrawCalls
+            << ", \"triangles\": " << frame.Triangles
+            << ", \"shader_program_switches\": " << frame.ShaderProgramSwitches
+            << ", \"uniform_uploads\": " << frame.UniformUploads << '}';
+
+        isFirst = false;
+    }
+
+    file<< "\n  ]\n"
+        << "}\n";
+
+    if (!file)
+        throw BenchReportException("Failed to write " + filePath);
+}
+
+void WriteBenchCsvReport(const BenchRun & run, const std::string & filePath)
+{
+    std::ofstream file(filePath);
+    if (!file)
+        throw BenchReportException("Failed to open " + filePath + " for writing");
+
+    file<< "frame,frame_ms,render_cpu_ms,gpu_ms,draw_calls,triangles,shader_program_switches,uniform_uploads\n";
+
+    for (const BenchFrameRecord & frame : run.Frames)
+    {
+        file<< frame.FrameIndex << ',' << frame.FrameMs << ',' << frame.RenderCpuMs << ',';
+
+        if (frame.GpuMs.has_value())
+            file<< *frame.GpuMs;
+
+        file<< ',' << frame.DrawCalls << ',' << frame.Triangles << ','
+            << frame.ShaderProgramSwitches << ',' << frame.UniformUploads << '\n';
+    }
+
+    if (!file)
+        throw BenchReportException("Failed to write " + filePath);
+}
+
+BenchSummary LoadBenchBaseline(const std::string & filePath)
+{
+    const std::string content = ReadFileContent(filePath);
+
+    // Only the flat summary object written by WriteBenchJsonReport() is supported, not arbitrary JSON.
+    static const std::regex SUMMARY_REGEX(R"re("summary"\s*:\s*\{([^}]*)\})re");
+    static const std::regex METRIC_REGEX(R"re("([A-Za-z0-9_]+)"\s*:\s*([-+0-9.eE]+))re");
+
+    std::smatch summaryMatch;
+    if (!std::regex_search(content, summaryMatch, SUMMARY_REGEX))
+        throw BenchReportException("No summary found in baseline report " + filePath);
+
+    BenchSummary baseline;
+
+    const std::string summaryContent = summaryMatch[1].str();
+    for (
+        auto metricIt = std::sregex_iterator(summaryContent.cbegin(), summaryContent.cend(), METRIC_REGEX);
+        metricIt != std::sregex_iterator();
+        ++metricIt
+    )
+    {
+        try
+        {
+            baseline[(*metricIt)[1].str()] = std::stod((*metricIt)[2].str());
+        }
+        catch (const std::logic_error &)
+        {
+            throw BenchReportException("Invalid value of " + (*metricIt)[1].str() + " in baseline report " + filePath);
+        }
+    }
+
+    return baseline;
+}
+
+std::vector<BenchRegression> FindBenchRegressions(
+    const BenchSummary & current,
+    const BenchSummary & baseline,
+    const double         tolerance
+)
+{
+    std::vector<BenchRegression> regressions;
+
+    for (const auto & [metric, currentValue] : current)
+    {
+        if (EndsWith(metric, MIN_METRIC_SUFFIX) || EndsWith(metric, MAX_METRIC_SUFFIX))
+            continue;
+
+        const auto baselineIt = baseline.find(metric);
+        if (baselineIt == baseline.cend())
+            continue;
+
+        const double baselineValue = baselineIt->second;
+        const double minDelta      = metric.find(TIME_METRIC_INFIX) != std::string::npos
+            ? MIN_TIME_REGRESSION_DELTA_MS
+            : MIN_COUNTER_REGRESSION_DELTA;
+
+        if (currentValue - baselineValue > std::max(baselineValue*tolerance, minDelta))
+            regressions.push_back(BenchRegression{metric, baselineValue, currentValue});
+    }
+
+    return regressions;
+}
+
+//
+// Exceptions
+//
+
+BenchReportException::BenchReportException(const std::string & message):
+    std::runtime_error(message)
+{
+    // Empty
+}
+
+//
+// Service
+//
+
+static void AddDistributionMetrics(const std::string & name, std::vector<double> values, BenchSummary & summary)
+{
+    if (values.empty())
+        return;
+
+    std::sort(values.begin(), values.end());
+
+    double sum = 0.0;
+    for (const double value : values)
+        sum += value;
+
+    const auto getPercentile = [&values] (const size_t percentile) {
+        return values[(values.size() - 1)*percentile / 100];
+    };
+
+    summary[name + MIN_METRIC_SUFFIX] = values.front();
+    summary[name + "_avg"]            = sum / static_cast<double>(values.size());
+    summary[name + "_p50"]            = getPercentile(50);
+    summary[name + "_p95"]            = getPercentile(95);
+    summary[name + "_p99"]            = getPercentile(99);
+    summary[name + MAX_METRIC_SUFFIX] = values.back();
+}
+
+static void AddAverageMetric(
+    const std::string &                                     name,
+    const std::vector<BenchFrameRecord> &                   frames,
+    const std::function<uint64_t(const BenchFrameRecord &)> getValue,
+    BenchSummary &                                          summary
+)
+{
+    if (frames.empty())
+        return;
+
+    uint64_t sum = 0;
+    for (const BenchFrameRecord & frame : frames)
+        sum += getValue(frame);
+
+    summary[name] = static_cast<double>(sum) / static_cast<double>(frames.size());
+}
+
+static std::string EscapeJsonString(const std::string & string)
+{
+    std::string escaped;
+
+    for (const char character : string)
+    {
+        if (character == '"' || character == '\\')
+            escaped.push_back('\\');
+
+        escaped.push_back(character);
+    }
+
+    return escaped;
+}
+
+static bool EndsWith(const std::string & string, const std::string & suffix)
+{
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <map>
+#include <stdexcept>
+
+//
+// Interface types
+//
+
+struct BenchFrameRecord final
+{
+    uint64_t FrameIndex = 0;
+
+    // Main thread time between consecutive frame starts
+    float FrameMs = 0.0f;
+
+    // Render thread time spent recording GL calls and presenting
+    float RenderCpuMs = 0.0f;
+
+    // Missing when the frame's timer queries were dropped
+    std::optional<float> GpuMs = std::nullopt;
+
+    uint64_t DrawCalls             = 0;
+    uint64_t Triangles             = 0;
+    uint64_t ShaderProgramSwitches = 0;
+    uint64_t UniformUploads        = 0;
+};
+
+struct BenchRun final
+{
+    std::string                   SceneName;
+    std::string                   CameraPathName;
+    uint64_t                      WarmupFrameCount;
+    float                         DeltaTimeSeconds;
+    std::vector<BenchFrameRecord> Frames;
+};
+
+// Metric name, e.g. "frame_ms_p95", to its value, lower being better for all of them
+using BenchSummary = std::map<std::string, double>;
+
+struct BenchRegression final
+{
+    std::string Metric;
+    double      BaselineValue;
+    double      CurrentValue;
+};
+
+//
+// Utilities
+//
+
+// Min, avg, p50, p95, p99 and max of frame, render CPU and GPU times, and averages of the counters.
+BenchSummary SummarizeBenchRun(const BenchRun & run);
+
+void LogBenchSummary(const BenchSummary & summary);
+
+void WriteBenchJsonReport(const BenchRun & run, const BenchSummary & summary, const std::string & filePath);
+
+void WriteBenchCsvReport(const BenchRun & run, const std::string & filePath);
+
+// Reads the summary of a report written by WriteBenchJsonReport().
+BenchSummary LoadBenchBaseline(const std::string & filePath);
+
+// Single frame extremes are too noisy to compare, so min and max metrics are skipped. Increases within the relative
+// tolerance, or below a small absolute delta for baselines at or near 0, aren't regressions.
+std::vector<BenchRegression> FindBenchRegressions(
+    const BenchSummary & current,
+    const BenchSummary & baseline,
+    const double         tolerance
+);
+
+//
+// Exceptions
+//
+
+class BenchReportException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit BenchReportException(const std::string & message);
+};
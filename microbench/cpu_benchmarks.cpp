@@ -0,0 +1,86 @@
+#include <cstdio>
+#include <array>
+#include <numbers>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <GLFW/glfw3.h>
+
+#include "camera/projections.h"
+#include "meshes/Vertex.h"
+#include "utils/glfw/key_mapping.h"
+#include "utils/file_utils.h"
+
+//
+// Benchmarks
+//
+
+static void BenchmarkVerticesToVertexData(benchmark::State & state)
+{
+    const std::vector<Vertex> vertices(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(VerticesToVertexData(vertices));
+
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+BENCHMARK(BenchmarkVerticesToVertexData)->Arg(36)->Arg(4096)->Arg(65536);
+
+static void BenchmarkCreateMatrixFromPerspectiveProjection(benchmark::State & state)
+{
+    const Projection projection = PerspectiveProjection{0.5f*std::numbers::pi_v<float>, 4.0f / 3.0f, 0.1f, 100.0f};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(CreateMatrixFromProjection(projection));
+}
+
+BENCHMARK(BenchmarkCreateMatrixFromPerspectiveProjection);
+
+static void BenchmarkCreateMatrixFromOrthographicProjection(benchmark::State & state)
+{
+    const Projection projection = OrthographicProjection{2.0f, 2.0f, 0.1f, 100.0f};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(CreateMatrixFromProjection(projection));
+}
+
+BENCHMARK(BenchmarkCreateMatrixFromOrthographicProjection);
+
+// Mix of mapped and unmapped keys, as received from key callbacks
+static void BenchmarkKeyFromGlfw(benchmark::State & state)
+{
+    static const std::array GLFW_KEYS{GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_S, GLFW_KEY_D, GLFW_KEY_Q, GLFW_KEY_ESCAPE, GLFW_KEY_F1};
+
+    size_t keyIdx = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(KeyFromGlfw(GLFW_KEYS[keyIdx]));
+
+        keyIdx = (keyIdx + 1) % GLFW_KEYS.size();
+    }
+}
+
+BENCHMARK(BenchmarkKeyFromGlfw);
+
+static void BenchmarkReadFileContent(benchmark::State & state)
+{
+    const std::string filePath = "learnopengl_microbench_" + std::to_string(state.range(0)) + ".tmp";
+
+    {
+        std::ofstream file(filePath, std::ios::binary);
+        file<< std::string(static_cast<size_t>(state.range(0)), 'x');
+    }
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ReadFileContent(filePath));
+
+    state.SetBytesProcessed(state.iterations()*state.range(0));
+
+    std::remove(filePath.c_str());
+}
+
+BENCHMARK(BenchmarkReadFileContent)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
@@ -0,0 +1,128 @@
+#include <array>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+
+#include "gl/wrappers.h"
+#include "gl/StatefulShaderProgram.h"
+
+//
+// Constants
+//
+
+static const std::array<std::string, 8> UNIFORM_NAMES{
+    "model",
+    "lightSourcePosition",
+    "objectRgb",
+    "lightRgb",
+    "ambientStrength",
+    "textureMixAmount",
+    "tex0",
+    "tex1"
+};
+
+//
+// Forward declarations
+//
+
+static UniqueShaderProgram CreateLinkedShaderProgram();
+
+//
+// Benchmarks
+//
+
+// Steady state lookup of cached locations, as done for every uniform set by name
+static void BenchmarkGetUniformLocationByName(benchmark::State & state)
+{
+    const StatefulShaderProgram shaderProgram(CreateLinkedShaderProgram());
+
+    for (const std::string & uniformName : UNIFORM_NAMES)
+        shaderProgram.GetUniformLocation(uniformName);
+
+    size_t uniformIdx = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(shaderProgram.GetUniformLocation(UNIFORM_NAMES[uniformIdx]));
+
+        uniformIdx = (uniformIdx + 1) % UNIFORM_NAMES.size();
+    }
+}
+
+BENCHMARK(BenchmarkGetUniformLocationByName);
+
+static void BenchmarkGetUniformLocationById(benchmark::State & state)
+{
+    const StatefulShaderProgram shaderProgram(CreateLinkedShaderProgram());
+
+    std::array<UniformId, UNIFORM_NAMES.size()> uniformIds;
+    for (size_t uniformIdx = 0; uniformIdx < UNIFORM_NAMES.size(); uniformIdx++)
+    {
+        uniformIds[uniformIdx] = InternUniformName(UNIFORM_NAMES[uniformIdx]);
+        shaderProgram.GetUniformLocation(uniformIds[uniformIdx]);
+    }
+
+    size_t uniformIdx = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(shaderProgram.GetUniformLocation(uniformIds[uniformIdx]));
+
+        uniformIdx = (uniformIdx + 1) % uniformIds.size();
+    }
+}
+
+BENCHMARK(BenchmarkGetUniformLocationById);
+
+// Dispatch of every UniformValue alternative through std::visit down to the glUniform* call of the null backend
+static void BenchmarkSetUniformValue(benchmark::State & state)
+{
+    StatefulShaderProgram shaderProgram(CreateLinkedShaderProgram());
+    shaderProgram.Use();
+
+    const std::array<UniformValue, 8> uniformValues{
+        GLint(1),
+        GLuint(2),
+        3.0f,
+        glm::vec1(4.0f),
+        glm::vec2(5.0f),
+        glm::vec3(6.0f),
+        glm::vec4(7.0f),
+        glm::mat4(8.0f)
+    };
+
+    size_t valueIdx = 0;
+    for (auto _ : state)
+    {
+        shaderProgram.SetUniformValue(0, uniformValues[valueIdx]);
+
+        valueIdx = (valueIdx + 1) % uniformValues.size();
+    }
+}
+
+BENCHMARK(BenchmarkSetUniformValue);
+
+static void BenchmarkCreateManyTextures(benchmark::State & state)
+{
+    const size_t textureCount = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(UniqueTexture::CreateMany(textureCount));
+
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+
+BENCHMARK(BenchmarkCreateManyTextures)->Arg(1)->Arg(16)->Arg(256);
+
+//
+// Service
+//
+
+// The null backend links programs without any shaders attached, after which every uniform name has a location.
+static UniqueShaderProgram CreateLinkedShaderProgram()
+{
+    UniqueShaderProgram shaderProgram = UniqueShaderProgram::Create();
+
+    glLinkProgram(shaderProgram);
+
+    return shaderProgram;
+}
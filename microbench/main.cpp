@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include "gl/backends/backend.h"
+#include "logging.h"
+
+//
+// Main
+//
+
+int main(int argc, char * argv[])
+{
+    InitLogger();
+
+    // The null backend runs the benchmarked code without a GL context, its calls doing nothing but validation.
+    if (!LoadGlBackend(GlBackend::Null, ""))
+    {
+        LOG_FATAL<< "Failed to load the null GL backend";
+
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    LogGlBackendSummary();
+
+    return 0;
+}
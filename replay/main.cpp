@@ -0,0 +1,303 @@
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <charconv>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "app/options.h"
+#include "app/window.h"
+#include "gl/utils.h"
+#include "gl/backends/replay.h"
+#include "utils/boost_utils.h"
+#include "utils/glfw_utils.h"
+#include "config.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+static constexpr int REPLAY_ERR_NONE         = 0;
+static constexpr int REPLAY_ERR_UNKNOWN      = -1;
+static constexpr int REPLAY_ERR_INIT_FAILED  = -2;
+static constexpr int REPLAY_ERR_INVALID_ARGS = -3;
+
+static const char * const REPLAY_WINDOW_TITLE = "learnopengl-cpp replay";
+
+static constexpr uint64_t DEFAULT_REPLAY_LOOP_COUNT = 10;
+
+//
+// Service types
+//
+
+struct ReplayArguments final
+{
+    std::string                CaptureFilePath;
+    uint64_t                   LoopCount          = DEFAULT_REPLAY_LOOP_COUNT;
+    bool                       IsHeadless         = false;
+    ContextApi                 ContextCreationApi = ContextApi::Native;
+    std::optional<std::string> CsvReportFilePath  = std::nullopt;
+};
+
+struct ReplayFrameRecord final
+{
+    uint64_t LoopIndex;
+    uint64_t FrameIndex;
+    double   CpuMilliseconds;
+};
+
+//
+// Forward declarations
+//
+
+static ReplayArguments ParseReplayArguments(const int argc, const char * const * const argv);
+
+static std::string GetReplayUsage(const std::string & executableName);
+
+static void LogReplaySummary(const std::vector<ReplayFrameRecord> & records);
+
+static void WriteReplayCsvReport(const std::vector<ReplayFrameRecord> & records, const std::string & filePath);
+
+//
+// Main
+//
+
+int main(int argc, char * argv[])
+{
+    InitLogger();
+    LogBoostVersion();
+
+    ReplayArguments arguments;
+
+    try
+    {
+        arguments = ParseReplayArguments(argc, argv);
+    }
+    catch (const AppOptionsException & e)
+    {
+        LOG_FATAL<< e.what() << '\n' << GetReplayUsage(argv[0]);
+
+        return REPLAY_ERR_INVALID_ARGS;
+    }
+
+    try
+    {
+        // Decoding doesn't need a context, so bad captures fail before any window shows up.
+        GlCaptureReplayer replayer(arguments.CaptureFilePath);
+
+        AppOptions appOptions;
+        appOptions.IsHeadless         = arguments.IsHeadless;
+        appOptions.ContextCreationApi = arguments.ContextCreationApi;
+
+        SetGlfwInitHints(appOptions);
+
+        ScopedGLFW scopedGlfw;
+
+        glfwSetErrorCallback(
+            [] (auto errorCode, auto description)
+            {
+                LOG_ERROR<< "GLFW error " << errorCode << ": " << description;
+            }
+        );
+
+        const UniqueWindow window = CreateGlWindow(WindowSettings{
+            WINDOW_WIDTH,
+            WINDOW_HEIGHT,
+            REPLAY_WINDOW_TITLE,
+            !arguments.IsHeadless,
+            arguments.ContextCreationApi,
+            GlBackend::Native,
+            ""
+        });
+
+        LogGlInfo();
+
+        // No vsync, frame times would measure the display refresh rate otherwise.
+        glfwSwapInterval(0);
+
+        replayer.ReplaySetup();
+
+        std::vector<ReplayFrameRecord> records;
+        records.reserve(arguments.LoopCount*replayer.GetFrameCount());
+
+        for (uint64_t loopIdx = 0; loopIdx < arguments.LoopCount && !glfwWindowShouldClose(window.get()); loopIdx++)
+        {
+            for (size_t frameIdx = 0; frameIdx < replayer.GetFrameCount(); frameIdx++)
+            {
+                const auto frameStartTime = std::chrono::steady_clock::now();
+
+                replayer.ReplayFrame(frameIdx);
+
+                // Swapping the invisible window of headless runs just keeps the driver's frame pacing.
+                glfwSwapBuffers(window.get());
+
+                records.push_back(ReplayFrameRecord{
+                    loopIdx,
+                    frameIdx,
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStartTime).count()
+                });
+            }
+
+            glfwPollEvents();
+        }
+
+        replayer.ReplayTeardown();
+
+        LOG_INFO<< "Replayed " << replayer.GetReplayedCallCount() << " GL calls";
+
+        LogReplaySummary(records);
+
+        if (arguments.CsvReportFilePath.has_value())
+        {
+            WriteReplayCsvReport(records, *arguments.CsvReportFilePath);
+
+            LOG_INFO<< "Wrote CSV report to " << *arguments.CsvReportFilePath;
+        }
+    }
+    catch (const ScopedGLFW::GLFWInitFailedException & e)
+    {
+        LOG_FATAL<< "Failed to init GLFW: " << e.what();
+
+        return REPLAY_ERR_INIT_FAILED;
+    }
+    catch (const WindowCreationException & e)
+    {
+        LOG_FATAL<< "Failed to create window: " << e.what();
+
+        return REPLAY_ERR_INIT_FAILED;
+    }
+    catch (const GlCaptureException & e)
+    {
+        LOG_FATAL<< "Failed to replay capture: " << e.what();
+
+        return REPLAY_ERR_INIT_FAILED;
+    }
+    catch (const std::exception & e)
+    {
+        LOG_FATAL<< "Fatal error: " << e.what();
+
+        return REPLAY_ERR_UNKNOWN;
+    }
+    catch (...)
+    {
+        LOG_FATAL<< "Unknown error";
+
+        return REPLAY_ERR_UNKNOWN;
+    }
+
+    return REPLAY_ERR_NONE;
+}
+
+//
+// Service
+//
+
+static ReplayArguments ParseReplayArguments(const int argc, const char * const * const argv)
+{
+    ReplayArguments arguments;
+
+    const auto getValue = [argc, argv] (int & argIdx) -> std::string_view
+    {
+        if (argIdx + 1 >= argc)
+            throw AppOptionsException("Missing value for argument " + std::string(argv[argIdx]));
+
+        return argv[++argIdx];
+    };
+
+    for (int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        const std::string_view arg(argv[argIdx]);
+
+        if (arg == "--loops")
+        {
+            const std::string_view value = getValue(argIdx);
+
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), arguments.LoopCount);
+
+            if (error != std::errc() || end != value.data() + value.size() || arguments.LoopCount == 0)
+                throw AppOptionsException("Invalid loop count " + std::string(value));
+        }
+        else if (arg == "--headless")
+            arguments.IsHeadless = true;
+        else if (arg == "--context-api")
+            arguments.ContextCreationApi = ParseContextApi(getValue(argIdx));
+        else if (arg == "--report-csv")
+            arguments.CsvReportFilePath = getValue(argIdx);
+        else if (arguments.CaptureFilePath.empty() && !arg.starts_with("--"))
+            arguments.CaptureFilePath = arg;
+        else
+            throw AppOptionsException("Unrecognized argument " + std::string(arg));
+    }
+
+    if (arguments.CaptureFilePath.empty())
+        throw AppOptionsException("Missing capture file");
+
+    return arguments;
+}
+
+static std::string GetReplayUsage(const std::string & executableName)
+{
+    return "Usage: " + executableName + " <capture file> [--loops <count>] [--headless] [--context-api native|egl|osmesa]\n"
+        "    [--report-csv <file>]\n"
+        "    capture file   written by learnopengl or learnopengl_bench with --gl-capture\n"
+        "    --loops        times the captured frames are replayed, " + std::to_string(DEFAULT_REPLAY_LOOP_COUNT) + " by default\n"
+        "    --headless     replay into an invisible window\n"
+        "    --context-api  GL context creation API, e.g. osmesa for machines without a GPU\n"
+        "    --report-csv   write per-frame CPU times as CSV";
+}
+
+static void LogReplaySummary(const std::vector<ReplayFrameRecord> & records)
+{
+    if (records.empty())
+    {
+        LOG_WARNING<< "No frames replayed";
+
+        return;
+    }
+
+    std::vector<double> frameMilliseconds;
+    frameMilliseconds.reserve(records.size());
+
+    for (const ReplayFrameRecord & record : records)
+        frameMilliseconds.push_back(record.CpuMilliseconds);
+
+    std::sort(frameMilliseconds.begin(), frameMilliseconds.end());
+
+    const auto getPercentile = [&frameMilliseconds] (const double percentile)
+    {
+        const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(frameMilliseconds.size())));
+
+        return frameMilliseconds[std::clamp<size_t>(rank, 1, frameMilliseconds.size()) - 1];
+    };
+
+    double totalMilliseconds = 0.0;
+
+    for (const double milliseconds : frameMilliseconds)
+        totalMilliseconds += milliseconds;
+
+    LOG_INFO<< "Replayed " << records.size() << " frames, CPU time min/avg/p50/p99/max "
+        << frameMilliseconds.front() << '/' << totalMilliseconds / static_cast<double>(frameMilliseconds.size()) << '/'
+        << getPercentile(50.0) << '/' << getPercentile(99.0) << '/' << frameMilliseconds.back() << " ms";
+}
+
+static void WriteReplayCsvReport(const std::vector<ReplayFrameRecord> & records, const std::string & filePath)
+{
+    std::ofstream file(filePath);
+
+    if (!file)
+        throw std::runtime_error("Failed to open replay report file " + filePath);
+
+    file<< "loop,frame,cpu_ms\n";
+
+    for (const ReplayFrameRecord & record : records)
+        file<< record.LoopIndex << ',' << record.FrameIndex << ',' << record.CpuMilliseconds << '\n';
+}
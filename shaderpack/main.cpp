@@ -0,0 +1,332 @@
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "app/options.h"
+#include "app/window.h"
+#include "gl/utils.h"
+#include "gl/shaders.h"
+#include "gl/shader_pack.h"
+#include "utils/boost_utils.h"
+#include "utils/file_utils.h"
+#include "utils/glfw_utils.h"
+#include "config.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+static constexpr int SHADERPACK_ERR_NONE           = 0;
+static constexpr int SHADERPACK_ERR_UNKNOWN        = -1;
+static constexpr int SHADERPACK_ERR_INIT_FAILED    = -2;
+static constexpr int SHADERPACK_ERR_INVALID_ARGS   = -3;
+static constexpr int SHADERPACK_ERR_INVALID_SHADER = -4;
+
+static const char * const SHADERPACK_WINDOW_TITLE = "learnopengl-cpp shaderpack";
+
+//
+// Service types
+//
+
+struct ShaderPackArguments final
+{
+    std::string OutputFilePath     = SHADER_PACK_PATH;
+    ContextApi  ContextCreationApi = ContextApi::Native;
+};
+
+//
+// Forward declarations
+//
+
+static ShaderPackArguments ParseShaderPackArguments(const int argc, const char * const * const argv);
+
+static std::string GetShaderPackUsage(const std::string & executableName);
+
+static std::vector<std::string> FindStageFiles();
+
+static std::string StripShaderSource(const std::string_view source);
+
+//
+// Main
+//
+
+// Resolves includes of every stage file in SHADERS_DIR, strips comments and redundant whitespace, validates
+// the result by compiling it and writes the shader pack. Nothing is written if any stage fails, so that
+// shader errors fail the build instead of startup.
+int main(int argc, char * argv[])
+{
+    InitLogger();
+    LogBoostVersion();
+
+    ShaderPackArguments arguments;
+
+    try
+    {
+        arguments = ParseShaderPackArguments(argc, argv);
+    }
+    catch (const AppOptionsException & e)
+    {
+        LOG_FATAL<< e.what() << '\n' << GetShaderPackUsage(argv[0]);
+
+        return SHADERPACK_ERR_INVALID_ARGS;
+    }
+
+    try
+    {
+        AppOptions appOptions;
+        appOptions.IsHeadless         = true;
+        appOptions.ContextCreationApi = arguments.ContextCreationApi;
+
+        SetGlfwInitHints(appOptions);
+
+        ScopedGLFW scopedGlfw;
+
+        glfwSetErrorCallback(
+            [] (auto errorCode, auto description)
+            {
+                LOG_ERROR<< "GLFW error " << errorCode << ": " << description;
+            }
+        );
+
+        // Compiling needs a context, e.g. of headless Mesa, the window itself is never shown.
+        const UniqueWindow window = CreateGlWindow(WindowSettings{
+            WINDOW_WIDTH,
+            WINDOW_HEIGHT,
+            SHADERPACK_WINDOW_TITLE,
+            false,
+            arguments.ContextCreationApi,
+            GlBackend::Native,
+            ""
+        });
+
+        LogGlInfo();
+
+        std::map<std::string, ResolvedShaderSource> sourcesByFilename;
+        size_t                                      originalSize = 0;
+        size_t                                      failedCount  = 0;
+
+        for (const std::string & shaderSourceFilename : FindStageFiles())
+        {
+            try
+            {
+                ResolvedShaderSource resolvedSource = ResolveShaderIncludes(shaderSourceFilename);
+
+                originalSize += resolvedSource.Source.size();
+
+                // Stripped separately, so that defines still go right after the #version directive.
+                const std::string_view source(resolvedSource.Source);
+                const std::string      strippedHead = StripShaderSource(source.substr(0, resolvedSource.DefinesOffset));
+                const std::string      strippedTail = StripShaderSource(source.substr(resolvedSource.DefinesOffset));
+
+                resolvedSource.Source        = strippedHead + strippedTail;
+                resolvedSource.DefinesOffset = strippedHead.size();
+
+                // The stripped source is what ships, so that's what gets validated.
+                CompileShaderFromSource(ShaderStageSource{
+                    DetermineShaderTypeFromFilename(shaderSourceFilename),
+                    shaderSourceFilename,
+                    resolvedSource.Source
+                });
+
+                sourcesByFilename.emplace(shaderSourceFilename, std::move(resolvedSource));
+            }
+            catch (const ShaderPreprocessingException & e)
+            {
+                LOG_ERROR<< e.what();
+
+                failedCount++;
+            }
+            catch (const ShaderCompilationException &)
+            {
+                // Compilation logs are logged already
+                failedCount++;
+            }
+        }
+
+        if (failedCount > 0)
+        {
+            LOG_FATAL<< failedCount << " shaders failed validation, not writing " << arguments.OutputFilePath;
+
+            return SHADERPACK_ERR_INVALID_SHADER;
+        }
+
+        size_t strippedSize = 0;
+
+        for (const auto & [shaderSourceFilename, resolvedSource] : sourcesByFilename)
+            strippedSize += resolvedSource.Source.size();
+
+        LOG_INFO<< "Validated " << sourcesByFilename.size() << " shaders, stripped from " << originalSize
+            << " to " << strippedSize << " bytes";
+
+        WriteShaderPack(arguments.OutputFilePath, sourcesByFilename);
+    }
+    catch (const ScopedGLFW::GLFWInitFailedException & e)
+    {
+        LOG_FATAL<< "Failed to init GLFW: " << e.what();
+
+        return SHADERPACK_ERR_INIT_FAILED;
+    }
+    catch (const WindowCreationException & e)
+    {
+        LOG_FATAL<< "Failed to create window: " << e.what();
+
+        return SHADERPACK_ERR_INIT_FAILED;
+    }
+    catch (const std::exception & e)
+    {
+        LOG_FATAL<< "Fatal error: " << e.what();
+
+        return SHADERPACK_ERR_UNKNOWN;
+    }
+    catch (...)
+    {
+        LOG_FATAL<< "Unknown error";
+
+        return SHADERPACK_ERR_UNKNOWN;
+    }
+
+    return SHADERPACK_ERR_NONE;
+}
+
+//
+// Service
+//
+
+static ShaderPackArguments ParseShaderPackArguments(const int argc, const char * const * const argv)
+{
+    ShaderPackArguments arguments;
+
+    const auto getValue = [argc, argv] (int & argIdx) -> std::string_view
+    {
+        if (argIdx + 1 >= argc)
+            throw AppOptionsException("Missing value for argument " + std::string(argv[argIdx]));
+
+        return argv[++argIdx];
+    };
+
+    for (int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        const std::string_view arg(argv[argIdx]);
+
+        if (arg == "--output")
+            arguments.OutputFilePath = getValue(argIdx);
+        else if (arg == "--context-api")
+            arguments.ContextCreationApi = ParseContextApi(getValue(argIdx));
+        else
+            throw AppOptionsException("Unrecognized argument " + std::string(arg));
+    }
+
+    return arguments;
+}
+
+static std::string GetShaderPackUsage(const std::string & executableName)
+{
+    return "Usage: " + executableName + " [--output <file>] [--context-api native|egl|osmesa]\n"
+        "    --output       shader pack to write, " + SHADER_PACK_PATH + " by default\n"
+        "    --context-api  GL context creation API shaders are validated with, e.g. osmesa for machines without a GPU";
+}
+
+// Stage files only, included files are packed as part of the stages including them.
+static std::vector<std::string> FindStageFiles()
+{
+    std::vector<std::string> shaderSourceFilenames;
+
+    for (const std::filesystem::directory_entry & entry : std::filesystem::directory_iterator(SHADERS_DIR))
+    {
+        const std::string shaderSourceFilename = entry.path().filename().string();
+
+        if (entry.is_regular_file() && IsShaderSourceFilename(shaderSourceFilename))
+            shaderSourceFilenames.push_back(shaderSourceFilename);
+    }
+
+    std::sort(shaderSourceFilenames.begin(), shaderSourceFilenames.end());
+
+    return shaderSourceFilenames;
+}
+
+// Drops comments, indentation, trailing whitespace and repeated spaces. Line breaks are kept, even of empty
+// lines and within comments, since directives end with them and #line directives count them.
+static std::string StripShaderSource(const std::string_view source)
+{
+    std::string stripped;
+    stripped.reserve(source.size());
+
+    bool isInBlockComment = false;
+    bool isInLineComment  = false;
+    bool isSpacePending   = false;
+
+    for (size_t charIdx = 0; charIdx < source.size(); charIdx++)
+    {
+        const char character     = source[charIdx];
+        const char nextCharacter = charIdx + 1 < source.size() ? source[charIdx + 1] : '\0';
+
+        if (character == '\n')
+        {
+            isInLineComment = false;
+            isSpacePending  = false;
+
+            while (!stripped.empty() && stripped.back() == ' ')
+                stripped.pop_back();
+
+            stripped += '\n';
+
+            continue;
+        }
+
+        if (isInLineComment)
+            continue;
+
+        if (isInBlockComment)
+        {
+            if (character == '*' && nextCharacter == '/')
+            {
+                isInBlockComment = false;
+                isSpacePending   = true;
+                charIdx++;
+            }
+
+            continue;
+        }
+
+        if (character == '/' && nextCharacter == '/')
+        {
+            isInLineComment = true;
+
+            continue;
+        }
+
+        if (character == '/' && nextCharacter == '*')
+        {
+            isInBlockComment = true;
+            charIdx++;
+
+            continue;
+        }
+
+        if (character == ' ' || character == '\t' || character == '\r')
+        {
+            isSpacePending = true;
+
+            continue;
+        }
+
+        // Indentation is dropped, other whitespace collapses into a single space.
+        if (isSpacePending && !stripped.empty() && stripped.back() != '\n')
+            stripped += ' ';
+
+        isSpacePending = false;
+
+        stripped += character;
+    }
+
+    return stripped;
+}
@@ -0,0 +1,146 @@
+#include "options.h"
+
+#include <cassert>
+#include <string_view>
+#include <charconv>
+
+#include "config.h"
+
+//
+// Forward declarations
+//
+
+static std::string_view GetOptionValue(const int argc, const char * const * const argv, int & argIdx);
+
+static uint64_t ParseFrameCount(const std::string_view value);
+
+//
+// Utilities
+//
+
+AppOptions ParseAppOptions(const int argc, const char * const * const argv)
+{
+    AppOptions options;
+
+    for (int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        const std::string_view arg(argv[argIdx]);
+
+        if (arg == "--headless")
+            options.IsHeadless = true;
+        else if (arg == "--frames")
+            options.FrameCount = ParseFrameCount(GetOptionValue(argc, argv, argIdx));
+        else if (arg == "--context-api")
+            options.ContextCreationApi = ParseContextApi(GetOptionValue(argc, argv, argIdx));
+        else if (arg == "--gl-backend")
+            options.Backend = ParseGlBackend(GetOptionValue(argc, argv, argIdx));
+        else if (arg == "--gl-capture")
+        {
+            options.Backend           = GlBackend::Recording;
+            options.GlCaptureFilePath = GetOptionValue(argc, argv, argIdx);
+        }
+        else if (arg == "--hot-reload-shaders")
+            options.IsShaderHotReloadEnabled = true;
+        else
+            throw AppOptionsException("Unrecognized option " + std::string(arg));
+    }
+
+    // Without a context there's nothing to present.
+    if (options.Backend == GlBackend::Null)
+        options.IsHeadless = true;
+
+    if (options.Backend == GlBackend::Recording && options.GlCaptureFilePath.empty())
+        options.GlCaptureFilePath = DEFAULT_GL_CAPTURE_FILE_PATH;
+
+    // Headless runs have nobody to close the window, so they must stop by themselves.
+    if (options.IsHeadless && !options.FrameCount.has_value())
+        options.FrameCount = DEFAULT_HEADLESS_FRAME_COUNT;
+
+    return options;
+}
+
+std::string GetAppUsage(const std::string & executableName)
+{
+    return "Usage: " + executableName + " [--headless] [--frames <count>] [--context-api native|egl|osmesa]\n"
+        "    [--gl-backend native|null|recording] [--gl-capture <file>] [--hot-reload-shaders]\n"
+        "    --headless     render offscreen into an invisible window's framebuffer object\n"
+        "    --frames       exit after rendering the given number of frames\n"
+        "    --context-api  GL context creation API, e.g. osmesa for machines without a GPU\n"
+        "    --gl-backend   null runs without any GL context and implies --headless,\n"
+        "                   recording captures GL calls for learnopengl_replay\n"
+        "    --gl-capture   capture file of the recording backend, implies --gl-backend recording\n"
+        "    --hot-reload-shaders\n"
+        "                   rebuild shader programs in the background once files under " + SHADERS_DIR + " change";
+}
+
+const char * ContextApiToCStr(const ContextApi contextApi)
+{
+    switch (contextApi)
+    {
+    case ContextApi::Native:
+        return "native";
+    case ContextApi::Egl:
+        return "egl";
+    case ContextApi::OsMesa:
+        return "osmesa";
+    default:
+        assert(false && "unrecognized context API");
+        return "<UNKNOWN>";
+    }
+}
+
+ContextApi ParseContextApi(const std::string_view value)
+{
+    for (const ContextApi contextApi : {ContextApi::Native, ContextApi::Egl, ContextApi::OsMesa})
+    {
+        if (value == ContextApiToCStr(contextApi))
+            return contextApi;
+    }
+
+    throw AppOptionsException("Invalid context API " + std::string(value));
+}
+
+GlBackend ParseGlBackend(const std::string_view value)
+{
+    for (const GlBackend backend : {GlBackend::Native, GlBackend::Null, GlBackend::Recording})
+    {
+        if (value == GlBackendToCStr(backend))
+            return backend;
+    }
+
+    throw AppOptionsException("Invalid GL backend " + std::string(value));
+}
+
+//
+// Exceptions
+//
+
+AppOptionsException::AppOptionsException(const std::string & message):
+    std::runtime_error(message)
+{
+    // Empty
+}
+
+//
+// Service
+//
+
+static std::string_view GetOptionValue(const int argc, const char * const * const argv, int & argIdx)
+{
+    if (argIdx + 1 >= argc)
+        throw AppOptionsException("Missing value for option " + std::string(argv[argIdx]));
+
+    return argv[++argIdx];
+}
+
+static uint64_t ParseFrameCount(const std::string_view value)
+{
+    uint64_t frameCount = 0;
+
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), frameCount);
+
+    if (error != std::errc() || end != value.data() + value.size() || frameCount == 0)
+        throw AppOptionsException("Invalid frame count " + std::string(value));
+
+    return frameCount;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+#include "gl/backends/backend.h"
+
+//
+// Interface types
+//
+
+enum class ContextApi: uint8_t
+{
+    Native,
+    Egl,
+    OsMesa
+};
+
+struct AppOptions final
+{
+    bool                    IsHeadless         = false;
+    std::optional<uint64_t> FrameCount         = std::nullopt;
+    ContextApi              ContextCreationApi = ContextApi::Native;
+    GlBackend               Backend            = GlBackend::Native;
+    // Only used with the recording backend
+    std::string             GlCaptureFilePath;
+    bool                    IsShaderHotReloadEnabled = false;
+};
+
+//
+// Utilities
+//
+
+AppOptions ParseAppOptions(const int argc, const char * const * const argv);
+
+std::string GetAppUsage(const std::string & executableName);
+
+const char * ContextApiToCStr(const ContextApi contextApi);
+
+// Inverse of ContextApiToCStr(), throws AppOptionsException on unrecognized names.
+ContextApi ParseContextApi(const std::string_view value);
+
+// Inverse of GlBackendToCStr(), throws AppOptionsException on unrecognized names.
+GlBackend ParseGlBackend(const std::string_view value);
+
+//
+// Exceptions
+//
+
+class AppOptionsException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit AppOptionsException(const std::string & message);
+};
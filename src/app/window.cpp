@@ -0,0 +1,117 @@
+#include "window.h"
+
+#include <cassert>
+
+#include <glad/glad.h>
+
+#include "gl/backends/backend.h"
+#include "config.h"
+#include "logging.h"
+
+//
+// Forward declarations
+//
+
+static int ContextApiToGlfwHint(const ContextApi contextApi);
+
+//
+// Utilities
+//
+
+void SetGlfwInitHints(const AppOptions & options)
+{
+#ifdef GLFW_PLATFORM_NULL
+    // Without a display server, OSMesa contexts are only available on the null platform (GLFW 3.4+).
+    // The null GL backend needs no context at all, so it never needs a display server either.
+    if (
+        (options.IsHeadless && options.ContextCreationApi == ContextApi::OsMesa)
+            || options.Backend == GlBackend::Null
+    )
+    {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
+        LOG_INFO<< "Using GLFW null platform";
+    }
+#else
+    static_cast<void>(options);
+#endif
+}
+
+UniqueWindow CreateGlWindow(const WindowSettings & settings)
+{
+    const bool hasContext = settings.Backend != GlBackend::Null;
+
+    glfwWindowHint(GLFW_CLIENT_API, hasContext ? GLFW_OPENGL_API : GLFW_NO_API);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, OPENGL_MAJOR_VERSION);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, OPENGL_MINOR_VERSION);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, IS_GL_DEBUG_CONTEXT ? GLFW_TRUE : GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, ContextApiToGlfwHint(settings.ContextCreationApi));
+    glfwWindowHint(GLFW_VISIBLE, settings.IsVisible ? GLFW_TRUE : GLFW_FALSE);
+
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+    UniqueWindow window(
+        glfwCreateWindow(settings.Width, settings.Height, settings.Title, nullptr, nullptr),
+        &glfwDestroyWindow
+    );
+
+    if (!window)
+        throw WindowCreationException("Failed to create GLFW window");
+
+    if (hasContext)
+    {
+        LOG_INFO<< "Created " << (settings.IsVisible ? "visible" : "invisible") << " GLFW window with "
+            << ContextApiToCStr(settings.ContextCreationApi) << " context";
+
+        glfwMakeContextCurrent(window.get());
+    }
+    else
+    {
+        LOG_INFO<< "Created " << (settings.IsVisible ? "visible" : "invisible") << " GLFW window without context";
+    }
+
+    if (!LoadGlBackend(settings.Backend, settings.GlCaptureFilePath))
+        throw WindowCreationException("Failed to load GLAD");
+
+    assert(
+        GLVersion.major == OPENGL_MAJOR_VERSION
+            && GLVersion.minor == OPENGL_MINOR_VERSION
+            && "GLAD GL version must match the expected one"
+    );
+    LOG_INFO<< "Loaded GLAD for OpenGL version " << GLVersion.major << '.' << GLVersion.minor;
+
+    return window;
+}
+
+//
+// Exceptions
+//
+
+WindowCreationException::WindowCreationException(const std::string & message):
+    std::runtime_error(message)
+{
+    // Empty
+}
+
+//
+// Service
+//
+
+static int ContextApiToGlfwHint(const ContextApi contextApi)
+{
+    switch (contextApi)
+    {
+    case ContextApi::Native:
+        return GLFW_NATIVE_CONTEXT_API;
+    case ContextApi::Egl:
+        return GLFW_EGL_CONTEXT_API;
+    case ContextApi::OsMesa:
+        return GLFW_OSMESA_CONTEXT_API;
+    default:
+        assert(false && "unrecognized context API");
+        return GLFW_NATIVE_CONTEXT_API;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+#include <GLFW/glfw3.h>
+
+#include "options.h"
+
+//
+// Interface types
+//
+
+struct WindowSettings final
+{
+    int          Width;
+    int          Height;
+    const char * Title;
+    bool         IsVisible;
+    ContextApi   ContextCreationApi;
+    GlBackend    Backend;
+    // Only used with the recording backend
+    std::string  GlCaptureFilePath;
+};
+
+using UniqueWindow = std::unique_ptr<GLFWwindow, decltype(&glfwDestroyWindow)>;
+
+//
+// Utilities
+//
+
+// Must be called before GLFW initialization.
+void SetGlfwInitHints(const AppOptions & options);
+
+// Creates a window with a GL context of the configured version, makes the context current and loads GLAD
+// through the given backend. Windows of the null backend have no context at all.
+UniqueWindow CreateGlWindow(const WindowSettings & settings);
+
+//
+// Exceptions
+//
+
+class WindowCreationException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit WindowCreationException(const std::string & message);
+};
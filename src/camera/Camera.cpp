@@ -17,6 +17,15 @@ glm::mat4 CreateMatrixFromLookAtSettings(const LookAtSettings & lookAtSettings)
     );
 }
 
+LookAtSettings InterpolateLookAtSettings(const LookAtSettings & from, const LookAtSettings & to, const float alpha)
+{
+    return LookAtSettings{
+        glm::mix(from.EyePosition, to.EyePosition, alpha),
+        glm::mix(from.Target,      to.Target,      alpha),
+        glm::mix(from.EyeUpWorld,  to.EyeUpWorld,  alpha)
+    };
+}
+
 //
 // Construction
 //
@@ -75,3 +84,15 @@ const glm::mat4 & Camera::GetProjectionMatrix() const
     assert(m_ProjectionMatrix.has_value());
     return *m_ProjectionMatrix;
 }
+
+//
+// Camera utilities
+//
+
+Camera InterpolateCameras(const Camera & from, const Camera & to, const float alpha)
+{
+    return Camera(
+        InterpolateLookAtSettings(from.GetLookAtSettings(), to.GetLookAtSettings(), alpha),
+        InterpolateProjections(from.GetProjection(), to.GetProjection(), alpha)
+    );
+}
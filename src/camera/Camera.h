@@ -42,6 +42,8 @@ public: // Interface
 
 glm::mat4 CreateMatrixFromLookAtSettings(const LookAtSettings & lookAtSettings);
 
+LookAtSettings InterpolateLookAtSettings(const LookAtSettings & from, const LookAtSettings & to, const float alpha);
+
 //
 // Camera
 //
@@ -78,3 +80,9 @@ private: // Members
     mutable std::optional<glm::mat4> m_LookAtMatrix;
     mutable std::optional<glm::mat4> m_ProjectionMatrix;
 };
+
+//
+// Camera utilities
+//
+
+Camera InterpolateCameras(const Camera & from, const Camera & to, const float alpha);
@@ -0,0 +1,158 @@
+#include "CameraPath.h"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+//
+// Constants
+//
+
+static const glm::vec3 WORLD_UP(0.0f, 1.0f, 0.0f);
+
+//
+// Construction
+//
+
+CameraPath::CameraPath(std::vector<CameraPathKeyframe> keyframes):
+    m_Keyframes(std::move(keyframes))
+{
+    assert(!m_Keyframes.empty() && "camera path must have at least one keyframe");
+    assert(
+        std::is_sorted(
+            m_Keyframes.cbegin(),
+            m_Keyframes.cend(),
+            [] (const CameraPathKeyframe & lhs, const CameraPathKeyframe & rhs) { return lhs.TimeSeconds < rhs.TimeSeconds; }
+        )
+            && "camera path keyframes must be sorted by time"
+    );
+}
+
+//
+// Interface
+//
+
+LookAtSettings CameraPath::Sample(const float timeSeconds) const
+{
+    const auto nextKeyframeIt = std::upper_bound(
+        m_Keyframes.cbegin(),
+        m_Keyframes.cend(),
+        timeSeconds,
+        [] (const float time, const CameraPathKeyframe & keyframe) { return time < keyframe.TimeSeconds; }
+    );
+
+    if (nextKeyframeIt == m_Keyframes.cbegin())
+        return m_Keyframes.front().Settings;
+
+    if (nextKeyframeIt == m_Keyframes.cend())
+        return m_Keyframes.back().Settings;
+
+    const CameraPathKeyframe & previousKeyframe = *(nextKeyframeIt - 1);
+    const CameraPathKeyframe & nextKeyframe     = *nextKeyframeIt;
+
+    const float alpha = (timeSeconds - previousKeyframe.TimeSeconds)
+        / (nextKeyframe.TimeSeconds - previousKeyframe.TimeSeconds);
+
+    return InterpolateLookAtSettings(previousKeyframe.Settings, nextKeyframe.Settings, alpha);
+}
+
+float CameraPath::GetDurationSeconds() const
+{
+    return m_Keyframes.back().TimeSeconds - m_Keyframes.front().TimeSeconds;
+}
+
+const std::vector<CameraPathKeyframe> & CameraPath::GetKeyframes() const
+{
+    return m_Keyframes;
+}
+
+//
+// Utilities
+//
+
+CameraPath LoadCameraPathFromFile(const std::string & filePath)
+{
+    std::ifstream file(filePath);
+
+    if (!file)
+        throw CameraPathLoadingException("Failed to open camera path file " + filePath);
+
+    std::vector<CameraPathKeyframe> keyframes;
+
+    std::string line;
+    size_t      lineNumber = 0;
+
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        std::istringstream lineStream(line);
+
+        CameraPathKeyframe keyframe{0.0f, LookAtSettings{glm::vec3(0.0f), glm::vec3(0.0f), WORLD_UP}};
+
+        lineStream>> keyframe.TimeSeconds
+            >> keyframe.Settings.EyePosition.x >> keyframe.Settings.EyePosition.y >> keyframe.Settings.EyePosition.z
+            >> keyframe.Settings.Target.x      >> keyframe.Settings.Target.y      >> keyframe.Settings.Target.z;
+
+        if (!lineStream)
+            throw CameraPathLoadingException("Malformed keyframe at " + filePath + ':' + std::to_string(lineNumber));
+
+        if (!keyframes.empty() && keyframe.TimeSeconds <= keyframes.back().TimeSeconds)
+            throw CameraPathLoadingException("Keyframe out of time order at " + filePath + ':' + std::to_string(lineNumber));
+
+        keyframes.push_back(keyframe);
+    }
+
+    if (keyframes.empty())
+        throw CameraPathLoadingException("No keyframes in camera path file " + filePath);
+
+    return CameraPath(std::move(keyframes));
+}
+
+CameraPath MakeOrbitCameraPath(
+    const glm::vec3 & target,
+    const float       radius,
+    const float       height,
+    const float       durationSeconds,
+    const size_t      keyframeCount
+)
+{
+    assert(keyframeCount > 1);
+    assert(durationSeconds > 0.0f);
+
+    std::vector<CameraPathKeyframe> keyframes;
+    keyframes.reserve(keyframeCount);
+
+    for (size_t keyframeIdx = 0; keyframeIdx < keyframeCount; keyframeIdx++)
+    {
+        const float progress = static_cast<float>(keyframeIdx) / static_cast<float>(keyframeCount - 1);
+        const float angle    = 2.0f*std::numbers::pi_v<float>*progress;
+
+        keyframes.push_back(CameraPathKeyframe{
+            durationSeconds*progress,
+            LookAtSettings{
+                target + glm::vec3(radius*std::sin(angle), height, radius*std::cos(angle)),
+                target,
+                WORLD_UP
+            }
+        });
+    }
+
+    return CameraPath(std::move(keyframes));
+}
+
+//
+// Exceptions
+//
+
+CameraPathLoadingException::CameraPathLoadingException(const std::string & message):
+    std::runtime_error(message)
+{
+    // Empty
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+
+//
+// Interface types
+//
+
+struct CameraPathKeyframe final
+{
+    float          TimeSeconds;
+    LookAtSettings Settings;
+};
+
+//
+// CameraPath
+//
+
+// Piecewise linear camera animation through keyframes sorted by time,
+// clamped to the first and the last keyframe outside of their time range.
+class CameraPath final
+{
+public: // Construction
+
+    explicit CameraPath(std::vector<CameraPathKeyframe> keyframes);
+
+public: // Interface
+
+    LookAtSettings Sample(const float timeSeconds) const;
+
+    float GetDurationSeconds() const;
+
+    const std::vector<CameraPathKeyframe> & GetKeyframes() const;
+
+private: // Members
+
+    std::vector<CameraPathKeyframe> m_Keyframes;
+};
+
+//
+// Utilities
+//
+
+// Each non-empty line not starting with '#' holds a keyframe as
+// "time eyeX eyeY eyeZ targetX targetY targetZ", with world Y axis up.
+CameraPath LoadCameraPathFromFile(const std::string & filePath);
+
+// Full circle around the target at constant height, starting on the +Z side.
+CameraPath MakeOrbitCameraPath(
+    const glm::vec3 & target,
+    const float       radius,
+    const float       height,
+    const float       durationSeconds,
+    const size_t      keyframeCount
+);
+
+//
+// Exceptions
+//
+
+class CameraPathLoadingException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit CameraPathLoadingException(const std::string & message);
+};
@@ -218,7 +218,7 @@ void FlyCameraController::OnScroll(const glm::vec2 scrollOffset)
 
     if (!std::holds_alternative<PerspectiveProjection>(cameraProjection))
     {
-        BOOST_LOG_TRIVIAL(warning)<< "Ignoring scroll since the controlled camera does NOT have perspective projection";
+        LOG_WARNING<< "Ignoring scroll since the controlled camera does NOT have perspective projection";
 
         return;
     }
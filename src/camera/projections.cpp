@@ -35,6 +35,41 @@ public: // Interface
     }
 };
 
+struct ProjectionInterpolationVisitor final
+{
+public: // Attributes
+
+    float Alpha;
+
+public: // Interface
+
+    Projection operator()(const OrthographicProjection & from, const OrthographicProjection & to) const
+    {
+        return OrthographicProjection{
+            glm::mix(from.Width,     to.Width,     Alpha),
+            glm::mix(from.Height,    to.Height,    Alpha),
+            glm::mix(from.NearPlane, to.NearPlane, Alpha),
+            glm::mix(from.FarPlane,  to.FarPlane,  Alpha)
+        };
+    }
+
+    Projection operator()(const PerspectiveProjection & from, const PerspectiveProjection & to) const
+    {
+        return PerspectiveProjection{
+            glm::mix(from.VerticalFov, to.VerticalFov, Alpha),
+            glm::mix(from.AspectRatio, to.AspectRatio, Alpha),
+            glm::mix(from.NearPlane,   to.NearPlane,   Alpha),
+            glm::mix(from.FarPlane,    to.FarPlane,    Alpha)
+        };
+    }
+
+    template <typename FromProjection, typename ToProjection>
+    Projection operator()(const FromProjection & /*from*/, const ToProjection & to) const
+    {
+        return to;
+    }
+};
+
 } // anonymous namespace
 
 //
@@ -47,3 +82,8 @@ glm::mat4 CreateMatrixFromProjection(const Projection & projection)
 
     return std::visit(PROJECTION_MATRIX_CREATION_VISITOR, projection);
 }
+
+Projection InterpolateProjections(const Projection & from, const Projection & to, const float alpha)
+{
+    return std::visit(ProjectionInterpolationVisitor{alpha}, from, to);
+}
@@ -31,3 +31,6 @@ using Projection = std::variant<OrthographicProjection, PerspectiveProjection>;
 //
 
 glm::mat4 CreateMatrixFromProjection(const Projection & projection);
+
+// Projections of different kinds can't be blended, in which case the target projection is returned.
+Projection InterpolateProjections(const Projection & from, const Projection & to, const float alpha);
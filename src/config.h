@@ -1,21 +1,85 @@
 #pragma once
 
-#include "logging.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <chrono>
 
 //
 // Constants
 //
 
-constexpr auto MIN_LOG_LEVEL = boost::log::trivial::debug; // TODO: Configure via CMake?
+// Messages logged while the queue to the logging thread is full are dropped. Must be a power of two.
+constexpr size_t LOG_QUEUE_CAPACITY = 1024;
+
+// How long the logging thread sleeps once it finds the queue empty
+constexpr std::chrono::milliseconds LOG_THREAD_IDLE_INTERVAL(5);
 
 constexpr int OPENGL_MAJOR_VERSION = 3;
 constexpr int OPENGL_MINOR_VERSION = 3;
 
 const char * const WINDOW_TITLE = "learnopengl-cpp";
 
+// Frame count of headless runs not given one explicitly
+constexpr uint64_t DEFAULT_HEADLESS_FRAME_COUNT = 1000;
+
 constexpr int WINDOW_WIDTH  = 800;
 constexpr int WINDOW_HEIGHT = 600;
 
+constexpr float SIMULATION_STEPS_PER_SECOND   = 120.0f;
+constexpr int   MAX_SIMULATION_CATCH_UP_STEPS = 8;
+
+// 0 disables overlap of main thread simulation with rendering of the previous frame.
+constexpr size_t RENDER_FRAMES_IN_FLIGHT = 1;
+
+// Regions are reused round-robin once the GPU is done with them, so there should be enough of them
+// to cover the frames queued by the driver, not just the ones in flight on the render thread.
+constexpr size_t STREAMING_BUFFER_REGION_COUNT = 3;
+constexpr size_t STREAMING_BUFFER_REGION_SIZE  = 4*1024*1024;
+
+// Texture bytes TextureLoader fills in per frame through pixel unpack buffers, which have as many regions
+// as streaming buffers, see above. Larger textures are filled in on a frame of their own.
+constexpr size_t TEXTURE_UPLOAD_BUDGET_PER_FRAME = 8*1024*1024;
+
+// GPU timer query results are read back this many frames late, so that reading them never stalls.
+constexpr size_t GPU_PROFILER_FRAME_LATENCY = 4;
+
+// Render statistics are logged as min/avg/p99 over this many frames, once per as many frames.
+constexpr size_t RENDER_STATISTICS_WINDOW_FRAMES = 300;
+
+// GL debug output, see gl/debug.h. Release builds don't ask for a debug context,
+// so they fall back to sampled glGetError checks, only made at frame ends.
+#ifdef NDEBUG
+constexpr bool     IS_GL_DEBUG_CONTEXT          = false;
+constexpr uint32_t GL_ERROR_CHECK_CALL_INTERVAL = 0;
+#else
+constexpr bool     IS_GL_DEBUG_CONTEXT          = true;
+constexpr uint32_t GL_ERROR_CHECK_CALL_INTERVAL = 256;
+#endif
+
+constexpr uint32_t GL_DEBUG_MAX_MESSAGES_PER_SECOND = 20;
+
+// Threads drivers supporting parallel shader compilation may use, 0xFFFFFFFF leaves it up to them.
+constexpr uint32_t MAX_SHADER_COMPILER_THREADS = 0xFFFFFFFF;
+
+// Shader hot reloading waits for files to stop changing for this long, since editors save in several steps.
+constexpr std::chrono::milliseconds SHADER_HOT_RELOAD_DEBOUNCE_INTERVAL(100);
+
+// Linked program binaries are cached here, keyed by their sources and the driver.
+const std::string PROGRAM_BINARY_CACHE_DIR = "learnopengl_program_cache/";
+
+// Capture file of the recording GL backend not given one explicitly
+const std::string DEFAULT_GL_CAPTURE_FILE_PATH = "learnopengl_capture.glcap";
+
+// Only used with LEARNOPENGL_ENABLE_PROFILING
+const std::string PROFILING_TRACE_FILE_PATH = "learnopengl_trace.json";
+
 const std::string ASSETS_ROOT  = "assets/";
 const std::string SHADERS_DIR  = ASSETS_ROOT + "shaders/";
 const std::string TEXTURES_DIR = ASSETS_ROOT + "textures/";
+
+// Written by learnopengl_texturebake at build time, TextureLoader decodes the texture files themselves while missing.
+const std::string BAKED_TEXTURES_DIR = TEXTURES_DIR + "baked/";
+
+// Written by learnopengl_shaderpack at build time, shader files are read instead while it's missing.
+const std::string SHADER_PACK_PATH = ASSETS_ROOT + "shaders.glpack";
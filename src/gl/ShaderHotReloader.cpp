@@ -0,0 +1,232 @@
+#include "ShaderHotReloader.h"
+
+#include <cassert>
+#include <algorithm>
+#include <utility>
+
+#include "utils/file_utils.h"
+#include "utils/string_utils.h"
+#include "profiling/profiling.h"
+#include "config.h"
+#include "logging.h"
+
+//
+// Construction
+//
+
+ShaderHotReloader::ShaderHotReloader():
+    m_Mutex                (),
+    m_WatchedShaderPrograms(),
+    m_SubmittableReloads   (),
+    m_PendingReloads       (),
+    m_ReloadCount          (0),
+    m_FailedReloadCount    (0),
+    m_FileWatcher(
+        SHADERS_DIR,
+        SHADER_HOT_RELOAD_DEBOUNCE_INTERVAL,
+        [this] (const std::vector<std::string> & changedPaths) { OnFilesChanged(changedPaths); }
+    )
+{
+    // Empty
+}
+
+//
+// Interface
+//
+
+void ShaderHotReloader::Watch(StatefulShaderProgram & shaderProgram, const ShaderPermutation & permutation)
+{
+    assert(shaderProgram.IsReloadable() && "watched shader program must be reloadable from its creation");
+
+    const uint64_t sourceHash = HashShaderStageSources(PreprocessShaderPermutation(permutation));
+
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    m_WatchedShaderPrograms.push_back(WatchedShaderProgram{&shaderProgram, permutation, sourceHash});
+}
+
+void ShaderHotReloader::Update()
+{
+    PROFILE_SCOPE("ShaderHotReloader::Update");
+
+    std::vector<ShaderProgramReload> reloads;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+
+        reloads.swap(m_SubmittableReloads);
+    }
+
+    if (!reloads.empty())
+        SubmitReloads(std::move(reloads));
+
+    if (!m_PendingReloads.empty())
+        SwapInCompletedReloads();
+}
+
+void ShaderHotReloader::LogSummary() const
+{
+    LOG_INFO<< "Reloaded shader programs " << m_ReloadCount << " times, " << m_FailedReloadCount << " reloads failed";
+}
+
+//
+// Service
+//
+
+void ShaderHotReloader::OnFilesChanged(const std::vector<std::string> & changedPaths)
+{
+    PROFILE_SCOPE("ShaderHotReloader::OnFilesChanged");
+
+    LOG_INFO<< "Shader files changed: " << MakeCommaSeparatedList(changedPaths);
+
+    std::vector<WatchedShaderProgram> watchedShaderPrograms;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+
+        watchedShaderPrograms = m_WatchedShaderPrograms;
+    }
+
+    // Preprocessed without holding the lock, so that Update() never waits for it. Programs themselves are only
+    // touched by Update(), on the GL context thread, hence logging file names only. Every program is checked,
+    // rather than tracking which files each includes, since preprocessing is cheap next to compiling.
+    std::vector<std::pair<size_t, uint64_t>> changedSourceHashes;
+    std::vector<ShaderProgramReload>         reloads;
+
+    for (size_t watchedIdx = 0; watchedIdx < watchedShaderPrograms.size(); watchedIdx++)
+    {
+        const WatchedShaderProgram & watched = watchedShaderPrograms[watchedIdx];
+
+        std::vector<ShaderStageSource> stages;
+
+        try
+        {
+            stages = PreprocessShaderPermutation(watched.Permutation);
+        }
+        catch (const ShaderPreprocessingException & e)
+        {
+            LOG_ERROR<< "Not reloading shader program of "
+                << MakeCommaSeparatedList(watched.Permutation.ShaderSourceFilenames) << ": " << e.what();
+
+            continue;
+        }
+        catch (const FileException & e)
+        {
+            LOG_ERROR<< "Not reloading shader program of "
+                << MakeCommaSeparatedList(watched.Permutation.ShaderSourceFilenames) << ": " << e.what();
+
+            continue;
+        }
+
+        const uint64_t sourceHash = HashShaderStageSources(stages);
+
+        if (sourceHash == watched.SourceHash)
+            continue;
+
+        changedSourceHashes.emplace_back(watchedIdx, sourceHash);
+        reloads.push_back(ShaderProgramReload{watched.ShaderProgram, std::move(stages)});
+    }
+
+    if (reloads.empty())
+        return;
+
+    LOG_INFO<< "Reloading " << reloads.size() << " shader programs";
+
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Programs are only ever added, so indices remain valid.
+    for (const auto & [watchedIdx, sourceHash] : changedSourceHashes)
+        m_WatchedShaderPrograms[watchedIdx].SourceHash = sourceHash;
+
+    for (ShaderProgramReload & reload : reloads)
+    {
+        // Supersedes a reload of the same program which Update() hasn't picked up yet
+        const auto submittableReloadIt = std::find_if(
+            m_SubmittableReloads.begin(),
+            m_SubmittableReloads.end(),
+            [&reload] (const ShaderProgramReload & submittableReload)
+            {
+                return submittableReload.ShaderProgram == reload.ShaderProgram;
+            }
+        );
+
+        if (submittableReloadIt != m_SubmittableReloads.end())
+            *submittableReloadIt = std::move(reload);
+        else
+            m_SubmittableReloads.push_back(std::move(reload));
+    }
+}
+
+void ShaderHotReloader::SubmitReloads(std::vector<ShaderProgramReload> && reloads)
+{
+    std::vector<std::vector<ShaderStageSource>> programStageLists;
+    programStageLists.reserve(reloads.size());
+
+    for (ShaderProgramReload & reload : reloads)
+        programStageLists.push_back(std::move(reload.Stages));
+
+    std::vector<PendingShaderProgram> replacements = SubmitShaderPrograms(programStageLists);
+    assert(replacements.size() == reloads.size());
+
+    for (size_t reloadIdx = 0; reloadIdx < reloads.size(); reloadIdx++)
+    {
+        StatefulShaderProgram * const shaderProgram = reloads[reloadIdx].ShaderProgram;
+
+        // Supersedes a reload of the same program whose build is still pending
+        const auto pendingReloadIt = std::find_if(
+            m_PendingReloads.begin(),
+            m_PendingReloads.end(),
+            [shaderProgram] (const PendingShaderProgramReload & pendingReload)
+            {
+                return pendingReload.ShaderProgram == shaderProgram;
+            }
+        );
+
+        if (pendingReloadIt != m_PendingReloads.end())
+            pendingReloadIt->Replacement = std::move(replacements[reloadIdx]);
+        else
+            m_PendingReloads.push_back(PendingShaderProgramReload{shaderProgram, std::move(replacements[reloadIdx])});
+    }
+}
+
+void ShaderHotReloader::SwapInCompletedReloads()
+{
+    for (auto pendingReloadIt = m_PendingReloads.begin(); pendingReloadIt != m_PendingReloads.end(); )
+    {
+        StatefulShaderProgram & shaderProgram = *pendingReloadIt->ShaderProgram;
+        PendingShaderProgram &  replacement   = pendingReloadIt->Replacement;
+
+        // Programs whose initial build is still pending are only replaced once it completes.
+        if (!shaderProgram.IsReady() || !IsShaderProgramBuildComplete(replacement.ShaderProgram, replacement.Build))
+        {
+            ++pendingReloadIt;
+
+            continue;
+        }
+
+        try
+        {
+            FinishShaderProgramBuild(replacement.ShaderProgram, std::move(replacement.Build));
+
+            LOG_INFO<< "Replacing shader program " << shaderProgram.Get() << " with reloaded " << replacement.ShaderProgram;
+
+            shaderProgram.ReplaceShaderProgram(std::move(replacement.ShaderProgram));
+
+            m_ReloadCount++;
+        }
+        catch (const ShaderCompilationException & e)
+        {
+            LOG_ERROR<< "Keeping shader program " << shaderProgram.Get() << ", its reload failed: " << e.what();
+
+            m_FailedReloadCount++;
+        }
+        catch (const ShaderProgramLinkingException & e)
+        {
+            LOG_ERROR<< "Keeping shader program " << shaderProgram.Get() << ", its reload failed: " << e.what();
+
+            m_FailedReloadCount++;
+        }
+
+        pendingReloadIt = m_PendingReloads.erase(pendingReloadIt);
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include "utils/FileWatcher.h"
+
+#include "shaders.h"
+#include "StatefulShaderProgram.h"
+
+//
+// ShaderHotReloader
+//
+
+// Rebuilds watched shader programs once files under SHADERS_DIR change and swaps them in, so that
+// shaders can be iterated on without restarting. Changes are preprocessed on the file watcher's thread, and only
+// programs whose preprocessed sources actually changed get rebuilt. Programs failing to build keep their previous
+// version. Builds are submitted and swapped in by Update(), which only blocks without parallel shader compilation.
+// Must be destroyed on the GL context thread.
+class ShaderHotReloader final
+{
+public: // Construction
+
+    ShaderHotReloader();
+
+public: // Copy / Move
+
+    ShaderHotReloader(const ShaderHotReloader &) = delete;
+
+    ShaderHotReloader & operator=(const ShaderHotReloader &) = delete;
+
+public: // Interface
+
+    // Preprocesses the permutation the program was built from right away, to tell later whether changes affect it.
+    // The program must have been reloadable since its creation, so that it knows every uniform value to re-apply.
+    // It must outlive the reloader and must not be in use on other threads, e.g. by a render thread, yet.
+    void Watch(StatefulShaderProgram & shaderProgram, const ShaderPermutation & permutation);
+
+    // Submits builds of changed programs and swaps in the ones which completed. Must be called
+    // on the GL context thread in between frames, so that no frame draws with both versions.
+    void Update();
+
+    void LogSummary() const;
+
+private: // Service types
+
+    struct WatchedShaderProgram final
+    {
+        StatefulShaderProgram * ShaderProgram;
+        ShaderPermutation       Permutation;
+        uint64_t                SourceHash;
+    };
+
+    struct ShaderProgramReload final
+    {
+        StatefulShaderProgram *        ShaderProgram;
+        std::vector<ShaderStageSource> Stages;
+    };
+
+    struct PendingShaderProgramReload final
+    {
+        StatefulShaderProgram * ShaderProgram;
+        PendingShaderProgram    Replacement;
+    };
+
+private: // Service
+
+    // Called on the file watcher's thread
+    void OnFilesChanged(const std::vector<std::string> & changedPaths);
+
+    void SubmitReloads(std::vector<ShaderProgramReload> && reloads);
+
+    void SwapInCompletedReloads();
+
+private: // Members
+
+    mutable std::mutex m_Mutex;
+
+    // Guarded by the mutex
+    std::vector<WatchedShaderProgram> m_WatchedShaderPrograms;
+    // Preprocessed but not submitted yet, guarded by the mutex
+    std::vector<ShaderProgramReload>  m_SubmittableReloads;
+
+    // GL context thread state
+    std::vector<PendingShaderProgramReload> m_PendingReloads;
+    uint64_t                                m_ReloadCount;
+    uint64_t                                m_FailedReloadCount;
+
+    // Last, so that its thread is stopped before any of the above is destroyed
+    FileWatcher m_FileWatcher;
+};
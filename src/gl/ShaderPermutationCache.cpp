@@ -0,0 +1,152 @@
+#include "ShaderPermutationCache.h"
+
+#include <cassert>
+#include <utility>
+
+#include "profiling/profiling.h"
+#include "logging.h"
+
+//
+// Construction
+//
+
+ShaderPermutationCache::ShaderPermutationCache(
+    StatefulShaderProgram * const fallbackShaderProgram,
+    ProgramInitializer            programInitializer,
+    const bool                    areProgramsReloadable
+):
+    m_FallbackShaderProgram         (fallbackShaderProgram),
+    m_ProgramInitializer            (std::move(programInitializer)),
+    m_AreProgramsReloadable         (areProgramsReloadable),
+    m_ShaderPrograms                (),
+    m_ShaderProgramsByPermutationKey(),
+    m_ShaderProgramsBySourceHash    (),
+    m_HitCount                      (0),
+    m_MissCount                     (0),
+    m_SharedCount                   (0)
+{
+    assert(m_FallbackShaderProgram != nullptr);
+}
+
+//
+// Interface
+//
+
+StatefulShaderProgram & ShaderPermutationCache::Get(const ShaderPermutation & permutation)
+{
+    const uint64_t permutationKey = MakeShaderPermutationKey(permutation);
+
+    const auto shaderProgramIt = m_ShaderProgramsByPermutationKey.find(permutationKey);
+    if (shaderProgramIt != m_ShaderProgramsByPermutationKey.cend())
+    {
+        m_HitCount++;
+
+        return *shaderProgramIt->second;
+    }
+
+    WarmUp({permutation});
+
+    return *m_ShaderProgramsByPermutationKey.at(permutationKey);
+}
+
+void ShaderPermutationCache::WarmUp(const std::vector<ShaderPermutation> & permutations)
+{
+    PROFILE_SCOPE("ShaderPermutationCache::WarmUp");
+
+    // Programs to build, and which of them every new permutation maps to
+    std::vector<std::vector<ShaderStageSource>> programStageLists;
+    std::vector<uint64_t>                       programSourceHashes;
+    std::unordered_map<uint64_t, size_t>        programIdxsBySourceHash;
+    std::unordered_map<uint64_t, size_t>        programIdxsByPermutationKey;
+
+    for (const ShaderPermutation & permutation : permutations)
+    {
+        const uint64_t permutationKey = MakeShaderPermutationKey(permutation);
+
+        if (m_ShaderProgramsByPermutationKey.contains(permutationKey) || programIdxsByPermutationKey.contains(permutationKey))
+            continue;
+
+        std::vector<ShaderStageSource> stages = PreprocessShaderPermutation(permutation);
+
+        const uint64_t sourceHash = HashShaderStageSources(stages);
+
+        size_t programIdx = programStageLists.size();
+
+        // A reload rebuilds a program from the edited sources of its own permutation, which may no longer match
+        // the ones of permutations sharing it, e.g. once an #ifdef checks a define only one of them sets.
+        // Reloadable programs are never shared for that reason.
+        if (!m_AreProgramsReloadable)
+        {
+            const auto shaderProgramIt = m_ShaderProgramsBySourceHash.find(sourceHash);
+            if (shaderProgramIt != m_ShaderProgramsBySourceHash.cend())
+            {
+                m_ShaderProgramsByPermutationKey.emplace(permutationKey, shaderProgramIt->second);
+                m_SharedCount++;
+
+                continue;
+            }
+
+            programIdx = programIdxsBySourceHash.emplace(sourceHash, programStageLists.size()).first->second;
+        }
+
+        if (programIdx == programStageLists.size())
+        {
+            programStageLists.push_back(std::move(stages));
+            programSourceHashes.push_back(sourceHash);
+            m_MissCount++;
+        }
+        else
+        {
+            m_SharedCount++;
+        }
+
+        programIdxsByPermutationKey.emplace(permutationKey, programIdx);
+    }
+
+    if (programStageLists.empty())
+        return;
+
+    std::vector<PendingShaderProgram> pendingShaderPrograms = SubmitShaderPrograms(programStageLists);
+    assert(pendingShaderPrograms.size() == programStageLists.size());
+
+    const size_t firstProgramIdx = m_ShaderPrograms.size();
+
+    for (size_t programIdx = 0; programIdx < pendingShaderPrograms.size(); programIdx++)
+    {
+        StatefulShaderProgram & shaderProgram = m_ShaderPrograms.emplace_back(
+            std::move(pendingShaderPrograms[programIdx]),
+            m_FallbackShaderProgram
+        );
+
+        if (m_AreProgramsReloadable)
+            shaderProgram.EnableReloading();
+
+        if (m_ProgramInitializer)
+            m_ProgramInitializer(shaderProgram);
+
+        if (!m_AreProgramsReloadable)
+            m_ShaderProgramsBySourceHash.emplace(programSourceHashes[programIdx], &shaderProgram);
+    }
+
+    for (const auto & [permutationKey, programIdx] : programIdxsByPermutationKey)
+        m_ShaderProgramsByPermutationKey.emplace(permutationKey, &m_ShaderPrograms[firstProgramIdx + programIdx]);
+
+    LOG_DEBUG<< "Submitted builds of " << programStageLists.size() << " shader permutation programs";
+}
+
+size_t ShaderPermutationCache::GetProgramCount() const
+{
+    return m_ShaderPrograms.size();
+}
+
+bool ShaderPermutationCache::AreProgramsReloadable() const
+{
+    return m_AreProgramsReloadable;
+}
+
+void ShaderPermutationCache::LogSummary() const
+{
+    LOG_INFO<< "Shader permutation cache holds " << m_ShaderPrograms.size() << " programs for "
+        << m_ShaderProgramsByPermutationKey.size() << " permutations, hits/misses " << m_HitCount << '/' << m_MissCount
+        << ", " << m_SharedCount << " permutations sharing programs";
+}
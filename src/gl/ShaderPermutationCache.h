@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "shaders.h"
+#include "StatefulShaderProgram.h"
+
+//
+// ShaderPermutationCache
+//
+
+// Shader programs by permutation, built on first use. Permutations are looked up by their key before
+// anything gets preprocessed, and permutations preprocessing into the same sources, e.g. ones differing
+// only in defines no stage checks, share a program unless programs are reloadable. Programs are shared,
+// so per-object parameters don't belong in their uniforms. Must be used on the GL context thread.
+class ShaderPermutationCache final
+{
+public: // Interface types
+
+    // Called once per built program, e.g. to bind shared uniform blocks.
+    using ProgramInitializer = std::function<void(StatefulShaderProgram &)>;
+
+public: // Construction
+
+    // Programs are drawn with the fallback program, which must outlive the cache, until their builds complete.
+    // Reloadable programs are made so on creation, e.g. for ShaderHotReloader to watch them, and are only shared by
+    // permutations with the same key, since edits may make the sources of others diverge.
+    ShaderPermutationCache(
+        StatefulShaderProgram * const fallbackShaderProgram,
+        ProgramInitializer            programInitializer,
+        const bool                    areProgramsReloadable
+    );
+
+public: // Copy / Move
+
+    ShaderPermutationCache(const ShaderPermutationCache &) = delete;
+
+    ShaderPermutationCache & operator=(const ShaderPermutationCache &) = delete;
+
+public: // Interface
+
+    // Submits the build if the permutation is new, without waiting for it. The program's address is stable.
+    StatefulShaderProgram & Get(const ShaderPermutation & permutation);
+
+    // Submits builds of all new permutations as one batch, e.g. during loading, so that they compile in parallel.
+    void WarmUp(const std::vector<ShaderPermutation> & permutations);
+
+    size_t GetProgramCount() const;
+
+    bool AreProgramsReloadable() const;
+
+    void LogSummary() const;
+
+private: // Members
+
+    StatefulShaderProgram * m_FallbackShaderProgram;
+    ProgramInitializer      m_ProgramInitializer;
+    bool                    m_AreProgramsReloadable;
+
+    // Deque keeps addresses of programs stable as more get added
+    std::deque<StatefulShaderProgram>                     m_ShaderPrograms;
+    std::unordered_map<uint64_t, StatefulShaderProgram *> m_ShaderProgramsByPermutationKey;
+    std::unordered_map<uint64_t, StatefulShaderProgram *> m_ShaderProgramsBySourceHash;
+
+    uint64_t m_HitCount;
+    // Permutations which needed a program built
+    uint64_t m_MissCount;
+    // Permutations which got the program of another one with the same sources
+    uint64_t m_SharedCount;
+};
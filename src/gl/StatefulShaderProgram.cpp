@@ -2,11 +2,15 @@
 
 #include <cassert>
 #include <string>
+#include <mutex>
+#include <deque>
+#include <algorithm>
 
 #include <glm/gtc/type_ptr.hpp>
 
 #include "constants.h"
 #include "shaders.h"
+#include "statistics.h"
 
 //
 // Service types
@@ -71,37 +75,150 @@ public: // Interface
     }
 };
 
+struct UniformNameRegistry final
+{
+public: // Attributes
+
+    std::mutex                                 Mutex;
+    std::unordered_map<std::string, UniformId> IdsByName;
+    std::deque<std::string>                    Names;
+};
+
 } // anonymous namespace
 
+//
+// Constants
+//
+
+// Marks uniforms whose location has not been queried from the shader program yet.
+static constexpr GLint UNQUERIED_UNIFORM_LOCATION = INVALID_OPENGL_UNIFORM_LOCATION - 1;
+
+//
+// Forward declarations
+//
+
+static UniformNameRegistry & GetUniformNameRegistry();
+
+//
+// Utilities
+//
+
+UniformId InternUniformName(std::string_view uniformName)
+{
+    UniformNameRegistry & registry = GetUniformNameRegistry();
+
+    const std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    const auto [uniformIdIt, isInserted] = registry.IdsByName.emplace(
+        std::string(uniformName),
+        static_cast<UniformId>(registry.Names.size())
+    );
+
+    if (isInserted)
+        registry.Names.emplace_back(uniformName);
+
+    return uniformIdIt->second;
+}
+
+std::string GetInternedUniformName(const UniformId uniformId)
+{
+    UniformNameRegistry & registry = GetUniformNameRegistry();
+
+    const std::lock_guard<std::mutex> lock(registry.Mutex);
+    assert(static_cast<size_t>(uniformId) < registry.Names.size() && "uniform name must be interned");
+
+    return registry.Names[static_cast<size_t>(uniformId)];
+}
+
 //
 // Construction
 //
 
 StatefulShaderProgram::StatefulShaderProgram(UniqueShaderProgram && shaderProgram):
-    m_ShaderProgram(std::move(shaderProgram))
+    m_ShaderProgram        (std::move(shaderProgram)),
+    m_PendingBuild         (),
+    m_FallbackShaderProgram(nullptr),
+    m_IsReloadable         (false)
+{
+    assert(m_ShaderProgram.IsSet());
+}
+
+StatefulShaderProgram::StatefulShaderProgram(
+    PendingShaderProgram &&       pendingShaderProgram,
+    StatefulShaderProgram * const fallbackShaderProgram
+):
+    m_ShaderProgram        (std::move(pendingShaderProgram.ShaderProgram)),
+    m_PendingBuild         (std::move(pendingShaderProgram.Build)),
+    m_FallbackShaderProgram(fallbackShaderProgram),
+    m_IsReloadable         (false)
 {
     assert(m_ShaderProgram.IsSet());
+    assert(m_FallbackShaderProgram != nullptr && m_FallbackShaderProgram->IsReady());
 }
 
 //
 // Interface
 //
 
-void StatefulShaderProgram::Use() const
+void StatefulShaderProgram::Use()
 {
+    if (!PollPendingBuild())
+    {
+        m_FallbackShaderProgram->Use();
+
+        return;
+    }
+
     glUseProgram(m_ShaderProgram);
+
+    CountRenderStatistic(RenderCounter::ShaderProgramSwitches);
+
+    if (!m_PendingUniformValues.empty())
+        ApplyPendingUniformValues();
+}
+
+bool StatefulShaderProgram::PollPendingBuild()
+{
+    if (!m_PendingBuild.has_value())
+        return true;
+
+    if (!IsShaderProgramBuildComplete(m_ShaderProgram, *m_PendingBuild))
+        return false;
+
+    CompletePendingBuild();
+
+    return true;
+}
+
+void StatefulShaderProgram::WaitForPendingBuild()
+{
+    if (m_PendingBuild.has_value())
+        CompletePendingBuild();
 }
 
 GLint StatefulShaderProgram::GetUniformLocation(StringView uniformName) const
 {
+    if (!IsReady())
+        return m_FallbackShaderProgram->GetUniformLocation(uniformName);
+
     const auto uniformLocationIt = m_UniformLocations.find(uniformName);
     if (uniformLocationIt == m_UniformLocations.cend())
     {
         const GLint uniformLocation = glGetUniformLocation(m_ShaderProgram, uniformName.data());
+        CountRenderStatistic(RenderCounter::GlQueries);
+
+        if (uniformLocation == INVALID_OPENGL_UNIFORM_LOCATION && m_IsReloadable)
+        {
+            LOG_WARNING<< "Ignoring undefined uniform \"" << uniformName << "\" of reloadable shader program " << m_ShaderProgram;
+
+            m_UniformLocations.emplace(std::string(uniformName), uniformLocation);
+
+            return uniformLocation;
+        }
 
         if (uniformLocation == INVALID_OPENGL_UNIFORM_LOCATION)
         {
-            BOOST_LOG_TRIVIAL(error)<< "Attempted to get location for undefined uniform \"" << uniformName
+            LOG_ERROR<< "Attempted to get location for undefined uniform \"" << uniformName
                 << "\" from shader program " << m_ShaderProgram;
 
             assert(false && "uniform must be defined in the shader program");
@@ -117,9 +234,167 @@ GLint StatefulShaderProgram::GetUniformLocation(StringView uniformName) const
     return uniformLocationIt->second;
 }
 
+GLint StatefulShaderProgram::GetUniformLocation(const UniformId uniformId) const
+{
+    if (!IsReady())
+        return m_FallbackShaderProgram->GetUniformLocation(uniformId);
+
+    const size_t uniformIdx = static_cast<size_t>(uniformId);
+
+    if (uniformIdx >= m_UniformLocationsById.size())
+        m_UniformLocationsById.resize(uniformIdx + 1, UNQUERIED_UNIFORM_LOCATION);
+
+    GLint & uniformLocation = m_UniformLocationsById[uniformIdx];
+
+    if (uniformLocation == UNQUERIED_UNIFORM_LOCATION)
+        uniformLocation = GetUniformLocation(GetInternedUniformName(uniformId));
+
+    return uniformLocation;
+}
+
 void StatefulShaderProgram::SetUniformValue(const GLint uniformLocation, const UniformValue & uniformValue)
 {
-    assert(IsShaderProgramCurrentlyUsed(m_ShaderProgram));
+    assert(IsShaderProgramCurrentlyUsed(IsReady() ? m_ShaderProgram : m_FallbackShaderProgram->Get()));
 
     std::visit(UniformValueSettingVisitor(uniformLocation), uniformValue);
+
+    CountRenderStatistic(RenderCounter::UniformUploads);
+    CountRenderStatistic(
+        RenderCounter::UniformUploadBytes,
+        std::visit([] (const auto & value) { return sizeof(value); }, uniformValue)
+    );
+
+    // Only reloadable programs pay for tracking, values set on the fallback belong to it instead.
+    if (m_IsReloadable && IsReady() && uniformLocation != INVALID_OPENGL_UNIFORM_LOCATION)
+        m_UniformValues.insert_or_assign(uniformLocation, uniformValue);
+}
+
+void StatefulShaderProgram::SetUniformValueByName(StringView uniformName, const UniformValue & uniformValue)
+{
+    if (!IsReady())
+    {
+        m_PendingUniformValues.emplace_back(std::string(uniformName), uniformValue);
+
+        return;
+    }
+
+    SetUniformValue(GetUniformLocation(uniformName), uniformValue);
+}
+
+bool StatefulShaderProgram::BindUniformBlock(StringView blockName, const GLuint bindingIdx)
+{
+    // Block indices can only be queried once linked, which would block.
+    if (!IsReady())
+    {
+        m_PendingUniformBlockBindings.emplace_back(std::string(blockName), bindingIdx);
+
+        return true;
+    }
+
+    // Kept regardless of the block being declared, programs replacing this one may declare it.
+    const auto blockBindingIt = std::find_if(
+        m_UniformBlockBindings.begin(),
+        m_UniformBlockBindings.end(),
+        [blockName] (const auto & blockBinding) { return blockBinding.first == blockName; }
+    );
+
+    if (blockBindingIt != m_UniformBlockBindings.end())
+        blockBindingIt->second = bindingIdx;
+    else
+        m_UniformBlockBindings.emplace_back(std::string(blockName), bindingIdx);
+
+    const GLuint blockIdx = glGetUniformBlockIndex(m_ShaderProgram, blockName.data());
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    if (blockIdx == GL_INVALID_INDEX)
+        return false;
+
+    glUniformBlockBinding(m_ShaderProgram, blockIdx, bindingIdx);
+
+    LOG_DEBUG<< "Bound uniform block \"" << blockName << "\" of shader program " << m_ShaderProgram
+        << " to binding " << bindingIdx;
+
+    return true;
+}
+
+void StatefulShaderProgram::EnableReloading()
+{
+    m_IsReloadable = true;
+}
+
+void StatefulShaderProgram::ReplaceShaderProgram(UniqueShaderProgram && shaderProgram)
+{
+    assert(m_IsReloadable && IsReady());
+    assert(shaderProgram.IsSet());
+
+    // Locations are only valid for the replaced program, so values are re-applied by name.
+    std::unordered_map<GLint, std::string> uniformNamesByLocation;
+
+    for (const auto & [uniformName, uniformLocation] : m_UniformLocations)
+        uniformNamesByLocation.emplace(uniformLocation, uniformName);
+
+    for (size_t uniformIdx = 0; uniformIdx < m_UniformLocationsById.size(); uniformIdx++)
+    {
+        const GLint uniformLocation = m_UniformLocationsById[uniformIdx];
+
+        if (uniformLocation != UNQUERIED_UNIFORM_LOCATION && !uniformNamesByLocation.contains(uniformLocation))
+            uniformNamesByLocation.emplace(uniformLocation, GetInternedUniformName(static_cast<UniformId>(uniformIdx)));
+    }
+
+    for (const auto & [uniformLocation, uniformValue] : m_UniformValues)
+    {
+        const auto uniformNameIt = uniformNamesByLocation.find(uniformLocation);
+
+        // Values set at locations which were never queried by name can't be carried over.
+        if (uniformNameIt != uniformNamesByLocation.cend())
+            m_PendingUniformValues.emplace_back(uniformNameIt->second, uniformValue);
+    }
+
+    m_ShaderProgram = std::move(shaderProgram);
+
+    m_UniformLocations.clear();
+    m_UniformLocationsById.clear();
+    m_UniformValues.clear();
+
+    const std::vector<std::pair<std::string, GLuint>> uniformBlockBindings = std::move(m_UniformBlockBindings);
+    m_UniformBlockBindings.clear();
+
+    for (const auto & [blockName, bindingIdx] : uniformBlockBindings)
+        BindUniformBlock(blockName, bindingIdx);
+}
+
+//
+// Service
+//
+
+void StatefulShaderProgram::CompletePendingBuild()
+{
+    assert(m_PendingBuild.has_value());
+
+    FinishShaderProgramBuild(m_ShaderProgram, std::move(*m_PendingBuild));
+
+    m_PendingBuild.reset();
+
+    for (const auto & [blockName, bindingIdx] : m_PendingUniformBlockBindings)
+        BindUniformBlock(blockName, bindingIdx);
+
+    m_PendingUniformBlockBindings.clear();
+}
+
+void StatefulShaderProgram::ApplyPendingUniformValues()
+{
+    assert(IsReady());
+
+    for (const auto & [uniformName, uniformValue] : m_PendingUniformValues)
+        SetUniformValue(GetUniformLocation(uniformName), uniformValue);
+
+    m_PendingUniformValues.clear();
+    m_PendingUniformValues.shrink_to_fit();
+}
+
+static UniformNameRegistry & GetUniformNameRegistry()
+{
+    static UniformNameRegistry registry;
+
+    return registry;
 }
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <variant>
+#include <optional>
+#include <utility>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include "shaders.h"
 #include "wrappers.h"
 
 //
@@ -24,6 +30,19 @@ using UniformValue = std::variant<
     glm::mat4
 >;
 
+// Process-wide identifier of a uniform name, usable without a GL context (e.g. by command recording threads).
+enum class UniformId: uint32_t {};
+
+//
+// Utilities
+//
+
+// Thread-safe.
+UniformId InternUniformName(std::string_view uniformName);
+
+// Thread-safe.
+std::string GetInternedUniformName(const UniformId uniformId);
+
 //
 // StatefulShaderProgram
 //
@@ -42,6 +61,9 @@ public: // Construction
 
     explicit StatefulShaderProgram(UniqueShaderProgram && shaderProgram);
 
+    // Draws with the fallback program, which must be ready and outlive this one, until the build completes.
+    StatefulShaderProgram(PendingShaderProgram && pendingShaderProgram, StatefulShaderProgram * const fallbackShaderProgram);
+
     ~StatefulShaderProgram() = default;
 
 public: // Copy / Move
@@ -56,15 +78,43 @@ public: // Copy / Move
 
 public: // Interface
 
-    void Use() const;
+    // Uses the fallback program instead while the build is pending, after polling it.
+    void Use();
 
     inline GLuint Get() const;
 
+    inline bool IsReady() const;
+
+    // Never blocks, returns whether the program is ready.
+    bool PollPendingBuild();
+
+    void WaitForPendingBuild();
+
+    // Locations of the fallback program while the build is pending, matching what Use() binds.
     GLint GetUniformLocation(StringView uniformName) const;
 
+    GLint GetUniformLocation(const UniformId uniformId) const;
+
     void SetUniformValue(const GLint uniformLocation, const UniformValue & uniformValue);
 
-    inline void SetUniformValueByName(StringView uniformName, const UniformValue & uniformValue);
+    // Deferred to the first use of the program once ready while the build is pending.
+    void SetUniformValueByName(StringView uniformName, const UniformValue & uniformValue);
+
+    // Returns false if the program doesn't declare the block, which is not an error,
+    // since shared blocks are bound for every program regardless of actual usage.
+    // Deferred until the build completes while it's pending, returning true.
+    bool BindUniformBlock(StringView blockName, const GLuint bindingIdx);
+
+    // Allows ReplaceShaderProgram(), which re-applies every uniform value set on the program from then on, so it
+    // must be called on creation, before any value is set. Uniforms the program doesn't define are ignored with a
+    // warning instead of asserted, since edits of reloaded shaders may well remove them.
+    void EnableReloading();
+
+    inline bool IsReloadable() const;
+
+    // Swaps in a linked program built from edited sources, e.g. by ShaderHotReloader. Uniform block bindings
+    // are redone right away, uniform values are re-applied on the next use. Must not be called while pending.
+    void ReplaceShaderProgram(UniqueShaderProgram && shaderProgram);
 
 private: // Service types
 
@@ -87,14 +137,31 @@ private: // Service types
         }
     };
 
+private: // Service
+
+    void CompletePendingBuild();
+
+    void ApplyPendingUniformValues();
+
 private: // Members
 
     UniqueShaderProgram m_ShaderProgram;
 
     mutable std::unordered_map<std::string, GLint, TransparentStringHash, std::equal_to<>> m_UniformLocations;
+    mutable std::vector<GLint>                                                             m_UniformLocationsById;
 
-    // TODO: Allow deferred uniform value setting on shader program becoming used
-    // std::unordered_map<GLint, UniformValue> m_PendingUniformValueSettings;
+    std::optional<ShaderProgramBuild> m_PendingBuild;
+    StatefulShaderProgram *           m_FallbackShaderProgram;
+
+    // Settings made while the build was pending, in the order they were made
+    std::vector<std::pair<std::string, UniformValue>> m_PendingUniformValues;
+    std::vector<std::pair<std::string, GLuint>>       m_PendingUniformBlockBindings;
+
+    std::vector<std::pair<std::string, GLuint>> m_UniformBlockBindings;
+
+    bool                                    m_IsReloadable;
+    // Latest values by location, including the pending ones once applied, only tracked if reloadable
+    std::unordered_map<GLint, UniformValue> m_UniformValues;
 };
 
 //
@@ -106,7 +173,12 @@ inline GLuint StatefulShaderProgram::Get() const
     return m_ShaderProgram;
 }
 
-inline void StatefulShaderProgram::SetUniformValueByName(StringView uniformName, const UniformValue & uniformValue)
+inline bool StatefulShaderProgram::IsReady() const
+{
+    return !m_PendingBuild.has_value();
+}
+
+inline bool StatefulShaderProgram::IsReloadable() const
 {
-    SetUniformValue(GetUniformLocation(uniformName), uniformValue);
+    return m_IsReloadable;
 }
@@ -0,0 +1,176 @@
+#include "StreamingBuffer.h"
+
+#include <cassert>
+#include <stdexcept>
+
+#include "logging.h"
+
+#include "constants.h"
+#include "statistics.h"
+
+//
+// Constants
+//
+
+static constexpr GLuint64 FENCE_WAIT_TIMEOUT_NANOSECONDS = 1000000;
+
+//
+// Forward declarations
+//
+
+static GLsizeiptr AlignUp(const GLsizeiptr value, const GLsizeiptr alignment);
+
+//
+// Construction / Destruction
+//
+
+StreamingBuffer::StreamingBuffer(const GLenum target, const GLsizeiptr regionSize, const size_t regionCount):
+    m_Target               (target),
+    m_RegionSize           (regionSize),
+    m_Buffer               (UniqueBuffer::Create()),
+    m_RegionFences         (regionCount, nullptr),
+    m_CurrentRegionIdx     (0),
+    m_CurrentRegionUsedSize(0),
+    m_MappedRegionData     (nullptr)
+{
+    assert(m_RegionSize > 0);
+    assert(regionCount > 1 && "streaming buffer must have at least one region for the GPU and one for the CPU");
+
+    glBindBuffer(m_Target, m_Buffer);
+    glBufferData(m_Target, m_RegionSize*static_cast<GLsizeiptr>(regionCount), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(m_Target, INVALID_OPENGL_BUFFER);
+
+    LOG_INFO<< "Created streaming buffer " << m_Buffer << " with " << regionCount
+        << " regions of " << m_RegionSize << " bytes";
+}
+
+StreamingBuffer::~StreamingBuffer()
+{
+    assert(m_MappedRegionData == nullptr && "streaming buffer must not be destroyed while mapped");
+
+    for (const GLsync fence : m_RegionFences)
+    {
+        if (fence != nullptr)
+            glDeleteSync(fence);
+    }
+}
+
+//
+// Interface
+//
+
+void StreamingBuffer::BeginFrame()
+{
+    assert(m_MappedRegionData == nullptr && "previous frame must be ended first");
+
+    GLsync & regionFence = m_RegionFences[m_CurrentRegionIdx];
+
+    if (regionFence != nullptr)
+    {
+        GLenum waitResult = glClientWaitSync(regionFence, 0, 0);
+
+        if (waitResult == GL_TIMEOUT_EXPIRED)
+        {
+            LOG_DEBUG<< "Waiting for GPU to release streaming buffer " << m_Buffer << " region " << m_CurrentRegionIdx;
+
+            do
+            {
+                waitResult = glClientWaitSync(regionFence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_TIMEOUT_NANOSECONDS);
+            }
+            while (waitResult == GL_TIMEOUT_EXPIRED);
+        }
+
+        if (waitResult == GL_WAIT_FAILED)
+            LOG_ERROR<< "Failed to wait for streaming buffer " << m_Buffer << " region " << m_CurrentRegionIdx;
+
+        glDeleteSync(regionFence);
+        regionFence = nullptr;
+    }
+
+    glBindBuffer(m_Target, m_Buffer);
+
+    // Unsynchronized is safe, since the fence guarantees the GPU no longer reads this region.
+    m_MappedRegionData = static_cast<std::byte *>(glMapBufferRange(
+        m_Target,
+        static_cast<GLintptr>(m_CurrentRegionIdx)*m_RegionSize,
+        m_RegionSize,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT
+    ));
+
+    if (m_MappedRegionData == nullptr)
+        throw std::runtime_error("Failed to map streaming buffer region");
+
+    m_CurrentRegionUsedSize = 0;
+}
+
+std::optional<StreamingBuffer::Allocation> StreamingBuffer::Allocate(const GLsizeiptr size, const GLsizeiptr alignment)
+{
+    assert(m_MappedRegionData != nullptr && "streaming buffer region must be mapped for allocation");
+    assert(size > 0);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "alignment must be a power of two");
+
+    // Region starts are aligned as long as the region size is a multiple of the alignment.
+    assert(m_RegionSize % alignment == 0);
+
+    const GLsizeiptr relativeOffset = AlignUp(m_CurrentRegionUsedSize, alignment);
+
+    if (relativeOffset + size > m_RegionSize)
+    {
+        LOG_WARNING<< "Streaming buffer " << m_Buffer << " region is out of space for " << size << " bytes";
+
+        return std::nullopt;
+    }
+
+    m_CurrentRegionUsedSize = relativeOffset + size;
+
+    return Allocation{
+        static_cast<GLintptr>(m_CurrentRegionIdx)*m_RegionSize + relativeOffset,
+        size,
+        m_MappedRegionData + relativeOffset
+    };
+}
+
+void StreamingBuffer::FinishWriting()
+{
+    assert(m_MappedRegionData != nullptr && "streaming buffer region must be mapped");
+
+    glBindBuffer(m_Target, m_Buffer);
+
+    if (m_CurrentRegionUsedSize > 0)
+    {
+        glFlushMappedBufferRange(m_Target, 0, m_CurrentRegionUsedSize);
+
+        CountRenderStatistic(RenderCounter::BufferUploadBytes, static_cast<uint64_t>(m_CurrentRegionUsedSize));
+    }
+
+    if (glUnmapBuffer(m_Target) == GL_FALSE)
+        LOG_ERROR<< "Streaming buffer " << m_Buffer << " contents got corrupted while mapped";
+
+    glBindBuffer(m_Target, INVALID_OPENGL_BUFFER);
+
+    m_MappedRegionData = nullptr;
+}
+
+void StreamingBuffer::EndFrame()
+{
+    assert(m_MappedRegionData == nullptr && "writing must be finished before the frame ends");
+    assert(m_RegionFences[m_CurrentRegionIdx] == nullptr);
+
+    m_RegionFences[m_CurrentRegionIdx] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_CurrentRegionIdx = (m_CurrentRegionIdx + 1) % m_RegionFences.size();
+}
+
+GLuint StreamingBuffer::Get() const
+{
+    return m_Buffer;
+}
+
+//
+// Service
+//
+
+static GLsizeiptr AlignUp(const GLsizeiptr value, const GLsizeiptr alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
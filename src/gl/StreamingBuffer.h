@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <optional>
+
+#include <glad/glad.h>
+
+#include "wrappers.h"
+
+//
+// StreamingBuffer
+//
+
+// Ring of frame-sized regions of a single buffer object for per-frame dynamic data. Each frame writes
+// into its own region, mapped unsynchronized; a fence per region guarantees the GPU is done reading
+// the region before it gets reused, so there are neither implicit driver syncs nor reallocations.
+class StreamingBuffer final
+{
+public: // Interface types
+
+    struct Allocation final
+    {
+        GLintptr    Offset;
+        GLsizeiptr  Size;
+        std::byte * Data;
+    };
+
+public: // Construction / Destruction
+
+    StreamingBuffer(const GLenum target, const GLsizeiptr regionSize, const size_t regionCount);
+
+    ~StreamingBuffer();
+
+public: // Copy / Move
+
+    StreamingBuffer(const StreamingBuffer &) = delete;
+
+    StreamingBuffer & operator=(const StreamingBuffer &) = delete;
+
+public: // Interface
+
+    // Waits for the GPU to release the next region, if needed, and maps it for writing.
+    void BeginFrame();
+
+    // Returns std::nullopt if the current region has no more room.
+    std::optional<Allocation> Allocate(const GLsizeiptr size, const GLsizeiptr alignment);
+
+    // Flushes and unmaps the written part of the region. Must be called before drawing with the allocated data.
+    void FinishWriting();
+
+    // Must be called after the last command sourcing this frame's allocations.
+    void EndFrame();
+
+    GLuint Get() const;
+
+private: // Members
+
+    GLenum       m_Target;
+    GLsizeiptr   m_RegionSize;
+    UniqueBuffer m_Buffer;
+
+    std::vector<GLsync> m_RegionFences;
+    size_t              m_CurrentRegionIdx;
+    GLsizeiptr          m_CurrentRegionUsedSize;
+    std::byte *         m_MappedRegionData;
+};
@@ -0,0 +1,112 @@
+#include "backend.h"
+
+#include <cassert>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "logging.h"
+
+#include "null.h"
+#include "recording.h"
+
+//
+// Statics
+//
+
+static GlBackend s_LoadedBackend = GlBackend::Native;
+
+//
+// Forward declarations
+//
+
+static void * GetNativeGlProcAddress(const char * const name);
+
+//
+// Utilities
+//
+
+const char * GlBackendToCStr(const GlBackend backend)
+{
+    switch (backend)
+    {
+    case GlBackend::Native:
+        return "native";
+    case GlBackend::Null:
+        return "null";
+    case GlBackend::Recording:
+        return "recording";
+    default:
+        assert(false && "unrecognized GL backend");
+        return "<UNKNOWN>";
+    }
+}
+
+bool LoadGlBackend(const GlBackend backend, const std::string & captureFilePath)
+{
+    bool isLoaded = false;
+
+    switch (backend)
+    {
+    case GlBackend::Native:
+        isLoaded = gladLoadGLLoader(&GetNativeGlProcAddress) != 0;
+        break;
+
+    case GlBackend::Null:
+        ResetNullGl();
+        isLoaded = gladLoadGLLoader(&GetNullGlProcAddress) != 0;
+        break;
+
+    case GlBackend::Recording:
+        StartGlCapture(captureFilePath, &GetNativeGlProcAddress);
+        isLoaded = gladLoadGLLoader(&GetRecordingGlProcAddress) != 0;
+        break;
+
+    default:
+        assert(false && "unrecognized GL backend");
+        break;
+    }
+
+    if (!isLoaded)
+        return false;
+
+    s_LoadedBackend = backend;
+
+    LOG_INFO<< "Loaded " << GlBackendToCStr(backend) << " GL backend";
+
+    return true;
+}
+
+GlBackend GetLoadedGlBackend()
+{
+    return s_LoadedBackend;
+}
+
+void * GetGlExtensionProcAddress(const char * const name)
+{
+    return s_LoadedBackend != GlBackend::Null ? GetNativeGlProcAddress(name) : nullptr;
+}
+
+void LogGlBackendSummary()
+{
+    switch (s_LoadedBackend)
+    {
+    case GlBackend::Native:
+        break;
+    case GlBackend::Null:
+        LogNullGlSummary();
+        break;
+    case GlBackend::Recording:
+        LogGlCaptureSummary();
+        break;
+    }
+}
+
+//
+// Service
+//
+
+static void * GetNativeGlProcAddress(const char * const name)
+{
+    return reinterpret_cast<void *>(glfwGetProcAddress(name));
+}
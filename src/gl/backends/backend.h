@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//
+// Interface types
+//
+
+enum class GlBackend: uint8_t
+{
+    // GL functions of the current context
+    Native,
+    // No context at all, calls are validated and counted but do nothing
+    Null,
+    // GL functions of the current context, with calls captured into a file for replay
+    Recording
+};
+
+//
+// Utilities
+//
+
+const char * GlBackendToCStr(const GlBackend backend);
+
+// Loads GLAD function pointers through the given backend. Native and recording backends require
+// a current GL context; the recording backend starts capturing into captureFilePath right away.
+// Returns false if GLAD fails to load, throws GlCaptureException if the capture can't be started.
+bool LoadGlBackend(const GlBackend backend, const std::string & captureFilePath);
+
+GlBackend GetLoadedGlBackend();
+
+// Loads functions GLAD isn't generated for, e.g. of extensions. Returns nullptr with the null backend.
+// Calls through the returned pointers bypass the recording backend, so they don't make it into captures.
+void * GetGlExtensionProcAddress(const char * const name);
+
+// Logs what the loaded backend collected, e.g. null backend call counts or the capture size.
+void LogGlBackendSummary();
@@ -0,0 +1,170 @@
+#include "capture_stream.h"
+
+#include <cassert>
+#include <iterator>
+#include <unordered_map>
+
+//
+// Construction
+//
+
+GlCaptureWriter::GlCaptureWriter(const std::string & filePath):
+    m_File(filePath, std::ios::binary)
+{
+    if (!m_File)
+        throw GlCaptureException("Failed to open GL capture file " + filePath + " for writing");
+
+    m_File.write(GL_CAPTURE_MAGIC, sizeof(GL_CAPTURE_MAGIC));
+    Write(GL_CAPTURE_VERSION);
+
+    // Function names let readers translate ids of captures made with a different function list.
+    Write(static_cast<uint32_t>(GL_FUNCTION_COUNT));
+    for (size_t functionIdx = 0; functionIdx < GL_FUNCTION_COUNT; functionIdx++)
+        WriteString(GlFunctionToCStr(static_cast<GlFunction>(functionIdx)));
+}
+
+GlCaptureReader::GlCaptureReader(const std::string & filePath):
+    m_FilePath         (filePath),
+    m_Data             (),
+    m_Offset           (0),
+    m_FunctionsByFileId()
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+        throw GlCaptureException("Failed to open GL capture file " + filePath);
+
+    m_Data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    char magic[sizeof(GL_CAPTURE_MAGIC)];
+    ReadBytes(magic, sizeof(magic));
+
+    if (std::memcmp(magic, GL_CAPTURE_MAGIC, sizeof(magic)) != 0)
+        throw GlCaptureException(filePath + " is not a GL capture file");
+
+    const uint32_t version = Read<uint32_t>();
+    if (version != GL_CAPTURE_VERSION)
+        throw GlCaptureException("Unsupported GL capture version " + std::to_string(version) + " of " + filePath);
+
+    std::unordered_map<std::string, GlFunction> functionsByName;
+    for (size_t functionIdx = 0; functionIdx < GL_FUNCTION_COUNT; functionIdx++)
+        functionsByName.emplace(GlFunctionToCStr(static_cast<GlFunction>(functionIdx)), static_cast<GlFunction>(functionIdx));
+
+    const uint32_t fileFunctionCount = Read<uint32_t>();
+    for (uint32_t fileFunctionIdx = 0; fileFunctionIdx < fileFunctionCount; fileFunctionIdx++)
+    {
+        const auto functionIt = functionsByName.find(ReadString());
+
+        m_FunctionsByFileId.push_back(
+            functionIt != functionsByName.cend() ? std::optional(functionIt->second) : std::nullopt
+        );
+    }
+}
+
+//
+// Interface
+//
+
+void GlCaptureWriter::BeginCall(const GlFunction function)
+{
+    Write(static_cast<uint16_t>(function));
+}
+
+void GlCaptureWriter::WriteFrameEnd()
+{
+    Write(GL_CAPTURE_FRAME_END_CALL_ID);
+}
+
+void GlCaptureWriter::WriteString(const std::string_view value)
+{
+    Write(static_cast<uint32_t>(value.size()));
+    m_File.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+void GlCaptureWriter::WriteBlob(const void * const data, const size_t size)
+{
+    assert(data != nullptr || size == 0);
+
+    Write(static_cast<uint64_t>(size));
+    m_File.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+}
+
+void GlCaptureWriter::Flush()
+{
+    m_File.flush();
+}
+
+bool GlCaptureReader::IsAtEnd() const
+{
+    return m_Offset >= m_Data.size();
+}
+
+size_t GlCaptureReader::GetOffset() const
+{
+    return m_Offset;
+}
+
+void GlCaptureReader::Seek(const size_t offset)
+{
+    assert(offset <= m_Data.size());
+
+    m_Offset = offset;
+}
+
+GlCaptureRecord GlCaptureReader::ReadRecord()
+{
+    const uint16_t callId = Read<uint16_t>();
+
+    if (callId == GL_CAPTURE_FRAME_END_CALL_ID)
+        return GlCaptureRecord{GlCaptureRecordType::FrameEnd, GlFunction::Count};
+
+    if (callId >= m_FunctionsByFileId.size() || !m_FunctionsByFileId[callId].has_value())
+        throw GlCaptureException("Unsupported call " + std::to_string(callId) + " in GL capture " + m_FilePath);
+
+    return GlCaptureRecord{GlCaptureRecordType::Call, *m_FunctionsByFileId[callId]};
+}
+
+std::string GlCaptureReader::ReadString()
+{
+    const uint32_t size = Read<uint32_t>();
+
+    std::string value(size, '\0');
+    ReadBytes(value.data(), size);
+
+    return value;
+}
+
+std::pair<const uint8_t *, size_t> GlCaptureReader::ReadBlob()
+{
+    const uint64_t size = Read<uint64_t>();
+
+    if (size > m_Data.size() - m_Offset)
+        throw GlCaptureException("Truncated GL capture " + m_FilePath);
+
+    const uint8_t * const data = m_Data.data() + m_Offset;
+    m_Offset += size;
+
+    return std::make_pair(data, static_cast<size_t>(size));
+}
+
+//
+// Service
+//
+
+void GlCaptureReader::ReadBytes(void * const destination, const size_t size)
+{
+    if (size > m_Data.size() - m_Offset)
+        throw GlCaptureException("Truncated GL capture " + m_FilePath);
+
+    std::memcpy(destination, m_Data.data() + m_Offset, size);
+    m_Offset += size;
+}
+
+//
+// Exceptions
+//
+
+GlCaptureException::GlCaptureException(const std::string & message):
+    std::runtime_error(message)
+{
+    // Empty
+}
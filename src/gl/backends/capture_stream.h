@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <utility>
+#include <fstream>
+#include <type_traits>
+#include <stdexcept>
+
+#include "functions.h"
+
+//
+// Constants
+//
+
+// Captures store values in the capturing machine's native representation,
+// so they are only replayable on machines of the same architecture.
+constexpr char     GL_CAPTURE_MAGIC[8] = {'L', 'O', 'G', 'L', 'C', 'A', 'P', '\0'};
+constexpr uint32_t GL_CAPTURE_VERSION  = 4;
+
+// Call id marking the end of a rendered frame, following the frame's calls
+constexpr uint16_t GL_CAPTURE_FRAME_END_CALL_ID = UINT16_MAX;
+
+//
+// Interface types
+//
+
+enum class GlCaptureRecordType: uint8_t
+{
+    Call,
+    FrameEnd
+};
+
+struct GlCaptureRecord final
+{
+    GlCaptureRecordType Type;
+    GlFunction          Function;
+};
+
+//
+// GlCaptureWriter
+//
+
+// Writes the header on construction, then calls one by one: the function id followed by
+// whatever the function's recorder writes. Not thread-safe.
+class GlCaptureWriter final
+{
+public: // Construction
+
+    explicit GlCaptureWriter(const std::string & filePath);
+
+public: // Interface
+
+    void BeginCall(const GlFunction function);
+
+    void WriteFrameEnd();
+
+    template <typename T>
+    void Write(const T value);
+
+    void WriteString(const std::string_view value);
+
+    void WriteBlob(const void * const data, const size_t size);
+
+    void Flush();
+
+private: // Members
+
+    std::ofstream m_File;
+};
+
+//
+// GlCaptureReader
+//
+
+// Reads a whole capture into memory on construction. Function ids are translated by name,
+// so captures stay readable when functions are added to LEARNOPENGL_BACKEND_GL_FUNCTIONS.
+class GlCaptureReader final
+{
+public: // Construction
+
+    explicit GlCaptureReader(const std::string & filePath);
+
+public: // Interface
+
+    bool IsAtEnd() const;
+
+    // Offset of the next record, usable with Seek() to read records again
+    size_t GetOffset() const;
+
+    void Seek(const size_t offset);
+
+    GlCaptureRecord ReadRecord();
+
+    template <typename T>
+    T Read();
+
+    std::string ReadString();
+
+    // Points into the reader's storage, valid for the reader's lifetime.
+    std::pair<const uint8_t *, size_t> ReadBlob();
+
+private: // Service
+
+    void ReadBytes(void * const destination, const size_t size);
+
+private: // Members
+
+    std::string                            m_FilePath;
+    std::vector<uint8_t>                   m_Data;
+    size_t                                 m_Offset;
+    std::vector<std::optional<GlFunction>> m_FunctionsByFileId;
+};
+
+//
+// Exceptions
+//
+
+class GlCaptureException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit GlCaptureException(const std::string & message);
+};
+
+//
+// Interface
+//
+
+template <typename T>
+void GlCaptureWriter::Write(const T value)
+{
+    // Pointers, e.g. GLsync handles and buffer offsets, are stored as plain addresses.
+    if constexpr (std::is_pointer_v<T>)
+    {
+        Write(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        m_File.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+}
+
+template <typename T>
+T GlCaptureReader::Read()
+{
+    if constexpr (std::is_pointer_v<T>)
+    {
+        return reinterpret_cast<T>(static_cast<uintptr_t>(Read<uint64_t>()));
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        T value;
+        ReadBytes(&value, sizeof(value));
+
+        return value;
+    }
+}
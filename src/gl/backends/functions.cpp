@@ -0,0 +1,26 @@
+#include "functions.h"
+
+#include <cassert>
+#include <array>
+
+//
+// Constants
+//
+
+static const std::array<const char *, GL_FUNCTION_COUNT> GL_FUNCTION_NAMES{
+#define LEARNOPENGL_GL_FUNCTION_NAME(name) "gl" #name,
+    LEARNOPENGL_BACKEND_GL_FUNCTIONS(LEARNOPENGL_GL_FUNCTION_NAME)
+#undef LEARNOPENGL_GL_FUNCTION_NAME
+};
+
+//
+// Utilities
+//
+
+const char * GlFunctionToCStr(const GlFunction function)
+{
+    const size_t functionIdx = static_cast<size_t>(function);
+    assert(functionIdx < GL_FUNCTION_NAMES.size() && "unrecognized GL function");
+
+    return functionIdx < GL_FUNCTION_NAMES.size() ? GL_FUNCTION_NAMES[functionIdx] : "<UNKNOWN>";
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//
+// Constants
+//
+
+// GL functions the engine calls, without the "gl" prefix. These are implemented by the null backend
+// and captured by the recording backend. Functions missing from here still work with the native
+// and recording backends, but are neither captured nor implemented by the null backend.
+#define LEARNOPENGL_BACKEND_GL_FUNCTIONS(X) \
+    X(ActiveTexture)                         \
+    X(AttachShader)                          \
+    X(BindBuffer)                            \
+    X(BindBufferRange)                       \
+    X(BindFramebuffer)                       \
+    X(BindRenderbuffer)                      \
+    X(BindTexture)                           \
+    X(BindVertexArray)                       \
+    X(BlendFunc)                             \
+    X(BufferData)                            \
+    X(CheckFramebufferStatus)                \
+    X(Clear)                                 \
+    X(ClearColor)                            \
+    X(ClientWaitSync)                        \
+    X(CompileShader)                         \
+    X(CompressedTexImage2D)                  \
+    X(CreateProgram)                         \
+    X(CreateShader)                          \
+    X(DeleteBuffers)                         \
+    X(DeleteFramebuffers)                    \
+    X(DeleteProgram)                         \
+    X(DeleteQueries)                         \
+    X(DeleteRenderbuffers)                   \
+    X(DeleteShader)                          \
+    X(DeleteSync)                            \
+    X(DeleteTextures)                        \
+    X(DeleteVertexArrays)                    \
+    X(DrawArrays)                            \
+    X(DrawElements)                          \
+    X(Enable)                                \
+    X(EnableVertexAttribArray)               \
+    X(FenceSync)                             \
+    X(Flush)                                 \
+    X(FlushMappedBufferRange)                \
+    X(FramebufferRenderbuffer)               \
+    X(GenBuffers)                            \
+    X(GenFramebuffers)                       \
+    X(GenQueries)                            \
+    X(GenRenderbuffers)                      \
+    X(GenTextures)                           \
+    X(GenVertexArrays)                       \
+    X(GenerateMipmap)                        \
+    X(GetInteger64v)                         \
+    X(GetIntegerv)                           \
+    X(GetProgramInfoLog)                     \
+    X(GetProgramiv)                          \
+    X(GetQueryObjectiv)                      \
+    X(GetQueryObjectui64v)                   \
+    X(GetShaderInfoLog)                      \
+    X(GetShaderiv)                           \
+    X(GetUniformBlockIndex)                  \
+    X(GetUniformLocation)                    \
+    X(LinkProgram)                           \
+    X(MapBufferRange)                        \
+    X(PolygonMode)                           \
+    X(QueryCounter)                          \
+    X(RenderbufferStorage)                   \
+    X(ShaderSource)                          \
+    X(TexImage2D)                            \
+    X(TexParameteri)                         \
+    X(TexSubImage2D)                         \
+    X(Uniform1f)                             \
+    X(Uniform1i)                             \
+    X(Uniform1ui)                            \
+    X(Uniform2f)                             \
+    X(Uniform3f)                             \
+    X(Uniform4f)                             \
+    X(UniformBlockBinding)                   \
+    X(UniformMatrix4fv)                      \
+    X(UnmapBuffer)                           \
+    X(UseProgram)                            \
+    X(VertexAttribPointer)                   \
+    X(Viewport)
+
+//
+// Interface types
+//
+
+enum class GlFunction: uint16_t
+{
+#define LEARNOPENGL_GL_FUNCTION_ENUMERATOR(name) name,
+    LEARNOPENGL_BACKEND_GL_FUNCTIONS(LEARNOPENGL_GL_FUNCTION_ENUMERATOR)
+#undef LEARNOPENGL_GL_FUNCTION_ENUMERATOR
+
+    Count
+};
+
+constexpr size_t GL_FUNCTION_COUNT = static_cast<size_t>(GlFunction::Count);
+
+//
+// Utilities
+//
+
+// Full GL name, e.g. "glBindBuffer"
+const char * GlFunctionToCStr(const GlFunction function);
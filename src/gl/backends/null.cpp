@@ -0,0 +1,1489 @@
+#include "null.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+
+#include <glad/glad.h>
+
+#include "gl/utils.h"
+#include "logging.h"
+
+#include "functions.h"
+
+//
+// Constants
+//
+
+static const char * const NULL_GL_VERSION                  = "3.3.0 Null";
+static const char * const NULL_GL_SHADING_LANGUAGE_VERSION = "3.30 Null";
+static const char * const NULL_GL_VENDOR                   = "learnopengl-cpp";
+static const char * const NULL_GL_RENDERER                 = "Null GL backend";
+
+// GLAD fails to load without any extensions in a 3.0+ context.
+static const char * const NULL_GL_EXTENSION = "GL_LEARNOPENGL_null_backend";
+
+static constexpr GLint NULL_GL_MAX_VERTEX_ATTRIBS              = 16;
+static constexpr GLint NULL_GL_MAX_TEXTURE_SIZE                = 16384;
+static constexpr GLint NULL_GL_MAX_TEXTURE_UNITS               = 32;
+static constexpr GLint NULL_GL_MAX_UNIFORM_BUFFER_BINDINGS     = 36;
+static constexpr GLint NULL_GL_MAX_UNIFORM_BLOCK_SIZE          = 65536;
+static constexpr GLint NULL_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT = 256;
+
+//
+// Service types
+//
+
+enum class NullObjectKind: uint8_t
+{
+    Buffer,
+    Framebuffer,
+    Query,
+    Renderbuffer,
+    Texture,
+    VertexArray,
+    // Programs and shaders share a namespace.
+    ShaderObject,
+
+    Count
+};
+
+struct NullBufferMapping final
+{
+    GLintptr   Offset;
+    GLsizeiptr Length;
+    GLbitfield Access;
+};
+
+struct NullBuffer final
+{
+    std::vector<std::byte>           Storage;
+    std::optional<NullBufferMapping> Mapping;
+};
+
+struct NullProgram final
+{
+    std::vector<GLuint>                     AttachedShaders;
+    bool                                    IsLinked = false;
+    std::unordered_map<std::string, GLint>  UniformLocations;
+    std::unordered_map<std::string, GLuint> UniformBlockIndices;
+};
+
+struct NullGlState final
+{
+    std::array<GLuint, static_cast<size_t>(NullObjectKind::Count)>                     NextNames{};
+    std::array<std::unordered_set<GLuint>, static_cast<size_t>(NullObjectKind::Count)> LiveNames;
+
+    std::unordered_map<GLuint, NullBuffer>  Buffers;
+    std::unordered_map<GLuint, GLenum>      ShaderTypes;
+    std::unordered_map<GLuint, NullProgram> Programs;
+    std::unordered_map<GLuint, GLuint64>    QueryResults;
+    std::unordered_set<uintptr_t>           Syncs;
+    uintptr_t                               NextSync = 1;
+
+    // Bindings, the element array buffer one being vertex array state
+    std::unordered_map<GLenum, GLuint>            BoundBuffers;
+    std::unordered_map<GLuint, GLuint>            ElementArrayBuffers;
+    std::array<GLuint, NULL_GL_MAX_TEXTURE_UNITS> BoundTextures{};
+    GLuint                                        ActiveTextureUnit = 0;
+    GLuint                                        BoundFramebuffer  = 0;
+    GLuint                                        BoundRenderbuffer = 0;
+    GLuint                                        BoundVertexArray  = 0;
+    GLuint                                        CurrentProgram    = 0;
+    GLenum                                        PolygonMode       = GL_FILL;
+    std::array<GLint, 4>                          Viewport{};
+
+    GLenum PendingError = GL_NO_ERROR;
+
+    std::array<uint64_t, GL_FUNCTION_COUNT> CallCounts{};
+    uint64_t                                ValidationErrorCount   = 0;
+    uint64_t                                UnimplementedCallCount = 0;
+};
+
+//
+// Statics
+//
+
+static NullGlState s_State;
+
+//
+// Forward declarations
+//
+
+static void CountCall(const GlFunction function);
+
+// Logs the failed validation and latches the error until glGetError() is called, as GL does.
+static void ReportError(const GlFunction function, const GLenum error, const char * const message);
+
+static bool IsLiveName(const NullObjectKind kind, const GLuint name);
+
+static void GenerateNames(const GlFunction function, const NullObjectKind kind, const GLsizei count, GLuint * const names);
+
+static void DeleteNames(const GlFunction function, const NullObjectKind kind, const GLsizei count, const GLuint * const names);
+
+static bool ValidateBinding(const GlFunction function, const NullObjectKind kind, const GLuint name);
+
+static NullBuffer * GetBoundBuffer(const GlFunction function, const GLenum target);
+
+static NullProgram * GetProgram(const GlFunction function, const GLuint program);
+
+static void ValidateUniformUpload(const GlFunction function, const GLint location);
+
+static void ValidateBoundTexture(const GlFunction function);
+
+static void ValidateUnpackSource(const GlFunction function, const void * const pixels, const size_t size);
+
+static void ValidateDraw(const GlFunction function, const GLsizei count);
+
+static GLuint64 GetTimestampNanoseconds();
+
+static void APIENTRY NullUnimplemented();
+
+//
+// Null GL functions
+//
+
+static GLenum APIENTRY NullGetError()
+{
+    const GLenum error = s_State.PendingError;
+    s_State.PendingError = GL_NO_ERROR;
+
+    return error;
+}
+
+static const GLubyte * APIENTRY NullGetString(const GLenum name)
+{
+    switch (name)
+    {
+    case GL_VERSION:
+        return reinterpret_cast<const GLubyte *>(NULL_GL_VERSION);
+    case GL_SHADING_LANGUAGE_VERSION:
+        return reinterpret_cast<const GLubyte *>(NULL_GL_SHADING_LANGUAGE_VERSION);
+    case GL_VENDOR:
+        return reinterpret_cast<const GLubyte *>(NULL_GL_VENDOR);
+    case GL_RENDERER:
+        return reinterpret_cast<const GLubyte *>(NULL_GL_RENDERER);
+    default:
+        s_State.ValidationErrorCount++;
+        s_State.PendingError = GL_INVALID_ENUM;
+        return nullptr;
+    }
+}
+
+static const GLubyte * APIENTRY NullGetStringi(const GLenum name, const GLuint index)
+{
+    if (name != GL_EXTENSIONS || index != 0)
+    {
+        s_State.ValidationErrorCount++;
+        s_State.PendingError = name != GL_EXTENSIONS ? GL_INVALID_ENUM : GL_INVALID_VALUE;
+        return nullptr;
+    }
+
+    return reinterpret_cast<const GLubyte *>(NULL_GL_EXTENSION);
+}
+
+static void APIENTRY NullActiveTexture(const GLenum texture)
+{
+    CountCall(GlFunction::ActiveTexture);
+
+    if (texture < GL_TEXTURE0 || texture >= GL_TEXTURE0 + NULL_GL_MAX_TEXTURE_UNITS)
+        return ReportError(GlFunction::ActiveTexture, GL_INVALID_ENUM, "texture unit out of range");
+
+    s_State.ActiveTextureUnit = texture - GL_TEXTURE0;
+}
+
+static void APIENTRY NullAttachShader(const GLuint program, const GLuint shader)
+{
+    CountCall(GlFunction::AttachShader);
+
+    NullProgram * const programState = GetProgram(GlFunction::AttachShader, program);
+
+    if (programState == nullptr)
+        return;
+
+    if (!s_State.ShaderTypes.contains(shader))
+        return ReportError(GlFunction::AttachShader, GL_INVALID_OPERATION, "not a shader");
+
+    if (std::find(programState->AttachedShaders.cbegin(), programState->AttachedShaders.cend(), shader)
+            != programState->AttachedShaders.cend())
+        return ReportError(GlFunction::AttachShader, GL_INVALID_OPERATION, "shader is already attached");
+
+    programState->AttachedShaders.push_back(shader);
+}
+
+static void APIENTRY NullBindBuffer(const GLenum target, const GLuint buffer)
+{
+    CountCall(GlFunction::BindBuffer);
+
+    if (!ValidateBinding(GlFunction::BindBuffer, NullObjectKind::Buffer, buffer))
+        return;
+
+    if (target == GL_ELEMENT_ARRAY_BUFFER)
+    {
+        if (s_State.BoundVertexArray == 0)
+            return ReportError(GlFunction::BindBuffer, GL_INVALID_OPERATION, "no vertex array bound for element array buffer");
+
+        s_State.ElementArrayBuffers[s_State.BoundVertexArray] = buffer;
+    }
+
+    s_State.BoundBuffers[target] = buffer;
+}
+
+static void APIENTRY NullBindBufferRange(
+    const GLenum     target,
+    const GLuint     index,
+    const GLuint     buffer,
+    const GLintptr   offset,
+    const GLsizeiptr size
+)
+{
+    CountCall(GlFunction::BindBufferRange);
+
+    if (target != GL_UNIFORM_BUFFER)
+        return ReportError(GlFunction::BindBufferRange, GL_INVALID_ENUM, "unsupported indexed buffer target");
+
+    if (index >= static_cast<GLuint>(NULL_GL_MAX_UNIFORM_BUFFER_BINDINGS))
+        return ReportError(GlFunction::BindBufferRange, GL_INVALID_VALUE, "binding index out of range");
+
+    if (buffer == 0 || !IsLiveName(NullObjectKind::Buffer, buffer))
+        return ReportError(GlFunction::BindBufferRange, GL_INVALID_OPERATION, "name was not generated or is deleted");
+
+    if (offset < 0 || size <= 0 || static_cast<size_t>(offset + size) > s_State.Buffers[buffer].Storage.size())
+        return ReportError(GlFunction::BindBufferRange, GL_INVALID_VALUE, "range exceeds buffer storage");
+
+    if (offset % NULL_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT != 0)
+        return ReportError(GlFunction::BindBufferRange, GL_INVALID_VALUE, "misaligned uniform buffer offset");
+
+    s_State.BoundBuffers[target] = buffer;
+}
+
+static void APIENTRY NullBindFramebuffer(const GLenum /*target*/, const GLuint framebuffer)
+{
+    CountCall(GlFunction::BindFramebuffer);
+
+    if (ValidateBinding(GlFunction::BindFramebuffer, NullObjectKind::Framebuffer, framebuffer))
+        s_State.BoundFramebuffer = framebuffer;
+}
+
+static void APIENTRY NullBindRenderbuffer(const GLenum /*target*/, const GLuint renderbuffer)
+{
+    CountCall(GlFunction::BindRenderbuffer);
+
+    if (ValidateBinding(GlFunction::BindRenderbuffer, NullObjectKind::Renderbuffer, renderbuffer))
+        s_State.BoundRenderbuffer = renderbuffer;
+}
+
+static void APIENTRY NullBindTexture(const GLenum /*target*/, const GLuint texture)
+{
+    CountCall(GlFunction::BindTexture);
+
+    if (ValidateBinding(GlFunction::BindTexture, NullObjectKind::Texture, texture))
+        s_State.BoundTextures[s_State.ActiveTextureUnit] = texture;
+}
+
+static void APIENTRY NullBindVertexArray(const GLuint array)
+{
+    CountCall(GlFunction::BindVertexArray);
+
+    if (ValidateBinding(GlFunction::BindVertexArray, NullObjectKind::VertexArray, array))
+        s_State.BoundVertexArray = array;
+}
+
+static void APIENTRY NullBlendFunc(const GLenum /*sfactor*/, const GLenum /*dfactor*/)
+{
+    CountCall(GlFunction::BlendFunc);
+}
+
+static void APIENTRY NullBufferData(const GLenum target, const GLsizeiptr size, const void * const data, const GLenum /*usage*/)
+{
+    CountCall(GlFunction::BufferData);
+
+    if (size < 0)
+        return ReportError(GlFunction::BufferData, GL_INVALID_VALUE, "negative size");
+
+    NullBuffer * const buffer = GetBoundBuffer(GlFunction::BufferData, target);
+
+    if (buffer == nullptr)
+        return;
+
+    if (buffer->Mapping.has_value())
+        return ReportError(GlFunction::BufferData, GL_INVALID_OPERATION, "buffer is mapped");
+
+    // Copying keeps the CPU cost comparable to a driver's staging copy.
+    buffer->Storage.resize(static_cast<size_t>(size));
+
+    if (data != nullptr && size > 0)
+        std::memcpy(buffer->Storage.data(), data, static_cast<size_t>(size));
+}
+
+static GLenum APIENTRY NullCheckFramebufferStatus(const GLenum /*target*/)
+{
+    CountCall(GlFunction::CheckFramebufferStatus);
+
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void APIENTRY NullClear(const GLbitfield mask)
+{
+    CountCall(GlFunction::Clear);
+
+    if ((mask & ~(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT)) != 0)
+        ReportError(GlFunction::Clear, GL_INVALID_VALUE, "unrecognized buffer bits");
+}
+
+static void APIENTRY NullClearColor(const GLfloat /*red*/, const GLfloat /*green*/, const GLfloat /*blue*/, const GLfloat /*alpha*/)
+{
+    CountCall(GlFunction::ClearColor);
+}
+
+static GLenum APIENTRY NullClientWaitSync(const GLsync sync, const GLbitfield /*flags*/, const GLuint64 /*timeout*/)
+{
+    CountCall(GlFunction::ClientWaitSync);
+
+    if (!s_State.Syncs.contains(reinterpret_cast<uintptr_t>(sync)))
+    {
+        ReportError(GlFunction::ClientWaitSync, GL_INVALID_VALUE, "not a sync object");
+
+        return GL_WAIT_FAILED;
+    }
+
+    // Nothing is ever queued, so every fence is signaled as soon as it's created.
+    return GL_ALREADY_SIGNALED;
+}
+
+static void APIENTRY NullCompileShader(const GLuint shader)
+{
+    CountCall(GlFunction::CompileShader);
+
+    if (!s_State.ShaderTypes.contains(shader))
+        ReportError(GlFunction::CompileShader, GL_INVALID_OPERATION, "not a shader");
+}
+
+static void APIENTRY NullCompressedTexImage2D(
+    const GLenum  /*target*/,
+    const GLint   level,
+    const GLenum  /*internalformat*/,
+    const GLsizei width,
+    const GLsizei height,
+    const GLint   border,
+    const GLsizei imageSize,
+    const void *  data
+)
+{
+    CountCall(GlFunction::CompressedTexImage2D);
+
+    if (level < 0 || width < 0 || height < 0 || border != 0 || imageSize < 0)
+        return ReportError(GlFunction::CompressedTexImage2D, GL_INVALID_VALUE, "invalid level, size, border or image size");
+
+    if (width > NULL_GL_MAX_TEXTURE_SIZE || height > NULL_GL_MAX_TEXTURE_SIZE)
+        return ReportError(GlFunction::CompressedTexImage2D, GL_INVALID_VALUE, "size exceeds GL_MAX_TEXTURE_SIZE");
+
+    ValidateBoundTexture(GlFunction::CompressedTexImage2D);
+    ValidateUnpackSource(GlFunction::CompressedTexImage2D, data, static_cast<size_t>(imageSize));
+}
+
+static GLuint APIENTRY NullCreateProgram()
+{
+    CountCall(GlFunction::CreateProgram);
+
+    GLuint program = 0;
+    GenerateNames(GlFunction::CreateProgram, NullObjectKind::ShaderObject, 1, &program);
+
+    s_State.Programs.emplace(program, NullProgram());
+
+    return program;
+}
+
+static GLuint APIENTRY NullCreateShader(const GLenum type)
+{
+    CountCall(GlFunction::CreateShader);
+
+    if (type != GL_VERTEX_SHADER && type != GL_FRAGMENT_SHADER && type != GL_GEOMETRY_SHADER)
+    {
+        ReportError(GlFunction::CreateShader, GL_INVALID_ENUM, "unrecognized shader type");
+
+        return 0;
+    }
+
+    GLuint shader = 0;
+    GenerateNames(GlFunction::CreateShader, NullObjectKind::ShaderObject, 1, &shader);
+
+    s_State.ShaderTypes.emplace(shader, type);
+
+    return shader;
+}
+
+static void APIENTRY NullDeleteBuffers(const GLsizei n, const GLuint * const buffers)
+{
+    CountCall(GlFunction::DeleteBuffers);
+    DeleteNames(GlFunction::DeleteBuffers, NullObjectKind::Buffer, n, buffers);
+
+    for (GLsizei bufferIdx = 0; bufferIdx < std::max(n, 0); bufferIdx++)
+    {
+        s_State.Buffers.erase(buffers[bufferIdx]);
+
+        for (auto & [target, boundBuffer] : s_State.BoundBuffers)
+        {
+            if (boundBuffer == buffers[bufferIdx])
+                boundBuffer = 0;
+        }
+
+        for (auto & [array, elementArrayBuffer] : s_State.ElementArrayBuffers)
+        {
+            if (elementArrayBuffer == buffers[bufferIdx])
+                elementArrayBuffer = 0;
+        }
+    }
+}
+
+static void APIENTRY NullDeleteFramebuffers(const GLsizei n, const GLuint * const framebuffers)
+{
+    CountCall(GlFunction::DeleteFramebuffers);
+    DeleteNames(GlFunction::DeleteFramebuffers, NullObjectKind::Framebuffer, n, framebuffers);
+
+    if (std::find(framebuffers, framebuffers + std::max(n, 0), s_State.BoundFramebuffer) != framebuffers + std::max(n, 0))
+        s_State.BoundFramebuffer = 0;
+}
+
+static void APIENTRY NullDeleteProgram(const GLuint program)
+{
+    CountCall(GlFunction::DeleteProgram);
+
+    if (program == 0)
+        return;
+
+    if (!s_State.Programs.contains(program))
+        return ReportError(GlFunction::DeleteProgram, GL_INVALID_VALUE, "not a program");
+
+    s_State.Programs.erase(program);
+    s_State.LiveNames[static_cast<size_t>(NullObjectKind::ShaderObject)].erase(program);
+}
+
+static void APIENTRY NullDeleteQueries(const GLsizei n, const GLuint * const ids)
+{
+    CountCall(GlFunction::DeleteQueries);
+    DeleteNames(GlFunction::DeleteQueries, NullObjectKind::Query, n, ids);
+
+    for (GLsizei queryIdx = 0; queryIdx < std::max(n, 0); queryIdx++)
+        s_State.QueryResults.erase(ids[queryIdx]);
+}
+
+static void APIENTRY NullDeleteRenderbuffers(const GLsizei n, const GLuint * const renderbuffers)
+{
+    CountCall(GlFunction::DeleteRenderbuffers);
+    DeleteNames(GlFunction::DeleteRenderbuffers, NullObjectKind::Renderbuffer, n, renderbuffers);
+
+    if (std::find(renderbuffers, renderbuffers + std::max(n, 0), s_State.BoundRenderbuffer) != renderbuffers + std::max(n, 0))
+        s_State.BoundRenderbuffer = 0;
+}
+
+static void APIENTRY NullDeleteShader(const GLuint shader)
+{
+    CountCall(GlFunction::DeleteShader);
+
+    if (shader == 0)
+        return;
+
+    if (!s_State.ShaderTypes.contains(shader))
+        return ReportError(GlFunction::DeleteShader, GL_INVALID_VALUE, "not a shader");
+
+    // Attached shaders stay referenced by their programs, which is fine since they're never used again.
+    s_State.ShaderTypes.erase(shader);
+    s_State.LiveNames[static_cast<size_t>(NullObjectKind::ShaderObject)].erase(shader);
+}
+
+static void APIENTRY NullDeleteSync(const GLsync sync)
+{
+    CountCall(GlFunction::DeleteSync);
+
+    if (sync == nullptr)
+        return;
+
+    if (s_State.Syncs.erase(reinterpret_cast<uintptr_t>(sync)) == 0)
+        ReportError(GlFunction::DeleteSync, GL_INVALID_VALUE, "not a sync object");
+}
+
+static void APIENTRY NullDeleteTextures(const GLsizei n, const GLuint * const textures)
+{
+    CountCall(GlFunction::DeleteTextures);
+    DeleteNames(GlFunction::DeleteTextures, NullObjectKind::Texture, n, textures);
+
+    for (GLuint & boundTexture : s_State.BoundTextures)
+    {
+        if (std::find(textures, textures + std::max(n, 0), boundTexture) != textures + std::max(n, 0))
+            boundTexture = 0;
+    }
+}
+
+static void APIENTRY NullDeleteVertexArrays(const GLsizei n, const GLuint * const arrays)
+{
+    CountCall(GlFunction::DeleteVertexArrays);
+    DeleteNames(GlFunction::DeleteVertexArrays, NullObjectKind::VertexArray, n, arrays);
+
+    for (GLsizei arrayIdx = 0; arrayIdx < std::max(n, 0); arrayIdx++)
+    {
+        s_State.ElementArrayBuffers.erase(arrays[arrayIdx]);
+
+        if (arrays[arrayIdx] == s_State.BoundVertexArray)
+            s_State.BoundVertexArray = 0;
+    }
+}
+
+static void APIENTRY NullDrawArrays(const GLenum /*mode*/, const GLint first, const GLsizei count)
+{
+    CountCall(GlFunction::DrawArrays);
+
+    if (first < 0)
+        return ReportError(GlFunction::DrawArrays, GL_INVALID_VALUE, "negative first vertex");
+
+    ValidateDraw(GlFunction::DrawArrays, count);
+}
+
+static void APIENTRY NullDrawElements(const GLenum /*mode*/, const GLsizei count, const GLenum type, const void * const /*indices*/)
+{
+    CountCall(GlFunction::DrawElements);
+
+    if (type != GL_UNSIGNED_BYTE && type != GL_UNSIGNED_SHORT && type != GL_UNSIGNED_INT)
+        return ReportError(GlFunction::DrawElements, GL_INVALID_ENUM, "unrecognized index type");
+
+    const auto elementBufferIt = s_State.ElementArrayBuffers.find(s_State.BoundVertexArray);
+
+    // Client-side index arrays aren't available in core profile.
+    if (elementBufferIt == s_State.ElementArrayBuffers.cend() || elementBufferIt->second == 0)
+        return ReportError(GlFunction::DrawElements, GL_INVALID_OPERATION, "no element array buffer bound");
+
+    ValidateDraw(GlFunction::DrawElements, count);
+}
+
+static void APIENTRY NullEnable(const GLenum /*cap*/)
+{
+    CountCall(GlFunction::Enable);
+}
+
+static void APIENTRY NullEnableVertexAttribArray(const GLuint index)
+{
+    CountCall(GlFunction::EnableVertexAttribArray);
+
+    if (index >= static_cast<GLuint>(NULL_GL_MAX_VERTEX_ATTRIBS))
+        return ReportError(GlFunction::EnableVertexAttribArray, GL_INVALID_VALUE, "attribute index out of range");
+
+    if (s_State.BoundVertexArray == 0)
+        ReportError(GlFunction::EnableVertexAttribArray, GL_INVALID_OPERATION, "no vertex array bound");
+}
+
+static GLsync APIENTRY NullFenceSync(const GLenum condition, const GLbitfield flags)
+{
+    CountCall(GlFunction::FenceSync);
+
+    if (condition != GL_SYNC_GPU_COMMANDS_COMPLETE || flags != 0)
+    {
+        ReportError(GlFunction::FenceSync, GL_INVALID_ENUM, "invalid fence condition or flags");
+
+        return nullptr;
+    }
+
+    const uintptr_t sync = s_State.NextSync++;
+    s_State.Syncs.insert(sync);
+
+    return reinterpret_cast<GLsync>(sync);
+}
+
+static void APIENTRY NullFlush()
+{
+    CountCall(GlFunction::Flush);
+}
+
+static void APIENTRY NullFlushMappedBufferRange(const GLenum target, const GLintptr offset, const GLsizeiptr length)
+{
+    CountCall(GlFunction::FlushMappedBufferRange);
+
+    NullBuffer * const buffer = GetBoundBuffer(GlFunction::FlushMappedBufferRange, target);
+
+    if (buffer == nullptr)
+        return;
+
+    if (!buffer->Mapping.has_value() || (buffer->Mapping->Access & GL_MAP_FLUSH_EXPLICIT_BIT) == 0)
+        return ReportError(GlFunction::FlushMappedBufferRange, GL_INVALID_OPERATION, "buffer is not mapped for explicit flushing");
+
+    // The range is relative to the mapped range.
+    if (offset < 0 || length < 0 || offset + length > buffer->Mapping->Length)
+        ReportError(GlFunction::FlushMappedBufferRange, GL_INVALID_VALUE, "range exceeds the mapped range");
+}
+
+static void APIENTRY NullFramebufferRenderbuffer(
+    const GLenum /*target*/,
+    const GLenum /*attachment*/,
+    const GLenum /*renderbuffertarget*/,
+    const GLuint renderbuffer
+)
+{
+    CountCall(GlFunction::FramebufferRenderbuffer);
+
+    if (s_State.BoundFramebuffer == 0)
+        return ReportError(GlFunction::FramebufferRenderbuffer, GL_INVALID_OPERATION, "default framebuffer is bound");
+
+    if (renderbuffer != 0 && !IsLiveName(NullObjectKind::Renderbuffer, renderbuffer))
+        ReportError(GlFunction::FramebufferRenderbuffer, GL_INVALID_OPERATION, "not a renderbuffer");
+}
+
+static void APIENTRY NullGenBuffers(const GLsizei n, GLuint * const buffers)
+{
+    CountCall(GlFunction::GenBuffers);
+    GenerateNames(GlFunction::GenBuffers, NullObjectKind::Buffer, n, buffers);
+}
+
+static void APIENTRY NullGenFramebuffers(const GLsizei n, GLuint * const framebuffers)
+{
+    CountCall(GlFunction::GenFramebuffers);
+    GenerateNames(GlFunction::GenFramebuffers, NullObjectKind::Framebuffer, n, framebuffers);
+}
+
+static void APIENTRY NullGenQueries(const GLsizei n, GLuint * const ids)
+{
+    CountCall(GlFunction::GenQueries);
+    GenerateNames(GlFunction::GenQueries, NullObjectKind::Query, n, ids);
+}
+
+static void APIENTRY NullGenRenderbuffers(const GLsizei n, GLuint * const renderbuffers)
+{
+    CountCall(GlFunction::GenRenderbuffers);
+    GenerateNames(GlFunction::GenRenderbuffers, NullObjectKind::Renderbuffer, n, renderbuffers);
+}
+
+static void APIENTRY NullGenTextures(const GLsizei n, GLuint * const textures)
+{
+    CountCall(GlFunction::GenTextures);
+    GenerateNames(GlFunction::GenTextures, NullObjectKind::Texture, n, textures);
+}
+
+static void APIENTRY NullGenVertexArrays(const GLsizei n, GLuint * const arrays)
+{
+    CountCall(GlFunction::GenVertexArrays);
+    GenerateNames(GlFunction::GenVertexArrays, NullObjectKind::VertexArray, n, arrays);
+}
+
+static void APIENTRY NullGenerateMipmap(const GLenum /*target*/)
+{
+    CountCall(GlFunction::GenerateMipmap);
+    ValidateBoundTexture(GlFunction::GenerateMipmap);
+}
+
+static void APIENTRY NullGetIntegerv(const GLenum pname, GLint * const data)
+{
+    CountCall(GlFunction::GetIntegerv);
+
+    const auto getBoundBuffer = [] (const GLenum target) -> GLint
+    {
+        const auto bufferIt = s_State.BoundBuffers.find(target);
+
+        return bufferIt != s_State.BoundBuffers.cend() ? static_cast<GLint>(bufferIt->second) : 0;
+    };
+
+    switch (pname)
+    {
+    case GL_NUM_EXTENSIONS:
+        *data = 1;
+        break;
+    case GL_MAJOR_VERSION:
+        *data = 3;
+        break;
+    case GL_MINOR_VERSION:
+        *data = 3;
+        break;
+    case GL_CONTEXT_FLAGS:
+        *data = 0;
+        break;
+    case GL_MAX_VERTEX_ATTRIBS:
+        *data = NULL_GL_MAX_VERTEX_ATTRIBS;
+        break;
+    case GL_MAX_TEXTURE_SIZE:
+        *data = NULL_GL_MAX_TEXTURE_SIZE;
+        break;
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        *data = NULL_GL_MAX_TEXTURE_UNITS;
+        break;
+    case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+        *data = NULL_GL_MAX_UNIFORM_BUFFER_BINDINGS;
+        break;
+    case GL_MAX_UNIFORM_BLOCK_SIZE:
+        *data = NULL_GL_MAX_UNIFORM_BLOCK_SIZE;
+        break;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+        *data = NULL_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT;
+        break;
+    case GL_UNPACK_ALIGNMENT:
+    case GL_PACK_ALIGNMENT:
+        *data = 4;
+        break;
+    case GL_ARRAY_BUFFER_BINDING:
+        *data = getBoundBuffer(GL_ARRAY_BUFFER);
+        break;
+    case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+    {
+        const auto elementBufferIt = s_State.ElementArrayBuffers.find(s_State.BoundVertexArray);
+        *data = elementBufferIt != s_State.ElementArrayBuffers.cend() ? static_cast<GLint>(elementBufferIt->second) : 0;
+        break;
+    }
+    case GL_UNIFORM_BUFFER_BINDING:
+        *data = getBoundBuffer(GL_UNIFORM_BUFFER);
+        break;
+    case GL_PIXEL_UNPACK_BUFFER_BINDING:
+        *data = getBoundBuffer(GL_PIXEL_UNPACK_BUFFER);
+        break;
+    case GL_VERTEX_ARRAY_BINDING:
+        *data = static_cast<GLint>(s_State.BoundVertexArray);
+        break;
+    case GL_CURRENT_PROGRAM:
+        *data = static_cast<GLint>(s_State.CurrentProgram);
+        break;
+    case GL_TEXTURE_BINDING_2D:
+        *data = static_cast<GLint>(s_State.BoundTextures[s_State.ActiveTextureUnit]);
+        break;
+    case GL_ACTIVE_TEXTURE:
+        *data = static_cast<GLint>(GL_TEXTURE0 + s_State.ActiveTextureUnit);
+        break;
+    case GL_POLYGON_MODE:
+        data[0] = static_cast<GLint>(s_State.PolygonMode);
+        data[1] = static_cast<GLint>(s_State.PolygonMode);
+        break;
+    case GL_VIEWPORT:
+        std::copy(s_State.Viewport.cbegin(), s_State.Viewport.cend(), data);
+        break;
+    default:
+        ReportError(GlFunction::GetIntegerv, GL_INVALID_ENUM, "unsupported parameter");
+        break;
+    }
+}
+
+static void APIENTRY NullGetInteger64v(const GLenum pname, GLint64 * const data)
+{
+    CountCall(GlFunction::GetInteger64v);
+
+    if (pname == GL_TIMESTAMP)
+    {
+        *data = static_cast<GLint64>(GetTimestampNanoseconds());
+
+        return;
+    }
+
+    // Multiple values are only returned by parameters GetIntegerv() handles as well.
+    std::array<GLint, 4> values{};
+    NullGetIntegerv(pname, values.data());
+
+    *data = values[0];
+}
+
+static void APIENTRY NullGetProgramInfoLog(const GLuint program, const GLsizei bufSize, GLsizei * const length, GLchar * const infoLog)
+{
+    CountCall(GlFunction::GetProgramInfoLog);
+
+    if (GetProgram(GlFunction::GetProgramInfoLog, program) == nullptr)
+        return;
+
+    if (length != nullptr)
+        *length = 0;
+
+    if (bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+static void APIENTRY NullGetProgramiv(const GLuint program, const GLenum pname, GLint * const params)
+{
+    CountCall(GlFunction::GetProgramiv);
+
+    const NullProgram * const programState = GetProgram(GlFunction::GetProgramiv, program);
+
+    if (programState == nullptr)
+        return;
+
+    switch (pname)
+    {
+    case GL_LINK_STATUS:
+        *params = programState->IsLinked ? GL_TRUE : GL_FALSE;
+        break;
+    case GL_INFO_LOG_LENGTH:
+        *params = 0;
+        break;
+    case GL_ATTACHED_SHADERS:
+        *params = static_cast<GLint>(programState->AttachedShaders.size());
+        break;
+    default:
+        ReportError(GlFunction::GetProgramiv, GL_INVALID_ENUM, "unsupported parameter");
+        break;
+    }
+}
+
+static void APIENTRY NullGetQueryObjectiv(const GLuint id, const GLenum pname, GLint * const params)
+{
+    CountCall(GlFunction::GetQueryObjectiv);
+
+    const auto queryIt = s_State.QueryResults.find(id);
+
+    if (queryIt == s_State.QueryResults.cend())
+        return ReportError(GlFunction::GetQueryObjectiv, GL_INVALID_OPERATION, "query was never issued");
+
+    switch (pname)
+    {
+    case GL_QUERY_RESULT_AVAILABLE:
+        *params = GL_TRUE;
+        break;
+    case GL_QUERY_RESULT:
+        *params = static_cast<GLint>(queryIt->second);
+        break;
+    default:
+        ReportError(GlFunction::GetQueryObjectiv, GL_INVALID_ENUM, "unsupported parameter");
+        break;
+    }
+}
+
+static void APIENTRY NullGetQueryObjectui64v(const GLuint id, const GLenum pname, GLuint64 * const params)
+{
+    CountCall(GlFunction::GetQueryObjectui64v);
+
+    const auto queryIt = s_State.QueryResults.find(id);
+
+    if (queryIt == s_State.QueryResults.cend())
+        return ReportError(GlFunction::GetQueryObjectui64v, GL_INVALID_OPERATION, "query was never issued");
+
+    switch (pname)
+    {
+    case GL_QUERY_RESULT_AVAILABLE:
+        *params = GL_TRUE;
+        break;
+    case GL_QUERY_RESULT:
+        *params = queryIt->second;
+        break;
+    default:
+        ReportError(GlFunction::GetQueryObjectui64v, GL_INVALID_ENUM, "unsupported parameter");
+        break;
+    }
+}
+
+static void APIENTRY NullGetShaderInfoLog(const GLuint shader, const GLsizei bufSize, GLsizei * const length, GLchar * const infoLog)
+{
+    CountCall(GlFunction::GetShaderInfoLog);
+
+    if (!s_State.ShaderTypes.contains(shader))
+        return ReportError(GlFunction::GetShaderInfoLog, GL_INVALID_OPERATION, "not a shader");
+
+    if (length != nullptr)
+        *length = 0;
+
+    if (bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+static void APIENTRY NullGetShaderiv(const GLuint shader, const GLenum pname, GLint * const params)
+{
+    CountCall(GlFunction::GetShaderiv);
+
+    const auto shaderIt = s_State.ShaderTypes.find(shader);
+
+    if (shaderIt == s_State.ShaderTypes.cend())
+        return ReportError(GlFunction::GetShaderiv, GL_INVALID_OPERATION, "not a shader");
+
+    switch (pname)
+    {
+    case GL_COMPILE_STATUS:
+        *params = GL_TRUE;
+        break;
+    case GL_INFO_LOG_LENGTH:
+        *params = 0;
+        break;
+    case GL_SHADER_TYPE:
+        *params = static_cast<GLint>(shaderIt->second);
+        break;
+    default:
+        ReportError(GlFunction::GetShaderiv, GL_INVALID_ENUM, "unsupported parameter");
+        break;
+    }
+}
+
+static GLuint APIENTRY NullGetUniformBlockIndex(const GLuint program, const GLchar * const uniformBlockName)
+{
+    CountCall(GlFunction::GetUniformBlockIndex);
+
+    NullProgram * const programState = GetProgram(GlFunction::GetUniformBlockIndex, program);
+
+    if (programState == nullptr)
+        return GL_INVALID_INDEX;
+
+    if (!programState->IsLinked)
+    {
+        ReportError(GlFunction::GetUniformBlockIndex, GL_INVALID_OPERATION, "program is not linked");
+
+        return GL_INVALID_INDEX;
+    }
+
+    // Every block is assumed to be active, since shader sources aren't parsed.
+    const auto [blockIt, isInserted] = programState->UniformBlockIndices.emplace(
+        uniformBlockName,
+        static_cast<GLuint>(programState->UniformBlockIndices.size())
+    );
+
+    return blockIt->second;
+}
+
+static GLint APIENTRY NullGetUniformLocation(const GLuint program, const GLchar * const name)
+{
+    CountCall(GlFunction::GetUniformLocation);
+
+    NullProgram * const programState = GetProgram(GlFunction::GetUniformLocation, program);
+
+    if (programState == nullptr)
+        return -1;
+
+    if (!programState->IsLinked)
+    {
+        ReportError(GlFunction::GetUniformLocation, GL_INVALID_OPERATION, "program is not linked");
+
+        return -1;
+    }
+
+    // Every uniform is assumed to be active, since shader sources aren't parsed.
+    const auto [locationIt, isInserted] = programState->UniformLocations.emplace(
+        name,
+        static_cast<GLint>(programState->UniformLocations.size())
+    );
+
+    return locationIt->second;
+}
+
+static void APIENTRY NullLinkProgram(const GLuint program)
+{
+    CountCall(GlFunction::LinkProgram);
+
+    NullProgram * const programState = GetProgram(GlFunction::LinkProgram, program);
+
+    if (programState == nullptr)
+        return;
+
+    programState->IsLinked = true;
+    programState->UniformLocations.clear();
+    programState->UniformBlockIndices.clear();
+}
+
+static void * APIENTRY NullMapBufferRange(const GLenum target, const GLintptr offset, const GLsizeiptr length, const GLbitfield access)
+{
+    CountCall(GlFunction::MapBufferRange);
+
+    NullBuffer * const buffer = GetBoundBuffer(GlFunction::MapBufferRange, target);
+
+    if (buffer == nullptr)
+        return nullptr;
+
+    if (offset < 0 || length <= 0 || static_cast<size_t>(offset + length) > buffer->Storage.size())
+    {
+        ReportError(GlFunction::MapBufferRange, GL_INVALID_VALUE, "range exceeds buffer storage");
+
+        return nullptr;
+    }
+
+    if ((access & (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT)) == 0)
+    {
+        ReportError(GlFunction::MapBufferRange, GL_INVALID_OPERATION, "neither read nor write access requested");
+
+        return nullptr;
+    }
+
+    if (buffer->Mapping.has_value())
+    {
+        ReportError(GlFunction::MapBufferRange, GL_INVALID_OPERATION, "buffer is already mapped");
+
+        return nullptr;
+    }
+
+    buffer->Mapping = NullBufferMapping{offset, length, access};
+
+    return buffer->Storage.data() + offset;
+}
+
+static void APIENTRY NullPolygonMode(const GLenum face, const GLenum mode)
+{
+    CountCall(GlFunction::PolygonMode);
+
+    if (face != GL_FRONT_AND_BACK)
+        return ReportError(GlFunction::PolygonMode, GL_INVALID_ENUM, "only GL_FRONT_AND_BACK is allowed in core profile");
+
+    if (mode != GL_POINT && mode != GL_LINE && mode != GL_FILL)
+        return ReportError(GlFunction::PolygonMode, GL_INVALID_ENUM, "unrecognized polygon mode");
+
+    s_State.PolygonMode = mode;
+}
+
+static void APIENTRY NullQueryCounter(const GLuint id, const GLenum target)
+{
+    CountCall(GlFunction::QueryCounter);
+
+    if (target != GL_TIMESTAMP)
+        return ReportError(GlFunction::QueryCounter, GL_INVALID_ENUM, "target must be GL_TIMESTAMP");
+
+    if (!IsLiveName(NullObjectKind::Query, id))
+        return ReportError(GlFunction::QueryCounter, GL_INVALID_OPERATION, "not a query");
+
+    s_State.QueryResults[id] = GetTimestampNanoseconds();
+}
+
+static void APIENTRY NullRenderbufferStorage(const GLenum /*target*/, const GLenum /*internalformat*/, const GLsizei width, const GLsizei height)
+{
+    CountCall(GlFunction::RenderbufferStorage);
+
+    if (s_State.BoundRenderbuffer == 0)
+        return ReportError(GlFunction::RenderbufferStorage, GL_INVALID_OPERATION, "no renderbuffer bound");
+
+    if (width < 0 || height < 0 || width > NULL_GL_MAX_TEXTURE_SIZE || height > NULL_GL_MAX_TEXTURE_SIZE)
+        ReportError(GlFunction::RenderbufferStorage, GL_INVALID_VALUE, "size out of range");
+}
+
+static void APIENTRY NullShaderSource(
+    const GLuint          shader,
+    const GLsizei         count,
+    const GLchar * const * const /*string*/,
+    const GLint * const   /*length*/
+)
+{
+    CountCall(GlFunction::ShaderSource);
+
+    if (!s_State.ShaderTypes.contains(shader))
+        return ReportError(GlFunction::ShaderSource, GL_INVALID_OPERATION, "not a shader");
+
+    if (count < 0)
+        ReportError(GlFunction::ShaderSource, GL_INVALID_VALUE, "negative string count");
+}
+
+static void APIENTRY NullTexImage2D(
+    const GLenum  /*target*/,
+    const GLint   level,
+    const GLint   /*internalformat*/,
+    const GLsizei width,
+    const GLsizei height,
+    const GLint   border,
+    const GLenum  /*format*/,
+    const GLenum  /*type*/,
+    const void *  /*pixels*/
+)
+{
+    CountCall(GlFunction::TexImage2D);
+
+    if (level < 0 || width < 0 || height < 0 || border != 0)
+        return ReportError(GlFunction::TexImage2D, GL_INVALID_VALUE, "invalid level, size or border");
+
+    if (width > NULL_GL_MAX_TEXTURE_SIZE || height > NULL_GL_MAX_TEXTURE_SIZE)
+        return ReportError(GlFunction::TexImage2D, GL_INVALID_VALUE, "size exceeds GL_MAX_TEXTURE_SIZE");
+
+    ValidateBoundTexture(GlFunction::TexImage2D);
+}
+
+static void APIENTRY NullTexParameteri(const GLenum /*target*/, const GLenum /*pname*/, const GLint /*param*/)
+{
+    CountCall(GlFunction::TexParameteri);
+    ValidateBoundTexture(GlFunction::TexParameteri);
+}
+
+static void APIENTRY NullTexSubImage2D(
+    const GLenum  /*target*/,
+    const GLint   level,
+    const GLint   xoffset,
+    const GLint   yoffset,
+    const GLsizei width,
+    const GLsizei height,
+    const GLenum  /*format*/,
+    const GLenum  /*type*/,
+    const void *  pixels
+)
+{
+    CountCall(GlFunction::TexSubImage2D);
+
+    if (level < 0 || xoffset < 0 || yoffset < 0 || width < 0 || height < 0)
+        return ReportError(GlFunction::TexSubImage2D, GL_INVALID_VALUE, "invalid level, offset or size");
+
+    ValidateBoundTexture(GlFunction::TexSubImage2D);
+
+    // Texture sizes aren't tracked, so only the source of the pixels is validated.
+    ValidateUnpackSource(GlFunction::TexSubImage2D, pixels, 0);
+}
+
+static void APIENTRY NullUniform1f(const GLint location, const GLfloat /*v0*/)
+{
+    CountCall(GlFunction::Uniform1f);
+    ValidateUniformUpload(GlFunction::Uniform1f, location);
+}
+
+static void APIENTRY NullUniform1i(const GLint location, const GLint /*v0*/)
+{
+    CountCall(GlFunction::Uniform1i);
+    ValidateUniformUpload(GlFunction::Uniform1i, location);
+}
+
+static void APIENTRY NullUniform1ui(const GLint location, const GLuint /*v0*/)
+{
+    CountCall(GlFunction::Uniform1ui);
+    ValidateUniformUpload(GlFunction::Uniform1ui, location);
+}
+
+static void APIENTRY NullUniform2f(const GLint location, const GLfloat /*v0*/, const GLfloat /*v1*/)
+{
+    CountCall(GlFunction::Uniform2f);
+    ValidateUniformUpload(GlFunction::Uniform2f, location);
+}
+
+static void APIENTRY NullUniform3f(const GLint location, const GLfloat /*v0*/, const GLfloat /*v1*/, const GLfloat /*v2*/)
+{
+    CountCall(GlFunction::Uniform3f);
+    ValidateUniformUpload(GlFunction::Uniform3f, location);
+}
+
+static void APIENTRY NullUniform4f(
+    const GLint   location,
+    const GLfloat /*v0*/,
+    const GLfloat /*v1*/,
+    const GLfloat /*v2*/,
+    const GLfloat /*v3*/
+)
+{
+    CountCall(GlFunction::Uniform4f);
+    ValidateUniformUpload(GlFunction::Uniform4f, location);
+}
+
+static void APIENTRY NullUniformBlockBinding(const GLuint program, const GLuint uniformBlockIndex, const GLuint uniformBlockBinding)
+{
+    CountCall(GlFunction::UniformBlockBinding);
+
+    const NullProgram * const programState = GetProgram(GlFunction::UniformBlockBinding, program);
+
+    if (programState == nullptr)
+        return;
+
+    if (uniformBlockIndex >= programState->UniformBlockIndices.size())
+        return ReportError(GlFunction::UniformBlockBinding, GL_INVALID_VALUE, "not an active uniform block index");
+
+    if (uniformBlockBinding >= static_cast<GLuint>(NULL_GL_MAX_UNIFORM_BUFFER_BINDINGS))
+        ReportError(GlFunction::UniformBlockBinding, GL_INVALID_VALUE, "binding index out of range");
+}
+
+static void APIENTRY NullUniformMatrix4fv(const GLint location, const GLsizei count, const GLboolean /*transpose*/, const GLfloat * const /*value*/)
+{
+    CountCall(GlFunction::UniformMatrix4fv);
+
+    if (count < 0)
+        return ReportError(GlFunction::UniformMatrix4fv, GL_INVALID_VALUE, "negative count");
+
+    ValidateUniformUpload(GlFunction::UniformMatrix4fv, location);
+}
+
+static GLboolean APIENTRY NullUnmapBuffer(const GLenum target)
+{
+    CountCall(GlFunction::UnmapBuffer);
+
+    NullBuffer * const buffer = GetBoundBuffer(GlFunction::UnmapBuffer, target);
+
+    if (buffer == nullptr)
+        return GL_FALSE;
+
+    if (!buffer->Mapping.has_value())
+    {
+        ReportError(GlFunction::UnmapBuffer, GL_INVALID_OPERATION, "buffer is not mapped");
+
+        return GL_FALSE;
+    }
+
+    buffer->Mapping.reset();
+
+    return GL_TRUE;
+}
+
+static void APIENTRY NullUseProgram(const GLuint program)
+{
+    CountCall(GlFunction::UseProgram);
+
+    if (program != 0)
+    {
+        const NullProgram * const programState = GetProgram(GlFunction::UseProgram, program);
+
+        if (programState == nullptr)
+            return;
+
+        if (!programState->IsLinked)
+            return ReportError(GlFunction::UseProgram, GL_INVALID_OPERATION, "program is not linked");
+    }
+
+    s_State.CurrentProgram = program;
+}
+
+static void APIENTRY NullVertexAttribPointer(
+    const GLuint      index,
+    const GLint       size,
+    const GLenum      /*type*/,
+    const GLboolean   /*normalized*/,
+    const GLsizei     stride,
+    const void *      pointer
+)
+{
+    CountCall(GlFunction::VertexAttribPointer);
+
+    if (index >= static_cast<GLuint>(NULL_GL_MAX_VERTEX_ATTRIBS) || size < 1 || size > 4 || stride < 0)
+        return ReportError(GlFunction::VertexAttribPointer, GL_INVALID_VALUE, "invalid index, size or stride");
+
+    if (s_State.BoundVertexArray == 0)
+        return ReportError(GlFunction::VertexAttribPointer, GL_INVALID_OPERATION, "no vertex array bound");
+
+    const auto arrayBufferIt = s_State.BoundBuffers.find(GL_ARRAY_BUFFER);
+
+    // Client-side vertex arrays aren't available in core profile.
+    if ((arrayBufferIt == s_State.BoundBuffers.cend() || arrayBufferIt->second == 0) && pointer != nullptr)
+        ReportError(GlFunction::VertexAttribPointer, GL_INVALID_OPERATION, "no array buffer bound");
+}
+
+static void APIENTRY NullViewport(const GLint x, const GLint y, const GLsizei width, const GLsizei height)
+{
+    CountCall(GlFunction::Viewport);
+
+    if (width < 0 || height < 0)
+        return ReportError(GlFunction::Viewport, GL_INVALID_VALUE, "negative size");
+
+    s_State.Viewport = {x, y, width, height};
+}
+
+//
+// Utilities
+//
+
+void * GetNullGlProcAddress(const char * const name)
+{
+    if (std::strcmp(name, "glGetError") == 0)
+        return reinterpret_cast<void *>(&NullGetError);
+
+    if (std::strcmp(name, "glGetString") == 0)
+        return reinterpret_cast<void *>(&NullGetString);
+
+    if (std::strcmp(name, "glGetStringi") == 0)
+        return reinterpret_cast<void *>(&NullGetStringi);
+
+#define LEARNOPENGL_GET_NULL_GL_FUNCTION(function)                                                 \
+    static_assert(                                                                                  \
+        std::is_same_v<decltype(&Null##function), decltype(glad_gl##function)>,                   \
+        "null GL function signature must match GLAD's"                                              \
+    );                                                                                              \
+    if (std::strcmp(name, "gl" #function) == 0)                                                    \
+        return reinterpret_cast<void *>(&Null##function);
+
+    LEARNOPENGL_BACKEND_GL_FUNCTIONS(LEARNOPENGL_GET_NULL_GL_FUNCTION)
+#undef LEARNOPENGL_GET_NULL_GL_FUNCTION
+
+    return reinterpret_cast<void *>(&NullUnimplemented);
+}
+
+void ResetNullGl()
+{
+    s_State = NullGlState();
+    s_State.NextNames.fill(1);
+}
+
+uint64_t GetNullGlValidationErrorCount()
+{
+    return s_State.ValidationErrorCount;
+}
+
+void LogNullGlSummary()
+{
+    std::vector<std::pair<uint64_t, GlFunction>> callCounts;
+    uint64_t                                     totalCallCount = 0;
+
+    for (size_t functionIdx = 0; functionIdx < GL_FUNCTION_COUNT; functionIdx++)
+    {
+        if (s_State.CallCounts[functionIdx] == 0)
+            continue;
+
+        callCounts.emplace_back(s_State.CallCounts[functionIdx], static_cast<GlFunction>(functionIdx));
+        totalCallCount += s_State.CallCounts[functionIdx];
+    }
+
+    std::sort(callCounts.begin(), callCounts.end(), [] (const auto & lhs, const auto & rhs) { return lhs.first > rhs.first; });
+
+    LOG_INFO<< "Null GL backend handled " << totalCallCount << " calls with "
+        << s_State.ValidationErrorCount << " validation errors";
+
+    for (const auto & [callCount, function] : callCounts)
+        LOG_INFO<< "    " << GlFunctionToCStr(function) << ": " << callCount;
+
+    if (s_State.UnimplementedCallCount > 0)
+    {
+        LOG_WARNING<< s_State.UnimplementedCallCount << " calls to GL functions unknown to the null backend "
+            << "were ignored, they should be added to LEARNOPENGL_BACKEND_GL_FUNCTIONS";
+    }
+}
+
+//
+// Service
+//
+
+static void CountCall(const GlFunction function)
+{
+    s_State.CallCounts[static_cast<size_t>(function)]++;
+}
+
+static void ReportError(const GlFunction function, const GLenum error, const char * const message)
+{
+    LOG_ERROR<< "Null GL backend: " << GlErrorToCStr(error) << " in " << GlFunctionToCStr(function)
+        << ": " << message;
+
+    s_State.ValidationErrorCount++;
+
+    if (s_State.PendingError == GL_NO_ERROR)
+        s_State.PendingError = error;
+}
+
+static bool IsLiveName(const NullObjectKind kind, const GLuint name)
+{
+    return s_State.LiveNames[static_cast<size_t>(kind)].contains(name);
+}
+
+static void GenerateNames(const GlFunction function, const NullObjectKind kind, const GLsizei count, GLuint * const names)
+{
+    if (count < 0)
+        return ReportError(function, GL_INVALID_VALUE, "negative count");
+
+    GLuint & nextName = s_State.NextNames[static_cast<size_t>(kind)];
+
+    for (GLsizei nameIdx = 0; nameIdx < count; nameIdx++)
+    {
+        names[nameIdx] = nextName++;
+        s_State.LiveNames[static_cast<size_t>(kind)].insert(names[nameIdx]);
+    }
+}
+
+static void DeleteNames(const GlFunction function, const NullObjectKind kind, const GLsizei count, const GLuint * const names)
+{
+    if (count < 0)
+        return ReportError(function, GL_INVALID_VALUE, "negative count");
+
+    // Unused names and 0 are silently ignored, as GL does.
+    for (GLsizei nameIdx = 0; nameIdx < count; nameIdx++)
+        s_State.LiveNames[static_cast<size_t>(kind)].erase(names[nameIdx]);
+}
+
+static bool ValidateBinding(const GlFunction function, const NullObjectKind kind, const GLuint name)
+{
+    // Core profile doesn't allow binding names that weren't generated.
+    if (name != 0 && !IsLiveName(kind, name))
+    {
+        ReportError(function, GL_INVALID_OPERATION, "name was not generated or is deleted");
+
+        return false;
+    }
+
+    return true;
+}
+
+static NullBuffer * GetBoundBuffer(const GlFunction function, const GLenum target)
+{
+    GLuint buffer = 0;
+
+    if (target == GL_ELEMENT_ARRAY_BUFFER)
+    {
+        const auto elementBufferIt = s_State.ElementArrayBuffers.find(s_State.BoundVertexArray);
+
+        if (elementBufferIt != s_State.ElementArrayBuffers.cend())
+            buffer = elementBufferIt->second;
+    }
+    else
+    {
+        const auto bufferIt = s_State.BoundBuffers.find(target);
+
+        if (bufferIt != s_State.BoundBuffers.cend())
+            buffer = bufferIt->second;
+    }
+
+    if (buffer == 0)
+    {
+        ReportError(function, GL_INVALID_OPERATION, "no buffer bound to target");
+
+        return nullptr;
+    }
+
+    return &s_State.Buffers[buffer];
+}
+
+static NullProgram * GetProgram(const GlFunction function, const GLuint program)
+{
+    const auto programIt = s_State.Programs.find(program);
+
+    if (programIt == s_State.Programs.end())
+    {
+        ReportError(function, s_State.ShaderTypes.contains(program) ? GL_INVALID_OPERATION : GL_INVALID_VALUE, "not a program");
+
+        return nullptr;
+    }
+
+    return &programIt->second;
+}
+
+static void ValidateUniformUpload(const GlFunction function, const GLint location)
+{
+    if (s_State.CurrentProgram == 0)
+        return ReportError(function, GL_INVALID_OPERATION, "no program in use");
+
+    // Location -1 is silently ignored, as GL does.
+    if (location < -1)
+        ReportError(function, GL_INVALID_OPERATION, "invalid uniform location");
+}
+
+static void ValidateBoundTexture(const GlFunction function)
+{
+    if (s_State.BoundTextures[s_State.ActiveTextureUnit] == 0)
+        ReportError(function, GL_INVALID_OPERATION, "no texture bound to the active unit");
+}
+
+// With an unpack buffer bound, pixels is an offset into it, which must fit size bytes.
+static void ValidateUnpackSource(const GlFunction function, const void * const pixels, const size_t size)
+{
+    const auto unpackBufferIt = s_State.BoundBuffers.find(GL_PIXEL_UNPACK_BUFFER);
+
+    if (unpackBufferIt == s_State.BoundBuffers.cend() || unpackBufferIt->second == 0)
+        return;
+
+    const NullBuffer & unpackBuffer = s_State.Buffers[unpackBufferIt->second];
+
+    if (unpackBuffer.Mapping.has_value())
+        return ReportError(function, GL_INVALID_OPERATION, "unpack buffer is mapped");
+
+    const uintptr_t offset = reinterpret_cast<uintptr_t>(pixels);
+
+    if (offset > unpackBuffer.Storage.size() || size > unpackBuffer.Storage.size() - offset)
+        ReportError(function, GL_INVALID_OPERATION, "range exceeds unpack buffer storage");
+}
+
+static void ValidateDraw(const GlFunction function, const GLsizei count)
+{
+    if (count < 0)
+        return ReportError(function, GL_INVALID_VALUE, "negative count");
+
+    if (s_State.BoundVertexArray == 0)
+        return ReportError(function, GL_INVALID_OPERATION, "no vertex array bound");
+
+    if (s_State.CurrentProgram == 0)
+        ReportError(function, GL_INVALID_OPERATION, "no program in use");
+}
+
+static GLuint64 GetTimestampNanoseconds()
+{
+    return static_cast<GLuint64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+    );
+}
+
+// Stands in for every function the null backend doesn't know. The signature doesn't match any of them,
+// which works since callers clean up the stack in all 64-bit calling conventions.
+static void APIENTRY NullUnimplemented()
+{
+    s_State.UnimplementedCallCount++;
+}
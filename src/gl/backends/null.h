@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+//
+// Utilities
+//
+
+// GLAD loader of the null backend. It implements every function of LEARNOPENGL_BACKEND_GL_FUNCTIONS
+// plus the ones GLAD needs for loading, tracking just enough object state to validate calls
+// and to return plausible names, locations and query results. Any other function is a no-op.
+// Like a real context, it must only be used by one thread at a time.
+void * GetNullGlProcAddress(const char * const name);
+
+// Releases all objects and clears counters.
+void ResetNullGl();
+
+uint64_t GetNullGlValidationErrorCount();
+
+void LogNullGlSummary();
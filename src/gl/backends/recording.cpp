@@ -0,0 +1,595 @@
+#include "recording.h"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <type_traits>
+
+#include "logging.h"
+
+#include "capture_stream.h"
+#include "functions.h"
+
+//
+// Service types
+//
+
+struct RecordedMapping final
+{
+    std::byte * Data;
+    GLsizeiptr  Length;
+    GLbitfield  Access;
+};
+
+//
+// Statics
+//
+
+// Calls are recorded while holding the mutex, so that the capture keeps their order
+// even when the context is handed over between threads.
+static std::mutex                       s_CaptureMutex;
+static std::unique_ptr<GlCaptureWriter> s_CaptureWriter;
+static std::string                      s_CaptureFilePath;
+static GLADloadproc                     s_RealLoader         = nullptr;
+static uint64_t                         s_RecordedCallCount  = 0;
+static uint64_t                         s_RecordedFrameCount = 0;
+
+// Mapped buffer ranges by target, written back into the capture on flush or unmap
+static std::unordered_map<GLenum, RecordedMapping> s_Mappings;
+
+#define LEARNOPENGL_DECLARE_REAL_GL_FUNCTION(function) static decltype(glad_gl##function) s_Real##function = nullptr;
+LEARNOPENGL_BACKEND_GL_FUNCTIONS(LEARNOPENGL_DECLARE_REAL_GL_FUNCTION)
+#undef LEARNOPENGL_DECLARE_REAL_GL_FUNCTION
+
+//
+// Forward declarations
+//
+
+static bool WriteUnpackBufferOffset(const void * const pixels);
+
+static void WriteUnpackedPixels(
+    const GLsizei      width,
+    const GLsizei      height,
+    const GLenum       format,
+    const GLenum       type,
+    const void * const pixels
+);
+
+static size_t GetPixelDataSize(
+    const GLsizei width,
+    const GLsizei height,
+    const GLenum  format,
+    const GLenum  type,
+    const GLint   rowAlignment
+);
+
+//
+// Recorders
+//
+
+// Records all arguments by value, followed by the result if any.
+template <
+    GlFunction function,
+    auto & realFunction,
+    typename Signature = std::remove_reference_t<decltype(realFunction)>
+>
+struct GenericRecorder;
+
+template <GlFunction function, auto & realFunction, typename Result, typename... Args>
+struct GenericRecorder<function, realFunction, Result (APIENTRY *)(Args...)> final
+{
+    static Result APIENTRY Record(Args... args)
+    {
+        const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+        s_RecordedCallCount++;
+        s_CaptureWriter->BeginCall(function);
+        (s_CaptureWriter->Write(args), ...);
+
+        if constexpr (std::is_void_v<Result>)
+        {
+            realFunction(args...);
+        }
+        else
+        {
+            const Result result = realFunction(args...);
+            s_CaptureWriter->Write(result);
+
+            return result;
+        }
+    }
+};
+
+// Records the count followed by the generated names.
+template <GlFunction function, auto & realFunction>
+static void APIENTRY RecordNameGeneration(const GLsizei n, GLuint * const names)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    realFunction(n, names);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(function);
+    s_CaptureWriter->Write(n);
+
+    for (GLsizei nameIdx = 0; nameIdx < n; nameIdx++)
+        s_CaptureWriter->Write(names[nameIdx]);
+}
+
+// Records the count followed by the deleted names.
+template <GlFunction function, auto & realFunction>
+static void APIENTRY RecordNameDeletion(const GLsizei n, const GLuint * const names)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(function);
+    s_CaptureWriter->Write(n);
+
+    for (GLsizei nameIdx = 0; nameIdx < n; nameIdx++)
+        s_CaptureWriter->Write(names[nameIdx]);
+
+    realFunction(n, names);
+}
+
+// Records the program, the looked up name and the result, e.g. a uniform location.
+template <GlFunction function, auto & realFunction>
+static auto APIENTRY RecordProgramLookup(const GLuint program, const GLchar * const name)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    const auto result = realFunction(program, name);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(function);
+    s_CaptureWriter->Write(program);
+    s_CaptureWriter->WriteString(name);
+    s_CaptureWriter->Write(result);
+
+    return result;
+}
+
+static void APIENTRY RecordBufferData(const GLenum target, const GLsizeiptr size, const void * const data, const GLenum usage)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::BufferData);
+    s_CaptureWriter->Write(target);
+    s_CaptureWriter->Write(size);
+    s_CaptureWriter->Write(usage);
+    s_CaptureWriter->Write(data != nullptr);
+
+    if (data != nullptr)
+        s_CaptureWriter->WriteBlob(data, static_cast<size_t>(size));
+
+    s_RealBufferData(target, size, data, usage);
+}
+
+static void * APIENTRY RecordMapBufferRange(const GLenum target, const GLintptr offset, const GLsizeiptr length, const GLbitfield access)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    void * const data = s_RealMapBufferRange(target, offset, length, access);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::MapBufferRange);
+    s_CaptureWriter->Write(target);
+    s_CaptureWriter->Write(offset);
+    s_CaptureWriter->Write(length);
+    s_CaptureWriter->Write(access);
+
+    if (data != nullptr)
+        s_Mappings[target] = RecordedMapping{static_cast<std::byte *>(data), length, access};
+
+    return data;
+}
+
+// Records the bytes written into the flushed range, since the app writes them through a plain pointer.
+static void APIENTRY RecordFlushMappedBufferRange(const GLenum target, const GLintptr offset, const GLsizeiptr length)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    const auto mappingIt = s_Mappings.find(target);
+    assert(mappingIt != s_Mappings.cend() && "flushed buffer must be mapped");
+    assert(offset >= 0 && offset + length <= mappingIt->second.Length);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::FlushMappedBufferRange);
+    s_CaptureWriter->Write(target);
+    s_CaptureWriter->Write(offset);
+    s_CaptureWriter->Write(length);
+    s_CaptureWriter->WriteBlob(mappingIt->second.Data + offset, static_cast<size_t>(length));
+
+    s_RealFlushMappedBufferRange(target, offset, length);
+}
+
+// Records the whole mapped range, unless it was written back by explicit flushes already.
+static GLboolean APIENTRY RecordUnmapBuffer(const GLenum target)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::UnmapBuffer);
+    s_CaptureWriter->Write(target);
+
+    const auto mappingIt = s_Mappings.find(target);
+
+    if (
+        mappingIt != s_Mappings.cend()
+            && (mappingIt->second.Access & GL_MAP_WRITE_BIT) != 0
+            && (mappingIt->second.Access & GL_MAP_FLUSH_EXPLICIT_BIT) == 0
+    )
+        s_CaptureWriter->WriteBlob(mappingIt->second.Data, static_cast<size_t>(mappingIt->second.Length));
+    else
+        s_CaptureWriter->WriteBlob(nullptr, 0);
+
+    if (mappingIt != s_Mappings.cend())
+        s_Mappings.erase(mappingIt);
+
+    return s_RealUnmapBuffer(target);
+}
+
+static void APIENTRY RecordShaderSource(
+    const GLuint                 shader,
+    const GLsizei                count,
+    const GLchar * const * const string,
+    const GLint * const          length
+)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::ShaderSource);
+    s_CaptureWriter->Write(shader);
+    s_CaptureWriter->Write(count);
+
+    for (GLsizei stringIdx = 0; stringIdx < count; stringIdx++)
+    {
+        // Strings without a non-negative length are null terminated.
+        s_CaptureWriter->WriteString(
+            length != nullptr && length[stringIdx] >= 0
+                ? std::string_view(string[stringIdx], static_cast<size_t>(length[stringIdx]))
+                : std::string_view(string[stringIdx])
+        );
+    }
+
+    s_RealShaderSource(shader, count, string, length);
+}
+
+static void APIENTRY RecordCompressedTexImage2D(
+    const GLenum  target,
+    const GLint   level,
+    const GLenum  internalformat,
+    const GLsizei width,
+    const GLsizei height,
+    const GLint   border,
+    const GLsizei imageSize,
+    const void *  data
+)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::CompressedTexImage2D);
+    s_CaptureWriter->Write(target);
+    s_CaptureWriter->Write(level);
+    s_CaptureWriter->Write(internalformat);
+    s_CaptureWriter->Write(width);
+    s_CaptureWriter->Write(height);
+    s_CaptureWriter->Write(border);
+    s_CaptureWriter->Write(imageSize);
+
+    // Same layout as pixels of uncompressed uploads, the size is given instead of derived from the format.
+    if (!WriteUnpackBufferOffset(data))
+    {
+        s_CaptureWriter->Write(data != nullptr);
+
+        if (data != nullptr)
+            s_CaptureWriter->WriteBlob(data, static_cast<size_t>(imageSize));
+    }
+
+    s_RealCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+}
+
+static void APIENTRY RecordTexImage2D(
+    const GLenum  target,
+    const GLint   level,
+    const GLint   internalformat,
+    const GLsizei width,
+    const GLsizei height,
+    const GLint   border,
+    const GLenum  format,
+    const GLenum  type,
+    const void *  pixels
+)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::TexImage2D);
+    s_CaptureWriter->Write(target);
+    s_CaptureWriter->Write(level);
+    s_CaptureWriter->Write(internalformat);
+    s_CaptureWriter->Write(width);
+    s_CaptureWriter->Write(height);
+    s_CaptureWriter->Write(border);
+    s_CaptureWriter->Write(format);
+    s_CaptureWriter->Write(type);
+    WriteUnpackedPixels(width, height, format, type, pixels);
+
+    s_RealTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+static void APIENTRY RecordTexSubImage2D(
+    const GLenum  target,
+    const GLint   level,
+    const GLint   xoffset,
+    const GLint   yoffset,
+    const GLsizei width,
+    const GLsizei height,
+    const GLenum  format,
+    const GLenum  type,
+    const void *  pixels
+)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::TexSubImage2D);
+    s_CaptureWriter->Write(target);
+    s_CaptureWriter->Write(level);
+    s_CaptureWriter->Write(xoffset);
+    s_CaptureWriter->Write(yoffset);
+    s_CaptureWriter->Write(width);
+    s_CaptureWriter->Write(height);
+    s_CaptureWriter->Write(format);
+    s_CaptureWriter->Write(type);
+    WriteUnpackedPixels(width, height, format, type, pixels);
+
+    s_RealTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
+static void APIENTRY RecordUniformMatrix4fv(const GLint location, const GLsizei count, const GLboolean transpose, const GLfloat * const value)
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    s_RecordedCallCount++;
+    s_CaptureWriter->BeginCall(GlFunction::UniformMatrix4fv);
+    s_CaptureWriter->Write(location);
+    s_CaptureWriter->Write(count);
+    s_CaptureWriter->Write(transpose);
+    s_CaptureWriter->WriteBlob(value, 16*sizeof(GLfloat)*static_cast<size_t>(std::max(count, 0)));
+
+    s_RealUniformMatrix4fv(location, count, transpose, value);
+}
+
+template <GlFunction function, auto & realFunction>
+static void * GetRecorder()
+{
+    if constexpr (
+        function == GlFunction::GenBuffers
+            || function == GlFunction::GenFramebuffers
+            || function == GlFunction::GenQueries
+            || function == GlFunction::GenRenderbuffers
+            || function == GlFunction::GenTextures
+            || function == GlFunction::GenVertexArrays
+    )
+        return reinterpret_cast<void *>(&RecordNameGeneration<function, realFunction>);
+    else if constexpr (
+        function == GlFunction::DeleteBuffers
+            || function == GlFunction::DeleteFramebuffers
+            || function == GlFunction::DeleteQueries
+            || function == GlFunction::DeleteRenderbuffers
+            || function == GlFunction::DeleteTextures
+            || function == GlFunction::DeleteVertexArrays
+    )
+        return reinterpret_cast<void *>(&RecordNameDeletion<function, realFunction>);
+    else if constexpr (function == GlFunction::GetUniformLocation || function == GlFunction::GetUniformBlockIndex)
+        return reinterpret_cast<void *>(&RecordProgramLookup<function, realFunction>);
+    else if constexpr (function == GlFunction::BufferData)
+        return reinterpret_cast<void *>(&RecordBufferData);
+    else if constexpr (function == GlFunction::MapBufferRange)
+        return reinterpret_cast<void *>(&RecordMapBufferRange);
+    else if constexpr (function == GlFunction::FlushMappedBufferRange)
+        return reinterpret_cast<void *>(&RecordFlushMappedBufferRange);
+    else if constexpr (function == GlFunction::UnmapBuffer)
+        return reinterpret_cast<void *>(&RecordUnmapBuffer);
+    else if constexpr (function == GlFunction::ShaderSource)
+        return reinterpret_cast<void *>(&RecordShaderSource);
+    else if constexpr (function == GlFunction::CompressedTexImage2D)
+        return reinterpret_cast<void *>(&RecordCompressedTexImage2D);
+    else if constexpr (function == GlFunction::TexImage2D)
+        return reinterpret_cast<void *>(&RecordTexImage2D);
+    else if constexpr (function == GlFunction::TexSubImage2D)
+        return reinterpret_cast<void *>(&RecordTexSubImage2D);
+    else if constexpr (function == GlFunction::UniformMatrix4fv)
+        return reinterpret_cast<void *>(&RecordUniformMatrix4fv);
+    // Queries are recorded by value too, output pointers included, and replayed into scratch storage.
+    else
+        return reinterpret_cast<void *>(&GenericRecorder<function, realFunction>::Record);
+}
+
+//
+// Utilities
+//
+
+void StartGlCapture(const std::string & filePath, const GLADloadproc realLoader)
+{
+    assert(realLoader != nullptr);
+
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+    assert(s_CaptureWriter == nullptr && "GL capture is started already");
+
+    s_CaptureWriter      = std::make_unique<GlCaptureWriter>(filePath);
+    s_CaptureFilePath    = filePath;
+    s_RealLoader         = realLoader;
+    s_RecordedCallCount  = 0;
+    s_RecordedFrameCount = 0;
+
+    LOG_INFO<< "Capturing GL calls into " << filePath;
+}
+
+void * GetRecordingGlProcAddress(const char * const name)
+{
+    assert(s_RealLoader != nullptr && "GL capture must be started before loading");
+
+    void * const realProc = s_RealLoader(name);
+
+#define LEARNOPENGL_GET_RECORDING_GL_FUNCTION(function)                                                 \
+    if (std::strcmp(name, "gl" #function) == 0)                                                        \
+    {                                                                                                   \
+        s_Real##function = reinterpret_cast<decltype(s_Real##function)>(realProc);                     \
+                                                                                                        \
+        return realProc != nullptr ? GetRecorder<GlFunction::function, s_Real##function>() : nullptr;  \
+    }
+
+    LEARNOPENGL_BACKEND_GL_FUNCTIONS(LEARNOPENGL_GET_RECORDING_GL_FUNCTION)
+#undef LEARNOPENGL_GET_RECORDING_GL_FUNCTION
+
+    return realProc;
+}
+
+void MarkGlCaptureFrameEnd()
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    if (s_CaptureWriter == nullptr)
+        return;
+
+    s_CaptureWriter->WriteFrameEnd();
+    s_CaptureWriter->Flush();
+
+    s_RecordedFrameCount++;
+}
+
+void LogGlCaptureSummary()
+{
+    const std::lock_guard<std::mutex> lock(s_CaptureMutex);
+
+    if (s_CaptureWriter == nullptr)
+        return;
+
+    // Calls made after this, e.g. during teardown, still get captured.
+    s_CaptureWriter->Flush();
+
+    LOG_INFO<< "Captured " << s_RecordedCallCount << " GL calls of " << s_RecordedFrameCount
+        << " frames into " << s_CaptureFilePath;
+}
+
+//
+// Service
+//
+
+// Must be called while holding the capture mutex.
+static bool WriteUnpackBufferOffset(const void * const pixels)
+{
+    // Queried straight from the driver, so that the queries don't end up in the capture.
+    GLint unpackBuffer = 0;
+    s_RealGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpackBuffer);
+
+    // With an unpack buffer bound, pixels is an offset into it, and the buffer's contents are captured already.
+    s_CaptureWriter->Write(unpackBuffer != 0);
+
+    if (unpackBuffer != 0)
+        s_CaptureWriter->Write(pixels);
+
+    return unpackBuffer != 0;
+}
+
+// Must be called while holding the capture mutex.
+static void WriteUnpackedPixels(
+    const GLsizei      width,
+    const GLsizei      height,
+    const GLenum       format,
+    const GLenum       type,
+    const void * const pixels
+)
+{
+    if (WriteUnpackBufferOffset(pixels))
+        return;
+
+    GLint rowAlignment = 4;
+    s_RealGetIntegerv(GL_UNPACK_ALIGNMENT, &rowAlignment);
+
+    s_CaptureWriter->Write(pixels != nullptr);
+
+    if (pixels != nullptr)
+        s_CaptureWriter->WriteBlob(pixels, GetPixelDataSize(width, height, format, type, rowAlignment));
+}
+
+static size_t GetPixelDataSize(
+    const GLsizei width,
+    const GLsizei height,
+    const GLenum  format,
+    const GLenum  type,
+    const GLint   rowAlignment
+)
+{
+    size_t componentCount = 0;
+
+    switch (format)
+    {
+    case GL_RED:
+    case GL_DEPTH_COMPONENT:
+    case GL_DEPTH_STENCIL:
+        componentCount = 1;
+        break;
+    case GL_RG:
+        componentCount = 2;
+        break;
+    case GL_RGB:
+    case GL_BGR:
+        componentCount = 3;
+        break;
+    case GL_RGBA:
+    case GL_BGRA:
+        componentCount = 4;
+        break;
+    default:
+        assert(false && "unsupported pixel format");
+        break;
+    }
+
+    size_t componentSize = 0;
+
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+        componentSize = 1;
+        break;
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+        componentSize = 2;
+        break;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+        componentSize = 4;
+        break;
+    // Packed types hold a whole pixel
+    case GL_UNSIGNED_INT_24_8:
+        componentSize  = 4;
+        componentCount = 1;
+        break;
+    default:
+        assert(false && "unsupported pixel type");
+        break;
+    }
+
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    // The last row isn't padded to the alignment, so it may end right at the end of the app's pixels.
+    const size_t alignment      = static_cast<size_t>(rowAlignment);
+    const size_t rowSize        = componentCount*componentSize*static_cast<size_t>(width);
+    const size_t alignedRowSize = (rowSize + alignment - 1) / alignment * alignment;
+
+    return alignedRowSize*static_cast<size_t>(height - 1) + rowSize;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+#include <glad/glad.h>
+
+//
+// Utilities
+//
+
+// Opens the capture file, throwing GlCaptureException on failure. Functions of the capture
+// are loaded through realLoader, the one of the native backend.
+void StartGlCapture(const std::string & filePath, const GLADloadproc realLoader);
+
+// GLAD loader of the recording backend. Functions of LEARNOPENGL_BACKEND_GL_FUNCTIONS are wrapped
+// with recorders appending the call and everything needed to reissue it to the capture;
+// any other function is returned unwrapped.
+void * GetRecordingGlProcAddress(const char * const name);
+
+// Appends a frame end marker and flushes the capture, so that it's usable even if the app dies later.
+// Does nothing unless capturing.
+void MarkGlCaptureFrameEnd();
+
+void LogGlCaptureSummary();
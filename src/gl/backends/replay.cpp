@@ -0,0 +1,940 @@
+#include "replay.h"
+
+#include <cassert>
+#include <cstring>
+#include <tuple>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+#include "logging.h"
+
+//
+// Constants
+//
+
+// Large enough for any query result of the captured functions, e.g. GL_VIEWPORT.
+static constexpr size_t QUERY_SCRATCH_SIZE = 16;
+
+//
+// Construction
+//
+
+GlCaptureReplayer::GlCaptureReplayer(const std::string & filePath):
+    m_Reader             (filePath),
+    m_SetupCalls         (),
+    m_FrameCalls         (),
+    m_TeardownCalls      (),
+    m_Names              (),
+    m_Syncs              (),
+    m_UniformLocations   (),
+    m_UniformBlockIndices(),
+    m_CurrentProgram     (0),
+    m_MappedBuffers      (),
+    m_ReplayedCallCount  (0)
+{
+    Decode();
+
+    LOG_INFO<< "Decoded GL capture " << filePath << " with " << m_SetupCalls.size() << " setup calls, "
+        << m_FrameCalls.size() << " frames and " << m_TeardownCalls.size() << " teardown calls";
+}
+
+//
+// Interface
+//
+
+size_t GlCaptureReplayer::GetFrameCount() const
+{
+    return m_FrameCalls.size();
+}
+
+void GlCaptureReplayer::ReplaySetup()
+{
+    ReplayCalls(m_SetupCalls);
+}
+
+void GlCaptureReplayer::ReplayFrame(const size_t frameIdx)
+{
+    assert(frameIdx < m_FrameCalls.size());
+
+    ReplayCalls(m_FrameCalls[frameIdx]);
+}
+
+void GlCaptureReplayer::ReplayTeardown()
+{
+    ReplayCalls(m_TeardownCalls);
+}
+
+uint64_t GlCaptureReplayer::GetReplayedCallCount() const
+{
+    return m_ReplayedCallCount;
+}
+
+//
+// Service
+//
+
+void GlCaptureReplayer::Decode()
+{
+    std::vector<ReplayedCall> calls;
+    bool                      isSetupDecoded = false;
+
+    while (!m_Reader.IsAtEnd())
+    {
+        const GlCaptureRecord record = m_Reader.ReadRecord();
+
+        if (record.Type == GlCaptureRecordType::Call)
+        {
+            calls.push_back(DecodeCall(record.Function));
+
+            continue;
+        }
+
+        if (isSetupDecoded)
+            m_FrameCalls.push_back(std::move(calls));
+        else
+            m_SetupCalls = std::move(calls);
+
+        isSetupDecoded = true;
+        calls.clear();
+    }
+
+    if (!isSetupDecoded)
+        throw GlCaptureException("GL capture has no complete frames");
+
+    m_TeardownCalls = std::move(calls);
+}
+
+GlCaptureReplayer::ReplayedCall GlCaptureReplayer::DecodeCall(const GlFunction function)
+{
+    switch (function)
+    {
+    case GlFunction::ActiveTexture:
+        return DecodeUnchangedCall(glad_glActiveTexture);
+
+    case GlFunction::AttachShader:
+    {
+        const GLuint program = m_Reader.Read<GLuint>();
+        const GLuint shader  = m_Reader.Read<GLuint>();
+
+        return [this, program, shader]
+        {
+            glad_glAttachShader(MapName(NameKind::ShaderObject, program), MapName(NameKind::ShaderObject, shader));
+        };
+    }
+
+    case GlFunction::BindBuffer:
+    {
+        const GLenum target = m_Reader.Read<GLenum>();
+        const GLuint buffer = m_Reader.Read<GLuint>();
+
+        return [this, target, buffer] { glad_glBindBuffer(target, MapName(NameKind::Buffer, buffer)); };
+    }
+
+    case GlFunction::BindBufferRange:
+    {
+        const GLenum     target = m_Reader.Read<GLenum>();
+        const GLuint     index  = m_Reader.Read<GLuint>();
+        const GLuint     buffer = m_Reader.Read<GLuint>();
+        const GLintptr   offset = m_Reader.Read<GLintptr>();
+        const GLsizeiptr size   = m_Reader.Read<GLsizeiptr>();
+
+        return [this, target, index, buffer, offset, size]
+        {
+            glad_glBindBufferRange(target, index, MapName(NameKind::Buffer, buffer), offset, size);
+        };
+    }
+
+    case GlFunction::BindFramebuffer:
+    {
+        const GLenum target      = m_Reader.Read<GLenum>();
+        const GLuint framebuffer = m_Reader.Read<GLuint>();
+
+        return [this, target, framebuffer] { glad_glBindFramebuffer(target, MapName(NameKind::Framebuffer, framebuffer)); };
+    }
+
+    case GlFunction::BindRenderbuffer:
+    {
+        const GLenum target       = m_Reader.Read<GLenum>();
+        const GLuint renderbuffer = m_Reader.Read<GLuint>();
+
+        return [this, target, renderbuffer] { glad_glBindRenderbuffer(target, MapName(NameKind::Renderbuffer, renderbuffer)); };
+    }
+
+    case GlFunction::BindTexture:
+    {
+        const GLenum target  = m_Reader.Read<GLenum>();
+        const GLuint texture = m_Reader.Read<GLuint>();
+
+        return [this, target, texture] { glad_glBindTexture(target, MapName(NameKind::Texture, texture)); };
+    }
+
+    case GlFunction::BindVertexArray:
+    {
+        const GLuint array = m_Reader.Read<GLuint>();
+
+        return [this, array] { glad_glBindVertexArray(MapName(NameKind::VertexArray, array)); };
+    }
+
+    case GlFunction::BlendFunc:
+        return DecodeUnchangedCall(glad_glBlendFunc);
+
+    case GlFunction::BufferData:
+    {
+        const GLenum     target  = m_Reader.Read<GLenum>();
+        const GLsizeiptr size    = m_Reader.Read<GLsizeiptr>();
+        const GLenum     usage   = m_Reader.Read<GLenum>();
+        const bool       hasData = m_Reader.Read<bool>();
+        const uint8_t *  data    = hasData ? m_Reader.ReadBlob().first : nullptr;
+
+        return [target, size, data, usage] { glad_glBufferData(target, size, data, usage); };
+    }
+
+    case GlFunction::CheckFramebufferStatus:
+        return DecodeUnchangedCall(glad_glCheckFramebufferStatus);
+
+    case GlFunction::Clear:
+        return DecodeUnchangedCall(glad_glClear);
+
+    case GlFunction::ClearColor:
+        return DecodeUnchangedCall(glad_glClearColor);
+
+    case GlFunction::ClientWaitSync:
+    {
+        const uint64_t   sync    = m_Reader.Read<uint64_t>();
+        const GLbitfield flags   = m_Reader.Read<GLbitfield>();
+        const GLuint64   timeout = m_Reader.Read<GLuint64>();
+        m_Reader.Read<GLenum>();
+
+        return [this, sync, flags, timeout]
+        {
+            const auto syncIt = m_Syncs.find(sync);
+
+            if (syncIt != m_Syncs.cend())
+                glad_glClientWaitSync(syncIt->second, flags, timeout);
+        };
+    }
+
+    case GlFunction::CompileShader:
+    {
+        const GLuint shader = m_Reader.Read<GLuint>();
+
+        return [this, shader] { glad_glCompileShader(MapName(NameKind::ShaderObject, shader)); };
+    }
+
+    case GlFunction::CompressedTexImage2D:
+    {
+        const GLenum  target         = m_Reader.Read<GLenum>();
+        const GLint   level          = m_Reader.Read<GLint>();
+        const GLenum  internalFormat = m_Reader.Read<GLenum>();
+        const GLsizei width          = m_Reader.Read<GLsizei>();
+        const GLsizei height         = m_Reader.Read<GLsizei>();
+        const GLint   border         = m_Reader.Read<GLint>();
+        const GLsizei imageSize      = m_Reader.Read<GLsizei>();
+        const void *  data           = DecodePixels();
+
+        return [target, level, internalFormat, width, height, border, imageSize, data]
+        {
+            glad_glCompressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data);
+        };
+    }
+
+    case GlFunction::CreateProgram:
+    {
+        const GLuint program = m_Reader.Read<GLuint>();
+
+        return [this, program] { AddName(NameKind::ShaderObject, program, glad_glCreateProgram()); };
+    }
+
+    case GlFunction::CreateShader:
+    {
+        const GLenum type   = m_Reader.Read<GLenum>();
+        const GLuint shader = m_Reader.Read<GLuint>();
+
+        return [this, type, shader] { AddName(NameKind::ShaderObject, shader, glad_glCreateShader(type)); };
+    }
+
+    case GlFunction::DeleteBuffers:
+        return DecodeNameDeletion(NameKind::Buffer, glad_glDeleteBuffers);
+
+    case GlFunction::DeleteFramebuffers:
+        return DecodeNameDeletion(NameKind::Framebuffer, glad_glDeleteFramebuffers);
+
+    case GlFunction::DeleteProgram:
+    {
+        const GLuint program = m_Reader.Read<GLuint>();
+
+        return [this, program]
+        {
+            glad_glDeleteProgram(MapName(NameKind::ShaderObject, program));
+            RemoveName(NameKind::ShaderObject, program);
+
+            m_UniformLocations.erase(program);
+            m_UniformBlockIndices.erase(program);
+        };
+    }
+
+    case GlFunction::DeleteQueries:
+        return DecodeNameDeletion(NameKind::Query, glad_glDeleteQueries);
+
+    case GlFunction::DeleteRenderbuffers:
+        return DecodeNameDeletion(NameKind::Renderbuffer, glad_glDeleteRenderbuffers);
+
+    case GlFunction::DeleteShader:
+    {
+        const GLuint shader = m_Reader.Read<GLuint>();
+
+        return [this, shader]
+        {
+            glad_glDeleteShader(MapName(NameKind::ShaderObject, shader));
+            RemoveName(NameKind::ShaderObject, shader);
+        };
+    }
+
+    case GlFunction::DeleteSync:
+    {
+        const uint64_t sync = m_Reader.Read<uint64_t>();
+
+        return [this, sync]
+        {
+            const auto syncIt = m_Syncs.find(sync);
+
+            if (syncIt == m_Syncs.cend())
+                return;
+
+            glad_glDeleteSync(syncIt->second);
+            m_Syncs.erase(syncIt);
+        };
+    }
+
+    case GlFunction::DeleteTextures:
+        return DecodeNameDeletion(NameKind::Texture, glad_glDeleteTextures);
+
+    case GlFunction::DeleteVertexArrays:
+        return DecodeNameDeletion(NameKind::VertexArray, glad_glDeleteVertexArrays);
+
+    case GlFunction::DrawArrays:
+        return DecodeUnchangedCall(glad_glDrawArrays);
+
+    case GlFunction::DrawElements:
+        return DecodeUnchangedCall(glad_glDrawElements);
+
+    case GlFunction::Enable:
+        return DecodeUnchangedCall(glad_glEnable);
+
+    case GlFunction::EnableVertexAttribArray:
+        return DecodeUnchangedCall(glad_glEnableVertexAttribArray);
+
+    case GlFunction::FenceSync:
+    {
+        const GLenum     condition = m_Reader.Read<GLenum>();
+        const GLbitfield flags     = m_Reader.Read<GLbitfield>();
+        const uint64_t   sync      = m_Reader.Read<uint64_t>();
+
+        return [this, condition, flags, sync]
+        {
+            GLsync & replayedSync = m_Syncs[sync];
+
+            // Created by an earlier replay of this frame, with its deletion in frames not replayed since.
+            if (replayedSync != nullptr)
+                glad_glDeleteSync(replayedSync);
+
+            replayedSync = glad_glFenceSync(condition, flags);
+        };
+    }
+
+    case GlFunction::Flush:
+        return DecodeUnchangedCall(glad_glFlush);
+
+    case GlFunction::FlushMappedBufferRange:
+    {
+        const GLenum     target = m_Reader.Read<GLenum>();
+        const GLintptr   offset = m_Reader.Read<GLintptr>();
+        const GLsizeiptr length = m_Reader.Read<GLsizeiptr>();
+        const uint8_t *  data   = m_Reader.ReadBlob().first;
+
+        return [this, target, offset, length, data]
+        {
+            const auto mappingIt = m_MappedBuffers.find(target);
+
+            if (mappingIt == m_MappedBuffers.cend())
+                return;
+
+            std::memcpy(mappingIt->second + offset, data, static_cast<size_t>(length));
+            glad_glFlushMappedBufferRange(target, offset, length);
+        };
+    }
+
+    case GlFunction::FramebufferRenderbuffer:
+    {
+        const GLenum target             = m_Reader.Read<GLenum>();
+        const GLenum attachment         = m_Reader.Read<GLenum>();
+        const GLenum renderbufferTarget = m_Reader.Read<GLenum>();
+        const GLuint renderbuffer       = m_Reader.Read<GLuint>();
+
+        return [this, target, attachment, renderbufferTarget, renderbuffer]
+        {
+            glad_glFramebufferRenderbuffer(
+                target,
+                attachment,
+                renderbufferTarget,
+                MapName(NameKind::Renderbuffer, renderbuffer)
+            );
+        };
+    }
+
+    case GlFunction::GenBuffers:
+        return DecodeNameGeneration(NameKind::Buffer, glad_glGenBuffers);
+
+    case GlFunction::GenFramebuffers:
+        return DecodeNameGeneration(NameKind::Framebuffer, glad_glGenFramebuffers);
+
+    case GlFunction::GenQueries:
+        return DecodeNameGeneration(NameKind::Query, glad_glGenQueries);
+
+    case GlFunction::GenRenderbuffers:
+        return DecodeNameGeneration(NameKind::Renderbuffer, glad_glGenRenderbuffers);
+
+    case GlFunction::GenTextures:
+        return DecodeNameGeneration(NameKind::Texture, glad_glGenTextures);
+
+    case GlFunction::GenVertexArrays:
+        return DecodeNameGeneration(NameKind::VertexArray, glad_glGenVertexArrays);
+
+    case GlFunction::GenerateMipmap:
+        return DecodeUnchangedCall(glad_glGenerateMipmap);
+
+    // Queries are reissued for their cost, into scratch storage instead of the captured output pointers.
+    case GlFunction::GetInteger64v:
+    {
+        const GLenum pname = m_Reader.Read<GLenum>();
+        m_Reader.Read<GLint64 *>();
+
+        return [pname]
+        {
+            std::array<GLint64, QUERY_SCRATCH_SIZE> scratch{};
+            glad_glGetInteger64v(pname, scratch.data());
+        };
+    }
+
+    case GlFunction::GetIntegerv:
+    {
+        const GLenum pname = m_Reader.Read<GLenum>();
+        m_Reader.Read<GLint *>();
+
+        return [pname]
+        {
+            std::array<GLint, QUERY_SCRATCH_SIZE> scratch{};
+            glad_glGetIntegerv(pname, scratch.data());
+        };
+    }
+
+    case GlFunction::GetProgramInfoLog:
+    {
+        const GLuint  program = m_Reader.Read<GLuint>();
+        const GLsizei bufSize = m_Reader.Read<GLsizei>();
+        m_Reader.Read<GLsizei *>();
+        m_Reader.Read<GLchar *>();
+
+        return [this, program, bufSize]
+        {
+            std::vector<GLchar> scratch(static_cast<size_t>(std::max(bufSize, 1)));
+            glad_glGetProgramInfoLog(MapName(NameKind::ShaderObject, program), bufSize, nullptr, scratch.data());
+        };
+    }
+
+    case GlFunction::GetProgramiv:
+    {
+        const GLuint program = m_Reader.Read<GLuint>();
+        const GLenum pname   = m_Reader.Read<GLenum>();
+        m_Reader.Read<GLint *>();
+
+        return [this, program, pname]
+        {
+            GLint scratch = 0;
+            glad_glGetProgramiv(MapName(NameKind::ShaderObject, program), pname, &scratch);
+        };
+    }
+
+    case GlFunction::GetQueryObjectiv:
+    {
+        const GLuint id    = m_Reader.Read<GLuint>();
+        const GLenum pname = m_Reader.Read<GLenum>();
+        m_Reader.Read<GLint *>();
+
+        return [this, id, pname]
+        {
+            GLint scratch = 0;
+            glad_glGetQueryObjectiv(MapName(NameKind::Query, id), pname, &scratch);
+        };
+    }
+
+    case GlFunction::GetQueryObjectui64v:
+    {
+        const GLuint id    = m_Reader.Read<GLuint>();
+        const GLenum pname = m_Reader.Read<GLenum>();
+        m_Reader.Read<GLuint64 *>();
+
+        return [this, id, pname]
+        {
+            const GLuint replayedId = MapName(NameKind::Query, id);
+
+            // The capturing app checked availability first, but results may be late at a different point
+            // in the replay, and waiting for them would stall the measured frame.
+            if (pname == GL_QUERY_RESULT)
+            {
+                GLint isAvailable = GL_FALSE;
+                glad_glGetQueryObjectiv(replayedId, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+                if (isAvailable == GL_FALSE)
+                    return;
+            }
+
+            GLuint64 scratch = 0;
+            glad_glGetQueryObjectui64v(replayedId, pname, &scratch);
+        };
+    }
+
+    case GlFunction::GetShaderInfoLog:
+    {
+        const GLuint  shader  = m_Reader.Read<GLuint>();
+        const GLsizei bufSize = m_Reader.Read<GLsizei>();
+        m_Reader.Read<GLsizei *>();
+        m_Reader.Read<GLchar *>();
+
+        return [this, shader, bufSize]
+        {
+            std::vector<GLchar> scratch(static_cast<size_t>(std::max(bufSize, 1)));
+            glad_glGetShaderInfoLog(MapName(NameKind::ShaderObject, shader), bufSize, nullptr, scratch.data());
+        };
+    }
+
+    case GlFunction::GetShaderiv:
+    {
+        const GLuint shader = m_Reader.Read<GLuint>();
+        const GLenum pname  = m_Reader.Read<GLenum>();
+        m_Reader.Read<GLint *>();
+
+        return [this, shader, pname]
+        {
+            GLint scratch = 0;
+            glad_glGetShaderiv(MapName(NameKind::ShaderObject, shader), pname, &scratch);
+        };
+    }
+
+    case GlFunction::GetUniformBlockIndex:
+    {
+        const GLuint      program    = m_Reader.Read<GLuint>();
+        const std::string blockName  = m_Reader.ReadString();
+        const GLuint      blockIndex = m_Reader.Read<GLuint>();
+
+        return [this, program, blockName, blockIndex]
+        {
+            m_UniformBlockIndices[program][blockIndex] = glad_glGetUniformBlockIndex(
+                MapName(NameKind::ShaderObject, program),
+                blockName.c_str()
+            );
+        };
+    }
+
+    case GlFunction::GetUniformLocation:
+    {
+        const GLuint      program     = m_Reader.Read<GLuint>();
+        const std::string uniformName = m_Reader.ReadString();
+        const GLint       location    = m_Reader.Read<GLint>();
+
+        return [this, program, uniformName, location]
+        {
+            m_UniformLocations[program][location] = glad_glGetUniformLocation(
+                MapName(NameKind::ShaderObject, program),
+                uniformName.c_str()
+            );
+        };
+    }
+
+    case GlFunction::LinkProgram:
+    {
+        const GLuint program = m_Reader.Read<GLuint>();
+
+        return [this, program] { glad_glLinkProgram(MapName(NameKind::ShaderObject, program)); };
+    }
+
+    case GlFunction::MapBufferRange:
+    {
+        const GLenum     target = m_Reader.Read<GLenum>();
+        const GLintptr   offset = m_Reader.Read<GLintptr>();
+        const GLsizeiptr length = m_Reader.Read<GLsizeiptr>();
+        const GLbitfield access = m_Reader.Read<GLbitfield>();
+
+        return [this, target, offset, length, access]
+        {
+            m_MappedBuffers[target] = static_cast<std::byte *>(glad_glMapBufferRange(target, offset, length, access));
+        };
+    }
+
+    case GlFunction::PolygonMode:
+        return DecodeUnchangedCall(glad_glPolygonMode);
+
+    case GlFunction::QueryCounter:
+    {
+        const GLuint id     = m_Reader.Read<GLuint>();
+        const GLenum target = m_Reader.Read<GLenum>();
+
+        return [this, id, target] { glad_glQueryCounter(MapName(NameKind::Query, id), target); };
+    }
+
+    case GlFunction::RenderbufferStorage:
+        return DecodeUnchangedCall(glad_glRenderbufferStorage);
+
+    case GlFunction::ShaderSource:
+    {
+        const GLuint  shader = m_Reader.Read<GLuint>();
+        const GLsizei count  = m_Reader.Read<GLsizei>();
+
+        std::vector<std::string> strings;
+
+        for (GLsizei stringIdx = 0; stringIdx < count; stringIdx++)
+            strings.push_back(m_Reader.ReadString());
+
+        return [this, shader, strings = std::move(strings)]
+        {
+            std::vector<const GLchar *> stringPointers;
+            std::vector<GLint>          lengths;
+
+            for (const std::string & string : strings)
+            {
+                stringPointers.push_back(string.data());
+                lengths.push_back(static_cast<GLint>(string.size()));
+            }
+
+            glad_glShaderSource(
+                MapName(NameKind::ShaderObject, shader),
+                static_cast<GLsizei>(strings.size()),
+                stringPointers.data(),
+                lengths.data()
+            );
+        };
+    }
+
+    case GlFunction::TexImage2D:
+    {
+        const GLenum  target         = m_Reader.Read<GLenum>();
+        const GLint   level          = m_Reader.Read<GLint>();
+        const GLint   internalFormat = m_Reader.Read<GLint>();
+        const GLsizei width          = m_Reader.Read<GLsizei>();
+        const GLsizei height         = m_Reader.Read<GLsizei>();
+        const GLint   border         = m_Reader.Read<GLint>();
+        const GLenum  format         = m_Reader.Read<GLenum>();
+        const GLenum  type           = m_Reader.Read<GLenum>();
+        const void *  pixels         = DecodePixels();
+
+        return [target, level, internalFormat, width, height, border, format, type, pixels]
+        {
+            glad_glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+        };
+    }
+
+    case GlFunction::TexParameteri:
+        return DecodeUnchangedCall(glad_glTexParameteri);
+
+    case GlFunction::TexSubImage2D:
+    {
+        const GLenum  target  = m_Reader.Read<GLenum>();
+        const GLint   level   = m_Reader.Read<GLint>();
+        const GLint   xOffset = m_Reader.Read<GLint>();
+        const GLint   yOffset = m_Reader.Read<GLint>();
+        const GLsizei width   = m_Reader.Read<GLsizei>();
+        const GLsizei height  = m_Reader.Read<GLsizei>();
+        const GLenum  format  = m_Reader.Read<GLenum>();
+        const GLenum  type    = m_Reader.Read<GLenum>();
+        const void *  pixels  = DecodePixels();
+
+        return [target, level, xOffset, yOffset, width, height, format, type, pixels]
+        {
+            glad_glTexSubImage2D(target, level, xOffset, yOffset, width, height, format, type, pixels);
+        };
+    }
+
+    case GlFunction::Uniform1f:
+    {
+        const GLint   location = m_Reader.Read<GLint>();
+        const GLfloat v0       = m_Reader.Read<GLfloat>();
+
+        return [this, location, v0] { glad_glUniform1f(MapUniformLocation(location), v0); };
+    }
+
+    case GlFunction::Uniform1i:
+    {
+        const GLint location = m_Reader.Read<GLint>();
+        const GLint v0       = m_Reader.Read<GLint>();
+
+        return [this, location, v0] { glad_glUniform1i(MapUniformLocation(location), v0); };
+    }
+
+    case GlFunction::Uniform1ui:
+    {
+        const GLint  location = m_Reader.Read<GLint>();
+        const GLuint v0       = m_Reader.Read<GLuint>();
+
+        return [this, location, v0] { glad_glUniform1ui(MapUniformLocation(location), v0); };
+    }
+
+    case GlFunction::Uniform2f:
+    {
+        const GLint   location = m_Reader.Read<GLint>();
+        const GLfloat v0       = m_Reader.Read<GLfloat>();
+        const GLfloat v1       = m_Reader.Read<GLfloat>();
+
+        return [this, location, v0, v1] { glad_glUniform2f(MapUniformLocation(location), v0, v1); };
+    }
+
+    case GlFunction::Uniform3f:
+    {
+        const GLint   location = m_Reader.Read<GLint>();
+        const GLfloat v0       = m_Reader.Read<GLfloat>();
+        const GLfloat v1       = m_Reader.Read<GLfloat>();
+        const GLfloat v2       = m_Reader.Read<GLfloat>();
+
+        return [this, location, v0, v1, v2] { glad_glUniform3f(MapUniformLocation(location), v0, v1, v2); };
+    }
+
+    case GlFunction::Uniform4f:
+    {
+        const GLint   location = m_Reader.Read<GLint>();
+        const GLfloat v0       = m_Reader.Read<GLfloat>();
+        const GLfloat v1       = m_Reader.Read<GLfloat>();
+        const GLfloat v2       = m_Reader.Read<GLfloat>();
+        const GLfloat v3       = m_Reader.Read<GLfloat>();
+
+        return [this, location, v0, v1, v2, v3] { glad_glUniform4f(MapUniformLocation(location), v0, v1, v2, v3); };
+    }
+
+    case GlFunction::UniformBlockBinding:
+    {
+        const GLuint program    = m_Reader.Read<GLuint>();
+        const GLuint blockIndex = m_Reader.Read<GLuint>();
+        const GLuint binding    = m_Reader.Read<GLuint>();
+
+        return [this, program, blockIndex, binding]
+        {
+            GLuint replayedBlockIndex = blockIndex;
+
+            if (const auto programIt = m_UniformBlockIndices.find(program); programIt != m_UniformBlockIndices.cend())
+            {
+                const auto blockIt = programIt->second.find(blockIndex);
+
+                if (blockIt != programIt->second.cend())
+                    replayedBlockIndex = blockIt->second;
+            }
+
+            glad_glUniformBlockBinding(MapName(NameKind::ShaderObject, program), replayedBlockIndex, binding);
+        };
+    }
+
+    case GlFunction::UniformMatrix4fv:
+    {
+        const GLint     location  = m_Reader.Read<GLint>();
+        const GLsizei   count     = m_Reader.Read<GLsizei>();
+        const GLboolean transpose = m_Reader.Read<GLboolean>();
+        const uint8_t * value     = m_Reader.ReadBlob().first;
+
+        // Blobs aren't aligned in the capture, so the matrices are copied out once.
+        auto matrices = std::make_shared<std::vector<GLfloat>>(16*static_cast<size_t>(std::max(count, 0)));
+        std::memcpy(matrices->data(), value, matrices->size()*sizeof(GLfloat));
+
+        return [this, location, count, transpose, matrices]
+        {
+            glad_glUniformMatrix4fv(MapUniformLocation(location), count, transpose, matrices->data());
+        };
+    }
+
+    case GlFunction::UnmapBuffer:
+    {
+        const GLenum                              target = m_Reader.Read<GLenum>();
+        const std::pair<const uint8_t *, size_t> data   = m_Reader.ReadBlob();
+
+        return [this, target, data]
+        {
+            const auto mappingIt = m_MappedBuffers.find(target);
+
+            if (mappingIt == m_MappedBuffers.cend())
+                return;
+
+            if (data.second > 0 && mappingIt->second != nullptr)
+                std::memcpy(mappingIt->second, data.first, data.second);
+
+            glad_glUnmapBuffer(target);
+            m_MappedBuffers.erase(mappingIt);
+        };
+    }
+
+    case GlFunction::UseProgram:
+    {
+        const GLuint program = m_Reader.Read<GLuint>();
+
+        return [this, program]
+        {
+            glad_glUseProgram(MapName(NameKind::ShaderObject, program));
+            m_CurrentProgram = program;
+        };
+    }
+
+    case GlFunction::VertexAttribPointer:
+        return DecodeUnchangedCall(glad_glVertexAttribPointer);
+
+    case GlFunction::Viewport:
+        return DecodeUnchangedCall(glad_glViewport);
+
+    default:
+        throw GlCaptureException(std::string("Replay of ") + GlFunctionToCStr(function) + " isn't supported");
+    }
+}
+
+template <typename Result, typename... Args>
+GlCaptureReplayer::ReplayedCall GlCaptureReplayer::DecodeUnchangedCall(Result (APIENTRY * & function)(Args...))
+{
+    // Braced initialization reads the arguments in order.
+    const std::tuple<std::remove_cv_t<Args>...> arguments{m_Reader.Read<std::remove_cv_t<Args>>()...};
+
+    if constexpr (!std::is_void_v<Result>)
+        m_Reader.Read<Result>();
+
+    return [&function, arguments] { std::apply(function, arguments); };
+}
+
+GlCaptureReplayer::ReplayedCall GlCaptureReplayer::DecodeNameGeneration(
+    const NameKind kind,
+    void (APIENTRY * & function)(GLsizei, GLuint *)
+)
+{
+    const GLsizei count = m_Reader.Read<GLsizei>();
+
+    std::vector<GLuint> names;
+
+    for (GLsizei nameIdx = 0; nameIdx < count; nameIdx++)
+        names.push_back(m_Reader.Read<GLuint>());
+
+    return [this, kind, &function, names = std::move(names)]
+    {
+        std::vector<GLuint> replayedNames(names.size());
+        function(static_cast<GLsizei>(replayedNames.size()), replayedNames.data());
+
+        for (size_t nameIdx = 0; nameIdx < names.size(); nameIdx++)
+            AddName(kind, names[nameIdx], replayedNames[nameIdx]);
+    };
+}
+
+GlCaptureReplayer::ReplayedCall GlCaptureReplayer::DecodeNameDeletion(
+    const NameKind kind,
+    void (APIENTRY * & function)(GLsizei, const GLuint *)
+)
+{
+    const GLsizei count = m_Reader.Read<GLsizei>();
+
+    std::vector<GLuint> names;
+
+    for (GLsizei nameIdx = 0; nameIdx < count; nameIdx++)
+        names.push_back(m_Reader.Read<GLuint>());
+
+    return [this, kind, &function, names = std::move(names)]
+    {
+        std::vector<GLuint> replayedNames;
+
+        for (const GLuint name : names)
+        {
+            replayedNames.push_back(MapName(kind, name));
+            RemoveName(kind, name);
+        }
+
+        function(static_cast<GLsizei>(replayedNames.size()), replayedNames.data());
+    };
+}
+
+const void * GlCaptureReplayer::DecodePixels()
+{
+    if (m_Reader.Read<bool>())
+        return m_Reader.Read<const void *>();
+
+    if (m_Reader.Read<bool>())
+        return m_Reader.ReadBlob().first;
+
+    return nullptr;
+}
+
+void GlCaptureReplayer::ReplayCalls(const std::vector<ReplayedCall> & calls)
+{
+    for (const ReplayedCall & call : calls)
+        call();
+
+    m_ReplayedCallCount += calls.size();
+}
+
+GLuint GlCaptureReplayer::MapName(const NameKind kind, const GLuint name) const
+{
+    const std::unordered_map<GLuint, GLuint> & names = m_Names[static_cast<size_t>(kind)];
+
+    const auto nameIt = names.find(name);
+
+    return nameIt != names.cend() ? nameIt->second : name;
+}
+
+void GlCaptureReplayer::AddName(const NameKind kind, const GLuint name, const GLuint replayedName)
+{
+    std::unordered_map<GLuint, GLuint> & names = m_Names[static_cast<size_t>(kind)];
+
+    const auto [nameIt, isInserted] = names.try_emplace(name, replayedName);
+
+    if (isInserted)
+        return;
+
+    switch (kind)
+    {
+    case NameKind::Buffer:
+        glad_glDeleteBuffers(1, &nameIt->second);
+        break;
+    case NameKind::Framebuffer:
+        glad_glDeleteFramebuffers(1, &nameIt->second);
+        break;
+    case NameKind::Query:
+        glad_glDeleteQueries(1, &nameIt->second);
+        break;
+    case NameKind::Renderbuffer:
+        glad_glDeleteRenderbuffers(1, &nameIt->second);
+        break;
+    case NameKind::Texture:
+        glad_glDeleteTextures(1, &nameIt->second);
+        break;
+    case NameKind::VertexArray:
+        glad_glDeleteVertexArrays(1, &nameIt->second);
+        break;
+    case NameKind::ShaderObject:
+        // Either call flags the name for deletion, depending on what it names.
+        if (glad_glIsProgram(nameIt->second))
+            glad_glDeleteProgram(nameIt->second);
+        else
+            glad_glDeleteShader(nameIt->second);
+        break;
+    default:
+        assert(false && "unrecognized name kind");
+        break;
+    }
+
+    nameIt->second = replayedName;
+}
+
+void GlCaptureReplayer::RemoveName(const NameKind kind, const GLuint name)
+{
+    m_Names[static_cast<size_t>(kind)].erase(name);
+}
+
+GLint GlCaptureReplayer::MapUniformLocation(const GLint location) const
+{
+    const auto programIt = m_UniformLocations.find(m_CurrentProgram);
+
+    if (programIt == m_UniformLocations.cend())
+        return location;
+
+    const auto locationIt = programIt->second.find(location);
+
+    return locationIt != programIt->second.cend() ? locationIt->second : location;
+}
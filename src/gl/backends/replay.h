@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <functional>
+
+#include <glad/glad.h>
+
+#include "capture_stream.h"
+
+//
+// GlCaptureReplayer
+//
+
+// Reissues the calls of a capture made with the recording backend against the current context.
+// The whole capture is decoded on construction, so that replay only measures the cost of the calls.
+// Calls go straight to the driver, bypassing GLAD debug callbacks and render statistics.
+//
+// A capture is split at its frame end markers: setup is everything up to the first marker, including
+// the first frame, which can't be told apart from the resource creation preceding it. Frames follow,
+// and teardown is what's left after the last marker. Frames may be replayed repeatedly, in order.
+class GlCaptureReplayer final
+{
+public: // Construction
+
+    explicit GlCaptureReplayer(const std::string & filePath);
+
+public: // Copy / Move
+
+    // Decoded calls refer to the replayer.
+    GlCaptureReplayer(const GlCaptureReplayer &) = delete;
+
+    GlCaptureReplayer(GlCaptureReplayer &&) = delete;
+
+    GlCaptureReplayer & operator=(const GlCaptureReplayer &) = delete;
+
+    GlCaptureReplayer & operator=(GlCaptureReplayer &&) = delete;
+
+public: // Interface
+
+    size_t GetFrameCount() const;
+
+    void ReplaySetup();
+
+    void ReplayFrame(const size_t frameIdx);
+
+    void ReplayTeardown();
+
+    uint64_t GetReplayedCallCount() const;
+
+private: // Service types
+
+    enum class NameKind: uint8_t
+    {
+        Buffer,
+        Framebuffer,
+        Query,
+        Renderbuffer,
+        Texture,
+        VertexArray,
+        // Programs and shaders share a namespace.
+        ShaderObject,
+
+        Count
+    };
+
+    using ReplayedCall = std::function<void()>;
+
+private: // Service
+
+    void Decode();
+
+    ReplayedCall DecodeCall(const GlFunction function);
+
+    template <typename Result, typename... Args>
+    ReplayedCall DecodeUnchangedCall(Result (APIENTRY * & function)(Args...));
+
+    ReplayedCall DecodeNameGeneration(const NameKind kind, void (APIENTRY * & function)(GLsizei, GLuint *));
+
+    ReplayedCall DecodeNameDeletion(const NameKind kind, void (APIENTRY * & function)(GLsizei, const GLuint *));
+
+    // Either an offset into the bound unpack buffer or captured pixels, which live as long as the reader.
+    const void * DecodePixels();
+
+    void ReplayCalls(const std::vector<ReplayedCall> & calls);
+
+    // Names unknown to the capture, e.g. 0, are passed through unchanged.
+    GLuint MapName(const NameKind kind, const GLuint name) const;
+
+    // Deletes the object previously mapped to the captured name; it was created by an earlier replay
+    // of the same frame and not deleted since, as its deletion follows in frames not replayed yet.
+    void AddName(const NameKind kind, const GLuint name, const GLuint replayedName);
+
+    void RemoveName(const NameKind kind, const GLuint name);
+
+    GLint MapUniformLocation(const GLint location) const;
+
+private: // Members
+
+    GlCaptureReader m_Reader;
+
+    std::vector<ReplayedCall>              m_SetupCalls;
+    std::vector<std::vector<ReplayedCall>> m_FrameCalls;
+    std::vector<ReplayedCall>              m_TeardownCalls;
+
+    // Replay state, keyed by captured names
+    std::array<std::unordered_map<GLuint, GLuint>, static_cast<size_t>(NameKind::Count)> m_Names;
+    std::unordered_map<uint64_t, GLsync>                                                m_Syncs;
+    std::unordered_map<GLuint, std::unordered_map<GLint, GLint>>                        m_UniformLocations;
+    std::unordered_map<GLuint, std::unordered_map<GLuint, GLuint>>                      m_UniformBlockIndices;
+    GLuint                                                                              m_CurrentProgram;
+    std::unordered_map<GLenum, std::byte *>                                             m_MappedBuffers;
+    uint64_t                                                                            m_ReplayedCallCount;
+};
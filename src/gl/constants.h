@@ -6,5 +6,15 @@ constexpr GLuint INVALID_OPENGL_VAO     = 0;
 constexpr GLuint INVALID_OPENGL_BUFFER  = 0;
 constexpr GLuint INVALID_OPENGL_SHADER  = 0;
 constexpr GLuint INVALID_OPENGL_TEXTURE = 0;
+constexpr GLuint INVALID_OPENGL_QUERY   = 0;
+
+constexpr GLuint INVALID_OPENGL_FRAMEBUFFER  = 0;
+constexpr GLuint INVALID_OPENGL_RENDERBUFFER = 0;
+
+// Window system provided framebuffer
+constexpr GLuint DEFAULT_OPENGL_FRAMEBUFFER = 0;
 
 constexpr GLint INVALID_OPENGL_UNIFORM_LOCATION = -1;
+
+// The spec caps GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT at this value, so it satisfies every implementation.
+constexpr GLsizeiptr MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT = 256;
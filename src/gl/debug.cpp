@@ -0,0 +1,406 @@
+#include "debug.h"
+
+#include <cassert>
+#include <cstring>
+#include <array>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "backends/backend.h"
+#include "utils.h"
+#include "logging.h"
+#include "config.h"
+
+//
+// Constants
+//
+
+// GL_KHR_debug tokens, the ARB_debug_output ones have the same values.
+// GLAD is generated for GL 3.3 core without the extensions, hence the local definitions.
+static constexpr GLenum GL_DEBUG_OUTPUT_KHR                 = 0x92E0;
+static constexpr GLenum GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR     = 0x8242;
+static constexpr GLint  GL_CONTEXT_FLAG_DEBUG_BIT_KHR       = 0x00000002;
+static constexpr GLenum GL_DEBUG_SOURCE_API_KHR             = 0x8246;
+static constexpr GLenum GL_DEBUG_SOURCE_WINDOW_SYSTEM_KHR   = 0x8247;
+static constexpr GLenum GL_DEBUG_SOURCE_SHADER_COMPILER_KHR = 0x8248;
+static constexpr GLenum GL_DEBUG_SOURCE_THIRD_PARTY_KHR     = 0x8249;
+static constexpr GLenum GL_DEBUG_SOURCE_APPLICATION_KHR     = 0x824A;
+static constexpr GLenum GL_DEBUG_TYPE_ERROR_KHR             = 0x824C;
+static constexpr GLenum GL_DEBUG_TYPE_DEPRECATED_KHR        = 0x824D;
+static constexpr GLenum GL_DEBUG_TYPE_UNDEFINED_KHR         = 0x824E;
+static constexpr GLenum GL_DEBUG_TYPE_PORTABILITY_KHR       = 0x824F;
+static constexpr GLenum GL_DEBUG_TYPE_PERFORMANCE_KHR       = 0x8250;
+static constexpr GLenum GL_DEBUG_TYPE_MARKER_KHR            = 0x8268;
+static constexpr GLenum GL_DEBUG_SEVERITY_HIGH_KHR          = 0x9146;
+static constexpr GLenum GL_DEBUG_SEVERITY_MEDIUM_KHR        = 0x9147;
+static constexpr GLenum GL_DEBUG_SEVERITY_LOW_KHR           = 0x9148;
+static constexpr GLenum GL_DEBUG_SEVERITY_NOTIFICATION_KHR  = 0x826B;
+
+// Distinct messages remembered for deduplication; later new ones are still rate limited, just not deduplicated.
+static constexpr size_t MAX_TRACKED_GL_DEBUG_MESSAGE_COUNT = 4096;
+
+//
+// Service types
+//
+
+using PFNGLDEBUGMESSAGECALLBACKKHRPROC = void (APIENTRY *)(GLDEBUGPROCKHR callback, const void * userParam);
+using PFNGLDEBUGMESSAGECONTROLKHRPROC  = void (APIENTRY *)(
+    GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint * ids, GLboolean enabled
+);
+
+struct GlDebugState final
+{
+    GlDebugSettings            Settings{GlDebugSeverity::Low, {}, 0, 0};
+    GlDebugOutputMode          Mode = GlDebugOutputMode::SampledErrorChecks;
+    std::unordered_set<GLuint> IgnoredMessageIds;
+
+    // Messages may come from driver threads, everything below is guarded by the mutex.
+    std::mutex                              Mutex;
+    std::unordered_map<uint64_t, uint64_t>  MessageRepeatCounts;
+    std::chrono::steady_clock::time_point   RateWindowStart;
+    uint32_t                                RateWindowMessageCount = 0;
+    uint64_t                                RateLimitedCount       = 0;
+    uint64_t                                TotalRateLimitedCount  = 0;
+    uint64_t                                TotalMessageCount      = 0;
+    uint64_t                                RepeatedMessageCount   = 0;
+};
+
+//
+// Statics
+//
+
+static GlDebugState s_State;
+
+// Calls since the last sampled check, per thread since calls are made by whichever thread owns the context.
+static thread_local uint32_t s_CallsSinceErrorCheck = 0;
+
+//
+// Forward declarations
+//
+
+static void * GetDebugOutputProcAddress(const char * const khrName, const char * const arbName);
+
+static void APIENTRY OnGlDebugMessage(
+    const GLenum         source,
+    const GLenum         type,
+    const GLuint         id,
+    const GLenum         severity,
+    const GLsizei        length,
+    const GLchar * const message,
+    const void * const   userParam
+);
+
+static void OnGladFunctionCalledWithCallbacks(const char * const funcName, void * const funcPtr, const int varArgsCount, ...);
+
+static void OnGladFunctionCalledWithSampling(const char * const funcName, void * const funcPtr, const int varArgsCount, ...);
+
+static void CheckGlError(const char * const location);
+
+static void ReportGlDebugMessage(
+    const GLenum            source,
+    const GLenum            type,
+    const GLuint            id,
+    const GlDebugSeverity   severity,
+    const std::string_view  message
+);
+
+static GlDebugSeverity GetGlDebugSeverity(const GLenum severity);
+
+static const char * GlDebugSourceToCStr(const GLenum source);
+
+static const char * GlDebugTypeToCStr(const GLenum type);
+
+//
+// Utilities
+//
+
+GlDebugSettings GetDefaultGlDebugSettings()
+{
+    return GlDebugSettings{
+        GlDebugSeverity::Low,
+        {},
+        GL_DEBUG_MAX_MESSAGES_PER_SECOND,
+        GL_ERROR_CHECK_CALL_INTERVAL
+    };
+}
+
+GlDebugOutputMode InitGlDebugOutput(const GlDebugSettings & settings)
+{
+    s_State.Settings = settings;
+    s_State.IgnoredMessageIds.clear();
+    s_State.IgnoredMessageIds.insert(settings.IgnoredMessageIds.cbegin(), settings.IgnoredMessageIds.cend());
+    s_State.Mode = GlDebugOutputMode::SampledErrorChecks;
+
+    GLint contextFlags = 0;
+    glGetIntegerv(GL_CONTEXT_FLAGS, &contextFlags);
+
+    // Non-debug contexts may legally report nothing, so they aren't worth a callback.
+    // The null backend has no driver to report anything.
+    const bool isDebugContext = (contextFlags & GL_CONTEXT_FLAG_DEBUG_BIT_KHR) != 0;
+    const bool hasDebugOutput = GetLoadedGlBackend() != GlBackend::Null
+        && (IsGlExtensionSupported("GL_KHR_debug") || IsGlExtensionSupported("GL_ARB_debug_output"));
+
+    if (isDebugContext && hasDebugOutput)
+    {
+        const auto debugMessageCallback = reinterpret_cast<PFNGLDEBUGMESSAGECALLBACKKHRPROC>(
+            GetDebugOutputProcAddress("glDebugMessageCallback", "glDebugMessageCallbackARB")
+        );
+        const auto debugMessageControl = reinterpret_cast<PFNGLDEBUGMESSAGECONTROLKHRPROC>(
+            GetDebugOutputProcAddress("glDebugMessageControl", "glDebugMessageControlARB")
+        );
+
+        if (debugMessageCallback != nullptr && debugMessageControl != nullptr)
+        {
+            // Filtering by severity in the driver saves formatting messages nobody reads.
+            // IDs can't be filtered regardless of source and type, so those are dropped in the callback.
+            static constexpr std::array<std::pair<GLenum, GlDebugSeverity>, 3> FILTERABLE_SEVERITIES{{
+                {GL_DEBUG_SEVERITY_NOTIFICATION_KHR, GlDebugSeverity::Notification},
+                {GL_DEBUG_SEVERITY_LOW_KHR,          GlDebugSeverity::Low},
+                {GL_DEBUG_SEVERITY_MEDIUM_KHR,       GlDebugSeverity::Medium}
+            }};
+
+            for (const auto & [glSeverity, severity] : FILTERABLE_SEVERITIES)
+            {
+                if (severity < settings.MinSeverity)
+                    debugMessageControl(GL_DONT_CARE, GL_DONT_CARE, glSeverity, 0, nullptr, GL_FALSE);
+            }
+
+            // ARB_debug_output has no notification severity and rejects it.
+            glad_glGetError();
+
+            // Asynchronous output keeps the driver free to run its own threads, at the cost of messages
+            // not being reported from within the offending call.
+            if (IsGlExtensionSupported("GL_KHR_debug"))
+                glEnable(GL_DEBUG_OUTPUT_KHR);
+
+            glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS_KHR);
+
+            debugMessageCallback(&OnGlDebugMessage, nullptr);
+
+            s_State.Mode = GlDebugOutputMode::Callback;
+        }
+    }
+
+    s_CallsSinceErrorCheck = 0;
+
+    glad_set_post_callback(
+        s_State.Mode == GlDebugOutputMode::Callback ? &OnGladFunctionCalledWithCallbacks : &OnGladFunctionCalledWithSampling
+    );
+
+    LOG_INFO<< "Using GL debug output mode " << GlDebugOutputModeToCStr(s_State.Mode)
+        << (isDebugContext ? "" : " without a debug context");
+
+    if (s_State.Mode == GlDebugOutputMode::SampledErrorChecks && settings.ErrorCheckCallInterval > 0)
+        LOG_INFO<< "Checking GL errors every " << settings.ErrorCheckCallInterval << " calls and at frame ends";
+
+    return s_State.Mode;
+}
+
+void CheckGlErrorsAtFrameEnd()
+{
+    if (s_State.Mode != GlDebugOutputMode::SampledErrorChecks)
+        return;
+
+    s_CallsSinceErrorCheck = 0;
+
+    CheckGlError("frame end");
+}
+
+void LogGlDebugSummary()
+{
+    const std::lock_guard<std::mutex> lock(s_State.Mutex);
+
+    if (s_State.TotalMessageCount == 0)
+        return;
+
+    LOG_INFO<< "GL debug output reported " << s_State.TotalMessageCount << " messages, "
+        << s_State.MessageRepeatCounts.size() << " distinct, " << s_State.RepeatedMessageCount << " repeats and "
+        << s_State.TotalRateLimitedCount << " rate limited ones not logged";
+}
+
+const char * GlDebugOutputModeToCStr(const GlDebugOutputMode mode)
+{
+    switch (mode)
+    {
+    case GlDebugOutputMode::Callback:
+        return "callback";
+    case GlDebugOutputMode::SampledErrorChecks:
+        return "sampled error checks";
+    default:
+        assert(false && "unrecognized GL debug output mode");
+        return "<UNKNOWN>";
+    }
+}
+
+//
+// Service
+//
+
+static void * GetDebugOutputProcAddress(const char * const khrName, const char * const arbName)
+{
+    // Core and KHR_debug entry points are unsuffixed, ARB_debug_output ones are not.
+    if (void * const proc = GetGlExtensionProcAddress(khrName); proc != nullptr)
+        return proc;
+
+    return GetGlExtensionProcAddress(arbName);
+}
+
+static void APIENTRY OnGlDebugMessage(
+    const GLenum         source,
+    const GLenum         type,
+    const GLuint         id,
+    const GLenum         severity,
+    const GLsizei        length,
+    const GLchar * const message,
+    const void * const   /*userParam*/
+)
+{
+    const GlDebugSeverity debugSeverity = GetGlDebugSeverity(severity);
+
+    // ARB_debug_output can't filter by severity in the driver.
+    if (debugSeverity < s_State.Settings.MinSeverity || s_State.IgnoredMessageIds.contains(id))
+        return;
+
+    const size_t messageLength = length >= 0 ? static_cast<size_t>(length) : std::strlen(message);
+
+    ReportGlDebugMessage(source, type, id, debugSeverity, std::string_view(message, messageLength));
+}
+
+static void OnGladFunctionCalledWithCallbacks(
+    const char * const /*funcName*/,
+    void * const       /*funcPtr*/,
+    const int          /*varArgsCount*/,
+    ...
+)
+{
+    // GLAD's default callback polls glGetError, the debug output callback reports errors instead.
+}
+
+static void OnGladFunctionCalledWithSampling(const char * const funcName, void * const /*funcPtr*/, const int /*varArgsCount*/, ...)
+{
+    const uint32_t callInterval = s_State.Settings.ErrorCheckCallInterval;
+
+    if (callInterval == 0 || ++s_CallsSinceErrorCheck < callInterval)
+        return;
+
+    s_CallsSinceErrorCheck = 0;
+
+    CheckGlError(funcName);
+}
+
+static void CheckGlError(const char * const location)
+{
+    // Errors are flags, several may be raised since the last check.
+    for (GLenum errorCode = glad_glGetError(); errorCode != GL_NO_ERROR; errorCode = glad_glGetError())
+    {
+        const std::string message = std::string(GlErrorToCStr(errorCode)) + " in " + location
+            + " or one of the calls preceding it";
+
+        ReportGlDebugMessage(GL_DEBUG_SOURCE_API_KHR, GL_DEBUG_TYPE_ERROR_KHR, errorCode, GlDebugSeverity::High, message);
+    }
+}
+
+static void ReportGlDebugMessage(
+    const GLenum            source,
+    const GLenum            type,
+    const GLuint            id,
+    const GlDebugSeverity   severity,
+    const std::string_view  message
+)
+{
+    const uint64_t messageHash = std::hash<std::string_view>()(message) ^ (static_cast<uint64_t>(id) << 32)
+        ^ (static_cast<uint64_t>(source) << 16) ^ type;
+
+    const auto now = std::chrono::steady_clock::now();
+
+    const std::lock_guard<std::mutex> lock(s_State.Mutex);
+
+    s_State.TotalMessageCount++;
+
+    if (const auto repeatCountIt = s_State.MessageRepeatCounts.find(messageHash); repeatCountIt != s_State.MessageRepeatCounts.end())
+    {
+        repeatCountIt->second++;
+        s_State.RepeatedMessageCount++;
+
+        return;
+    }
+
+    if (s_State.MessageRepeatCounts.size() < MAX_TRACKED_GL_DEBUG_MESSAGE_COUNT)
+        s_State.MessageRepeatCounts.emplace(messageHash, 0);
+
+    if (now - s_State.RateWindowStart >= std::chrono::seconds(1))
+    {
+        if (s_State.RateLimitedCount > 0)
+            LOG_WARNING<< "Dropped " << s_State.RateLimitedCount << " GL debug messages over the rate limit";
+
+        s_State.RateWindowStart        = now;
+        s_State.RateWindowMessageCount = 0;
+        s_State.RateLimitedCount       = 0;
+    }
+
+    if (s_State.RateWindowMessageCount >= s_State.Settings.MaxMessagesPerSecond)
+    {
+        s_State.RateLimitedCount++;
+        s_State.TotalRateLimitedCount++;
+
+        return;
+    }
+
+    s_State.RateWindowMessageCount++;
+
+    const LogSeverity logSeverity = type == GL_DEBUG_TYPE_ERROR_KHR || severity == GlDebugSeverity::High
+        ? LogSeverity::Error
+        : severity == GlDebugSeverity::Medium
+            ? LogSeverity::Warning
+            : LogSeverity::Info;
+
+    LOG_AT(logSeverity)<< "GL " << GlDebugSourceToCStr(source) << ' ' << GlDebugTypeToCStr(type) << " message " << id
+        << ": " << message;
+}
+
+static GlDebugSeverity GetGlDebugSeverity(const GLenum severity)
+{
+    switch (severity)
+    {
+    case GL_DEBUG_SEVERITY_HIGH_KHR:
+        return GlDebugSeverity::High;
+    case GL_DEBUG_SEVERITY_MEDIUM_KHR:
+        return GlDebugSeverity::Medium;
+    case GL_DEBUG_SEVERITY_LOW_KHR:
+        return GlDebugSeverity::Low;
+    default:
+        return GlDebugSeverity::Notification;
+    }
+}
+
+static const char * GlDebugSourceToCStr(const GLenum source)
+{
+    switch (source)
+    {
+    case GL_DEBUG_SOURCE_API_KHR:             return "API";
+    case GL_DEBUG_SOURCE_WINDOW_SYSTEM_KHR:   return "window system";
+    case GL_DEBUG_SOURCE_SHADER_COMPILER_KHR: return "shader compiler";
+    case GL_DEBUG_SOURCE_THIRD_PARTY_KHR:     return "third party";
+    case GL_DEBUG_SOURCE_APPLICATION_KHR:     return "application";
+    default:                                  return "other";
+    }
+}
+
+static const char * GlDebugTypeToCStr(const GLenum type)
+{
+    switch (type)
+    {
+    case GL_DEBUG_TYPE_ERROR_KHR:       return "error";
+    case GL_DEBUG_TYPE_DEPRECATED_KHR:  return "deprecated behavior";
+    case GL_DEBUG_TYPE_UNDEFINED_KHR:   return "undefined behavior";
+    case GL_DEBUG_TYPE_PORTABILITY_KHR: return "portability";
+    case GL_DEBUG_TYPE_PERFORMANCE_KHR: return "performance";
+    case GL_DEBUG_TYPE_MARKER_KHR:      return "marker";
+    default:                            return "other";
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+//
+// Interface types
+//
+
+enum class GlDebugSeverity: uint8_t
+{
+    Notification,
+    Low,
+    Medium,
+    High
+};
+
+enum class GlDebugOutputMode: uint8_t
+{
+    // Messages are pushed by the driver through GL_KHR_debug or GL_ARB_debug_output
+    Callback,
+    // glGetError is polled every ErrorCheckCallInterval calls and at the end of every frame
+    SampledErrorChecks
+};
+
+struct GlDebugSettings final
+{
+    // Messages below this severity are filtered out, by the driver where possible.
+    GlDebugSeverity     MinSeverity;
+    // Driver specific message IDs to drop, e.g. verbose buffer placement notes.
+    std::vector<GLuint> IgnoredMessageIds;
+    // Messages past this rate are dropped and only counted. Repeats of a message are never logged.
+    uint32_t            MaxMessagesPerSecond;
+    // Only used by the SampledErrorChecks mode, 0 limits checks to frame ends.
+    uint32_t            ErrorCheckCallInterval;
+};
+
+//
+// Utilities
+//
+
+// Settings from config.h
+GlDebugSettings GetDefaultGlDebugSettings();
+
+// Replaces the glGetError call GLAD debug wrappers make after every GL call. Debug output callbacks are used
+// if the context is a debug one supporting them, sampled glGetError checks otherwise.
+// Must be called on the GL context thread, after the GL backend is loaded.
+GlDebugOutputMode InitGlDebugOutput(const GlDebugSettings & settings);
+
+// Reports errors raised since the previous check. Only polls glGetError in the SampledErrorChecks mode,
+// so it's cheap to call once per frame regardless of the mode.
+void CheckGlErrorsAtFrameEnd();
+
+void LogGlDebugSummary();
+
+const char * GlDebugOutputModeToCStr(const GlDebugOutputMode mode);
@@ -0,0 +1,349 @@
+#include "program_binary_cache.h"
+
+#include <cassert>
+#include <cstring>
+#include <array>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#include "backends/backend.h"
+#include "utils/file_utils.h"
+#include "utils/hash_utils.h"
+#include "profiling/profiling.h"
+#include "statistics.h"
+#include "utils.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+// ARB_get_program_binary tokens, GLAD is generated for GL 3.3 core without the extension.
+static constexpr GLenum GL_PROGRAM_BINARY_RETRIEVABLE_HINT_ARB = 0x8257;
+static constexpr GLenum GL_PROGRAM_BINARY_LENGTH_ARB           = 0x8741;
+static constexpr GLenum GL_NUM_PROGRAM_BINARY_FORMATS_ARB      = 0x87FE;
+
+static constexpr std::array<char, 8> PROGRAM_BINARY_FILE_MAGIC{'L', 'O', 'G', 'L', 'P', 'R', 'G', '\0'};
+
+// Bumping it invalidates all cached binaries, e.g. when the way keys are made changes.
+static constexpr uint32_t PROGRAM_BINARY_FILE_VERSION = 1;
+
+static const std::string PROGRAM_BINARY_FILE_EXTENSION = ".glprog";
+
+//
+// Service types
+//
+
+using PFNGLGETPROGRAMBINARYARBPROC  = void (APIENTRY *)(
+    GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary
+);
+using PFNGLPROGRAMBINARYARBPROC     = void (APIENTRY *)(GLuint program, GLenum binaryFormat, const void * binary, GLsizei length);
+using PFNGLPROGRAMPARAMETERIARBPROC = void (APIENTRY *)(GLuint program, GLenum pname, GLint value);
+
+struct ProgramBinaryFileHeader final
+{
+    std::array<char, 8> Magic;
+    uint32_t            Version;
+    uint32_t            BinaryFormat;
+    uint64_t            Key;
+    uint64_t            BinarySize;
+};
+
+struct ProgramBinaryCacheState final
+{
+    bool        IsEnabled = false;
+    std::string DirPath;
+    // Hash of the driver identification, every key starts from it
+    uint64_t    DriverHash = 0;
+
+    PFNGLGETPROGRAMBINARYARBPROC  GetProgramBinary  = nullptr;
+    PFNGLPROGRAMBINARYARBPROC     ProgramBinary     = nullptr;
+    PFNGLPROGRAMPARAMETERIARBPROC ProgramParameteri = nullptr;
+
+    uint64_t HitCount      = 0;
+    uint64_t MissCount     = 0;
+    uint64_t RejectedCount = 0;
+    uint64_t StoredCount   = 0;
+};
+
+//
+// Statics
+//
+
+static ProgramBinaryCacheState s_State;
+
+//
+// Forward declarations
+//
+
+static std::string GetProgramBinaryFilePath(const uint64_t key);
+
+static void EvictProgramBinary(const std::string & filePath);
+
+static bool IsProgramLinked(const GLuint shaderProgram);
+
+//
+// Utilities
+//
+
+bool InitProgramBinaryCache(const std::string & cacheDirPath)
+{
+    s_State = ProgramBinaryCacheState();
+
+    if (GetLoadedGlBackend() != GlBackend::Native)
+    {
+        LOG_INFO<< "Program binary cache disabled with the " << GlBackendToCStr(GetLoadedGlBackend()) << " GL backend";
+
+        return false;
+    }
+
+    const bool isCoreFeature = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+
+    if (!isCoreFeature && !IsGlExtensionSupported("GL_ARB_get_program_binary"))
+    {
+        LOG_INFO<< "Program binary cache disabled, program binaries aren't supported";
+
+        return false;
+    }
+
+    // Drivers may support the extension without supporting any binary format.
+    GLint binaryFormatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_ARB, &binaryFormatCount);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    s_State.GetProgramBinary  = reinterpret_cast<PFNGLGETPROGRAMBINARYARBPROC>(GetGlExtensionProcAddress("glGetProgramBinary"));
+    s_State.ProgramBinary     = reinterpret_cast<PFNGLPROGRAMBINARYARBPROC>(GetGlExtensionProcAddress("glProgramBinary"));
+    s_State.ProgramParameteri = reinterpret_cast<PFNGLPROGRAMPARAMETERIARBPROC>(GetGlExtensionProcAddress("glProgramParameteri"));
+
+    if (
+        binaryFormatCount <= 0
+            || s_State.GetProgramBinary == nullptr
+            || s_State.ProgramBinary == nullptr
+            || s_State.ProgramParameteri == nullptr
+    )
+    {
+        LOG_INFO<< "Program binary cache disabled, the driver provides no program binary formats";
+
+        return false;
+    }
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(cacheDirPath, errorCode);
+
+    if (errorCode)
+    {
+        LOG_WARNING<< "Program binary cache disabled, failed to create " << cacheDirPath << ": " << errorCode.message();
+
+        return false;
+    }
+
+    // Binaries are only valid for the exact driver which produced them.
+    uint64_t driverHash = HashFnv1a64(&PROGRAM_BINARY_FILE_VERSION, sizeof(PROGRAM_BINARY_FILE_VERSION));
+
+    for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION})
+    {
+        const GLubyte * const value = glGetString(name);
+
+        driverHash = HashFnv1a64(std::string_view(value != nullptr ? reinterpret_cast<const char *>(value) : ""), driverHash);
+    }
+
+    s_State.IsEnabled  = true;
+    s_State.DirPath    = cacheDirPath;
+    s_State.DriverHash = driverHash;
+
+    LOG_INFO<< "Caching program binaries in " << cacheDirPath;
+
+    return true;
+}
+
+bool IsProgramBinaryCacheEnabled()
+{
+    return s_State.IsEnabled;
+}
+
+uint64_t MakeProgramBinaryCacheKey(const std::vector<ShaderStageSource> & stages)
+{
+    assert(s_State.IsEnabled);
+
+    return HashShaderStageSources(stages, s_State.DriverHash);
+}
+
+std::optional<UniqueShaderProgram> LoadCachedProgramBinary(const uint64_t key)
+{
+    PROFILE_SCOPE("LoadCachedProgramBinary");
+
+    assert(s_State.IsEnabled);
+
+    const std::string filePath = GetProgramBinaryFilePath(key);
+
+    std::vector<std::byte> content;
+
+    try
+    {
+        content = ReadBinaryFileContent(filePath);
+    }
+    catch (const FileException &)
+    {
+        s_State.MissCount++;
+
+        return std::nullopt;
+    }
+
+    ProgramBinaryFileHeader header{};
+
+    if (content.size() >= sizeof(header))
+        std::memcpy(&header, content.data(), sizeof(header));
+
+    const bool isValid = content.size() >= sizeof(header)
+        && header.Magic == PROGRAM_BINARY_FILE_MAGIC
+        && header.Version == PROGRAM_BINARY_FILE_VERSION
+        && header.Key == key
+        && header.BinarySize == content.size() - sizeof(header);
+
+    if (!isValid)
+    {
+        LOG_WARNING<< "Evicting malformed program binary " << filePath;
+
+        EvictProgramBinary(filePath);
+
+        s_State.MissCount++;
+
+        return std::nullopt;
+    }
+
+    UniqueShaderProgram shaderProgram = UniqueShaderProgram::Create();
+
+    s_State.ProgramBinary(
+        shaderProgram,
+        header.BinaryFormat,
+        content.data() + sizeof(header),
+        static_cast<GLsizei>(header.BinarySize)
+    );
+
+    // Errors raised by a rejected binary are expected, not worth reporting.
+    glad_glGetError();
+
+    if (!IsProgramLinked(shaderProgram))
+    {
+        LOG_INFO<< "Driver rejected program binary " << filePath << ", evicting it";
+
+        EvictProgramBinary(filePath);
+
+        s_State.RejectedCount++;
+        s_State.MissCount++;
+
+        return std::nullopt;
+    }
+
+    s_State.HitCount++;
+
+    return shaderProgram;
+}
+
+void PrepareProgramBinaryRetrieval(const GLuint shaderProgram)
+{
+    assert(s_State.IsEnabled);
+
+    s_State.ProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT_ARB, GL_TRUE);
+}
+
+void StoreProgramBinary(const uint64_t key, const GLuint shaderProgram)
+{
+    PROFILE_SCOPE("StoreProgramBinary");
+
+    assert(s_State.IsEnabled);
+
+    GLint binarySize = 0;
+    glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH_ARB, &binarySize);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    if (binarySize <= 0)
+    {
+        LOG_WARNING<< "Driver provided no binary for shader program " << shaderProgram;
+
+        return;
+    }
+
+    std::string content(sizeof(ProgramBinaryFileHeader) + static_cast<size_t>(binarySize), '\0');
+
+    GLsizei writtenSize  = 0;
+    GLenum  binaryFormat = GL_NONE;
+    s_State.GetProgramBinary(shaderProgram, binarySize, &writtenSize, &binaryFormat, content.data() + sizeof(ProgramBinaryFileHeader));
+
+    if (writtenSize <= 0)
+    {
+        LOG_WARNING<< "Failed to retrieve binary of shader program " << shaderProgram;
+
+        return;
+    }
+
+    content.resize(sizeof(ProgramBinaryFileHeader) + static_cast<size_t>(writtenSize));
+
+    const ProgramBinaryFileHeader header{
+        PROGRAM_BINARY_FILE_MAGIC,
+        PROGRAM_BINARY_FILE_VERSION,
+        binaryFormat,
+        key,
+        static_cast<uint64_t>(writtenSize)
+    };
+
+    std::memcpy(content.data(), &header, sizeof(header));
+
+    const std::string filePath = GetProgramBinaryFilePath(key);
+
+    try
+    {
+        WriteFileContentAtomically(filePath, content);
+    }
+    catch (const FileException & e)
+    {
+        LOG_WARNING<< "Failed to store program binary: " << e.what();
+
+        return;
+    }
+
+    s_State.StoredCount++;
+
+    LOG_DEBUG<< "Stored " << writtenSize << " bytes of shader program " << shaderProgram << " binary in " << filePath;
+}
+
+void LogProgramBinaryCacheSummary()
+{
+    if (!s_State.IsEnabled)
+        return;
+
+    LOG_INFO<< "Program binary cache hits/misses " << s_State.HitCount << '/' << s_State.MissCount
+        << ", " << s_State.RejectedCount << " binaries rejected by the driver, " << s_State.StoredCount << " stored";
+}
+
+//
+// Service
+//
+
+static std::string GetProgramBinaryFilePath(const uint64_t key)
+{
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    std::string fileName(2*sizeof(key), '0');
+
+    for (size_t digitIdx = 0; digitIdx < fileName.size(); digitIdx++)
+        fileName[fileName.size() - 1 - digitIdx] = HEX_DIGITS[(key >> (4*digitIdx)) & 0xF];
+
+    return (std::filesystem::path(s_State.DirPath) / (fileName + PROGRAM_BINARY_FILE_EXTENSION)).string();
+}
+
+static void EvictProgramBinary(const std::string & filePath)
+{
+    std::error_code errorCode;
+    std::filesystem::remove(filePath, errorCode);
+}
+
+static bool IsProgramLinked(const GLuint shaderProgram)
+{
+    GLint linkStatusValue = GL_FALSE;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linkStatusValue);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    return linkStatusValue == GL_TRUE;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+
+#include <glad/glad.h>
+
+#include "shaders.h"
+#include "wrappers.h"
+
+//
+// Utilities
+//
+
+// Enables caching linked program binaries as files in cacheDirPath, created if needed. Requires
+// program binary support and the native GL backend, since binaries would bypass captures of the recording one.
+// Must be called on the GL context thread. Returns whether the cache got enabled.
+bool InitProgramBinaryCache(const std::string & cacheDirPath);
+
+bool IsProgramBinaryCacheEnabled();
+
+// Covers the stages with their sources, as well as the driver, so that any change of either
+// leads to a different key and stale binaries are never loaded.
+uint64_t MakeProgramBinaryCacheKey(const std::vector<ShaderStageSource> & stages);
+
+// Returns a linked program if the cache has a binary for the key which the driver accepts.
+// Binaries it rejects, e.g. after a driver update keeping its version string, are evicted.
+std::optional<UniqueShaderProgram> LoadCachedProgramBinary(const uint64_t key);
+
+// Must be called before linking a program which is going to be stored.
+void PrepareProgramBinaryRetrieval(const GLuint shaderProgram);
+
+// Failures to write the cache are logged, not thrown, the program is usable regardless.
+void StoreProgramBinary(const uint64_t key, const GLuint shaderProgram);
+
+void LogProgramBinaryCacheSummary();
@@ -0,0 +1,310 @@
+#include "shader_pack.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#include "utils/file_utils.h"
+#include "profiling/profiling.h"
+#include "config.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+static constexpr std::array<char, 8> SHADER_PACK_FILE_MAGIC{'L', 'O', 'G', 'L', 'S', 'H', 'P', 'K'};
+
+// Bumping it invalidates all packs, e.g. when the way sources are resolved changes.
+static constexpr uint32_t SHADER_PACK_FILE_VERSION = 2;
+
+//
+// Service types
+//
+
+struct ShaderPackFileHeader final
+{
+    std::array<char, 8> Magic;
+    uint32_t            Version;
+    uint32_t            EntryCount;
+};
+
+// Offsets are relative to the data following the index, which in turn follows the header.
+struct ShaderPackIndexEntry final
+{
+    uint64_t NameOffset;
+    uint64_t NameSize;
+    uint64_t SourceOffset;
+    uint64_t SourceSize;
+    uint64_t DefinesOffset;
+    uint64_t DefinesLineNumber;
+    // ShaderPackDependency records of the files the source was resolved from
+    uint64_t DependenciesOffset;
+    uint64_t DependencyCount;
+};
+
+// Stamp of a file as of packing, entries of files changed since are read from the files instead.
+struct ShaderPackDependency final
+{
+    uint64_t NameOffset;
+    uint64_t NameSize;
+    uint64_t FileSize;
+    int64_t  ModificationTime;
+};
+
+struct ShaderPackState final
+{
+    bool                                                  IsLoaded = false;
+    std::unordered_map<std::string, ResolvedShaderSource> SourcesByFilename;
+};
+
+//
+// Statics
+//
+
+static ShaderPackState s_State;
+
+//
+// Forward declarations
+//
+
+// Returns false if any record or name is out of the data's bounds.
+static bool ReadShaderPackDependencies(
+    const std::byte * const                          data,
+    const size_t                                     dataSize,
+    const ShaderPackIndexEntry &                     entry,
+    std::vector<std::pair<std::string, FileStamp>> & dependencies
+);
+
+//
+// Utilities
+//
+
+bool LoadShaderPack(const std::string & path)
+{
+    PROFILE_SCOPE("LoadShaderPack");
+
+    s_State = ShaderPackState();
+
+    std::vector<std::byte> content;
+
+    try
+    {
+        content = ReadBinaryFileContent(path);
+    }
+    catch (const FileException &)
+    {
+        LOG_INFO<< "No shader pack at " << path << ", reading shader files instead";
+
+        return false;
+    }
+
+    ShaderPackFileHeader header{};
+
+    if (content.size() >= sizeof(header))
+        std::memcpy(&header, content.data(), sizeof(header));
+
+    const size_t indexSize = sizeof(ShaderPackIndexEntry)*header.EntryCount;
+
+    const bool isHeaderValid = content.size() >= sizeof(header)
+        && header.Magic == SHADER_PACK_FILE_MAGIC
+        && header.Version == SHADER_PACK_FILE_VERSION
+        && content.size() - sizeof(header) >= indexSize;
+
+    if (!isHeaderValid)
+    {
+        LOG_WARNING<< "Ignoring malformed or outdated shader pack " << path << ", reading shader files instead";
+
+        return false;
+    }
+
+    const std::byte * const data     = content.data() + sizeof(header) + indexSize;
+    const size_t            dataSize = content.size() - sizeof(header) - indexSize;
+
+    std::unordered_map<std::string, ResolvedShaderSource>     sourcesByFilename;
+    // Files are shared by entries through includes, so each of them is only queried once.
+    std::unordered_map<std::string, std::optional<FileStamp>> fileStamps;
+    std::vector<std::pair<std::string, FileStamp>>            dependencies;
+    size_t                                                    outdatedCount = 0;
+
+    sourcesByFilename.reserve(header.EntryCount);
+
+    for (uint32_t entryIdx = 0; entryIdx < header.EntryCount; entryIdx++)
+    {
+        ShaderPackIndexEntry entry{};
+        std::memcpy(&entry, content.data() + sizeof(header) + entryIdx*sizeof(entry), sizeof(entry));
+
+        const bool isEntryValid = entry.NameOffset <= dataSize
+            && entry.NameSize <= dataSize - entry.NameOffset
+            && entry.SourceOffset <= dataSize
+            && entry.SourceSize <= dataSize - entry.SourceOffset
+            && entry.DefinesOffset <= entry.SourceSize
+            && ReadShaderPackDependencies(data, dataSize, entry, dependencies);
+
+        if (!isEntryValid)
+        {
+            LOG_WARNING<< "Ignoring shader pack " << path << " with malformed entry " << entryIdx << ", reading shader files instead";
+
+            return false;
+        }
+
+        std::string shaderSourceFilename(reinterpret_cast<const char *>(data + entry.NameOffset), entry.NameSize);
+
+        // Edited without rebuilding the pack, e.g. with the build option producing it turned off since.
+        const auto changedDependencyIt = std::find_if(
+            dependencies.cbegin(),
+            dependencies.cend(),
+            [&fileStamps] (const auto & dependency)
+            {
+                const auto & [dependencyFilename, packedFileStamp] = dependency;
+
+                auto fileStampIt = fileStamps.find(dependencyFilename);
+                if (fileStampIt == fileStamps.end())
+                    fileStampIt = fileStamps.emplace(dependencyFilename, GetFileStamp(SHADERS_DIR + dependencyFilename)).first;
+
+                return fileStampIt->second != packedFileStamp;
+            }
+        );
+
+        if (changedDependencyIt != dependencies.cend())
+        {
+            LOG_WARNING<< "Ignoring " << shaderSourceFilename << " in shader pack " << path << ", "
+                << changedDependencyIt->first << " changed since it was packed";
+
+            outdatedCount++;
+
+            continue;
+        }
+
+        ResolvedShaderSource resolvedSource{
+            std::string(reinterpret_cast<const char *>(data + entry.SourceOffset), entry.SourceSize),
+            entry.DefinesOffset,
+            entry.DefinesLineNumber,
+            {}
+        };
+
+        sourcesByFilename.emplace(std::move(shaderSourceFilename), std::move(resolvedSource));
+    }
+
+    s_State.IsLoaded          = true;
+    s_State.SourcesByFilename = std::move(sourcesByFilename);
+
+    LOG_INFO<< "Loaded " << s_State.SourcesByFilename.size() << " shader sources from shader pack " << path
+        << ", " << outdatedCount << " outdated ones are read from shader files";
+
+    return true;
+}
+
+bool IsShaderPackLoaded()
+{
+    return s_State.IsLoaded;
+}
+
+const ResolvedShaderSource * FindPackedShaderSource(const std::string & shaderSourceFilename)
+{
+    const auto sourceIt = s_State.SourcesByFilename.find(shaderSourceFilename);
+
+    return sourceIt != s_State.SourcesByFilename.cend() ? &sourceIt->second : nullptr;
+}
+
+void WriteShaderPack(const std::string & path, const std::map<std::string, ResolvedShaderSource> & sourcesByFilename)
+{
+    std::vector<ShaderPackIndexEntry> index;
+    index.reserve(sourcesByFilename.size());
+
+    std::string data;
+
+    for (const auto & [shaderSourceFilename, resolvedSource] : sourcesByFilename)
+    {
+        assert(!resolvedSource.SourceFilenames.empty() && "packed sources must know the files they were resolved from");
+
+        const uint64_t nameOffset = data.size();
+        data += shaderSourceFilename;
+
+        const uint64_t sourceOffset = data.size();
+        data += resolvedSource.Source;
+
+        std::vector<ShaderPackDependency> dependencies;
+        dependencies.reserve(resolvedSource.SourceFilenames.size());
+
+        for (const std::string & dependencyFilename : resolvedSource.SourceFilenames)
+        {
+            const std::optional<FileStamp> fileStamp = GetFileStamp(SHADERS_DIR + dependencyFilename);
+
+            if (!fileStamp.has_value())
+                throw FileException(SHADERS_DIR + dependencyFilename);
+
+            dependencies.push_back(ShaderPackDependency{data.size(), dependencyFilename.size(), fileStamp->Size, fileStamp->ModificationTime});
+            data += dependencyFilename;
+        }
+
+        const uint64_t dependenciesOffset = data.size();
+        data.append(reinterpret_cast<const char *>(dependencies.data()), sizeof(ShaderPackDependency)*dependencies.size());
+
+        index.push_back(ShaderPackIndexEntry{
+            nameOffset,
+            shaderSourceFilename.size(),
+            sourceOffset,
+            resolvedSource.Source.size(),
+            resolvedSource.DefinesOffset,
+            resolvedSource.DefinesLineNumber,
+            dependenciesOffset,
+            dependencies.size()
+        });
+    }
+
+    const ShaderPackFileHeader header{SHADER_PACK_FILE_MAGIC, SHADER_PACK_FILE_VERSION, static_cast<uint32_t>(index.size())};
+
+    std::string content(sizeof(header) + sizeof(ShaderPackIndexEntry)*index.size(), '\0');
+
+    std::memcpy(content.data(), &header, sizeof(header));
+    std::memcpy(content.data() + sizeof(header), index.data(), sizeof(ShaderPackIndexEntry)*index.size());
+
+    content += data;
+
+    WriteFileContentAtomically(path, content);
+
+    LOG_INFO<< "Wrote " << index.size() << " shader sources, " << content.size() << " bytes, to shader pack " << path;
+}
+
+
+//
+// Service
+//
+
+static bool ReadShaderPackDependencies(
+    const std::byte * const                          data,
+    const size_t                                     dataSize,
+    const ShaderPackIndexEntry &                     entry,
+    std::vector<std::pair<std::string, FileStamp>> & dependencies
+)
+{
+    dependencies.clear();
+
+    if (entry.DependenciesOffset > dataSize || entry.DependencyCount > (dataSize - entry.DependenciesOffset) / sizeof(ShaderPackDependency))
+        return false;
+
+    for (uint64_t dependencyIdx = 0; dependencyIdx < entry.DependencyCount; dependencyIdx++)
+    {
+        ShaderPackDependency dependency{};
+        std::memcpy(&dependency, data + entry.DependenciesOffset + dependencyIdx*sizeof(dependency), sizeof(dependency));
+
+        if (dependency.NameOffset > dataSize || dependency.NameSize > dataSize - dependency.NameOffset)
+            return false;
+
+        dependencies.emplace_back(
+            std::string(reinterpret_cast<const char *>(data + dependency.NameOffset), dependency.NameSize),
+            FileStamp{dependency.FileSize, dependency.ModificationTime}
+        );
+    }
+
+    return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "shaders.h"
+
+//
+// Utilities
+//
+
+// Makes preprocessing take resolved shader sources from the pack written by learnopengl_shaderpack instead of
+// reading, and probing for, shader files. Packs are validated at build time and record the size and modification
+// time of every file an entry was resolved from, entries of files edited since are left out so that the files
+// are read instead. Returns whether the pack got loaded, missing or malformed packs leave shader files in use.
+// Must be called before any shader is preprocessed, the pack is read-only afterwards.
+bool LoadShaderPack(const std::string & path);
+
+bool IsShaderPackLoaded();
+
+// Returns nullptr if no pack is loaded or the pack doesn't have the file. Thread-safe.
+const ResolvedShaderSource * FindPackedShaderSource(const std::string & shaderSourceFilename);
+
+// Stamps the files the sources were resolved from as they are now. Throws FileException if the pack can't be
+// written or any of the files can't be queried.
+void WriteShaderPack(const std::string & path, const std::map<std::string, ResolvedShaderSource> & sourcesByFilename);
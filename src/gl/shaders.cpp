@@ -1,15 +1,32 @@
 #include "shaders.h"
 
 #include <cassert>
+#include <cctype>
+#include <optional>
+#include <algorithm>
+#include <string_view>
 #include <unordered_map>
 
 #include "utils/file_utils.h"
+#include "backends/backend.h"
+#include "program_binary_cache.h"
+#include "shader_pack.h"
+#include "utils.h"
+#include "statistics.h"
+#include "profiling/profiling.h"
 #include "config.h"
 
 //
 // Constants
 //
 
+static constexpr std::string_view VERSION_DIRECTIVE = "#version";
+static constexpr std::string_view INCLUDE_DIRECTIVE = "#include";
+
+// GL_KHR_parallel_shader_compile tokens, equal to the GL_ARB_parallel_shader_compile ones.
+// GLAD is generated for GL 3.3 core without either extension.
+static constexpr GLenum GL_COMPLETION_STATUS_KHR = 0x91B1;
+
 static const std::unordered_map<std::string, GLenum> SHADER_TYPES_BY_EXTENSION{
     {"vert", GL_VERTEX_SHADER},
     {"geom", GL_GEOMETRY_SHADER},
@@ -23,10 +40,61 @@ static const std::unordered_map<std::string, GLenum> SHADER_TYPES_BY_EXTENSION{
 #endif
 };
 
+//
+// Service types
+//
+
+using PFNGLMAXSHADERCOMPILERTHREADSKHRPROC = void (APIENTRY *)(GLuint count);
+
+struct ShaderPreprocessingState final
+{
+    // Indexed by source string number
+    std::vector<std::string> IncludedFilenames;
+    std::string              Output;
+    // Where defines go, right after the stage file's #version directive if it has one
+    size_t                   DefinesOffset;
+    size_t                   DefinesLineNumber;
+    bool                     IsVersionDirectiveFound;
+};
+
+//
+// Statics
+//
+
+static bool s_IsParallelShaderCompilationEnabled = false;
+
 //
 // Forward declarations
 //
 
+static void PreprocessShaderFile(const std::string & shaderSourceFilename, ShaderPreprocessingState & state);
+
+static std::string ParseIncludeDirective(
+    const std::string_view directive,
+    const std::string &    shaderSourceFilename,
+    const size_t           lineNumber
+);
+
+static void AppendDefines(const ShaderDefines & defines, const std::string_view source, std::string & output);
+
+static bool ContainsIdentifier(const std::string_view source, const std::string_view identifier);
+
+static void AppendLineDirective(const size_t lineNumber, const size_t sourceStringIdx, std::string & output);
+
+static PendingShaderProgram BeginShaderProgramBuild(const std::vector<ShaderStageSource> & stages);
+
+static bool IsShaderCompiled(const GLuint shader);
+
+static bool IsShaderProgramLinked(const GLuint shaderProgram);
+
+[[noreturn]] static void ThrowShaderCompilationFailure(
+    const GLuint        shader,
+    const GLenum        shaderType,
+    const std::string & shaderSourceFilename
+);
+
+[[noreturn]] static void ThrowShaderProgramLinkingFailure(const GLuint shaderProgram);
+
 static GLenum ExtensionToShaderType(const std::string & extension);
 
 static const char * ShaderTypeToCStr(const GLenum shaderType);
@@ -37,98 +105,292 @@ static std::string GetFullShaderPath(const std::string & shaderSourceFilename);
 // Utilities
 //
 
+bool InitParallelShaderCompilation(const GLuint maxCompilerThreadCount)
+{
+    s_IsParallelShaderCompilationEnabled = false;
+
+    const bool isKhrSupported = IsGlExtensionSupported("GL_KHR_parallel_shader_compile");
+
+    if (!isKhrSupported && !IsGlExtensionSupported("GL_ARB_parallel_shader_compile"))
+    {
+        LOG_INFO<< "Parallel shader compilation unavailable, shader program builds are going to block";
+
+        return false;
+    }
+
+    const auto maxShaderCompilerThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(
+        GetGlExtensionProcAddress(isKhrSupported ? "glMaxShaderCompilerThreadsKHR" : "glMaxShaderCompilerThreadsARB")
+    );
+
+    // Completion can be polled regardless, drivers pick their own thread count then.
+    if (maxShaderCompilerThreads != nullptr)
+        maxShaderCompilerThreads(maxCompilerThreadCount);
+
+    s_IsParallelShaderCompilationEnabled = true;
+
+    LOG_INFO<< "Parallel shader compilation enabled through "
+        << (isKhrSupported ? "GL_KHR_parallel_shader_compile" : "GL_ARB_parallel_shader_compile");
+
+    return true;
+}
+
+bool IsParallelShaderCompilationEnabled()
+{
+    return s_IsParallelShaderCompilationEnabled;
+}
+
 GLenum DetermineShaderTypeFromFilename(const std::string & shaderSourceFilename)
 {
     return ExtensionToShaderType(GetFileExtension(shaderSourceFilename));
 }
 
-UniqueShader CompileShaderFromFile(const GLenum shaderType, const std::string & shaderSourceFilename)
+bool IsShaderSourceFilename(const std::string & shaderSourceFilename)
 {
-    const std::string shaderSource = ReadFileContent(GetFullShaderPath(shaderSourceFilename));
-    BOOST_LOG_TRIVIAL(debug)<< "Loaded shader source from " << shaderSourceFilename << ":\n" << shaderSource;
+    return SHADER_TYPES_BY_EXTENSION.contains(GetFileExtension(shaderSourceFilename));
+}
 
-    const char * const shaderSourceData = shaderSource.data();
+ResolvedShaderSource ResolveShaderIncludes(const std::string & shaderSourceFilename)
+{
+    PROFILE_SCOPE("ResolveShaderIncludes");
 
-    UniqueShader shader = UniqueShader::Create(shaderType);
+    ShaderPreprocessingState state{{}, {}, 0, 1, false};
 
-    glShaderSource(shader, 1, &shaderSourceData, nullptr);
-    glCompileShader(shader);
+    PreprocessShaderFile(shaderSourceFilename, state);
 
+    LOG_DEBUG<< "Resolved includes of " << shaderSourceFilename << ": " << MakeCommaSeparatedList(state.IncludedFilenames);
+
+    return ResolvedShaderSource{
+        std::move(state.Output),
+        state.DefinesOffset,
+        state.DefinesLineNumber,
+        std::move(state.IncludedFilenames)
+    };
+}
+
+ShaderStageSource PreprocessShaderSource(
+    const GLenum          shaderType,
+    const std::string &   shaderSourceFilename,
+    const ShaderDefines & defines
+)
+{
+    PROFILE_SCOPE("PreprocessShaderSource");
+
+    const ResolvedShaderSource * const packedSource = FindPackedShaderSource(shaderSourceFilename);
+
+    ResolvedShaderSource resolvedSource = packedSource != nullptr
+        ? *packedSource
+        : ResolveShaderIncludes(shaderSourceFilename);
+
+    // Defines are only injected once the whole source is known, so that unused ones can be left out.
+    std::string definesOutput;
+    AppendDefines(defines, resolvedSource.Source, definesOutput);
+
+    if (!definesOutput.empty())
     {
-        GLint compilationStatusValue = GL_FALSE;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &compilationStatusValue);
+        AppendLineDirective(resolvedSource.DefinesLineNumber, 0, definesOutput);
 
-        if (!compilationStatusValue)
-        {
-            static const size_t MAX_SHADER_COMPILATION_LOG_SIZE = 512;
+        resolvedSource.Source.insert(resolvedSource.DefinesOffset, definesOutput);
+    }
 
-            std::string compilationLog(MAX_SHADER_COMPILATION_LOG_SIZE, '\0');
-            glGetShaderInfoLog(shader, MAX_SHADER_COMPILATION_LOG_SIZE, nullptr, compilationLog.data());
+    LOG_DEBUG<< "Preprocessed shader source from " << shaderSourceFilename
+        << (packedSource != nullptr ? " in the shader pack" : "") << ":\n" << resolvedSource.Source;
 
-            BOOST_LOG_TRIVIAL(fatal)<< "Failed to compile " << ShaderTypeToCStr(shaderType)
-                << " shader " << shader << " from " << shaderSourceFilename << ": " << compilationLog;
+    return ShaderStageSource{shaderType, shaderSourceFilename, std::move(resolvedSource.Source)};
+}
 
-            assert(false && "shader compilation must succeed");
+std::vector<ShaderStageSource> PreprocessShaderPermutation(const ShaderPermutation & permutation)
+{
+    assert(!permutation.ShaderSourceFilenames.empty());
 
-            throw ShaderCompilationException(shaderType, shaderSourceFilename);
-        }
+    std::vector<ShaderStageSource> stages;
+    stages.reserve(permutation.ShaderSourceFilenames.size());
+
+    for (const std::string & shaderSourceFilename : permutation.ShaderSourceFilenames)
+    {
+        stages.push_back(PreprocessShaderSource(
+            DetermineShaderTypeFromFilename(shaderSourceFilename),
+            shaderSourceFilename,
+            permutation.Defines
+        ));
     }
 
-    BOOST_LOG_TRIVIAL(debug)<< "Successfully compiled " << ShaderTypeToCStr(shaderType)
-        << " shader " << shader << " from " << shaderSourceFilename;
+    return stages;
+}
+
+uint64_t MakeShaderPermutationKey(const ShaderPermutation & permutation)
+{
+    uint64_t key = FNV1A_64_OFFSET_BASIS;
+
+    // Counts go first, so that file names can't be mistaken for defines.
+    const uint64_t shaderSourceFilenameCount = permutation.ShaderSourceFilenames.size();
+    key = HashFnv1a64(&shaderSourceFilenameCount, sizeof(shaderSourceFilenameCount), key);
+
+    for (const std::string & shaderSourceFilename : permutation.ShaderSourceFilenames)
+        key = HashFnv1a64(shaderSourceFilename, key);
+
+    const uint64_t defineCount = permutation.Defines.size();
+    key = HashFnv1a64(&defineCount, sizeof(defineCount), key);
+
+    for (const auto & [defineName, defineValue] : permutation.Defines)
+    {
+        key = HashFnv1a64(defineName, key);
+        key = HashFnv1a64(defineValue, key);
+    }
+
+    return key;
+}
+
+uint64_t HashShaderStageSources(const std::vector<ShaderStageSource> & stages, uint64_t hash)
+{
+    // Stage order is part of the hash, programs are linked from stages in the given order.
+    for (const ShaderStageSource & stage : stages)
+    {
+        hash = HashFnv1a64(&stage.Type, sizeof(stage.Type), hash);
+        hash = HashFnv1a64(stage.Source, hash);
+    }
+
+    return hash;
+}
+
+UniqueShader CompileShaderFromFile(const GLenum shaderType, const std::string & shaderSourceFilename)
+{
+    return CompileShaderFromSource(PreprocessShaderSource(shaderType, shaderSourceFilename, {}));
+}
+
+UniqueShader CompileShaderFromSource(const ShaderStageSource & stage)
+{
+    PROFILE_SCOPE("CompileShaderFromSource");
+
+    const char * const shaderSourceData = stage.Source.data();
+
+    UniqueShader shader = UniqueShader::Create(stage.Type);
+
+    glShaderSource(shader, 1, &shaderSourceData, nullptr);
+    glCompileShader(shader);
+
+    if (!IsShaderCompiled(shader))
+        ThrowShaderCompilationFailure(shader, stage.Type, stage.Name);
+
+    LOG_DEBUG<< "Successfully compiled " << ShaderTypeToCStr(stage.Type)
+        << " shader " << shader << " from " << stage.Name;
 
     return shader;
 }
 
 void LinkShaderProgram(const GLuint shaderProgram)
 {
+    PROFILE_SCOPE("LinkShaderProgram");
+
     glLinkProgram(shaderProgram);
 
-    {
-        GLint linkStatusValue = GL_FALSE;
-        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linkStatusValue);
+    if (!IsShaderProgramLinked(shaderProgram))
+        ThrowShaderProgramLinkingFailure(shaderProgram);
 
-        if (!linkStatusValue)
-        {
-            static const size_t MAX_SHADER_LINKING_LOG_SIZE = 512;
+    LOG_DEBUG<< "Successfully linked shader program " << shaderProgram;
+}
 
-            std::string linkingLog(MAX_SHADER_LINKING_LOG_SIZE, '\0');
-            glGetShaderInfoLog(shaderProgram, MAX_SHADER_LINKING_LOG_SIZE, nullptr, linkingLog.data());
+std::vector<PendingShaderProgram> SubmitShaderPrograms(const std::vector<std::vector<ShaderStageSource>> & programStageLists)
+{
+    PROFILE_SCOPE("SubmitShaderPrograms");
 
-            BOOST_LOG_TRIVIAL(fatal)<< "Failed to link shader program: " << linkingLog;
+    std::vector<PendingShaderProgram> pendingShaderPrograms;
+    pendingShaderPrograms.reserve(programStageLists.size());
 
-            assert(false && "shader program linking must succeed");
+    for (const std::vector<ShaderStageSource> & stages : programStageLists)
+        pendingShaderPrograms.push_back(BeginShaderProgramBuild(stages));
 
-            throw ShaderProgramLinkingException();
-        }
+    // Drivers compiling on threads of their own may still block linking until the stages are compiled.
+    for (PendingShaderProgram & pendingShaderProgram : pendingShaderPrograms)
+    {
+        if (pendingShaderProgram.Build.IsCached)
+            continue;
+
+        if (pendingShaderProgram.Build.CacheKey.has_value())
+            PrepareProgramBinaryRetrieval(pendingShaderProgram.ShaderProgram);
+
+        glLinkProgram(pendingShaderProgram.ShaderProgram);
     }
 
-    BOOST_LOG_TRIVIAL(debug)<< "Successfully linked shader program " << shaderProgram;
+    return pendingShaderPrograms;
 }
 
-UniqueShaderProgram MakeShaderProgramFromFiles(const std::vector<std::string> & shaderSourceFilenames)
+std::vector<PendingShaderProgram> SubmitShaderProgramsFromFiles(
+    const std::vector<std::vector<std::string>> & shaderSourceFilenameLists
+)
+{
+    std::vector<std::vector<ShaderStageSource>> programStageLists;
+    programStageLists.reserve(shaderSourceFilenameLists.size());
+
+    for (const std::vector<std::string> & shaderSourceFilenames : shaderSourceFilenameLists)
+        programStageLists.push_back(PreprocessShaderPermutation(ShaderPermutation{shaderSourceFilenames, {}}));
+
+    return SubmitShaderPrograms(programStageLists);
+}
+
+PendingShaderProgram SubmitShaderProgramFromFiles(const std::vector<std::string> & shaderSourceFilenames)
 {
-    assert(!shaderSourceFilenames.empty());
+    std::vector<PendingShaderProgram> pendingShaderPrograms = SubmitShaderProgramsFromFiles({shaderSourceFilenames});
+    assert(pendingShaderPrograms.size() == 1);
 
-    UniqueShaderProgram shaderProgram = UniqueShaderProgram::Create();
+    return std::move(pendingShaderPrograms.front());
+}
+
+bool IsShaderProgramBuildComplete(const GLuint shaderProgram, const ShaderProgramBuild & build)
+{
+    if (build.IsCached || !s_IsParallelShaderCompilationEnabled)
+        return true;
+
+    // Only covers linking, which in turn only completes once all stages are compiled.
+    GLint completionStatusValue = GL_FALSE;
+    glGetProgramiv(shaderProgram, GL_COMPLETION_STATUS_KHR, &completionStatusValue);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    return completionStatusValue == GL_TRUE;
+}
+
+void FinishShaderProgramBuild(const GLuint shaderProgram, ShaderProgramBuild && build)
+{
+    PROFILE_SCOPE("FinishShaderProgramBuild");
 
-    for (const std::string & shaderSourceFilename : shaderSourceFilenames)
+    if (build.IsCached)
     {
-        const GLenum       shaderType = DetermineShaderTypeFromFilename(shaderSourceFilename);
-        const UniqueShader shader     = CompileShaderFromFile(shaderType, shaderSourceFilename);
+        LOG_INFO<< "Loaded shader program " << shaderProgram << " of "
+            << MakeCommaSeparatedList(build.ShaderSourceFilenames) << " from the program binary cache";
 
-        glAttachShader(shaderProgram, shader);
+        return;
     }
 
-    LinkShaderProgram(shaderProgram);
+    if (!IsShaderProgramLinked(shaderProgram))
+    {
+        // Stages failing to compile fail linking as well, their logs tell more.
+        for (const PendingShaderStage & stage : build.Stages)
+        {
+            if (!IsShaderCompiled(stage.Shader))
+                ThrowShaderCompilationFailure(stage.Shader, stage.Type, stage.Name);
+        }
 
-    BOOST_LOG_TRIVIAL(info)<< "Successfully linked shader program " << shaderProgram << " from "
-        << MakeCommaSeparatedList(shaderSourceFilenames);
+        ThrowShaderProgramLinkingFailure(shaderProgram);
+    }
+
+    if (build.CacheKey.has_value())
+        StoreProgramBinary(*build.CacheKey, shaderProgram);
 
-    return shaderProgram;
+    LOG_INFO<< "Successfully linked shader program " << shaderProgram << " from "
+        << MakeCommaSeparatedList(build.ShaderSourceFilenames);
 }
 
-UniqueShaderProgram MakeShaderProgramFromMatchingFiles(const std::string & matchingFilename)
+UniqueShaderProgram MakeShaderProgramFromFiles(const std::vector<std::string> & shaderSourceFilenames)
+{
+    PROFILE_SCOPE("MakeShaderProgramFromFiles");
+
+    PendingShaderProgram pendingShaderProgram = SubmitShaderProgramFromFiles(shaderSourceFilenames);
+
+    FinishShaderProgramBuild(pendingShaderProgram.ShaderProgram, std::move(pendingShaderProgram.Build));
+
+    return std::move(pendingShaderProgram.ShaderProgram);
+}
+
+std::vector<std::string> FindMatchingShaderFiles(const std::string & matchingFilename)
 {
     assert(!matchingFilename.empty());
 
@@ -141,20 +403,30 @@ UniqueShaderProgram MakeShaderProgramFromMatchingFiles(const std::string & match
 
         const std::string shaderSourceFilename = matchingFilename + '.' + fileExtension;
 
-        if (DoesFileExist(GetFullShaderPath(shaderSourceFilename)))
+        const bool isFound = IsShaderPackLoaded()
+            ? FindPackedShaderSource(shaderSourceFilename) != nullptr
+            : DoesFileExist(GetFullShaderPath(shaderSourceFilename));
+
+        if (isFound)
             shaderSourceFilenames.push_back(shaderSourceFilename);
     }
 
-    BOOST_LOG_TRIVIAL(info)<< "Found " << shaderSourceFilenames.size() << " matching shader files: "
+    LOG_INFO<< "Found " << shaderSourceFilenames.size() << " matching shader files: "
         << MakeCommaSeparatedList(shaderSourceFilenames);
 
-    return MakeShaderProgramFromFiles(shaderSourceFilenames);
+    return shaderSourceFilenames;
+}
+
+UniqueShaderProgram MakeShaderProgramFromMatchingFiles(const std::string & matchingFilename)
+{
+    return MakeShaderProgramFromFiles(FindMatchingShaderFiles(matchingFilename));
 }
 
 GLuint GetCurrentlyUsedShaderProgram()
 {
     GLint currentShaderProgram = -1;
     glGetIntegerv(GL_CURRENT_PROGRAM, &currentShaderProgram);
+    CountRenderStatistic(RenderCounter::GlQueries);
     assert(currentShaderProgram != -1);
 
     return static_cast<GLuint>(currentShaderProgram);
@@ -173,6 +445,16 @@ ShaderCompilationException::ShaderCompilationException(
     // Empty
 }
 
+ShaderPreprocessingException::ShaderPreprocessingException(
+    const std::string & shaderSourceFilename,
+    const size_t        lineNumber,
+    const std::string & message
+):
+    std::runtime_error("Failed to preprocess " + shaderSourceFilename + ':' + std::to_string(lineNumber) + ": " + message)
+{
+    // Empty
+}
+
 ShaderProgramLinkingException::ShaderProgramLinkingException():
     std::runtime_error("Failed to link shader program")
 {
@@ -183,6 +465,248 @@ ShaderProgramLinkingException::ShaderProgramLinkingException():
 // Service
 //
 
+static void PreprocessShaderFile(const std::string & shaderSourceFilename, ShaderPreprocessingState & state)
+{
+    const size_t sourceStringIdx = state.IncludedFilenames.size();
+    const bool   isStageFile     = sourceStringIdx == 0;
+
+    state.IncludedFilenames.push_back(shaderSourceFilename);
+
+    const std::string source = ReadFileContent(GetFullShaderPath(shaderSourceFilename));
+
+    if (!isStageFile)
+        AppendLineDirective(1, sourceStringIdx, state.Output);
+
+    size_t lineBegin  = 0;
+    size_t lineNumber = 0;
+
+    while (lineBegin < source.size())
+    {
+        const size_t lineEnd = std::min(source.find('\n', lineBegin), source.size());
+
+        const std::string_view line(source.data() + lineBegin, lineEnd - lineBegin);
+
+        lineBegin = lineEnd + 1;
+        lineNumber++;
+
+        const size_t           directiveBegin = line.find_first_not_of(" \t");
+        const std::string_view directive      = directiveBegin != std::string_view::npos
+            ? line.substr(directiveBegin)
+            : std::string_view();
+
+        if (directive.starts_with(INCLUDE_DIRECTIVE))
+        {
+            const std::string includedFilename = ParseIncludeDirective(directive, shaderSourceFilename, lineNumber);
+
+            const bool isIncluded = std::find(
+                state.IncludedFilenames.cbegin(),
+                state.IncludedFilenames.cend(),
+                includedFilename
+            ) != state.IncludedFilenames.cend();
+
+            if (isIncluded)
+            {
+                // Keeps line numbers without a directive.
+                state.Output += '\n';
+
+                continue;
+            }
+
+            if (!DoesFileExist(GetFullShaderPath(includedFilename)))
+                throw ShaderPreprocessingException(shaderSourceFilename, lineNumber, "included file " + includedFilename + " not found");
+
+            PreprocessShaderFile(includedFilename, state);
+
+            AppendLineDirective(lineNumber + 1, sourceStringIdx, state.Output);
+
+            continue;
+        }
+
+        state.Output += line;
+        state.Output += '\n';
+
+        if (isStageFile && !state.IsVersionDirectiveFound && directive.starts_with(VERSION_DIRECTIVE))
+        {
+            state.DefinesOffset           = state.Output.size();
+            state.DefinesLineNumber       = lineNumber + 1;
+            state.IsVersionDirectiveFound = true;
+        }
+    }
+}
+
+static std::string ParseIncludeDirective(
+    const std::string_view directive,
+    const std::string &    shaderSourceFilename,
+    const size_t           lineNumber
+)
+{
+    assert(directive.starts_with(INCLUDE_DIRECTIVE));
+
+    const size_t filenameBegin = directive.find_first_not_of(" \t", INCLUDE_DIRECTIVE.size());
+
+    if (filenameBegin == std::string_view::npos || (directive[filenameBegin] != '"' && directive[filenameBegin] != '<'))
+        throw ShaderPreprocessingException(shaderSourceFilename, lineNumber, "expected a quoted file name after #include");
+
+    const char   closingQuote = directive[filenameBegin] == '"' ? '"' : '>';
+    const size_t filenameEnd  = directive.find(closingQuote, filenameBegin + 1);
+
+    if (filenameEnd == std::string_view::npos || filenameEnd == filenameBegin + 1)
+        throw ShaderPreprocessingException(shaderSourceFilename, lineNumber, "unterminated or empty file name after #include");
+
+    return std::string(directive.substr(filenameBegin + 1, filenameEnd - filenameBegin - 1));
+}
+
+static void AppendDefines(const ShaderDefines & defines, const std::string_view source, std::string & output)
+{
+    for (const auto & [defineName, defineValue] : defines)
+    {
+        assert(!defineName.empty());
+
+        // Permutations differing only in defines a stage doesn't check preprocess into the same stage source.
+        if (!ContainsIdentifier(source, defineName))
+            continue;
+
+        output += "#define ";
+        output += defineName;
+
+        if (!defineValue.empty())
+        {
+            output += ' ';
+            output += defineValue;
+        }
+
+        output += '\n';
+    }
+}
+
+static bool ContainsIdentifier(const std::string_view source, const std::string_view identifier)
+{
+    const auto isIdentifierCharacter = [] (const char character)
+    {
+        return std::isalnum(static_cast<unsigned char>(character)) || character == '_';
+    };
+
+    for (size_t offset = source.find(identifier); offset != std::string_view::npos; offset = source.find(identifier, offset + 1))
+    {
+        const size_t end = offset + identifier.size();
+
+        if ((offset == 0 || !isIdentifierCharacter(source[offset - 1])) && (end == source.size() || !isIdentifierCharacter(source[end])))
+            return true;
+    }
+
+    return false;
+}
+
+static void AppendLineDirective(const size_t lineNumber, const size_t sourceStringIdx, std::string & output)
+{
+    output += "#line ";
+    output += std::to_string(lineNumber);
+    output += ' ';
+    output += std::to_string(sourceStringIdx);
+    output += '\n';
+}
+
+static PendingShaderProgram BeginShaderProgramBuild(const std::vector<ShaderStageSource> & stages)
+{
+    assert(!stages.empty());
+
+    std::vector<std::string> shaderSourceFilenames;
+    shaderSourceFilenames.reserve(stages.size());
+
+    for (const ShaderStageSource & stage : stages)
+        shaderSourceFilenames.push_back(stage.Name);
+
+    std::optional<uint64_t> cacheKey;
+
+    if (IsProgramBinaryCacheEnabled())
+    {
+        cacheKey = MakeProgramBinaryCacheKey(stages);
+
+        if (std::optional<UniqueShaderProgram> cachedShaderProgram = LoadCachedProgramBinary(*cacheKey))
+        {
+            return PendingShaderProgram{
+                std::move(*cachedShaderProgram),
+                ShaderProgramBuild{{}, shaderSourceFilenames, std::nullopt, true}
+            };
+        }
+    }
+
+    PendingShaderProgram pendingShaderProgram{
+        UniqueShaderProgram::Create(),
+        ShaderProgramBuild{{}, shaderSourceFilenames, cacheKey, false}
+    };
+
+    pendingShaderProgram.Build.Stages.reserve(stages.size());
+
+    for (const ShaderStageSource & stage : stages)
+    {
+        const char * const shaderSourceData = stage.Source.data();
+
+        UniqueShader shader = UniqueShader::Create(stage.Type);
+
+        glShaderSource(shader, 1, &shaderSourceData, nullptr);
+        glCompileShader(shader);
+
+        glAttachShader(pendingShaderProgram.ShaderProgram, shader);
+
+        pendingShaderProgram.Build.Stages.push_back(PendingShaderStage{stage.Type, stage.Name, std::move(shader)});
+    }
+
+    return pendingShaderProgram;
+}
+
+static bool IsShaderCompiled(const GLuint shader)
+{
+    GLint compilationStatusValue = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compilationStatusValue);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    return compilationStatusValue == GL_TRUE;
+}
+
+static bool IsShaderProgramLinked(const GLuint shaderProgram)
+{
+    GLint linkStatusValue = GL_FALSE;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linkStatusValue);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    return linkStatusValue == GL_TRUE;
+}
+
+[[noreturn]] static void ThrowShaderCompilationFailure(
+    const GLuint        shader,
+    const GLenum        shaderType,
+    const std::string & shaderSourceFilename
+)
+{
+    static const size_t MAX_SHADER_COMPILATION_LOG_SIZE = 512;
+
+    GLsizei     compilationLogSize = 0;
+    std::string compilationLog(MAX_SHADER_COMPILATION_LOG_SIZE, '\0');
+    glGetShaderInfoLog(shader, MAX_SHADER_COMPILATION_LOG_SIZE, &compilationLogSize, compilationLog.data());
+    compilationLog.resize(static_cast<size_t>(compilationLogSize));
+
+    // Not asserted, failures are recoverable when reloading shaders, see ShaderHotReloader.
+    LOG_ERROR<< "Failed to compile " << ShaderTypeToCStr(shaderType)
+        << " shader " << shader << " from " << shaderSourceFilename << ": " << compilationLog;
+
+    throw ShaderCompilationException(shaderType, shaderSourceFilename);
+}
+
+[[noreturn]] static void ThrowShaderProgramLinkingFailure(const GLuint shaderProgram)
+{
+    static const size_t MAX_SHADER_LINKING_LOG_SIZE = 512;
+
+    GLsizei     linkingLogSize = 0;
+    std::string linkingLog(MAX_SHADER_LINKING_LOG_SIZE, '\0');
+    glGetProgramInfoLog(shaderProgram, MAX_SHADER_LINKING_LOG_SIZE, &linkingLogSize, linkingLog.data());
+    linkingLog.resize(static_cast<size_t>(linkingLogSize));
+
+    LOG_ERROR<< "Failed to link shader program " << shaderProgram << ": " << linkingLog;
+
+    throw ShaderProgramLinkingException();
+}
+
 static GLenum ExtensionToShaderType(const std::string & extension)
 {
     const auto shaderTypeIt = SHADER_TYPES_BY_EXTENSION.find(extension);
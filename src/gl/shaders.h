@@ -1,15 +1,80 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <optional>
 #include <stdexcept>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
 #include "utils/string_utils.h"
+#include "utils/hash_utils.h"
 #include "logging.h"
 
 #include "wrappers.h"
 
+//
+// Interface types
+//
+
+// Ordered, so that permutations made with the same defines get the same key regardless of insertion order.
+using ShaderDefines = std::map<std::string, std::string>;
+
+struct ShaderPermutation final
+{
+    std::vector<std::string> ShaderSourceFilenames;
+    // Injected into every stage, values may be empty
+    ShaderDefines            Defines;
+};
+
+// Stage file with its includes resolved, before any defines are injected, e.g. as stored in the shader pack.
+struct ResolvedShaderSource final
+{
+    std::string              Source;
+    // Where defines go, right after the #version directive if there is one, and the line number following it
+    size_t                   DefinesOffset;
+    size_t                   DefinesLineNumber;
+    // Stage file and the files it includes, indexed by source string number
+    std::vector<std::string> SourceFilenames;
+};
+
+struct ShaderStageSource final
+{
+    GLenum      Type;
+    // File name, only used for logging
+    std::string Name;
+    std::string Source;
+};
+
+struct PendingShaderStage final
+{
+    GLenum       Type;
+    std::string  Name;
+    UniqueShader Shader;
+};
+
+// Compilation and linking submitted to the driver, whose statuses haven't been checked yet.
+struct ShaderProgramBuild final
+{
+    // Empty for programs loaded from the program binary cache
+    std::vector<PendingShaderStage> Stages;
+    std::vector<std::string>        ShaderSourceFilenames;
+    // Set if the program is going to be stored in the program binary cache once linked
+    std::optional<uint64_t>         CacheKey;
+    bool                            IsCached;
+};
+
+// The program name is usable right away, e.g. for binding uniform blocks, but drawing
+// with it or querying its uniforms blocks until its build completes.
+struct PendingShaderProgram final
+{
+    UniqueShaderProgram ShaderProgram;
+    ShaderProgramBuild  Build;
+};
+
 //
 // Service
 //
@@ -36,10 +101,45 @@ inline void AttachShaders(const GLuint shaderProgram, const GLuint headShader, c
 // Utilities
 //
 
+// Lets the driver compile and link on up to maxCompilerThreadCount threads of its own, if it supports
+// GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile. Without either, completion of shader
+// program builds can't be polled and they are assumed to be complete. Returns whether it's supported.
+bool InitParallelShaderCompilation(const GLuint maxCompilerThreadCount);
+
+bool IsParallelShaderCompilationEnabled();
+
 GLenum DetermineShaderTypeFromFilename(const std::string & shaderSourceFilename);
 
+// Whether the file name has one of the extensions shader types are determined from.
+bool IsShaderSourceFilename(const std::string & shaderSourceFilename);
+
+// Resolves #include "file" directives against SHADERS_DIR, including every file at most once per stage. Inserted
+// #line directives keep compiler messages pointing at original lines, their source string numbers index files
+// in order of inclusion, 0 being the stage file itself. Throws ShaderPreprocessingException on malformed or
+// unresolved includes. Always reads the files, unlike PreprocessShaderSource().
+ResolvedShaderSource ResolveShaderIncludes(const std::string & shaderSourceFilename);
+
+// Takes the resolved source from the shader pack if one is loaded and has the file, see LoadShaderPack(),
+// and resolves the file's includes otherwise. Defines the stage mentions are injected right after
+// the #version directive.
+ShaderStageSource PreprocessShaderSource(
+    const GLenum          shaderType,
+    const std::string &   shaderSourceFilename,
+    const ShaderDefines & defines
+);
+
+std::vector<ShaderStageSource> PreprocessShaderPermutation(const ShaderPermutation & permutation);
+
+// Stable across runs and made without reading any file, covers file names and defines, not file contents.
+uint64_t MakeShaderPermutationKey(const ShaderPermutation & permutation);
+
+// Covers stage types and their preprocessed sources, equal for permutations which preprocess into the same program.
+uint64_t HashShaderStageSources(const std::vector<ShaderStageSource> & stages, const uint64_t hash = FNV1A_64_OFFSET_BASIS);
+
 UniqueShader CompileShaderFromFile(const GLenum shaderType, const std::string & shaderSourceFilename);
 
+UniqueShader CompileShaderFromSource(const ShaderStageSource & stage);
+
 void LinkShaderProgram(const GLuint shaderProgram);
 
 template <typename... Shader>
@@ -53,25 +153,38 @@ inline UniqueShaderProgram MakeShaderProgram(Shader &&... shaders)
     return shaderProgram;
 }
 
+// Submits builds of all the programs without checking any status, so that the driver can compile them
+// while the caller goes on. Compilation of every program is submitted before linking any of them.
+// Programs in the program binary cache are loaded from it instead, those which aren't get stored there once linked.
+std::vector<PendingShaderProgram> SubmitShaderPrograms(const std::vector<std::vector<ShaderStageSource>> & programStageLists);
+
+// Preprocesses the files without any defines.
+std::vector<PendingShaderProgram> SubmitShaderProgramsFromFiles(
+    const std::vector<std::vector<std::string>> & shaderSourceFilenameLists
+);
+
+PendingShaderProgram SubmitShaderProgramFromFiles(const std::vector<std::string> & shaderSourceFilenames);
+
+// Never blocks, unlike checking the statuses of a build which isn't complete.
+bool IsShaderProgramBuildComplete(const GLuint shaderProgram, const ShaderProgramBuild & build);
+
+// Blocks until the build completes. Throws if any stage failed to compile or the program failed to link.
+void FinishShaderProgramBuild(const GLuint shaderProgram, ShaderProgramBuild && build);
+
+// Loads the program from the program binary cache if it's enabled and has it, stores it there otherwise.
+UniqueShaderProgram MakeShaderProgramFromFiles(const std::vector<std::string> & shaderSourceFilenames);
+
 template <typename... ShaderFileNames>
 inline UniqueShaderProgram MakeShaderProgramFromFilesPack(ShaderFileNames &&... shaderSourceFilenames)
 {
     static_assert(sizeof...(shaderSourceFilenames) > 0);
 
-    UniqueShaderProgram shaderProgram = MakeShaderProgram(
-        CompileShaderFromFile(
-            DetermineShaderTypeFromFilename(shaderSourceFilenames),
-            shaderSourceFilenames
-        )...
-    );
-
-    BOOST_LOG_TRIVIAL(info)<< "Successfully linked shader program " << shaderProgram << " from "
-        << MakeCommaSeparatedListFromPack(std::forward<ShaderFileNames>(shaderSourceFilenames)...);
-
-    return shaderProgram;
+    return MakeShaderProgramFromFiles({std::string(std::forward<ShaderFileNames>(shaderSourceFilenames))...});
 }
 
-UniqueShaderProgram MakeShaderProgramFromFiles(const std::vector<std::string> & shaderSourceFilenames);
+// Shader files named matchingFilename with any shader extension, e.g. "basic.vert" and "basic.frag" for "basic".
+// Looked up in the shader pack instead of the file system if one is loaded.
+std::vector<std::string> FindMatchingShaderFiles(const std::string & matchingFilename);
 
 UniqueShaderProgram MakeShaderProgramFromMatchingFiles(const std::string & matchingFilename);
 
@@ -93,6 +206,13 @@ public: // Construction
     explicit ShaderCompilationException(const GLenum shaderType, const std::string & shaderSourceFilename);
 };
 
+class ShaderPreprocessingException final: public std::runtime_error
+{
+public: // Construction
+
+    ShaderPreprocessingException(const std::string & shaderSourceFilename, const size_t lineNumber, const std::string & message);
+};
+
 class ShaderProgramLinkingException final: public std::runtime_error
 {
 public: // Construction
@@ -0,0 +1,62 @@
+#include "statistics.h"
+
+#include <cassert>
+
+//
+// Service
+//
+
+namespace detail
+{
+
+thread_local RenderStatistics s_ThreadRenderStatistics;
+
+} // namespace detail
+
+//
+// Utilities
+//
+
+const RenderStatistics & GetRenderStatistics()
+{
+    return detail::s_ThreadRenderStatistics;
+}
+
+RenderStatistics TakeRenderStatistics()
+{
+    const RenderStatistics result = detail::s_ThreadRenderStatistics;
+
+    detail::s_ThreadRenderStatistics = RenderStatistics();
+
+    return result;
+}
+
+const char * RenderCounterToCStr(const RenderCounter counter)
+{
+    switch (counter)
+    {
+    case RenderCounter::DrawCalls:
+        return "draw calls";
+    case RenderCounter::Vertices:
+        return "vertices";
+    case RenderCounter::Triangles:
+        return "triangles";
+    case RenderCounter::ShaderProgramSwitches:
+        return "shader program switches";
+    case RenderCounter::VaoBinds:
+        return "VAO binds";
+    case RenderCounter::TextureBinds:
+        return "texture binds";
+    case RenderCounter::UniformUploads:
+        return "uniform uploads";
+    case RenderCounter::UniformUploadBytes:
+        return "uniform upload bytes";
+    case RenderCounter::BufferUploadBytes:
+        return "buffer upload bytes";
+    case RenderCounter::GlQueries:
+        return "glGet queries";
+    default:
+        assert(false && "unrecognized render counter");
+        return "<UNKNOWN>";
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+//
+// Interface types
+//
+
+enum class RenderCounter: uint8_t
+{
+    DrawCalls,
+    Vertices,
+    Triangles,
+    ShaderProgramSwitches,
+    VaoBinds,
+    TextureBinds,
+    UniformUploads,
+    UniformUploadBytes,
+    BufferUploadBytes,
+    GlQueries,
+
+    Count
+};
+
+constexpr size_t RENDER_COUNTER_COUNT = static_cast<size_t>(RenderCounter::Count);
+
+struct RenderStatistics final
+{
+    std::array<uint64_t, RENDER_COUNTER_COUNT> Counters{};
+
+    uint64_t Get(const RenderCounter counter) const
+    {
+        return Counters[static_cast<size_t>(counter)];
+    }
+};
+
+//
+// Service
+//
+
+namespace detail
+{
+
+extern thread_local RenderStatistics s_ThreadRenderStatistics;
+
+} // namespace detail
+
+//
+// Utilities
+//
+
+// Counters are per thread, so that they can be bumped from GL wrappers without synchronization.
+// Since only the thread owning the GL context issues GL calls, its counters cover all GL work of a frame.
+inline void CountRenderStatistic(const RenderCounter counter, const uint64_t amount = 1)
+{
+    detail::s_ThreadRenderStatistics.Counters[static_cast<size_t>(counter)] += amount;
+}
+
+const RenderStatistics & GetRenderStatistics();
+
+// Returns the counters accumulated since the previous call on the calling thread and resets them.
+RenderStatistics TakeRenderStatistics();
+
+const char * RenderCounterToCStr(const RenderCounter counter);
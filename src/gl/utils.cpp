@@ -1,7 +1,9 @@
 #include "utils.h"
 
+#include <cassert>
 #include <array>
 
+#include "statistics.h"
 #include "logging.h"
 #include "config.h"
 
@@ -17,11 +19,12 @@ int GetGlIntegerParam(const GLenum name);
 
 void LogGlInfo()
 {
-    BOOST_LOG_TRIVIAL(info)<< "Using OpenGL version " << glGetString(GL_VERSION);
-    BOOST_LOG_TRIVIAL(info)<< "Using OpenGL renderer " << glGetString(GL_RENDERER);
+    LOG_INFO<< "Using OpenGL version " << glGetString(GL_VERSION);
+    LOG_INFO<< "Using OpenGL renderer " << glGetString(GL_RENDERER);
 
-    BOOST_LOG_TRIVIAL(info)<< "Max number of OpenGL vertex attributes: " << GetMaxVertexAttribs();
-    BOOST_LOG_TRIVIAL(info)<< "Max OpenGL texture size: " << GetMaxTextureSize();
+    LOG_INFO<< "Max number of OpenGL vertex attributes: " << GetMaxVertexAttribs();
+    LOG_INFO<< "Max OpenGL texture size: " << GetMaxTextureSize();
+    LOG_INFO<< "OpenGL uniform buffer offset alignment: " << GetUniformBufferOffsetAlignment();
 }
 
 void SetViewportSize(const int width, const int height)
@@ -31,7 +34,7 @@ void SetViewportSize(const int width, const int height)
 
     glViewport(0, 0, width, height);
 
-    BOOST_LOG_TRIVIAL(debug)<< "Set GL viewport size to " << width << 'x' << height;
+    LOG_DEBUG<< "Set GL viewport size to " << width << 'x' << height;
 }
 
 void TogglePolygonMode()
@@ -41,6 +44,7 @@ void TogglePolygonMode()
   // This seems to yield either 1 or 2 values (depending on the platform maybe?).
   // If there are 2 values, the first is for front face mode, the second - for back face.
   glGetIntegerv(GL_POLYGON_MODE, polygonMode.data());
+  CountRenderStatistic(RenderCounter::GlQueries);
 
   const GLint frontFaceMode = polygonMode[0];
   const GLint backFaceMode  = polygonMode[1];
@@ -59,6 +63,11 @@ int GetMaxTextureSize()
     return GetGlIntegerParam(GL_MAX_TEXTURE_SIZE);
 }
 
+int GetUniformBufferOffsetAlignment()
+{
+    return GetGlIntegerParam(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+}
+
 GLuint GetBoundVertexArray()
 {
     return static_cast<GLuint>(GetGlIntegerParam(GL_VERTEX_ARRAY_BINDING));
@@ -74,6 +83,21 @@ GLuint GetBoundElementArrayBuffer()
     return static_cast<GLuint>(GetGlIntegerParam(GL_ELEMENT_ARRAY_BUFFER_BINDING));
 }
 
+bool IsGlExtensionSupported(const std::string_view extension)
+{
+    const int extensionCount = GetGlIntegerParam(GL_NUM_EXTENSIONS);
+
+    for (int extensionIdx = 0; extensionIdx < extensionCount; extensionIdx++)
+    {
+        const GLubyte * const name = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(extensionIdx));
+
+        if (name != nullptr && extension == reinterpret_cast<const char *>(name))
+            return true;
+    }
+
+    return false;
+}
+
 const char * GlErrorToCStr(const GLenum error)
 {
     switch (error)
@@ -104,6 +128,7 @@ int GetGlIntegerParam(const GLenum name)
 
     int result = INVALID_PARAM_VALUE;
     glGetIntegerv(name, &result);
+    CountRenderStatistic(RenderCounter::GlQueries);
     assert(result != INVALID_PARAM_VALUE);
 
     return result;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include <glad/glad.h>
 
 //
@@ -16,10 +18,14 @@ int GetMaxVertexAttribs();
 
 int GetMaxTextureSize();
 
+int GetUniformBufferOffsetAlignment();
+
 GLuint GetBoundVertexArray();
 
 GLuint GetBoundArrayBuffer();
 
 GLuint GetBoundElementArrayBuffer();
 
+bool IsGlExtensionSupported(const std::string_view extension);
+
 const char * GlErrorToCStr(const GLenum error);
@@ -139,4 +139,86 @@ void TextureTraits::Destroy(const GLuint texture)
     glDeleteTextures(1, &texture);
 }
 
+//
+// FramebufferTraits
+//
+
+const char * const FramebufferTraits::ValueTypeDisplayName = "framebuffer";
+
+GLuint FramebufferTraits::Create()
+{
+    GLuint framebuffer = INVALID_OPENGL_FRAMEBUFFER;
+    glGenFramebuffers(1, &framebuffer);
+    assert(framebuffer != INVALID_OPENGL_FRAMEBUFFER);
+
+    return framebuffer;
+}
+
+void FramebufferTraits::Destroy(const GLuint framebuffer)
+{
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+//
+// RenderbufferTraits
+//
+
+const char * const RenderbufferTraits::ValueTypeDisplayName = "renderbuffer";
+
+GLuint RenderbufferTraits::Create()
+{
+    GLuint renderbuffer = INVALID_OPENGL_RENDERBUFFER;
+    glGenRenderbuffers(1, &renderbuffer);
+    assert(renderbuffer != INVALID_OPENGL_RENDERBUFFER);
+
+    return renderbuffer;
+}
+
+std::vector<GLuint> RenderbufferTraits::CreateMany(const size_t count)
+{
+    std::vector<GLuint> result(count, INVALID_OPENGL_RENDERBUFFER);
+    assert(result.size() == count);
+
+    glGenRenderbuffers(static_cast<GLsizei>(count), result.data());
+
+    assert(std::find(result.cbegin(), result.cend(), INVALID_OPENGL_RENDERBUFFER) == result.cend());
+    return result;
+}
+
+void RenderbufferTraits::Destroy(const GLuint renderbuffer)
+{
+    glDeleteRenderbuffers(1, &renderbuffer);
+}
+
+//
+// QueryTraits
+//
+
+const char * const QueryTraits::ValueTypeDisplayName = "query";
+
+GLuint QueryTraits::Create()
+{
+    GLuint query = INVALID_OPENGL_QUERY;
+    glGenQueries(1, &query);
+    assert(query != INVALID_OPENGL_QUERY);
+
+    return query;
+}
+
+std::vector<GLuint> QueryTraits::CreateMany(const size_t count)
+{
+    std::vector<GLuint> result(count, INVALID_OPENGL_QUERY);
+    assert(result.size() == count);
+
+    glGenQueries(static_cast<GLsizei>(count), result.data());
+
+    assert(std::find(result.cbegin(), result.cend(), INVALID_OPENGL_QUERY) == result.cend());
+    return result;
+}
+
+void QueryTraits::Destroy(const GLuint query)
+{
+    glDeleteQueries(1, &query);
+}
+
 } // namespace detail
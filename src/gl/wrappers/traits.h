@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include <glad/glad.h>
@@ -68,4 +69,41 @@ struct TextureTraits final
     static void Destroy(const GLuint texture);
 };
 
+struct FramebufferTraits final
+{
+    using ValueType = GLuint;
+
+    static const char * const ValueTypeDisplayName;
+
+    static GLuint Create();
+
+    static void Destroy(const GLuint framebuffer);
+};
+
+struct RenderbufferTraits final
+{
+    using ValueType = GLuint;
+
+    static const char * const ValueTypeDisplayName;
+
+    static GLuint Create();
+
+    static std::vector<GLuint> CreateMany(const size_t count);
+
+    static void Destroy(const GLuint renderbuffer);
+};
+
+struct QueryTraits final
+{
+    using ValueType = GLuint;
+
+    static const char * const ValueTypeDisplayName;
+
+    static GLuint Create();
+
+    static std::vector<GLuint> CreateMany(const size_t count);
+
+    static void Destroy(const GLuint query);
+};
+
 } // namespace detail
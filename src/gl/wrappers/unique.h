@@ -5,7 +5,7 @@
 #include <cassert>
 #include <vector>
 
-#include <boost/log/trivial.hpp>
+#include "logging.h"
 
 #include "traits.h"
 
@@ -51,7 +51,7 @@ private: // Construction
     {
         assert(m_Value.has_value());
 
-        BOOST_LOG_TRIVIAL(trace)<< "Created unique " << Traits::ValueTypeDisplayName << ' ' << *m_Value;
+        LOG_TRACE<< "Created unique " << Traits::ValueTypeDisplayName << ' ' << *m_Value;
     }
 
 public: // Copy / Move
@@ -146,7 +146,7 @@ public: // Interface
 
         Traits::Destroy(*m_Value);
 
-        BOOST_LOG_TRIVIAL(trace)<< "Destroyed unique " << Traits::ValueTypeDisplayName << ' ' << *m_Value;
+        LOG_TRACE<< "Destroyed unique " << Traits::ValueTypeDisplayName << ' ' << *m_Value;
 
         m_Value.reset();
     }
@@ -165,3 +165,6 @@ using UniqueBuffer  = UniqueEntity<detail::BufferTraits>;
 using UniqueShader  = UniqueEntity<detail::ShaderTraits>;
 using UniqueShaderProgram = UniqueEntity<detail::ShaderProgramTraits>;
 using UniqueTexture = UniqueEntity<detail::TextureTraits>;
+using UniqueFramebuffer  = UniqueEntity<detail::FramebufferTraits>;
+using UniqueRenderbuffer = UniqueEntity<detail::RenderbufferTraits>;
+using UniqueQuery   = UniqueEntity<detail::QueryTraits>;
@@ -112,7 +112,7 @@ void GlfwInputReceiver::OnGlfwKeyEvent(
 {
     if (window != GlfwInputReceiver::GetInstance()->m_Window)
     {
-        BOOST_LOG_TRIVIAL(warning)<< "Ignoring key event because the source window is different from the one GlfwInputReceiver has been initialized with";
+        LOG_WARNING<< "Ignoring key event because the source window is different from the one GlfwInputReceiver has been initialized with";
 
         return;
     }
@@ -131,7 +131,7 @@ void GlfwInputReceiver::OnGlfwCursorPositionChanged(
 {
     if (window != GlfwInputReceiver::GetInstance()->m_Window)
     {
-        BOOST_LOG_TRIVIAL(debug)<< "Ignoring cursor position change because the source window is different from the one GlfwInputReceiver has been initialized with";
+        LOG_DEBUG<< "Ignoring cursor position change because the source window is different from the one GlfwInputReceiver has been initialized with";
 
         return;
     }
@@ -148,7 +148,7 @@ void GlfwInputReceiver::OnGlfwMouseButtonEvent(
 {
     if (window != GlfwInputReceiver::GetInstance()->m_Window)
     {
-        BOOST_LOG_TRIVIAL(warning)<< "Ignoring mouse button event because the source window is different from the one GlfwInputReceiver has been initialized with";
+        LOG_WARNING<< "Ignoring mouse button event because the source window is different from the one GlfwInputReceiver has been initialized with";
 
         return;
     }
@@ -179,7 +179,7 @@ void GlfwInputReceiver::OnGlfwScrollEvent(
 {
     if (window != GlfwInputReceiver::GetInstance()->m_Window)
     {
-        BOOST_LOG_TRIVIAL(warning)<< "Ignoring scroll event because the source window is different from the one GlfwInputReceiver has been initialized with";
+        LOG_WARNING<< "Ignoring scroll event because the source window is different from the one GlfwInputReceiver has been initialized with";
 
         return;
     }
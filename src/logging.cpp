@@ -1,10 +1,287 @@
 #include "logging.h"
 
+#include <cassert>
+#include <cstring>
+#include <ctime>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+#include "threading/MpscRingBuffer.h"
 #include "config.h"
 
+//
+// Service types
+//
+
+struct LogRecord final
+{
+    LogSeverity                              Severity;
+    std::chrono::system_clock::time_point    Timestamp;
+    std::thread::id                          ThreadId;
+    size_t                                   Length;
+    bool                                     IsTruncated;
+    std::array<char, LOG_MESSAGE_MAX_LENGTH> Message;
+};
+
+//
+// Statics
+//
+
+static std::unique_ptr<MpscRingBuffer<LogRecord>> s_Queue;
+static std::thread                                s_Thread;
+static std::atomic<bool>                          s_IsRunning = false;
+
+// Submitted and written counts let fatal messages wait until everything before them is written.
+static std::atomic<uint64_t> s_SubmittedCount       = 0;
+static std::atomic<uint64_t> s_WrittenCount         = 0;
+static std::atomic<uint64_t> s_DroppedCount         = 0;
+static uint64_t              s_ReportedDroppedCount = 0;
+
+// Serializes writes of the logging thread with synchronous ones made while it isn't running.
+static std::mutex s_OutputMutex;
+
+//
+// Forward declarations
+//
+
+static void RunLogger();
+
+static size_t WriteQueuedLogRecords();
+
+static void WriteLogRecord(const LogRecord & record);
+
+static void WaitForLogRecordsWritten(const uint64_t recordCount);
+
+//
+// Construction / Destruction
+//
+
+LogRecordStream::LogRecordStream(const LogSeverity severity):
+    m_Severity(severity),
+    m_Message (),
+    m_Buffer  (m_Message.data(), m_Message.data() + m_Message.size()),
+    m_Stream  (&m_Buffer)
+{
+}
+
+LogRecordStream::~LogRecordStream()
+{
+    const auto fillRecord = [this] (LogRecord & record)
+    {
+        record.Severity    = m_Severity;
+        record.Timestamp   = std::chrono::system_clock::now();
+        record.ThreadId    = std::this_thread::get_id();
+        record.Length      = m_Buffer.GetLength();
+        record.IsTruncated = m_Buffer.IsTruncated();
+        std::memcpy(record.Message.data(), m_Message.data(), record.Length);
+    };
+
+    if (!s_IsRunning.load(std::memory_order_acquire))
+    {
+        LogRecord record;
+        fillRecord(record);
+
+        const std::lock_guard<std::mutex> lock(s_OutputMutex);
+
+        WriteLogRecord(record);
+
+        return;
+    }
+
+    while (!s_Queue->TryPushWith(fillRecord))
+    {
+        if (m_Severity != LogSeverity::Fatal)
+        {
+            s_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+
+            return;
+        }
+
+        // Fatal messages are the ones most worth keeping, they wait for room instead.
+        std::this_thread::yield();
+    }
+
+    const uint64_t submittedCount = s_SubmittedCount.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    // Whatever comes after a fatal message is unlikely to leave time for the logging thread to catch up.
+    if (m_Severity == LogSeverity::Fatal)
+        WaitForLogRecordsWritten(submittedCount);
+}
+
+LogRecordStream::FixedStreamBuffer::FixedStreamBuffer(char * const begin, char * const end):
+    m_IsTruncated(false)
+{
+    setp(begin, end);
+}
+
+//
+// Interface
+//
+
+std::ostream & LogRecordStream::GetStream()
+{
+    return m_Stream;
+}
+
+size_t LogRecordStream::FixedStreamBuffer::GetLength() const
+{
+    return static_cast<size_t>(pptr() - pbase());
+}
+
+bool LogRecordStream::FixedStreamBuffer::IsTruncated() const
+{
+    return m_IsTruncated;
+}
+
+LogRecordStream::FixedStreamBuffer::int_type LogRecordStream::FixedStreamBuffer::overflow(const int_type character)
+{
+    // Only called once the buffer is full, reporting success keeps the stream usable for the rest of the message.
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+        m_IsTruncated = true;
+
+    return traits_type::not_eof(character);
+}
+
+//
+// Utilities
+//
+
 void InitLogger()
 {
-    boost::log::core::get()->set_filter(
-        boost::log::trivial::severity >= MIN_LOG_LEVEL
-    );
+    if (s_IsRunning.load(std::memory_order_acquire))
+        return;
+
+    if (!s_Queue)
+        s_Queue = std::make_unique<MpscRingBuffer<LogRecord>>(LOG_QUEUE_CAPACITY);
+
+    s_IsRunning.store(true, std::memory_order_release);
+
+    s_Thread = std::thread(&RunLogger);
+
+    // Stops the logging thread before statics it uses are destroyed.
+    static const struct LoggerShutdown final
+    {
+        ~LoggerShutdown()
+        {
+            ShutdownLogger();
+        }
+    } s_LoggerShutdown;
+}
+
+void ShutdownLogger()
+{
+    if (!s_IsRunning.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    s_Thread.join();
+
+    // Producers which saw the logger running just before it stopped may have pushed after the last drain.
+    WriteQueuedLogRecords();
+
+    // Fatal messages waiting for the logging thread give up once it's stopped.
+    s_WrittenCount.notify_all();
+}
+
+uint64_t GetDroppedLogMessageCount()
+{
+    return s_DroppedCount.load(std::memory_order_relaxed);
+}
+
+const char * LogSeverityToCStr(const LogSeverity severity)
+{
+    switch (severity)
+    {
+    case LogSeverity::Trace:
+        return "trace";
+    case LogSeverity::Debug:
+        return "debug";
+    case LogSeverity::Info:
+        return "info";
+    case LogSeverity::Warning:
+        return "warning";
+    case LogSeverity::Error:
+        return "error";
+    case LogSeverity::Fatal:
+        return "fatal";
+    default:
+        assert(false && "unrecognized log severity");
+        return "<UNKNOWN>";
+    }
+}
+
+//
+// Service
+//
+
+static void RunLogger()
+{
+    while (s_IsRunning.load(std::memory_order_acquire))
+    {
+        // Polling keeps producers from having to wake the logging thread up, which would cost them a syscall.
+        if (WriteQueuedLogRecords() == 0)
+            std::this_thread::sleep_for(LOG_THREAD_IDLE_INTERVAL);
+    }
+
+    WriteQueuedLogRecords();
+}
+
+static size_t WriteQueuedLogRecords()
+{
+    const std::lock_guard<std::mutex> lock(s_OutputMutex);
+
+    const size_t writtenCount = s_Queue->PopAll(&WriteLogRecord);
+
+    const uint64_t droppedCount = s_DroppedCount.load(std::memory_order_relaxed);
+
+    if (droppedCount != s_ReportedDroppedCount)
+    {
+        std::clog<< "[warning] Dropped " << droppedCount - s_ReportedDroppedCount
+            << " log messages, the logging queue was full\n";
+
+        s_ReportedDroppedCount = droppedCount;
+    }
+
+    if (writtenCount > 0)
+    {
+        std::clog.flush();
+
+        s_WrittenCount.fetch_add(writtenCount, std::memory_order_acq_rel);
+        s_WrittenCount.notify_all();
+    }
+
+    return writtenCount;
+}
+
+static void WriteLogRecord(const LogRecord & record)
+{
+    const std::time_t time         = std::chrono::system_clock::to_time_t(record.Timestamp);
+    const auto        microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+        record.Timestamp.time_since_epoch()
+    ).count() % 1000000;
+
+    // std::localtime isn't thread safe, records are only written under the output mutex.
+    std::clog<< '[' << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S") << '.'
+        << std::setfill('0') << std::setw(6) << microseconds << std::setfill(' ') << "] "
+        << '[' << record.ThreadId << "] "
+        << '[' << LogSeverityToCStr(record.Severity) << "] "
+        << std::string_view(record.Message.data(), record.Length)
+        << (record.IsTruncated ? "... (truncated)" : "") << '\n';
+}
+
+static void WaitForLogRecordsWritten(const uint64_t recordCount)
+{
+    uint64_t writtenCount = s_WrittenCount.load(std::memory_order_acquire);
+
+    while (writtenCount < recordCount && s_IsRunning.load(std::memory_order_acquire))
+    {
+        s_WrittenCount.wait(writtenCount, std::memory_order_acquire);
+
+        writtenCount = s_WrittenCount.load(std::memory_order_acquire);
+    }
 }
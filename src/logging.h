@@ -1,7 +1,131 @@
 #pragma once
 
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/expressions.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <ostream>
+#include <streambuf>
 
+//
+// Constants
+//
+
+// Set by CMake from LEARNOPENGL_MIN_LOG_LEVEL, as an index into LogSeverity.
+#ifndef LEARNOPENGL_MIN_LOG_SEVERITY
+#define LEARNOPENGL_MIN_LOG_SEVERITY 1
+#endif
+
+// Longer messages are truncated.
+constexpr size_t LOG_MESSAGE_MAX_LENGTH = 1024;
+
+//
+// Interface types
+//
+
+enum class LogSeverity: uint8_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Fatal
+};
+
+// Messages below this severity are compiled out, along with the evaluation of whatever they print.
+constexpr LogSeverity MIN_LOG_SEVERITY = static_cast<LogSeverity>(LEARNOPENGL_MIN_LOG_SEVERITY);
+
+//
+// LogRecordStream
+//
+
+// Formats a message into a fixed size buffer on the stack and hands it over to the logging thread
+// when destroyed, at the end of the full expression of a LOG_* statement. Never blocks or allocates,
+// except for fatal messages, which wait for everything logged before them to be written out.
+class LogRecordStream final
+{
+public: // Construction / Destruction
+
+    explicit LogRecordStream(const LogSeverity severity);
+
+    ~LogRecordStream();
+
+public: // Copy / Move
+
+    LogRecordStream(const LogRecordStream &) = delete;
+
+    LogRecordStream & operator=(const LogRecordStream &) = delete;
+
+public: // Interface
+
+    std::ostream & GetStream();
+
+private: // Service types
+
+    // Drops whatever doesn't fit instead of growing.
+    class FixedStreamBuffer final: public std::streambuf
+    {
+    public: // Construction
+
+        FixedStreamBuffer(char * const begin, char * const end);
+
+    public: // Interface
+
+        size_t GetLength() const;
+
+        bool IsTruncated() const;
+
+    protected: // std::streambuf
+
+        int_type overflow(int_type character) override;
+
+    private: // Members
+
+        bool m_IsTruncated;
+    };
+
+private: // Members
+
+    LogSeverity                              m_Severity;
+    std::array<char, LOG_MESSAGE_MAX_LENGTH> m_Message;
+    FixedStreamBuffer                        m_Buffer;
+    std::ostream                             m_Stream;
+};
+
+// Turns a LOG_* statement into a void expression, so that it can be the branch of a conditional one.
+// Binds looser than << and tighter than ?:, which makes it apply to the whole message.
+struct LogRecordVoidifier final
+{
+    void operator&(const std::ostream &) const {}
+};
+
+//
+// Macros
+//
+
+// LOG_INFO<< "Loaded " << fileName; and the like. The severity check is a constant expression,
+// so messages below MIN_LOG_SEVERITY are compiled out, arguments included. LOG_AT takes one known at runtime.
+#define LOG_AT(severity) \
+    ((severity) < MIN_LOG_SEVERITY) ? static_cast<void>(0) : LogRecordVoidifier() & LogRecordStream(severity).GetStream()
+
+#define LOG_TRACE   LOG_AT(LogSeverity::Trace)
+#define LOG_DEBUG   LOG_AT(LogSeverity::Debug)
+#define LOG_INFO    LOG_AT(LogSeverity::Info)
+#define LOG_WARNING LOG_AT(LogSeverity::Warning)
+#define LOG_ERROR   LOG_AT(LogSeverity::Error)
+#define LOG_FATAL   LOG_AT(LogSeverity::Fatal)
+
+//
+// Utilities
+//
+
+// Starts the logging thread. Messages logged before are written out synchronously.
 void InitLogger();
+
+// Writes out everything logged so far and stops the logging thread. Called on exit at the latest.
+void ShutdownLogger();
+
+// Messages dropped because the queue to the logging thread was full.
+uint64_t GetDroppedLogMessageCount();
+
+const char * LogSeverityToCStr(const LogSeverity severity);
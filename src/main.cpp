@@ -4,22 +4,37 @@
 #include <array>
 #include <cmath>
 #include <numbers>
+#include <limits>
+#include <algorithm>
+#include <optional>
 
 #include <boost/format.hpp>
-#include <boost/signals2.hpp>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/ext/matrix_transform.hpp>
 
+#include "app/options.h"
+#include "app/window.h"
 #include "gl/constants.h"
 #include "gl/wrappers.h"
 #include "gl/utils.h"
+#include "gl/debug.h"
+#include "gl/program_binary_cache.h"
+#include "gl/shader_pack.h"
 #include "gl/shaders.h"
 #include "gl/StatefulShaderProgram.h"
-#include "meshes/construction.h"
-#include "textures/loading.h"
+#include "gl/ShaderHotReloader.h"
+#include "gl/backends/backend.h"
+#include "threading/ThreadPool.h"
+#include "systems/SystemScheduler.h"
+#include "systems/FixedTimestep.h"
+#include "rendering/RenderThread.h"
+#include "rendering/recording.h"
+#include "scene/demo.h"
+#include "textures/TextureLoader.h"
+#include "profiling/profiling.h"
 #include "camera/Camera.h"
 #include "camera/controllers.h"
 #include "utils/boost_utils.h"
@@ -32,19 +47,22 @@
 // Constants
 //
 
-static constexpr int MAIN_ERR_NONE        = 0;
-static constexpr int MAIN_ERR_UNKNOWN     = -1;
-static constexpr int MAIN_ERR_INIT_FAILED = -2;
+static constexpr int MAIN_ERR_NONE         = 0;
+static constexpr int MAIN_ERR_UNKNOWN      = -1;
+static constexpr int MAIN_ERR_INIT_FAILED  = -2;
+static constexpr int MAIN_ERR_INVALID_ARGS = -3;
 
 static const std::string SHADER_SOURCES_MATCHING_FILENAME = "basic";
 
 //
-// Forward declarations
+// Statics
 //
 
-#ifdef GLAD_DEBUG
-static void OnGladFunctionCalled(const char * const funcName, void * const funcPtr, const int varArgsCount, ...);
-#endif
+static bool s_IsWireframeEnabled = false;
+
+//
+// Forward declarations
+//
 
 static void OnFramebufferSizeChanged(GLFWwindow * const /*window*/, const int width, const int height);
 
@@ -56,86 +74,69 @@ static void SetMouseCursorCapture(GLFWwindow * const window, const bool isEnable
 // Main
 //
 
-int main()
+int main(int argc, char * argv[])
 {
     InitLogger();
     LogBoostVersion();
 
-#ifdef GLAD_DEBUG
-    BOOST_LOG_TRIVIAL(info)<< "Using GLAD with debug callbacks";
-#ifdef NDEBUG
-    BOOST_LOG_TRIVIAL(warning)<< "Using slower GLAD with debug callbacks in Release build";
-#endif // NDEBUG
+    AppOptions options;
 
-    glad_set_post_callback(OnGladFunctionCalled);
-#endif // GLAD_DEBUG
+    try
+    {
+        options = ParseAppOptions(argc, argv);
+    }
+    catch (const AppOptionsException & e)
+    {
+        LOG_FATAL<< e.what() << '\n' << GetAppUsage(argv[0]);
+
+        return MAIN_ERR_INVALID_ARGS;
+    }
 
     try
     {
+#ifdef LEARNOPENGL_ENABLE_PROFILING
+        PROFILE_THREAD_NAME("Main");
+
+        const ProfilingSession profilingSession(PROFILING_TRACE_FILE_PATH);
+#endif
+
+        SetGlfwInitHints(options);
+
         ScopedGLFW scopedGlfw;
 
         glfwSetErrorCallback(
             [] (auto errorCode, auto description)
             {
-                BOOST_LOG_TRIVIAL(error)<< "GLFW error " << errorCode << ": " << description;
+                LOG_ERROR<< "GLFW error " << errorCode << ": " << description;
             }
         );
 
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, OPENGL_MAJOR_VERSION);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, OPENGL_MINOR_VERSION);
-        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-        const std::unique_ptr<GLFWwindow, decltype(&glfwDestroyWindow)> window(
-            glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, nullptr, nullptr),
-            &glfwDestroyWindow
-        );
-
-        if (!window)
-        {
-            assert(false && "GLFW window creation must succeed");
-            BOOST_LOG_TRIVIAL(fatal)<< "Failed to create GLFW window";
-
-            return MAIN_ERR_INIT_FAILED;
-        }
+        const UniqueWindow window = CreateGlWindow(WindowSettings{
+            WINDOW_WIDTH,
+            WINDOW_HEIGHT,
+            WINDOW_TITLE,
+            !options.IsHeadless,
+            options.ContextCreationApi,
+            options.Backend,
+            options.GlCaptureFilePath
+        });
 
-        glfwMakeContextCurrent(window.get());
-
-        if (!gladLoadGLLoader(GLADloadproc(glfwGetProcAddress)))
-        {
-            assert(false && "GLAD loading must succeed");
-            BOOST_LOG_TRIVIAL(fatal)<< "Failed to load GLAD";
-
-            return MAIN_ERR_INIT_FAILED;
-        }
-
-        assert(
-            GLVersion.major == OPENGL_MAJOR_VERSION
-                && GLVersion.minor == OPENGL_MINOR_VERSION
-                && "GLAD GL version must match the expected one"
-        );
-        BOOST_LOG_TRIVIAL(info)<< "Loaded GLAD for OpenGL version " << GLVersion.major << '.' << GLVersion.minor;
+        InitGlDebugOutput(GetDefaultGlDebugSettings());
 
         LogGlInfo();
 
-        {
-            int framebufferWidth  = -1;
-            int framebufferHeight = -1;
-
-            glfwGetFramebufferSize(window.get(), &framebufferWidth, &framebufferHeight);
+        InitProgramBinaryCache(PROGRAM_BINARY_CACHE_DIR);
+        InitParallelShaderCompilation(MAX_SHADER_COMPILER_THREADS);
 
-            OnFramebufferSizeChanged(window.get(), framebufferWidth, framebufferHeight);
-        }
+        // Reloads must read the edited files, not the pack built from them.
+        if (!options.IsShaderHotReloadEnabled)
+            LoadShaderPack(SHADER_PACK_PATH);
 
+        // Viewport is updated by the render thread from the framebuffer size passed with every snapshot
         glfwSetFramebufferSizeCallback(window.get(), &OnFramebufferSizeChanged);
 
-        // Set default polygon mode
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-        boost::signals2::signal<void(float)> updateSignal;
+        ThreadPool      threadPool(ThreadPool::GetDefaultThreadCount());
+        SystemScheduler systemScheduler(&threadPool);
 
         // SECTION: Input setup
         GlfwInputReceiver::InitializeInstance(window.get());
@@ -173,9 +174,15 @@ int main()
         FlyCameraController cameraController(&camera, GlfwInputReceiver::GetInstance(), std::move(cameraControllerSettings));
         cameraController.SetEnabled(false);
 
-        const boost::signals2::connection cameraControllerUpdateConnection = updateSignal.connect(
+        // Polls keyboard state through GLFW, which is only allowed on the main thread.
+        systemScheduler.AddSystem(SystemDescriptor{
+            "FlyCameraController",
+            SystemPhase::Simulation,
+            SystemAffinity::MainThread,
+            MakeComponentSet({Component::Input}),
+            MakeComponentSet({Component::Camera}),
             std::bind(&decltype(cameraController)::Update, &cameraController, std::placeholders::_1)
-        );
+        });
 
         // Toggle camera controller activation on RMB click
         GlfwInputReceiver::GetInstance()->MouseButtonPressedSignal.connect(
@@ -193,108 +200,62 @@ int main()
 
         // END SECTION
 
-        // SECTION: Mesh setup
-        // TODO: Refactor mesh creation interface to reduce the number of non-descriptive boolean parameters.
-        const Mesh subjectMesh     = CreateUnitCubeMesh(false, true, false, false);
-        const Mesh lightSourceMesh = CreateUnitCubeMesh(true, true, false, true);
-        // END SECTION
-
-        // SECTION: Texture setup
-        static const std::array TEXTURE_FILENAMES{
-            "rtwe_output_cropped.jpeg"/*,
-            "white_pawn.png"*/
-        };
-
-        const std::vector<UniqueTexture> textures = UniqueTexture::CreateMany(TEXTURE_FILENAMES.size());
-
-        for (int textureIdx = 0; static_cast<size_t>(textureIdx) < textures.size(); textureIdx++)
-        {
-            const TextureData       textureData     = LoadTextureDataFromFile(TEXTURE_FILENAMES[textureIdx]);
-            const TextureMetadata & textureMetadata = textureData.GetMetadata();
-
-            glActiveTexture(GL_TEXTURE0 + textureIdx); // sic
-            glBindTexture(GL_TEXTURE_2D, textures[textureIdx]);
-
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            glTexImage2D(
-                GL_TEXTURE_2D,
-                0,
-                textureMetadata.ChannelsCount == 3 ? GL_RGB : GL_RGBA,
-                textureMetadata.Width,
-                textureMetadata.Height,
-                0,
-                textureMetadata.ChannelsCount == 3 ? GL_RGB : GL_RGBA,
-                GL_UNSIGNED_BYTE,
-                textureData.GetData()
-            );
-            glGenerateMipmap(GL_TEXTURE_2D);
-        }
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, INVALID_OPENGL_TEXTURE);
-        // END SECTION
-
-        // SECTION: Shader setup
-        static const glm::vec3 SUBJECT_POSITION     (0.0f);
-        static const glm::vec3 LIGHT_SOURCE_POSITION(1.2f, 1.0f, 2.0f);
-
-        static const glm::vec3 SUBJECT_RGB(0.6f, 0.2f, 0.8f);
-        static const glm::vec3 LIGHT_RGB  (1.0f, 1.0f, 1.0f);
-
-        static const float AMBIENT_LIGHT_STRENGTH = 0.1f;
-
-        // StatefulShaderProgram subjectShaderProgram(MakeShaderProgramFromFilesPack(
-        //     "lighting_basic.vert",
-        //     "lighting_basic.frag"
-        // ));
-        StatefulShaderProgram subjectShaderProgram(MakeShaderProgramFromMatchingFiles("lighting_basic"));
-
-        subjectShaderProgram.Use();
+        // Declared before the scene and the render thread, so that uploads can't outlive either.
+        TextureLoader textureLoader(threadPool);
 
-        //shaderProgram.SetUniformValueByName("tex", 0); // Using GL_TEXTURE0 for this sampler uniform
-        //shaderProgram.SetUniformValueByName("tex1", 1); // ...GL_TEXTURE1...
+        Scene scene = CreateDemoScene(textureLoader, options.IsShaderHotReloadEnabled);
 
-        subjectShaderProgram.SetUniformValueByName("model", glm::translate(glm::mat4(1.0f), SUBJECT_POSITION));
-
-        subjectShaderProgram.SetUniformValueByName("lightSourcePosition", LIGHT_SOURCE_POSITION);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        subjectShaderProgram.SetUniformValueByName("objectRgb", SUBJECT_RGB);
-        subjectShaderProgram.SetUniformValueByName("lightRgb", LIGHT_RGB);
+        glEnable(GL_DEPTH_TEST);
+        // END TODO0
 
-        subjectShaderProgram.SetUniformValueByName("ambientStrength", AMBIENT_LIGHT_STRENGTH);
+        const uint64_t ticksPerSecond = glfwGetTimerFrequency();
+        const float    secondsPerTick = 1.0f / static_cast<float>(ticksPerSecond);
 
-        StatefulShaderProgram lightSourceShaderProgram(MakeShaderProgramFromFilesPack(
-            "basic_mvp.vert",
-            "lighting_trivial_light_source.frag"
-        ));
+        uint64_t lastTimeTicks = glfwGetTimerValue();
+        uint64_t frameIndex    = 0;
 
-        lightSourceShaderProgram.Use();
+        FixedTimestep fixedTimestep(FixedTimestep::Settings{SIMULATION_STEPS_PER_SECOND, MAX_SIMULATION_CATCH_UP_STEPS});
 
-        lightSourceShaderProgram.SetUniformValueByName("model", glm::translate(glm::mat4(1.0f), LIGHT_SOURCE_POSITION));
+        // Camera state as of the simulation step preceding the latest one
+        Camera previousCamera(camera);
 
-        lightSourceShaderProgram.SetUniformValueByName("lightRgb", LIGHT_RGB);
+        // Declared before the render thread, so that its pending programs are released once the context is handed back.
+        std::optional<ShaderHotReloader> shaderHotReloader;
 
-        glUseProgram(INVALID_OPENGL_SHADER);
+        if (options.IsShaderHotReloadEnabled)
+        {
+            shaderHotReloader.emplace();
 
-        // END SECTION
+            WatchSceneShaderPrograms(scene, *shaderHotReloader);
+        }
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        // Scene GL resources are released after the render thread hands the context back.
+        RenderThread renderThread(window.get(), RENDER_FRAMES_IN_FLIGHT, options.IsHeadless);
 
-        glEnable(GL_DEPTH_TEST);
-        // END TODO0
+        renderThread.SetFrameBeginCallback(
+            [&textureLoader, &shaderHotReloader]
+            {
+                textureLoader.Update();
 
-        const uint64_t ticksPerSecond = glfwGetTimerFrequency();
-        const float    secondsPerTick = 1.0f / static_cast<float>(ticksPerSecond);
+                if (shaderHotReloader.has_value())
+                    shaderHotReloader->Update();
+            }
+        );
 
-        uint64_t lastTimeTicks = glfwGetTimerValue();
+        const uint64_t runStartTicks   = glfwGetTimerValue();
+        float          minFrameSeconds = std::numeric_limits<float>::max();
+        float          maxFrameSeconds = 0.0f;
 
-        while (!glfwWindowShouldClose(window.get()))
+        while (
+            !glfwWindowShouldClose(window.get())
+                && (!options.FrameCount.has_value() || frameIndex < *options.FrameCount)
+        )
         {
+            PROFILE_SCOPE("Frame");
+
             const uint64_t currentTimeTicks = glfwGetTimerValue();
             assert(currentTimeTicks >= lastTimeTicks);
 
@@ -303,70 +264,93 @@ int main()
 
             lastTimeTicks = currentTimeTicks;
 
-            updateSignal(deltaTimeSeconds);
+            // The first frame's delta covers setup rather than a frame.
+            if (frameIndex > 0)
+            {
+                minFrameSeconds = std::min(minFrameSeconds, deltaTimeSeconds);
+                maxFrameSeconds = std::max(maxFrameSeconds, deltaTimeSeconds);
+            }
 
-            // TODO: Extract as scene render logic
-            glClearColor(0.3f, 0.5f, 0.5f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            const int simulationStepCount = fixedTimestep.Advance(deltaTimeSeconds);
 
-            for (StatefulShaderProgram & shaderProgram : {std::ref(subjectShaderProgram), std::ref(lightSourceShaderProgram)})
+            for (int simulationStepIdx = 0; simulationStepIdx < simulationStepCount; simulationStepIdx++)
             {
-                shaderProgram.Use();
+                PROFILE_SCOPE("SimulationStep");
 
-                shaderProgram.SetUniformValueByName("view",       camera.GetLookAtMatrix());
-                shaderProgram.SetUniformValueByName("projection", camera.GetProjectionMatrix());
-            }
+                previousCamera = camera;
 
-            for (int textureIdx = 0; static_cast<size_t>(textureIdx) < textures.size(); textureIdx++)
-            {
-                glActiveTexture(GL_TEXTURE0 + textureIdx); // sic
-                glBindTexture(GL_TEXTURE_2D, textures[textureIdx]);
+                systemScheduler.Update(fixedTimestep.GetStepSeconds());
+                systemScheduler.LogLastFrameTrace();
             }
 
-            // Render subject
-            {
-                subjectMesh.Bind();
-                subjectShaderProgram.Use();
+            const Camera renderedCamera = InterpolateCameras(previousCamera, camera, fixedTimestep.GetInterpolationAlpha());
 
-                const glm::mat4 model = glm::translate(glm::mat4(1.0f), SUBJECT_POSITION);
+            // Simulation of the next frame above overlaps with rendering of the previous one.
+            RenderSnapshot & snapshot = renderThread.AcquireSnapshot();
 
-                subjectShaderProgram.SetUniformValueByName("model", model);
+            {
+                PROFILE_SCOPE("BuildRenderSnapshot");
 
-                subjectMesh.Render(GL_TRIANGLES);
+                BuildRenderSnapshot(scene, renderedCamera, snapshot);
             }
 
-            // Render light source
-            {
-                lightSourceMesh.Bind();
-                lightSourceShaderProgram.Use();
+            snapshot.FrameIndex  = frameIndex++;
+            snapshot.PolygonMode = s_IsWireframeEnabled ? GL_LINE : GL_FILL;
+            glfwGetFramebufferSize(window.get(), &snapshot.FramebufferWidth, &snapshot.FramebufferHeight);
+
+            RecordRenderSnapshotCommands(snapshot, &threadPool);
 
-                const glm::mat4 model = glm::translate(glm::mat4(1.0f), LIGHT_SOURCE_POSITION);
+            renderThread.SubmitSnapshot();
 
-                lightSourceShaderProgram.SetUniformValueByName("model", model);
+            {
+                PROFILE_SCOPE("PollEvents");
 
-                lightSourceMesh.Render(GL_TRIANGLES);
+                glfwPollEvents();
             }
-            // END TODO
+        }
+
+        renderThread.WaitIdle();
+
+        if (frameIndex > 1)
+        {
+            const float runSeconds      = secondsPerTick*static_cast<float>(glfwGetTimerValue() - runStartTicks);
+            const float avgFrameSeconds = runSeconds / static_cast<float>(frameIndex);
 
-            glfwSwapBuffers(window.get());
-            glfwPollEvents();
+            LOG_INFO<< "Rendered " << frameIndex << " frames in " << runSeconds << " s, "
+                << "frame time min/avg/max " << 1000.0f*minFrameSeconds << '/' << 1000.0f*avgFrameSeconds << '/'
+                << 1000.0f*maxFrameSeconds << " ms";
         }
+
+        LogGlDebugSummary();
+        LogProgramBinaryCacheSummary();
+        scene.ShaderPermutations->LogSummary();
+        textureLoader.LogSummary();
+
+        if (shaderHotReloader.has_value())
+            shaderHotReloader->LogSummary();
+        LogGlBackendSummary();
     }
     catch (const ScopedGLFW::GLFWInitFailedException & e)
     {
-        BOOST_LOG_TRIVIAL(fatal)<< "Failed to init GLFW: " << e.what();
+        LOG_FATAL<< "Failed to init GLFW: " << e.what();
+
+        return MAIN_ERR_INIT_FAILED;
+    }
+    catch (const WindowCreationException & e)
+    {
+        LOG_FATAL<< "Failed to create window: " << e.what();
 
         return MAIN_ERR_INIT_FAILED;
     }
     catch (const std::exception & e)
     {
-        BOOST_LOG_TRIVIAL(fatal)<< "Fatal error: " << e.what();
+        LOG_FATAL<< "Fatal error: " << e.what();
 
         return MAIN_ERR_UNKNOWN;
     }
     catch (...)
     {
-        BOOST_LOG_TRIVIAL(fatal)<< "Unknown error";
+        LOG_FATAL<< "Unknown error";
 
         return MAIN_ERR_UNKNOWN;
     }
@@ -378,25 +362,9 @@ int main()
 // Service
 //
 
-#ifdef GLAD_DEBUG
-static void OnGladFunctionCalled(const char * const funcName, void * const /*funcPtr*/, const int /*varArgsCount*/, ...)
-{
-    const GLenum errorCode = glad_glGetError();
-
-    if (errorCode == GL_NO_ERROR)
-        return;
-
-    BOOST_LOG_TRIVIAL(error)<< "OpenGL error " << errorCode << " (" << GlErrorToCStr(errorCode) << ") in " << funcName;
-
-    assert(false && "OpenGL calls must succeed");
-}
-#endif
-
 static void OnFramebufferSizeChanged(GLFWwindow * const /*window*/, const int width, const int height)
 {
-    BOOST_LOG_TRIVIAL(info)<< "Framebuffer size changed to " << width << 'x' << height;
-
-    SetViewportSize(width, height);
+    LOG_INFO<< "Framebuffer size changed to " << width << 'x' << height;
 }
 
 static void OnKeyPressed(GLFWwindow * const window, const Key key)
@@ -411,7 +379,7 @@ static void OnKeyPressed(GLFWwindow * const window, const Key key)
         break;
 
     case Key::Z:
-        TogglePolygonMode();
+        s_IsWireframeEnabled = !s_IsWireframeEnabled;
         break;
     }
 }
@@ -2,6 +2,7 @@
 
 #include <cassert>
 
+#include "gl/statistics.h"
 #include "gl/utils.h"
 
 //
@@ -21,6 +22,8 @@ Mesh::Mesh(MeshData && data):
 void Mesh::Bind() const
 {
     glBindVertexArray(m_Data.VertexArrayObject);
+
+    CountRenderStatistic(RenderCounter::VaoBinds);
 }
 
 void Mesh::Render(const GLenum mode) const
@@ -31,4 +34,10 @@ void Mesh::Render(const GLenum mode) const
         glDrawElements(mode, m_Data.IndicesCount, GL_UNSIGNED_INT, 0);
     else
         glDrawArrays(mode, 0, m_Data.IndicesCount);
+
+    CountRenderStatistic(RenderCounter::DrawCalls);
+    CountRenderStatistic(RenderCounter::Vertices, static_cast<uint64_t>(m_Data.IndicesCount));
+
+    if (mode == GL_TRIANGLES)
+        CountRenderStatistic(RenderCounter::Triangles, static_cast<uint64_t>(m_Data.IndicesCount) / 3);
 }
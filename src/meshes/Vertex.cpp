@@ -0,0 +1,26 @@
+#include "Vertex.h"
+
+//
+// Constants
+//
+
+const glm::vec3 Vertex::NO_TINT_RGB = glm::vec3(1.0f, 1.0f, 1.0f);
+
+//
+// Utilities
+//
+
+std::vector<float> VerticesToVertexData(const std::vector<Vertex> & vertices)
+{
+    std::vector<float> result;
+    result.reserve(vertices.size() * Vertex::FLOATS_PER_VERTEX);
+
+    for (const Vertex & vertex : vertices)
+    {
+        const auto vertexData = vertex.AsVertexData();
+
+        result.insert(result.cend(), vertexData.cbegin(), vertexData.cend());
+    }
+
+    return result;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <array>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+//
+// Vertex
+//
+
+struct Vertex final
+{
+public: // Constants
+
+    static const size_t FLOATS_PER_VERTEX = 11;
+
+public: // Attributes
+
+    glm::vec3 Position;
+    glm::vec3 TintRgb;
+    glm::vec2 TextureUv;
+    glm::vec3 Normal;
+
+private: // Constants
+
+    static const glm::vec3 NO_TINT_RGB;
+
+public: // Construction
+
+    Vertex():
+        Position (0.0f),
+        TintRgb  (NO_TINT_RGB),
+        TextureUv(0.0f),
+        Normal   (0.0f)
+    {
+        // Empty
+    }
+
+    std::array<float, FLOATS_PER_VERTEX> AsVertexData() const
+    {
+        return std::array{
+            Position.x, Position.y, Position.z,
+            TintRgb.x, TintRgb.y, TintRgb.z,
+            TextureUv.x, TextureUv.y,
+            Normal.x, Normal.y, Normal.z
+        };
+    }
+};
+
+//
+// Utilities
+//
+
+// Interleaves vertex attributes in the layout set up for mesh vertex array objects.
+std::vector<float> VerticesToVertexData(const std::vector<Vertex> & vertices);
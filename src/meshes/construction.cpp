@@ -4,74 +4,17 @@
 #include <vector>
 #include <tuple>
 
+#include "gl/statistics.h"
 #include "gl/utils.h"
+#include "profiling/profiling.h"
 #include "utils/collection_utils.h"
 
+#include "Vertex.h"
+
 //
 // Service
 //
 
-namespace
-{
-
-struct Vertex final
-{
-public: // Constants
-
-    static const size_t FLOATS_PER_VERTEX = 11;
-
-public: // Attributes
-
-    glm::vec3 Position;
-    glm::vec3 TintRgb;
-    glm::vec2 TextureUv;
-    glm::vec3 Normal;
-
-private: // Constants
-
-    static const glm::vec3 NO_TINT_RGB;
-
-public: // Construction
-
-    Vertex():
-        Position (0.0f),
-        TintRgb  (NO_TINT_RGB),
-        TextureUv(0.0f),
-        Normal   (0.0f)
-    {
-        // Empty
-    }
-
-    std::array<float, FLOATS_PER_VERTEX> AsVertexData() const
-    {
-        return std::array{
-            Position.x, Position.y, Position.z,
-            TintRgb.x, TintRgb.y, TintRgb.z,
-            TextureUv.x, TextureUv.y,
-            Normal.x, Normal.y, Normal.z
-        };
-    }
-};
-
-const glm::vec3 Vertex::NO_TINT_RGB = glm::vec3(1.0f, 1.0f, 1.0f);
-
-} // anonymous namespace
-
-static std::vector<float> VerticesToVertexData(const std::vector<Vertex> & vertices)
-{
-    std::vector<float> result;
-    result.reserve(vertices.size() * Vertex::FLOATS_PER_VERTEX);
-
-    for (const Vertex & vertex : vertices)
-    {
-        const auto vertexData = vertex.AsVertexData();
-
-        result.insert(result.cend(), vertexData.cbegin(), vertexData.cend());
-    }
-
-    return result;
-}
-
 static void SetupGlVertexLayout()
 {
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, Vertex::FLOATS_PER_VERTEX*sizeof(float), (void*)(0));
@@ -86,6 +29,8 @@ static void SetupGlVertexLayout()
 
 static MeshData MakeIndexedMeshData(const std::vector<Vertex> & vertices, const std::vector<GLuint> & indices)
 {
+    PROFILE_SCOPE("MakeIndexedMeshData");
+
     const GLuint oldVertexArray = GetBoundVertexArray();
     const GLuint oldArrayBuffer = GetBoundArrayBuffer();
 
@@ -106,6 +51,8 @@ static MeshData MakeIndexedMeshData(const std::vector<Vertex> & vertices, const
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBufferObject);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, SizeOfCollectionData(indices), indices.data(), GL_STATIC_DRAW);
 
+    CountRenderStatistic(RenderCounter::BufferUploadBytes, SizeOfCollectionData(vertexData) + SizeOfCollectionData(indices));
+
     SetupGlVertexLayout();
 
     glBindVertexArray(oldVertexArray);
@@ -120,6 +67,8 @@ static MeshData MakeIndexedMeshData(const std::vector<Vertex> & vertices, const
 
 static MeshData MakeUnindexedMeshData(const std::vector<Vertex> & vertices)
 {
+    PROFILE_SCOPE("MakeUnindexedMeshData");
+
     const GLuint oldVertexArray = GetBoundVertexArray();
     const GLuint oldArrayBuffer = GetBoundArrayBuffer();
 
@@ -133,6 +82,8 @@ static MeshData MakeUnindexedMeshData(const std::vector<Vertex> & vertices)
     glBindBuffer(GL_ARRAY_BUFFER, vertexBufferObject);
     glBufferData(GL_ARRAY_BUFFER, SizeOfCollectionData(vertexData), vertices.data(), GL_STATIC_DRAW);
 
+    CountRenderStatistic(RenderCounter::BufferUploadBytes, SizeOfCollectionData(vertexData));
+
     SetupGlVertexLayout();
 
     glBindVertexArray(oldVertexArray);
@@ -358,6 +309,8 @@ Mesh CreateAabbMesh(
     const bool        mustUseSmoothShading
 )
 {
+    PROFILE_SCOPE("CreateAabbMesh");
+
     assert(
         (mustUseSmoothShading || !mustUseIndices)
             && "indexed AABB mesh, as currently implemented, will always use smooth shading"
@@ -0,0 +1,201 @@
+#include "GpuProfiler.h"
+
+#include <cassert>
+#include <string>
+
+#include "gl/statistics.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+// GPU and CPU clocks drift apart slowly, so an occasional synchronous GL_TIMESTAMP read suffices.
+static constexpr uint64_t CALIBRATION_INTERVAL_FRAMES = 600;
+
+//
+// Construction
+//
+
+GpuProfiler::GpuProfiler(const size_t frameLatency):
+    m_Frames                (frameLatency),
+    m_CurrentFrameIdx       (0),
+    m_IsInFrame             (false),
+    m_OpenScopes            (),
+    m_LastFrameTimings      (),
+    m_LastFrameIndex        (std::nullopt),
+    m_DroppedFrameCount     (0),
+    m_GpuToCpuOffsetNs      (0),
+    m_FramesSinceCalibration(0),
+    m_Track                 ("GPU")
+{
+    assert(frameLatency > 0);
+
+    Calibrate();
+
+    LOG_INFO<< "Created GPU profiler with latency of " << frameLatency << " frames";
+}
+
+//
+// Interface
+//
+
+void GpuProfiler::BeginFrame(const uint64_t frameIndex)
+{
+    assert(!m_IsInFrame && "previous GPU profiler frame must be ended first");
+
+    if (++m_FramesSinceCalibration >= CALIBRATION_INTERVAL_FRAMES)
+        Calibrate();
+
+    FrameQueries & frame = m_Frames[m_CurrentFrameIdx];
+
+    if (frame.IsPending)
+        CollectFrame(frame);
+
+    frame.UsedQueryCount = 0;
+    frame.Scopes.clear();
+    frame.FrameIndex = frameIndex;
+    frame.IsPending  = false;
+
+    m_IsInFrame = true;
+}
+
+void GpuProfiler::EndFrame()
+{
+    assert(m_IsInFrame && "GPU profiler frame must be begun first");
+    assert(m_OpenScopes.empty() && "all GPU profiler scopes must be ended before the frame");
+
+    FrameQueries & frame = m_Frames[m_CurrentFrameIdx];
+    frame.IsPending = !frame.Scopes.empty();
+
+    m_CurrentFrameIdx = (m_CurrentFrameIdx + 1) % m_Frames.size();
+    m_IsInFrame       = false;
+}
+
+void GpuProfiler::BeginScope(const char * const name)
+{
+    assert(m_IsInFrame && "GPU profiler scopes must be within a frame");
+    assert(name != nullptr);
+
+    FrameQueries & frame = m_Frames[m_CurrentFrameIdx];
+
+    ScopeQueries scope{name, static_cast<uint32_t>(m_OpenScopes.size()), 0, 0};
+    glQueryCounter(IssueTimestampQuery(frame, scope.BeginQueryIdx), GL_TIMESTAMP);
+
+    m_OpenScopes.push_back(frame.Scopes.size());
+    frame.Scopes.push_back(scope);
+}
+
+void GpuProfiler::EndScope()
+{
+    assert(!m_OpenScopes.empty() && "GPU profiler scope must be begun first");
+
+    FrameQueries & frame = m_Frames[m_CurrentFrameIdx];
+    ScopeQueries & scope = frame.Scopes[m_OpenScopes.back()];
+
+    glQueryCounter(IssueTimestampQuery(frame, scope.EndQueryIdx), GL_TIMESTAMP);
+
+    m_OpenScopes.pop_back();
+}
+
+const std::vector<GpuScopeTiming> & GpuProfiler::GetLastFrameTimings() const
+{
+    return m_LastFrameTimings;
+}
+
+std::optional<uint64_t> GpuProfiler::GetLastFrameIndex() const
+{
+    return m_LastFrameIndex;
+}
+
+void GpuProfiler::LogLastFrameTimings() const
+{
+    for (const GpuScopeTiming & timing : m_LastFrameTimings)
+    {
+        LOG_TRACE<< "GPU " << std::string(2*timing.Depth, ' ') << timing.Name << ": "
+            << static_cast<double>(timing.DurationNs) / 1000000.0 << " ms";
+    }
+}
+
+//
+// Service
+//
+
+GLuint GpuProfiler::IssueTimestampQuery(FrameQueries & frame, size_t & queryIdx)
+{
+    // Query pools only grow, so that steady state frames don't create any query objects.
+    if (frame.UsedQueryCount == frame.Queries.size())
+        frame.Queries.push_back(UniqueQuery::Create());
+
+    queryIdx = frame.UsedQueryCount++;
+
+    return frame.Queries[queryIdx];
+}
+
+void GpuProfiler::CollectFrame(FrameQueries & frame)
+{
+    // Queries complete in submission order, so the last one being available implies all the rest are too.
+    GLint isAvailable = GL_FALSE;
+    glGetQueryObjectiv(frame.Queries[frame.UsedQueryCount - 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    if (!isAvailable)
+    {
+        // Waiting would stall the pipeline, so the frame is dropped instead.
+        m_DroppedFrameCount++;
+
+        LOG_DEBUG<< "Dropped GPU profiler frame results not available after " << m_Frames.size()
+            << " frames (" << m_DroppedFrameCount << " dropped so far)";
+
+        return;
+    }
+
+    m_LastFrameTimings.clear();
+    m_LastFrameIndex = frame.FrameIndex;
+
+    for (const ScopeQueries & scope : frame.Scopes)
+    {
+        GLuint64 beginNs = 0;
+        GLuint64 endNs   = 0;
+
+        glGetQueryObjectui64v(frame.Queries[scope.BeginQueryIdx], GL_QUERY_RESULT, &beginNs);
+        glGetQueryObjectui64v(frame.Queries[scope.EndQueryIdx],   GL_QUERY_RESULT, &endNs);
+        CountRenderStatistic(RenderCounter::GlQueries, 2);
+
+        m_LastFrameTimings.push_back(GpuScopeTiming{scope.Name, scope.Depth, endNs - beginNs});
+
+        m_Track.RecordZone(
+            scope.Name,
+            static_cast<uint64_t>(static_cast<int64_t>(beginNs) + m_GpuToCpuOffsetNs),
+            static_cast<uint64_t>(static_cast<int64_t>(endNs)   + m_GpuToCpuOffsetNs)
+        );
+    }
+}
+
+void GpuProfiler::Calibrate()
+{
+    // Returns GPU time as of all previously issued commands having reached the GPU, without waiting for their completion.
+    GLint64 gpuNs = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+    CountRenderStatistic(RenderCounter::GlQueries);
+
+    const uint64_t cpuNs = GetProfilingTimestampNs();
+
+    m_GpuToCpuOffsetNs       = static_cast<int64_t>(cpuNs) - gpuNs;
+    m_FramesSinceCalibration = 0;
+}
+
+//
+// GpuProfileScope
+//
+
+GpuProfileScope::GpuProfileScope(GpuProfiler & profiler, const char * const name):
+    m_Profiler(profiler)
+{
+    m_Profiler.BeginScope(name);
+}
+
+GpuProfileScope::~GpuProfileScope()
+{
+    m_Profiler.EndScope();
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <optional>
+
+#include <glad/glad.h>
+
+#include "gl/wrappers.h"
+
+#include "profiling.h"
+
+//
+// Interface types
+//
+
+struct GpuScopeTiming final
+{
+    const char * Name;
+    uint32_t     Depth;
+    uint64_t     DurationNs;
+};
+
+//
+// GpuProfiler
+//
+
+// Measures GPU execution time of nested scopes with GL_TIMESTAMP queries. Queries of the last
+// frameLatency frames stay in flight, so results are only read back once available, without stalling.
+// Measured scopes are also recorded into the profiling trace on a separate GPU track,
+// with timestamps calibrated to the CPU profiling timeline. Must only be used on the GL context thread.
+class GpuProfiler final
+{
+public: // Construction
+
+    explicit GpuProfiler(const size_t frameLatency);
+
+public: // Copy / Move
+
+    GpuProfiler(const GpuProfiler &) = delete;
+
+    GpuProfiler & operator=(const GpuProfiler &) = delete;
+
+public: // Interface
+
+    // Collects results of the oldest frame in flight, if they are available by now.
+    void BeginFrame(const uint64_t frameIndex);
+
+    void EndFrame();
+
+    // Scope names must have static storage duration.
+    void BeginScope(const char * const name);
+
+    void EndScope();
+
+    // Timings of the latest frame with available results, in scope begin order.
+    const std::vector<GpuScopeTiming> & GetLastFrameTimings() const;
+
+    // Index of the frame the last timings belong to, lagging behind the current one.
+    std::optional<uint64_t> GetLastFrameIndex() const;
+
+    void LogLastFrameTimings() const;
+
+private: // Service types
+
+    struct ScopeQueries final
+    {
+        const char * Name;
+        uint32_t     Depth;
+        size_t       BeginQueryIdx;
+        size_t       EndQueryIdx;
+    };
+
+    struct FrameQueries final
+    {
+        std::vector<UniqueQuery>  Queries;
+        size_t                    UsedQueryCount = 0;
+        std::vector<ScopeQueries> Scopes;
+        uint64_t                  FrameIndex = 0;
+        bool                      IsPending = false;
+    };
+
+private: // Service
+
+    GLuint IssueTimestampQuery(FrameQueries & frame, size_t & queryIdx);
+
+    void CollectFrame(FrameQueries & frame);
+
+    void Calibrate();
+
+private: // Members
+
+    std::vector<FrameQueries> m_Frames;
+    size_t                    m_CurrentFrameIdx;
+    bool                      m_IsInFrame;
+    std::vector<size_t>       m_OpenScopes;
+
+    std::vector<GpuScopeTiming> m_LastFrameTimings;
+    std::optional<uint64_t>     m_LastFrameIndex;
+    uint64_t                    m_DroppedFrameCount;
+
+    int64_t  m_GpuToCpuOffsetNs;
+    uint64_t m_FramesSinceCalibration;
+
+    ProfileTrack m_Track;
+};
+
+//
+// GpuProfileScope
+//
+
+class GpuProfileScope final
+{
+public: // Construction / Destruction
+
+    GpuProfileScope(GpuProfiler & profiler, const char * const name);
+
+    ~GpuProfileScope();
+
+public: // Copy / Move
+
+    GpuProfileScope(const GpuProfileScope &) = delete;
+
+    GpuProfileScope & operator=(const GpuProfileScope &) = delete;
+
+private: // Members
+
+    GpuProfiler & m_Profiler;
+};
@@ -0,0 +1,348 @@
+#include "profiling.h"
+
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <iomanip>
+
+#include "threading/SpscRingBuffer.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+// Per track; at 24 bytes per event, this is enough for tens of thousands of zones per flush.
+static constexpr size_t TRACK_EVENT_CAPACITY = 1 << 16;
+
+static constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(50);
+
+// Chrome trace format requires a process id, even though all tracks belong to this process.
+static constexpr int TRACE_PROCESS_ID = 1;
+
+//
+// Service types
+//
+
+namespace detail
+{
+
+struct ProfileEvent final
+{
+    const char * Name;
+    uint64_t     BeginNs;
+    uint64_t     EndNs;
+};
+
+struct ProfileTrackState final
+{
+    explicit ProfileTrackState(const uint32_t id):
+        Id               (id),
+        Name             (),
+        Events           (TRACK_EVENT_CAPACITY),
+        DroppedEventCount(0)
+    {
+        // Empty
+    }
+
+    const uint32_t Id;
+
+    // Guarded by the registry mutex
+    std::string Name;
+
+    SpscRingBuffer<ProfileEvent> Events;
+    std::atomic<uint64_t>        DroppedEventCount;
+};
+
+} // namespace detail
+
+using detail::ProfileEvent;
+using detail::ProfileTrackState;
+
+namespace
+{
+
+// Tracks are shared with the registry, so that events of exited threads still get flushed.
+struct ProfilerRegistry final
+{
+    std::mutex                                      Mutex;
+    std::vector<std::shared_ptr<ProfileTrackState>> Tracks;
+    std::atomic<bool>                               IsSessionActive{false};
+};
+
+} // anonymous namespace
+
+//
+// Forward declarations
+//
+
+static ProfilerRegistry & GetProfilerRegistry();
+
+static std::shared_ptr<ProfileTrackState> RegisterTrack();
+
+static ProfileTrackState & GetCurrentThreadTrack();
+
+static void RecordTrackZone(ProfileTrackState & track, const char * const name, const uint64_t beginNs, const uint64_t endNs);
+
+static void WriteJsonString(std::ostream & stream, const std::string_view value);
+
+//
+// Utilities
+//
+
+uint64_t GetProfilingTimestampNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()
+    );
+}
+
+void SetProfiledThreadName(const std::string & name)
+{
+    ProfileTrackState & track = GetCurrentThreadTrack();
+
+    const std::lock_guard<std::mutex> lock(GetProfilerRegistry().Mutex);
+
+    track.Name = name;
+}
+
+void RecordProfileZone(const char * const name, const uint64_t beginNs, const uint64_t endNs)
+{
+    RecordTrackZone(GetCurrentThreadTrack(), name, beginNs, endNs);
+}
+
+//
+// ProfileZone
+//
+
+ProfileZone::ProfileZone(const char * const name):
+    m_Name   (name),
+    m_BeginNs(GetProfilingTimestampNs())
+{
+    // Empty
+}
+
+ProfileZone::~ProfileZone()
+{
+    RecordProfileZone(m_Name, m_BeginNs, GetProfilingTimestampNs());
+}
+
+//
+// ProfileTrack
+//
+
+ProfileTrack::ProfileTrack(const std::string & name):
+    m_State(RegisterTrack())
+{
+    const std::lock_guard<std::mutex> lock(GetProfilerRegistry().Mutex);
+
+    m_State->Name = name;
+}
+
+void ProfileTrack::RecordZone(const char * const name, const uint64_t beginNs, const uint64_t endNs)
+{
+    RecordTrackZone(*m_State, name, beginNs, endNs);
+}
+
+//
+// ProfilingSession
+//
+
+ProfilingSession::ProfilingSession(const std::string & traceFilePath):
+    m_TraceFile       (traceFilePath, std::ios::out | std::ios::trunc),
+    m_StartNs         (GetProfilingTimestampNs()),
+    m_HasWrittenEvents(false),
+    m_Mutex           (),
+    m_StopCondition   (),
+    m_IsStopping      (false),
+    m_FlusherThread   ()
+{
+    if (!m_TraceFile)
+        throw ProfilingSessionException(traceFilePath);
+
+    ProfilerRegistry & registry = GetProfilerRegistry();
+
+    {
+        const std::lock_guard<std::mutex> lock(registry.Mutex);
+
+        // Leftovers of a previous session would be out of this trace's timeline.
+        for (const std::shared_ptr<ProfileTrackState> & track : registry.Tracks)
+            track->Events.PopAll([] (const ProfileEvent &) {});
+    }
+
+    const bool wasSessionActive = registry.IsSessionActive.exchange(true);
+    assert(!wasSessionActive && "only one profiling session may be active at a time");
+
+    m_TraceFile<< std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    m_FlusherThread = std::thread(&ProfilingSession::RunFlusher, this);
+
+    LOG_INFO<< "Started profiling session writing to " << traceFilePath;
+}
+
+ProfilingSession::~ProfilingSession()
+{
+    GetProfilerRegistry().IsSessionActive = false;
+
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+
+        m_IsStopping = true;
+    }
+
+    m_StopCondition.notify_all();
+
+    m_FlusherThread.join();
+
+    Flush();
+    WriteThreadNames();
+
+    m_TraceFile<< "]}\n";
+
+    LOG_INFO<< "Stopped profiling session";
+}
+
+void ProfilingSession::RunFlusher()
+{
+    PROFILE_THREAD_NAME("Profiler");
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    while (!m_StopCondition.wait_for(lock, FLUSH_INTERVAL, [this] { return m_IsStopping; }))
+    {
+        lock.unlock();
+
+        Flush();
+
+        lock.lock();
+    }
+}
+
+void ProfilingSession::Flush()
+{
+    ProfilerRegistry & registry = GetProfilerRegistry();
+
+    std::vector<std::shared_ptr<ProfileTrackState>> tracks;
+
+    {
+        const std::lock_guard<std::mutex> lock(registry.Mutex);
+
+        tracks = registry.Tracks;
+    }
+
+    for (const std::shared_ptr<ProfileTrackState> & track : tracks)
+    {
+        track->Events.PopAll(
+            [this, &track] (const ProfileEvent & event)
+            {
+                m_TraceFile<< (m_HasWrittenEvents ? ",\n" : "\n") << "{\"name\":";
+                WriteJsonString(m_TraceFile, event.Name);
+                m_TraceFile<< ",\"ph\":\"X\",\"pid\":" << TRACE_PROCESS_ID << ",\"tid\":" << track->Id
+                    << ",\"ts\":"  << static_cast<double>(event.BeginNs - m_StartNs) / 1000.0
+                    << ",\"dur\":" << static_cast<double>(event.EndNs - event.BeginNs) / 1000.0 << '}';
+
+                m_HasWrittenEvents = true;
+            }
+        );
+
+        const uint64_t droppedEventCount = track->DroppedEventCount.exchange(0, std::memory_order_relaxed);
+
+        if (droppedEventCount > 0)
+        {
+            LOG_WARNING<< "Dropped " << droppedEventCount << " profiling events of track "
+                << track->Id << " due to full event buffer";
+        }
+    }
+
+    m_TraceFile.flush();
+}
+
+void ProfilingSession::WriteThreadNames()
+{
+    ProfilerRegistry & registry = GetProfilerRegistry();
+
+    const std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    for (const std::shared_ptr<ProfileTrackState> & track : registry.Tracks)
+    {
+        if (track->Name.empty())
+            continue;
+
+        m_TraceFile<< (m_HasWrittenEvents ? ",\n" : "\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":"
+            << TRACE_PROCESS_ID << ",\"tid\":" << track->Id << ",\"args\":{\"name\":";
+        WriteJsonString(m_TraceFile, track->Name);
+        m_TraceFile<< "}}";
+
+        m_HasWrittenEvents = true;
+    }
+}
+
+//
+// Exceptions
+//
+
+ProfilingSessionException::ProfilingSessionException(const std::string & traceFilePath):
+    std::runtime_error("Failed to open profiling trace file " + traceFilePath)
+{
+    // Empty
+}
+
+//
+// Service
+//
+
+static ProfilerRegistry & GetProfilerRegistry()
+{
+    static ProfilerRegistry registry;
+
+    return registry;
+}
+
+static std::shared_ptr<ProfileTrackState> RegisterTrack()
+{
+    ProfilerRegistry & registry = GetProfilerRegistry();
+
+    const std::lock_guard<std::mutex> lock(registry.Mutex);
+
+    std::shared_ptr<ProfileTrackState> track = std::make_shared<ProfileTrackState>(
+        static_cast<uint32_t>(registry.Tracks.size() + 1)
+    );
+    registry.Tracks.push_back(track);
+
+    return track;
+}
+
+static ProfileTrackState & GetCurrentThreadTrack()
+{
+    static thread_local const std::shared_ptr<ProfileTrackState> s_ThreadTrack = RegisterTrack();
+
+    return *s_ThreadTrack;
+}
+
+static void RecordTrackZone(ProfileTrackState & track, const char * const name, const uint64_t beginNs, const uint64_t endNs)
+{
+    assert(name != nullptr);
+
+    if (!GetProfilerRegistry().IsSessionActive.load(std::memory_order_relaxed))
+        return;
+
+    if (!track.Events.TryPush(ProfileEvent{name, beginNs, endNs}))
+        track.DroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void WriteJsonString(std::ostream & stream, const std::string_view value)
+{
+    stream<< '"';
+
+    for (const char character : value)
+    {
+        if (character == '"' || character == '\\')
+            stream<< '\\';
+
+        stream<< character;
+    }
+
+    stream<< '"';
+}
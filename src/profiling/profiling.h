@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//
+// Macros
+//
+
+// Zones compile to nothing unless profiling is enabled via the LEARNOPENGL_ENABLE_PROFILING CMake option.
+// Zone names must have static storage duration, since they are only dereferenced when flushed.
+#ifdef LEARNOPENGL_ENABLE_PROFILING
+#define PROFILE_DETAIL_CONCAT_IMPL(a, b) a##b
+#define PROFILE_DETAIL_CONCAT(a, b)      PROFILE_DETAIL_CONCAT_IMPL(a, b)
+
+#define PROFILE_SCOPE(name)       const ProfileZone PROFILE_DETAIL_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) SetProfiledThreadName(name)
+#else
+#define PROFILE_SCOPE(name)       static_cast<void>(0)
+#define PROFILE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+//
+// Forward declarations
+//
+
+namespace detail
+{
+
+struct ProfileTrackState;
+
+} // namespace detail
+
+//
+// Utilities
+//
+
+// Common timeline for every profiled thread.
+uint64_t GetProfilingTimestampNs();
+
+void SetProfiledThreadName(const std::string & name);
+
+// Lock-free: the zone is pushed into the calling thread's own event buffer,
+// or dropped if the buffer is full or no profiling session is active.
+void RecordProfileZone(const char * const name, const uint64_t beginNs, const uint64_t endNs);
+
+//
+// ProfileZone
+//
+
+class ProfileZone final
+{
+public: // Construction / Destruction
+
+    explicit ProfileZone(const char * const name);
+
+    ~ProfileZone();
+
+public: // Copy / Move
+
+    ProfileZone(const ProfileZone &) = delete;
+
+    ProfileZone & operator=(const ProfileZone &) = delete;
+
+private: // Members
+
+    const char * m_Name;
+    uint64_t     m_BeginNs;
+};
+
+//
+// ProfileTrack
+//
+
+// Timeline of its own for zones that don't happen on the recording thread, e.g. GPU work.
+// Must only be recorded to by one thread at a time.
+class ProfileTrack final
+{
+public: // Construction
+
+    explicit ProfileTrack(const std::string & name);
+
+public: // Interface
+
+    void RecordZone(const char * const name, const uint64_t beginNs, const uint64_t endNs);
+
+private: // Members
+
+    std::shared_ptr<detail::ProfileTrackState> m_State;
+};
+
+//
+// ProfilingSession
+//
+
+// Periodically flushes zones recorded on every thread into a Chrome Trace Event JSON file,
+// which can be opened with chrome://tracing or ui.perfetto.dev. Only one session may be active at a time.
+class ProfilingSession final
+{
+public: // Construction / Destruction
+
+    explicit ProfilingSession(const std::string & traceFilePath);
+
+    ~ProfilingSession();
+
+public: // Copy / Move
+
+    ProfilingSession(const ProfilingSession &) = delete;
+
+    ProfilingSession & operator=(const ProfilingSession &) = delete;
+
+private: // Service
+
+    void RunFlusher();
+
+    void Flush();
+
+    void WriteThreadNames();
+
+private: // Members
+
+    std::ofstream m_TraceFile;
+    uint64_t      m_StartNs;
+    bool          m_HasWrittenEvents;
+
+    std::mutex              m_Mutex;
+    std::condition_variable m_StopCondition;
+    bool                    m_IsStopping;
+
+    std::thread m_FlusherThread;
+};
+
+//
+// Exceptions
+//
+
+class ProfilingSessionException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit ProfilingSessionException(const std::string & traceFilePath);
+};
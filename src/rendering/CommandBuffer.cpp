@@ -0,0 +1,222 @@
+#include "CommandBuffer.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "gl/statistics.h"
+
+//
+// Recording
+//
+
+void CommandBuffer::Clear()
+{
+    m_Data.clear();
+    m_CommandCount = 0;
+    m_StreamedData.clear();
+}
+
+void CommandBuffer::BindShaderProgram(StatefulShaderProgram * const shaderProgram)
+{
+    assert(shaderProgram != nullptr);
+
+    Write(CommandType::BindShaderProgram, BindShaderProgramCommand{shaderProgram});
+}
+
+void CommandBuffer::BindMaterial(const Material * const material)
+{
+    assert(material != nullptr);
+
+    Write(CommandType::BindMaterial, BindMaterialCommand{material});
+}
+
+void CommandBuffer::BindMesh(const Mesh * const mesh)
+{
+    assert(mesh != nullptr);
+
+    Write(CommandType::BindMesh, BindMeshCommand{mesh});
+}
+
+void CommandBuffer::BindTexture(const GLuint textureUnitIdx, const GLuint texture)
+{
+    Write(CommandType::BindTexture, BindTextureCommand{textureUnitIdx, texture});
+}
+
+void CommandBuffer::SetUniform(const UniformId uniformId, const UniformValue & uniformValue)
+{
+    Write(CommandType::SetUniform, SetUniformCommand{uniformId, uniformValue});
+}
+
+void CommandBuffer::BindUniformBufferRange(
+    const GLuint     bindingIdx,
+    const GLuint     buffer,
+    const GLintptr   offset,
+    const GLsizeiptr size
+)
+{
+    Write(CommandType::BindUniformBufferRange, BindUniformBufferRangeCommand{bindingIdx, buffer, offset, size});
+}
+
+void CommandBuffer::BindStreamedUniformRange(const GLuint bindingIdx, const void * const data, const GLsizeiptr size)
+{
+    assert(data != nullptr);
+    assert(size > 0);
+
+    const size_t relativeOffset = (m_StreamedData.size() + MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT - 1)
+        / MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT * MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT;
+
+    m_StreamedData.resize(relativeOffset + static_cast<size_t>(size));
+    std::memcpy(m_StreamedData.data() + relativeOffset, data, static_cast<size_t>(size));
+
+    Write(
+        CommandType::BindStreamedUniformRange,
+        BindStreamedUniformRangeCommand{bindingIdx, static_cast<GLintptr>(relativeOffset), size}
+    );
+}
+
+void CommandBuffer::Draw(const GLenum mode)
+{
+    Write(CommandType::Draw, DrawCommand{mode});
+}
+
+//
+// Interface
+//
+
+bool CommandBuffer::IsEmpty() const
+{
+    return m_CommandCount == 0;
+}
+
+size_t CommandBuffer::GetCommandCount() const
+{
+    return m_CommandCount;
+}
+
+const std::vector<std::byte> & CommandBuffer::GetStreamedData() const
+{
+    return m_StreamedData;
+}
+
+void CommandBuffer::Execute(const GLuint streamedDataBuffer, const GLintptr streamedDataOffset) const
+{
+    assert((m_StreamedData.empty() || streamedDataBuffer != INVALID_OPENGL_BUFFER) && "streamed data must be uploaded");
+    assert(streamedDataOffset % MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT == 0);
+
+    StatefulShaderProgram * currentShaderProgram = nullptr;
+    const Mesh *            currentMesh          = nullptr;
+
+    const std::byte *       data    = m_Data.data();
+    const std::byte * const dataEnd = data + m_Data.size();
+
+    while (data < dataEnd)
+    {
+        switch (Read<CommandType>(data))
+        {
+        case CommandType::BindShaderProgram:
+            currentShaderProgram = Read<BindShaderProgramCommand>(data).ShaderProgram;
+            currentShaderProgram->Use();
+            break;
+
+        case CommandType::BindMaterial:
+        {
+            const Material * const material = Read<BindMaterialCommand>(data).BoundMaterial;
+            assert(material->GetShaderProgram() == currentShaderProgram && "material's shader program must be bound");
+
+            material->Bind();
+            break;
+        }
+
+        case CommandType::BindMesh:
+            currentMesh = Read<BindMeshCommand>(data).BoundMesh;
+            currentMesh->Bind();
+            break;
+
+        case CommandType::BindTexture:
+        {
+            const BindTextureCommand command = Read<BindTextureCommand>(data);
+
+            glActiveTexture(GL_TEXTURE0 + command.TextureUnitIdx);
+            glBindTexture(GL_TEXTURE_2D, command.Texture);
+
+            CountRenderStatistic(RenderCounter::TextureBinds);
+            break;
+        }
+
+        case CommandType::SetUniform:
+        {
+            const SetUniformCommand command = Read<SetUniformCommand>(data);
+            assert(currentShaderProgram != nullptr && "shader program must be bound before setting uniforms");
+
+            currentShaderProgram->SetUniformValue(currentShaderProgram->GetUniformLocation(command.Uniform), command.Value);
+            break;
+        }
+
+        case CommandType::BindUniformBufferRange:
+        {
+            const BindUniformBufferRangeCommand command = Read<BindUniformBufferRangeCommand>(data);
+
+            glBindBufferRange(GL_UNIFORM_BUFFER, command.BindingIdx, command.Buffer, command.Offset, command.Size);
+            break;
+        }
+
+        case CommandType::BindStreamedUniformRange:
+        {
+            const BindStreamedUniformRangeCommand command = Read<BindStreamedUniformRangeCommand>(data);
+
+            glBindBufferRange(
+                GL_UNIFORM_BUFFER,
+                command.BindingIdx,
+                streamedDataBuffer,
+                streamedDataOffset + command.RelativeOffset,
+                command.Size
+            );
+            break;
+        }
+
+        case CommandType::Draw:
+            assert(currentMesh != nullptr && "mesh must be bound before drawing");
+
+            currentMesh->Render(Read<DrawCommand>(data).Mode);
+            break;
+
+        default:
+            assert(false && "unrecognized render command type");
+            return;
+        }
+    }
+
+    assert(data == dataEnd);
+}
+
+//
+// Service
+//
+
+template <typename Command>
+void CommandBuffer::Write(const CommandType commandType, const Command & command)
+{
+    static_assert(std::is_trivially_copyable_v<Command>);
+
+    const size_t offset = m_Data.size();
+    m_Data.resize(offset + sizeof(CommandType) + sizeof(Command));
+
+    std::memcpy(m_Data.data() + offset, &commandType, sizeof(CommandType));
+    std::memcpy(m_Data.data() + offset + sizeof(CommandType), &command, sizeof(Command));
+
+    m_CommandCount++;
+}
+
+// Commands are packed without padding, hence the copy instead of an in-place cast.
+template <typename Command>
+Command CommandBuffer::Read(const std::byte *& data)
+{
+    static_assert(std::is_trivially_copyable_v<Command>);
+
+    Command command;
+    std::memcpy(&command, data, sizeof(Command));
+
+    data += sizeof(Command);
+
+    return command;
+}
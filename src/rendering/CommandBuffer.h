@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+
+#include <glad/glad.h>
+
+#include "gl/constants.h"
+#include "gl/StatefulShaderProgram.h"
+#include "meshes/Mesh.h"
+
+#include "Material.h"
+
+//
+// CommandBuffer
+//
+
+// Linear buffer of packed render commands. Recording doesn't touch GL, so it may happen on any thread,
+// while execution must happen on the thread owning the GL context. Referenced shader programs, materials
+// and meshes must outlive the recorded commands. Streamed data is staged alongside the commands and has to be
+// uploaded into a streaming buffer by the executing thread, see StreamingBuffer.
+class CommandBuffer final
+{
+public: // Construction
+
+    CommandBuffer() = default;
+
+public: // Copy / Move
+
+    CommandBuffer(const CommandBuffer &) = delete;
+
+    CommandBuffer(CommandBuffer &&) = default;
+
+    CommandBuffer & operator=(const CommandBuffer &) = delete;
+
+    CommandBuffer & operator=(CommandBuffer &&) = default;
+
+public: // Recording
+
+    // Keeps allocated storage, so that buffers reused every frame don't allocate in steady state.
+    void Clear();
+
+    void BindShaderProgram(StatefulShaderProgram * const shaderProgram);
+
+    // Binds the material's parameters and textures, its program must be bound by a preceding BindShaderProgram().
+    void BindMaterial(const Material * const material);
+
+    void BindMesh(const Mesh * const mesh);
+
+    void BindTexture(const GLuint textureUnitIdx, const GLuint texture);
+
+    // Applies to the shader program bound by the last preceding BindShaderProgram() command.
+    void SetUniform(const UniformId uniformId, const UniformValue & uniformValue);
+
+    void BindUniformBufferRange(const GLuint bindingIdx, const GLuint buffer, const GLintptr offset, const GLsizeiptr size);
+
+    // Copies the data into the staged streamed data, to be bound from wherever it gets uploaded to on execution.
+    void BindStreamedUniformRange(const GLuint bindingIdx, const void * const data, const GLsizeiptr size);
+
+    // Draws the mesh bound by the last preceding BindMesh() command.
+    void Draw(const GLenum mode);
+
+public: // Interface
+
+    bool IsEmpty() const;
+
+    size_t GetCommandCount() const;
+
+    // Staged data ranges are aligned relative to the start, which must thus be uploaded
+    // at an offset aligned to MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+    const std::vector<std::byte> & GetStreamedData() const;
+
+    void Execute(
+        const GLuint   streamedDataBuffer = INVALID_OPENGL_BUFFER,
+        const GLintptr streamedDataOffset = 0
+    ) const;
+
+private: // Service types
+
+    enum class CommandType: uint8_t
+    {
+        BindShaderProgram,
+        BindMaterial,
+        BindMesh,
+        BindTexture,
+        SetUniform,
+        BindUniformBufferRange,
+        BindStreamedUniformRange,
+        Draw
+    };
+
+    struct BindShaderProgramCommand final
+    {
+        StatefulShaderProgram * ShaderProgram;
+    };
+
+    struct BindMaterialCommand final
+    {
+        const Material * BoundMaterial;
+    };
+
+    struct BindMeshCommand final
+    {
+        const Mesh * BoundMesh;
+    };
+
+    struct BindTextureCommand final
+    {
+        GLuint TextureUnitIdx;
+        GLuint Texture;
+    };
+
+    struct SetUniformCommand final
+    {
+        UniformId    Uniform;
+        UniformValue Value;
+    };
+
+    struct BindUniformBufferRangeCommand final
+    {
+        GLuint     BindingIdx;
+        GLuint     Buffer;
+        GLintptr   Offset;
+        GLsizeiptr Size;
+    };
+
+    struct BindStreamedUniformRangeCommand final
+    {
+        GLuint     BindingIdx;
+        GLintptr   RelativeOffset;
+        GLsizeiptr Size;
+    };
+
+    struct DrawCommand final
+    {
+        GLenum Mode;
+    };
+
+private: // Service
+
+    template <typename Command>
+    void Write(const CommandType commandType, const Command & command);
+
+    template <typename Command>
+    static Command Read(const std::byte *& data);
+
+private: // Members
+
+    std::vector<std::byte> m_Data;
+    size_t                 m_CommandCount = 0;
+    std::vector<std::byte> m_StreamedData;
+};
@@ -0,0 +1,51 @@
+#include "Material.h"
+
+#include <cassert>
+#include <utility>
+
+#include "gl/constants.h"
+#include "gl/statistics.h"
+
+#include "uniform_blocks.h"
+
+//
+// Construction
+//
+
+Material::Material(
+    const uint64_t               sortId,
+    StatefulShaderProgram *      shaderProgram,
+    const GLuint                 parameterBuffer,
+    const GLintptr               parameterOffset,
+    const GLsizeiptr             parameterSize,
+    std::vector<MaterialTexture> textures
+):
+    m_SortId         (sortId),
+    m_ShaderProgram  (shaderProgram),
+    m_ParameterBuffer(parameterBuffer),
+    m_ParameterOffset(parameterOffset),
+    m_ParameterSize  (parameterSize),
+    m_Textures       (std::move(textures))
+{
+    assert(m_ShaderProgram != nullptr);
+    assert((m_ParameterSize == 0 || m_ParameterBuffer != INVALID_OPENGL_BUFFER) && "parameters must be in a buffer");
+    assert(m_ParameterOffset % MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT == 0);
+}
+
+//
+// Interface
+//
+
+void Material::Bind() const
+{
+    if (m_ParameterSize > 0)
+        glBindBufferRange(GL_UNIFORM_BUFFER, MATERIAL_UNIFORM_BLOCK_BINDING, m_ParameterBuffer, m_ParameterOffset, m_ParameterSize);
+
+    for (const MaterialTexture & texture : m_Textures)
+    {
+        glActiveTexture(GL_TEXTURE0 + texture.TextureUnitIdx);
+        glBindTexture(GL_TEXTURE_2D, texture.Texture);
+
+        CountRenderStatistic(RenderCounter::TextureBinds);
+    }
+}
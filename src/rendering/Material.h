@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+#include <glad/glad.h>
+
+#include "gl/StatefulShaderProgram.h"
+
+//
+// Interface types
+//
+
+struct MaterialTexture final
+{
+    GLuint TextureUnitIdx;
+    GLuint Texture;
+};
+
+//
+// Material
+//
+
+// Shader program, parameters and textures drawn with. The program is used separately, so that consecutive
+// materials sharing it don't switch programs. Parameters live in a range of a uniform buffer laid out as the
+// program's std140 MaterialBlock, so binding them is a single range bind instead of a uniform upload per
+// parameter. Sampler uniforms are program state, so they must be pointed at the texture units once per program,
+// and materials sharing a program must agree on them.
+class Material final
+{
+public: // Construction
+
+    // The program and buffer must outlive the material. An empty parameter range binds no buffer.
+    Material(
+        const uint64_t               sortId,
+        StatefulShaderProgram *      shaderProgram,
+        const GLuint                 parameterBuffer,
+        const GLintptr               parameterOffset,
+        const GLsizeiptr             parameterSize,
+        std::vector<MaterialTexture> textures
+    );
+
+public: // Interface
+
+    // Binds the parameter range to MATERIAL_UNIFORM_BLOCK_BINDING and the textures to their units, expects
+    // the program to be in use already.
+    void Bind() const;
+
+    // Orders materials so that ones sharing a program are adjacent, e.g. for sorting draws.
+    inline uint64_t GetSortId() const;
+
+    inline StatefulShaderProgram * GetShaderProgram() const;
+
+private: // Members
+
+    uint64_t                m_SortId;
+    StatefulShaderProgram * m_ShaderProgram;
+
+    GLuint     m_ParameterBuffer;
+    GLintptr   m_ParameterOffset;
+    GLsizeiptr m_ParameterSize;
+
+    std::vector<MaterialTexture> m_Textures;
+};
+
+//
+// Utilities
+//
+
+// Copies a mirror of a std140 MaterialBlock, see rendering/uniform_blocks.h, into material parameters.
+template <typename UniformBlock>
+std::vector<std::byte> MakeMaterialParameters(const UniformBlock & uniformBlock)
+{
+    static_assert(std::is_trivially_copyable_v<UniformBlock>);
+
+    std::vector<std::byte> parameters(sizeof(UniformBlock));
+    std::memcpy(parameters.data(), &uniformBlock, sizeof(UniformBlock));
+
+    return parameters;
+}
+
+//
+// Interface
+//
+
+inline uint64_t Material::GetSortId() const
+{
+    return m_SortId;
+}
+
+inline StatefulShaderProgram * Material::GetShaderProgram() const
+{
+    return m_ShaderProgram;
+}
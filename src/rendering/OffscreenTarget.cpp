@@ -0,0 +1,80 @@
+#include "OffscreenTarget.h"
+
+#include <cassert>
+#include <string>
+
+#include "gl/constants.h"
+#include "logging.h"
+
+//
+// Construction
+//
+
+OffscreenTarget::OffscreenTarget(const int width, const int height):
+    m_Framebuffer             (UniqueFramebuffer::Create()),
+    m_ColorRenderbuffer       (UniqueRenderbuffer::Create()),
+    m_DepthStencilRenderbuffer(UniqueRenderbuffer::Create()),
+    m_Width                   (0),
+    m_Height                  (0)
+{
+    Resize(width, height);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_ColorRenderbuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencilRenderbuffer);
+
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, DEFAULT_OPENGL_FRAMEBUFFER);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        throw IncompleteFramebufferException(status);
+
+    LOG_INFO<< "Created offscreen target " << m_Framebuffer << " of " << m_Width << 'x' << m_Height;
+}
+
+//
+// Interface
+//
+
+void OffscreenTarget::Resize(const int width, const int height)
+{
+    assert(width > 0);
+    assert(height > 0);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, m_ColorRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, m_DepthStencilRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, INVALID_OPENGL_RENDERBUFFER);
+
+    m_Width  = width;
+    m_Height = height;
+}
+
+void OffscreenTarget::Bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+}
+
+int OffscreenTarget::GetWidth() const
+{
+    return m_Width;
+}
+
+int OffscreenTarget::GetHeight() const
+{
+    return m_Height;
+}
+
+//
+// Exceptions
+//
+
+IncompleteFramebufferException::IncompleteFramebufferException(const GLenum status):
+    std::runtime_error("Framebuffer is incomplete with status " + std::to_string(status))
+{
+    // Empty
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <glad/glad.h>
+
+#include "gl/wrappers.h"
+
+//
+// OffscreenTarget
+//
+
+// Framebuffer object with color and depth-stencil renderbuffers, used in place of the window's
+// default framebuffer when rendering headless.
+class OffscreenTarget final
+{
+public: // Construction
+
+    OffscreenTarget(const int width, const int height);
+
+public: // Interface
+
+    // Reallocates the renderbuffers; contents are lost.
+    void Resize(const int width, const int height);
+
+    void Bind() const;
+
+    int GetWidth() const;
+
+    int GetHeight() const;
+
+private: // Members
+
+    UniqueFramebuffer  m_Framebuffer;
+    UniqueRenderbuffer m_ColorRenderbuffer;
+    UniqueRenderbuffer m_DepthStencilRenderbuffer;
+
+    int m_Width;
+    int m_Height;
+};
+
+//
+// Exceptions
+//
+
+class IncompleteFramebufferException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit IncompleteFramebufferException(const GLenum status);
+};
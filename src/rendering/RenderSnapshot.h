@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "meshes/Mesh.h"
+
+#include "CommandBuffer.h"
+#include "Material.h"
+
+//
+// Interface types
+//
+
+// Consecutive items sharing a material or mesh bind it once, so draw lists should be ordered by material sort ID.
+struct DrawItem final
+{
+    const Mesh *     DrawnMesh;
+    const Material * DrawnMaterial;
+    glm::mat4        ModelMatrix;
+};
+
+// Everything the render thread needs to draw a frame, produced by the main thread.
+// Referenced meshes and materials must outlive every snapshot in flight.
+struct RenderSnapshot final
+{
+    uint64_t  FrameIndex;
+    int       FramebufferWidth;
+    int       FramebufferHeight;
+    GLenum    PolygonMode;
+    glm::vec4 ClearRgba;
+    glm::mat4 ViewMatrix;
+    glm::mat4 ProjectionMatrix;
+
+    std::vector<DrawItem> DrawItems;
+
+    // Recorded from the above by RecordRenderSnapshotCommands(), executed in order
+    std::vector<CommandBuffer> CommandBuffers;
+};
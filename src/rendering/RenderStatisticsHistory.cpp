@@ -0,0 +1,74 @@
+#include "RenderStatisticsHistory.h"
+
+#include <cassert>
+#include <algorithm>
+
+#include "logging.h"
+
+//
+// Construction
+//
+
+RenderStatisticsHistory::RenderStatisticsHistory(const size_t windowFrameCount):
+    m_Frames      (windowFrameCount),
+    m_NextFrameIdx(0),
+    m_FrameCount  (0)
+{
+    assert(windowFrameCount > 0);
+}
+
+//
+// Interface
+//
+
+void RenderStatisticsHistory::AddFrame(const RenderStatistics & frameStatistics)
+{
+    m_Frames[m_NextFrameIdx] = frameStatistics;
+
+    m_NextFrameIdx = (m_NextFrameIdx + 1) % m_Frames.size();
+    m_FrameCount   = std::min(m_FrameCount + 1, m_Frames.size());
+}
+
+size_t RenderStatisticsHistory::GetFrameCount() const
+{
+    return m_FrameCount;
+}
+
+RenderStatisticsHistory::Summary RenderStatisticsHistory::GetSummary(const RenderCounter counter) const
+{
+    if (m_FrameCount == 0)
+        return Summary{0, 0.0, 0};
+
+    // Order of frames doesn't matter here, so the filled part of the ring is used as is.
+    std::vector<uint64_t> values(m_FrameCount);
+    for (size_t frameIdx = 0; frameIdx < m_FrameCount; frameIdx++)
+        values[frameIdx] = m_Frames[frameIdx].Get(counter);
+
+    uint64_t sum = 0;
+    for (const uint64_t value : values)
+        sum += value;
+
+    const size_t p99Idx = (values.size() - 1)*99 / 100;
+    std::nth_element(values.begin(), values.begin() + p99Idx, values.end());
+    const uint64_t p99 = values[p99Idx];
+
+    return Summary{
+        *std::min_element(values.cbegin(), values.cend()),
+        static_cast<double>(sum) / static_cast<double>(values.size()),
+        p99
+    };
+}
+
+void RenderStatisticsHistory::LogSummaries() const
+{
+    LOG_DEBUG<< "Render statistics over last " << m_FrameCount << " frames (min/avg/p99):";
+
+    for (size_t counterIdx = 0; counterIdx < RENDER_COUNTER_COUNT; counterIdx++)
+    {
+        const RenderCounter counter = static_cast<RenderCounter>(counterIdx);
+        const Summary       summary = GetSummary(counter);
+
+        LOG_DEBUG<< "    " << RenderCounterToCStr(counter) << ": "
+            << summary.Min << '/' << summary.Avg << '/' << summary.P99;
+    }
+}
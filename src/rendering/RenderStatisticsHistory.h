@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gl/statistics.h"
+
+//
+// RenderStatisticsHistory
+//
+
+// Rolling window of per-frame render statistics.
+class RenderStatisticsHistory final
+{
+public: // Interface types
+
+    struct Summary final
+    {
+        uint64_t Min;
+        double   Avg;
+        uint64_t P99;
+    };
+
+public: // Construction
+
+    explicit RenderStatisticsHistory(const size_t windowFrameCount);
+
+public: // Interface
+
+    void AddFrame(const RenderStatistics & frameStatistics);
+
+    size_t GetFrameCount() const;
+
+    Summary GetSummary(const RenderCounter counter) const;
+
+    void LogSummaries() const;
+
+private: // Members
+
+    std::vector<RenderStatistics> m_Frames;
+    size_t                        m_NextFrameIdx;
+    size_t                        m_FrameCount;
+};
@@ -0,0 +1,309 @@
+#include "RenderThread.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <chrono>
+
+#include <GLFW/glfw3.h>
+
+#include "gl/constants.h"
+#include "gl/debug.h"
+#include "gl/statistics.h"
+#include "gl/utils.h"
+#include "gl/backends/recording.h"
+#include "logging.h"
+#include "config.h"
+#include "profiling/profiling.h"
+
+#include "submission.h"
+
+//
+// Construction / Destruction
+//
+
+RenderThread::RenderThread(GLFWwindow * const window, const size_t maxFramesInFlight, const bool isOffscreen):
+    m_Window                    (window),
+    m_IsOffscreen               (isOffscreen),
+    m_HasContext                (glfwGetWindowAttrib(window, GLFW_CLIENT_API) != GLFW_NO_API),
+    m_Snapshots                 (maxFramesInFlight + 1),
+    m_FreeSnapshots             (),
+    m_SubmittedSnapshots        (),
+    m_AcquiredSnapshot          (std::nullopt),
+    m_IsRendering               (false),
+    m_IsStopping                (false),
+    m_RenderException           (),
+    m_Mutex                     (),
+    m_SnapshotSubmittedCondition(),
+    m_SnapshotFreedCondition    (),
+    m_ViewportWidth             (-1),
+    m_ViewportHeight            (-1),
+    m_PolygonMode               (GL_NONE),
+    m_RenderStatisticsHistory   (RENDER_STATISTICS_WINDOW_FRAMES),
+    m_FrameReportCallback       (),
+    m_FrameBeginCallback        (),
+    m_Thread                    ()
+{
+    assert(m_Window != nullptr);
+    assert(
+        (!m_HasContext || glfwGetCurrentContext() == m_Window)
+            && "RenderThread must be created by the thread owning the GL context"
+    );
+
+    for (size_t snapshotIdx = 0; snapshotIdx < m_Snapshots.size(); snapshotIdx++)
+        m_FreeSnapshots.push_back(snapshotIdx);
+
+    if (m_HasContext)
+        glfwMakeContextCurrent(nullptr);
+
+    m_Thread = std::thread(&RenderThread::Run, this);
+
+    LOG_INFO<< "Started " << (m_IsOffscreen ? "offscreen " : "") << "render thread with up to "
+        << maxFramesInFlight << " frames in flight";
+}
+
+RenderThread::~RenderThread()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+
+        m_IsStopping = true;
+    }
+
+    m_SnapshotSubmittedCondition.notify_all();
+
+    m_Thread.join();
+
+    if (m_HasContext)
+        glfwMakeContextCurrent(m_Window);
+
+    LOG_INFO<< "Stopped render thread";
+}
+
+//
+// Interface
+//
+
+RenderSnapshot & RenderThread::AcquireSnapshot()
+{
+    PROFILE_SCOPE("AcquireSnapshot");
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    assert(!m_AcquiredSnapshot.has_value() && "previously acquired snapshot must be submitted first");
+
+    m_SnapshotFreedCondition.wait(lock, [this] { return !m_FreeSnapshots.empty() || m_RenderException; });
+
+    RethrowRenderException();
+
+    m_AcquiredSnapshot = m_FreeSnapshots.front();
+    m_FreeSnapshots.pop_front();
+
+    return m_Snapshots[*m_AcquiredSnapshot];
+}
+
+void RenderThread::SubmitSnapshot()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+        assert(m_AcquiredSnapshot.has_value() && "snapshot must be acquired before submission");
+
+        m_SubmittedSnapshots.push_back(*m_AcquiredSnapshot);
+        m_AcquiredSnapshot.reset();
+    }
+
+    m_SnapshotSubmittedCondition.notify_one();
+}
+
+void RenderThread::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    m_SnapshotFreedCondition.wait(
+        lock,
+        [this] { return (m_SubmittedSnapshots.empty() && !m_IsRendering) || m_RenderException; }
+    );
+
+    RethrowRenderException();
+}
+
+void RenderThread::SetFrameReportCallback(RenderFrameReportCallback callback)
+{
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    assert(m_SubmittedSnapshots.empty() && !m_IsRendering && "frame report callback must be set before rendering");
+
+    m_FrameReportCallback = std::move(callback);
+}
+
+void RenderThread::SetFrameBeginCallback(RenderFrameBeginCallback callback)
+{
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    assert(m_SubmittedSnapshots.empty() && !m_IsRendering && "frame begin callback must be set before rendering");
+
+    m_FrameBeginCallback = std::move(callback);
+}
+
+//
+// Service
+//
+
+void RenderThread::Run()
+{
+    PROFILE_THREAD_NAME("Render");
+
+    if (m_HasContext)
+        glfwMakeContextCurrent(m_Window);
+
+    try
+    {
+        if (GetUniformBufferOffsetAlignment() > MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+            throw std::runtime_error("Unsupported uniform buffer offset alignment");
+
+        RenderResources resources{
+            StreamingBuffer(
+                GL_UNIFORM_BUFFER,
+                static_cast<GLsizeiptr>(STREAMING_BUFFER_REGION_SIZE),
+                STREAMING_BUFFER_REGION_COUNT
+            ),
+            GpuProfiler(GPU_PROFILER_FRAME_LATENCY),
+            std::nullopt
+        };
+
+        while (true)
+        {
+            size_t snapshotIdx = m_Snapshots.size();
+
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+
+                m_SnapshotSubmittedCondition.wait(lock, [this] { return m_IsStopping || !m_SubmittedSnapshots.empty(); });
+
+                if (m_IsStopping)
+                    break;
+
+                snapshotIdx = m_SubmittedSnapshots.front();
+                m_SubmittedSnapshots.pop_front();
+
+                m_IsRendering = true;
+            }
+
+            RenderFrame(m_Snapshots[snapshotIdx], resources);
+
+            {
+                const std::lock_guard<std::mutex> lock(m_Mutex);
+
+                m_FreeSnapshots.push_back(snapshotIdx);
+                m_IsRendering = false;
+            }
+
+            m_SnapshotFreedCondition.notify_all();
+        }
+
+        if (m_RenderStatisticsHistory.GetFrameCount() > 0)
+            m_RenderStatisticsHistory.LogSummaries();
+    }
+    catch (...)
+    {
+        LOG_ERROR<< "Render thread stopped due to an exception";
+
+        {
+            const std::lock_guard<std::mutex> lock(m_Mutex);
+
+            m_RenderException = std::current_exception();
+            m_IsRendering     = false;
+        }
+
+        m_SnapshotFreedCondition.notify_all();
+    }
+
+    if (m_HasContext)
+        glfwMakeContextCurrent(nullptr);
+}
+
+void RenderThread::RenderFrame(const RenderSnapshot & snapshot, RenderResources & resources)
+{
+    PROFILE_SCOPE("RenderFrame");
+
+    const auto frameStartTime = std::chrono::steady_clock::now();
+
+    if (m_FrameBeginCallback)
+        m_FrameBeginCallback();
+
+    if (snapshot.FramebufferWidth != m_ViewportWidth || snapshot.FramebufferHeight != m_ViewportHeight)
+    {
+        m_ViewportWidth  = snapshot.FramebufferWidth;
+        m_ViewportHeight = snapshot.FramebufferHeight;
+
+        SetViewportSize(m_ViewportWidth, m_ViewportHeight);
+
+        if (m_IsOffscreen)
+        {
+            if (resources.Offscreen.has_value())
+            {
+                resources.Offscreen->Resize(m_ViewportWidth, m_ViewportHeight);
+            }
+            else
+            {
+                resources.Offscreen.emplace(m_ViewportWidth, m_ViewportHeight);
+                resources.Offscreen->Bind();
+            }
+        }
+    }
+
+    if (snapshot.PolygonMode != m_PolygonMode)
+    {
+        m_PolygonMode = snapshot.PolygonMode;
+
+        glPolygonMode(GL_FRONT_AND_BACK, m_PolygonMode);
+    }
+
+    resources.Profiler.BeginFrame(snapshot.FrameIndex);
+
+    {
+        const GpuProfileScope gpuFrameScope(resources.Profiler, "Frame");
+
+        SubmitRenderSnapshot(snapshot, resources.StreamingUniformBuffer, resources.Profiler);
+    }
+
+    resources.Profiler.EndFrame();
+    resources.Profiler.LogLastFrameTimings();
+
+    if (m_IsOffscreen)
+    {
+        // Nothing is presented, so just make sure the frame's commands get submitted;
+        // streaming buffer fences keep the CPU from running arbitrarily far ahead.
+        glFlush();
+    }
+    else
+    {
+        PROFILE_SCOPE("SwapBuffers");
+
+        glfwSwapBuffers(m_Window);
+    }
+
+    CheckGlErrorsAtFrameEnd();
+
+    MarkGlCaptureFrameEnd();
+
+    const RenderStatistics frameStatistics = TakeRenderStatistics();
+
+    m_RenderStatisticsHistory.AddFrame(frameStatistics);
+
+    if (snapshot.FrameIndex % RENDER_STATISTICS_WINDOW_FRAMES == RENDER_STATISTICS_WINDOW_FRAMES - 1)
+        m_RenderStatisticsHistory.LogSummaries();
+
+    if (m_FrameReportCallback)
+    {
+        m_FrameReportCallback(RenderFrameReport{
+            snapshot.FrameIndex,
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - frameStartTime).count(),
+            frameStatistics,
+            resources.Profiler.GetLastFrameIndex(),
+            resources.Profiler.GetLastFrameTimings()
+        });
+    }
+}
+
+void RenderThread::RethrowRenderException()
+{
+    if (m_RenderException)
+        std::rethrow_exception(m_RenderException);
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <span>
+
+#include <glad/glad.h>
+
+#include "gl/StreamingBuffer.h"
+#include "profiling/GpuProfiler.h"
+
+#include "OffscreenTarget.h"
+#include "RenderSnapshot.h"
+#include "RenderStatisticsHistory.h"
+
+struct GLFWwindow;
+
+//
+// Interface types
+//
+
+struct RenderFrameReport final
+{
+    uint64_t         FrameIndex;
+    float            CpuSeconds;
+    RenderStatistics Statistics;
+
+    // GPU timings become available a few frames late, hence the separate frame index.
+    std::optional<uint64_t>         GpuFrameIndex;
+    std::span<const GpuScopeTiming> GpuTimings;
+};
+
+using RenderFrameReportCallback = std::function<void(const RenderFrameReport &)>;
+
+using RenderFrameBeginCallback = std::function<void()>;
+
+//
+// RenderThread
+//
+
+// Owns the window's GL context for its lifetime: the context is released by the constructing thread
+// on construction and made current on it again on destruction. Snapshots are multi-buffered,
+// so that the main thread can fill the next one while the previous ones are being rendered.
+// Offscreen render threads draw into a framebuffer object instead of the window and never swap buffers.
+class RenderThread final
+{
+public: // Construction / Destruction
+
+    RenderThread(GLFWwindow * const window, const size_t maxFramesInFlight, const bool isOffscreen);
+
+    ~RenderThread();
+
+public: // Copy / Move
+
+    RenderThread(const RenderThread &) = delete;
+
+    RenderThread(RenderThread &&) = delete;
+
+    RenderThread & operator=(const RenderThread &) = delete;
+
+    RenderThread & operator=(RenderThread &&) = delete;
+
+public: // Interface
+
+    // Blocks until a snapshot is no longer used by the render thread.
+    RenderSnapshot & AcquireSnapshot();
+
+    void SubmitSnapshot();
+
+    void WaitIdle();
+
+    // Called on the render thread after every frame. Must be set before the first snapshot submission.
+    void SetFrameReportCallback(RenderFrameReportCallback callback);
+
+    // Called on the render thread before every frame, e.g. to swap in reloaded shader programs
+    // in between frames. Must be set before the first snapshot submission.
+    void SetFrameBeginCallback(RenderFrameBeginCallback callback);
+
+private: // Service types
+
+    // Owned by the render thread, since both their creation and destruction require the GL context.
+    struct RenderResources final
+    {
+        StreamingBuffer                StreamingUniformBuffer;
+        GpuProfiler                    Profiler;
+        std::optional<OffscreenTarget> Offscreen;
+    };
+
+private: // Service
+
+    void Run();
+
+    void RenderFrame(const RenderSnapshot & snapshot, RenderResources & resources);
+
+    void RethrowRenderException();
+
+private: // Members
+
+    GLFWwindow * const m_Window;
+    const bool         m_IsOffscreen;
+    // False with the null GL backend, whose windows have no context to hand over
+    const bool         m_HasContext;
+
+    std::vector<RenderSnapshot> m_Snapshots;
+    std::deque<size_t>          m_FreeSnapshots;
+    std::deque<size_t>          m_SubmittedSnapshots;
+    std::optional<size_t>       m_AcquiredSnapshot;
+    bool                        m_IsRendering;
+    bool                        m_IsStopping;
+    std::exception_ptr          m_RenderException;
+
+    std::mutex              m_Mutex;
+    std::condition_variable m_SnapshotSubmittedCondition;
+    std::condition_variable m_SnapshotFreedCondition;
+
+    // Render thread state
+    int                       m_ViewportWidth;
+    int                       m_ViewportHeight;
+    GLenum                    m_PolygonMode;
+    RenderStatisticsHistory   m_RenderStatisticsHistory;
+    RenderFrameReportCallback m_FrameReportCallback;
+    RenderFrameBeginCallback  m_FrameBeginCallback;
+
+    std::thread m_Thread;
+};
@@ -0,0 +1,121 @@
+#include "recording.h"
+
+#include <cassert>
+#include <algorithm>
+#include <span>
+
+#include "profiling/profiling.h"
+
+#include "uniform_blocks.h"
+
+//
+// Constants
+//
+
+// Below this, the cost of handing a chunk over to a worker exceeds the cost of recording it.
+static constexpr size_t MIN_DRAW_ITEMS_PER_COMMAND_BUFFER = 256;
+
+static const UniformId MODEL_UNIFORM_ID = InternUniformName("model");
+
+//
+// Forward declarations
+//
+
+static void RecordFrameSetupCommands(const RenderSnapshot & snapshot, CommandBuffer & commandBuffer);
+
+static void RecordDrawItemCommands(std::span<const DrawItem> drawItems, CommandBuffer & commandBuffer);
+
+//
+// Utilities
+//
+
+void RecordRenderSnapshotCommands(RenderSnapshot & snapshot, ThreadPool * const threadPool)
+{
+    PROFILE_SCOPE("RecordRenderSnapshotCommands");
+
+    const size_t drawItemCount = snapshot.DrawItems.size();
+    const size_t workerCount   = threadPool != nullptr ? threadPool->GetThreadCount() + 1 : 1;
+
+    const size_t drawItemsPerChunk = std::max(
+        MIN_DRAW_ITEMS_PER_COMMAND_BUFFER,
+        (drawItemCount + workerCount - 1) / workerCount
+    );
+    const size_t chunkCount = (drawItemCount + drawItemsPerChunk - 1) / drawItemsPerChunk;
+
+    // The first command buffer holds per-frame state setup
+    snapshot.CommandBuffers.resize(chunkCount + 1);
+
+    for (CommandBuffer & commandBuffer : snapshot.CommandBuffers)
+        commandBuffer.Clear();
+
+    RecordFrameSetupCommands(snapshot, snapshot.CommandBuffers.front());
+
+    const auto recordChunk = [&snapshot, drawItemCount, drawItemsPerChunk] (const size_t chunkIdx)
+    {
+        const size_t chunkStart = chunkIdx*drawItemsPerChunk;
+        const size_t chunkEnd   = std::min(chunkStart + drawItemsPerChunk, drawItemCount);
+
+        RecordDrawItemCommands(
+            std::span<const DrawItem>(snapshot.DrawItems).subspan(chunkStart, chunkEnd - chunkStart),
+            snapshot.CommandBuffers[chunkIdx + 1]
+        );
+    };
+
+    if (threadPool == nullptr || chunkCount <= 1)
+    {
+        for (size_t chunkIdx = 0; chunkIdx < chunkCount; chunkIdx++)
+            recordChunk(chunkIdx);
+
+        return;
+    }
+
+    threadPool->RunParallel(chunkCount, recordChunk);
+}
+
+//
+// Service
+//
+
+static void RecordFrameSetupCommands(const RenderSnapshot & snapshot, CommandBuffer & commandBuffer)
+{
+    const FrameUniformBlock frameUniformBlock{snapshot.ViewMatrix, snapshot.ProjectionMatrix};
+
+    commandBuffer.BindStreamedUniformRange(FRAME_UNIFORM_BLOCK_BINDING, &frameUniformBlock, sizeof(frameUniformBlock));
+}
+
+static void RecordDrawItemCommands(std::span<const DrawItem> drawItems, CommandBuffer & commandBuffer)
+{
+    PROFILE_SCOPE("RecordDrawItemCommands");
+
+    const StatefulShaderProgram * boundShaderProgram = nullptr;
+    const Material *              boundMaterial      = nullptr;
+    const Mesh *                  boundMesh          = nullptr;
+
+    for (const DrawItem & drawItem : drawItems)
+    {
+        assert(drawItem.DrawnMesh != nullptr);
+        assert(drawItem.DrawnMaterial != nullptr);
+
+        if (drawItem.DrawnMesh != boundMesh)
+        {
+            commandBuffer.BindMesh(drawItem.DrawnMesh);
+            boundMesh = drawItem.DrawnMesh;
+        }
+
+        // Materials sharing a program are adjacent once sorted, so switching between them keeps the program.
+        if (drawItem.DrawnMaterial->GetShaderProgram() != boundShaderProgram)
+        {
+            commandBuffer.BindShaderProgram(drawItem.DrawnMaterial->GetShaderProgram());
+            boundShaderProgram = drawItem.DrawnMaterial->GetShaderProgram();
+        }
+
+        if (drawItem.DrawnMaterial != boundMaterial)
+        {
+            commandBuffer.BindMaterial(drawItem.DrawnMaterial);
+            boundMaterial = drawItem.DrawnMaterial;
+        }
+
+        commandBuffer.SetUniform(MODEL_UNIFORM_ID, drawItem.ModelMatrix);
+        commandBuffer.Draw(GL_TRIANGLES);
+    }
+}
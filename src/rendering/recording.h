@@ -0,0 +1,13 @@
+#pragma once
+
+#include "threading/ThreadPool.h"
+
+#include "RenderSnapshot.h"
+
+//
+// Utilities
+//
+
+// Records the snapshot's command buffers from its draw list, splitting large draw lists
+// across the thread pool's workers. Doesn't issue any GL calls.
+void RecordRenderSnapshotCommands(RenderSnapshot & snapshot, ThreadPool * const threadPool);
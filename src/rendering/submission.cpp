@@ -0,0 +1,66 @@
+#include "submission.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "gl/constants.h"
+#include "profiling/profiling.h"
+
+//
+// Utilities
+//
+
+void SubmitRenderSnapshot(const RenderSnapshot & snapshot, StreamingBuffer & streamingBuffer, GpuProfiler & gpuProfiler)
+{
+    // Reused across frames, since submission only ever happens on the render thread.
+    static thread_local std::vector<GLintptr> s_StreamedDataOffsets;
+
+    PROFILE_SCOPE("SubmitRenderSnapshot");
+
+    s_StreamedDataOffsets.assign(snapshot.CommandBuffers.size(), 0);
+
+    streamingBuffer.BeginFrame();
+
+    for (size_t commandBufferIdx = 0; commandBufferIdx < snapshot.CommandBuffers.size(); commandBufferIdx++)
+    {
+        const std::vector<std::byte> & streamedData = snapshot.CommandBuffers[commandBufferIdx].GetStreamedData();
+
+        if (streamedData.empty())
+            continue;
+
+        const std::optional<StreamingBuffer::Allocation> allocation = streamingBuffer.Allocate(
+            static_cast<GLsizeiptr>(streamedData.size()),
+            MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+        );
+
+        if (!allocation.has_value())
+        {
+            streamingBuffer.FinishWriting();
+
+            throw std::runtime_error("Streaming buffer region is too small for frame's streamed data");
+        }
+
+        std::memcpy(allocation->Data, streamedData.data(), streamedData.size());
+
+        s_StreamedDataOffsets[commandBufferIdx] = allocation->Offset;
+    }
+
+    streamingBuffer.FinishWriting();
+
+    {
+        const GpuProfileScope gpuClearScope(gpuProfiler, "Clear");
+
+        glClearColor(snapshot.ClearRgba.x, snapshot.ClearRgba.y, snapshot.ClearRgba.z, snapshot.ClearRgba.w);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    {
+        const GpuProfileScope gpuDrawScope(gpuProfiler, "Draw");
+
+        for (size_t commandBufferIdx = 0; commandBufferIdx < snapshot.CommandBuffers.size(); commandBufferIdx++)
+            snapshot.CommandBuffers[commandBufferIdx].Execute(streamingBuffer.Get(), s_StreamedDataOffsets[commandBufferIdx]);
+    }
+
+    streamingBuffer.EndFrame();
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "gl/StreamingBuffer.h"
+#include "profiling/GpuProfiler.h"
+
+#include "RenderSnapshot.h"
+
+//
+// Utilities
+//
+
+// Issues GL commands for the snapshot contents to the currently bound framebuffer,
+// without touching viewport or polygon mode state. Streamed data of the snapshot's command buffers
+// is uploaded into the current frame region of the streaming buffer. GPU time of every pass is measured
+// within the GPU profiler's current frame.
+void SubmitRenderSnapshot(const RenderSnapshot & snapshot, StreamingBuffer & streamingBuffer, GpuProfiler & gpuProfiler);
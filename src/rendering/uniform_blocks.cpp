@@ -0,0 +1,11 @@
+#include "uniform_blocks.h"
+
+//
+// Utilities
+//
+
+void BindSharedUniformBlocks(StatefulShaderProgram & shaderProgram)
+{
+    shaderProgram.BindUniformBlock(FRAME_UNIFORM_BLOCK_NAME, FRAME_UNIFORM_BLOCK_BINDING);
+    shaderProgram.BindUniformBlock(MATERIAL_UNIFORM_BLOCK_NAME, MATERIAL_UNIFORM_BLOCK_BINDING);
+}
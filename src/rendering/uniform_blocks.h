@@ -0,0 +1,63 @@
+#pragma once
+
+#include <string>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "gl/StatefulShaderProgram.h"
+
+//
+// Constants
+//
+
+const std::string FRAME_UNIFORM_BLOCK_NAME = "FrameBlock";
+
+constexpr GLuint FRAME_UNIFORM_BLOCK_BINDING = 0;
+
+// Layout differs per program, see Material
+const std::string MATERIAL_UNIFORM_BLOCK_NAME = "MaterialBlock";
+
+constexpr GLuint MATERIAL_UNIFORM_BLOCK_BINDING = 1;
+
+//
+// Interface types
+//
+
+// Mirrors FrameBlock std140 layout, in which every mat4 column is vec4-aligned, so no padding is needed.
+struct FrameUniformBlock final
+{
+    glm::mat4 View;
+    glm::mat4 Projection;
+};
+
+static_assert(sizeof(FrameUniformBlock) == 2*16*sizeof(float));
+
+// Mirrors MaterialBlock of lighting_basic.frag. A float fits in after a vec3, other vec3s are vec4-aligned.
+struct LitMaterialUniformBlock final
+{
+    glm::vec3 ObjectRgb;
+    float     AmbientStrength;
+    glm::vec3 LightRgb;
+    float     Padding0;
+    glm::vec3 LightSourcePosition;
+    float     Padding1;
+};
+
+static_assert(sizeof(LitMaterialUniformBlock) == 3*4*sizeof(float));
+
+// Mirrors MaterialBlock of lighting_trivial_light_source.frag, padded to a vec4 to cover the block size drivers report.
+struct LightSourceMaterialUniformBlock final
+{
+    glm::vec3 LightRgb;
+    float     Padding0;
+};
+
+static_assert(sizeof(LightSourceMaterialUniformBlock) == 4*sizeof(float));
+
+//
+// Utilities
+//
+
+// Binds every shared uniform block the program declares to its fixed binding point.
+void BindSharedUniformBlocks(StatefulShaderProgram & shaderProgram);
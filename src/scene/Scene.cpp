@@ -0,0 +1,199 @@
+#include "Scene.h"
+
+#include <cassert>
+#include <algorithm>
+#include <tuple>
+#include <unordered_set>
+
+#include "gl/constants.h"
+#include "gl/shaders.h"
+#include "rendering/uniform_blocks.h"
+#include "profiling/profiling.h"
+
+//
+// Constants
+//
+
+static const std::vector<std::string> FALLBACK_SHADER_FILENAMES{"basic_mvp.vert", "fallback.frag"};
+
+//
+// Utilities
+//
+
+StatefulShaderProgram & InitSceneFallbackShaderProgram(Scene & scene, const bool areShaderProgramsReloadable)
+{
+    scene.FallbackShaderProgram = std::make_unique<StatefulShaderProgram>(
+        MakeShaderProgramFromFiles(FALLBACK_SHADER_FILENAMES)
+    );
+
+    if (areShaderProgramsReloadable)
+        scene.FallbackShaderProgram->EnableReloading();
+
+    BindSharedUniformBlocks(*scene.FallbackShaderProgram);
+
+    scene.ShaderPermutations = std::make_unique<ShaderPermutationCache>(
+        scene.FallbackShaderProgram.get(),
+        [] (StatefulShaderProgram & shaderProgram) { BindSharedUniformBlocks(shaderProgram); },
+        areShaderProgramsReloadable
+    );
+
+    return *scene.FallbackShaderProgram;
+}
+
+void AddSceneShaderPrograms(Scene & scene, const std::vector<std::vector<std::string>> & shaderSourceFilenameLists)
+{
+    assert(scene.ShaderPermutations != nullptr && "scene fallback shader program must be initialized");
+
+    std::vector<ShaderPermutation> permutations;
+    permutations.reserve(shaderSourceFilenameLists.size());
+
+    for (const std::vector<std::string> & shaderSourceFilenames : shaderSourceFilenameLists)
+        permutations.push_back(ShaderPermutation{shaderSourceFilenames, {}});
+
+    scene.ShaderPermutations->WarmUp(permutations);
+
+    for (ShaderPermutation & permutation : permutations)
+    {
+        scene.ShaderPrograms.push_back(&scene.ShaderPermutations->Get(permutation));
+        scene.ShaderProgramPermutations.push_back(std::move(permutation));
+    }
+}
+
+void WatchSceneShaderPrograms(Scene & scene, ShaderHotReloader & shaderHotReloader)
+{
+    assert(scene.FallbackShaderProgram != nullptr && "scene fallback shader program must be initialized");
+    assert(scene.ShaderPermutations->AreProgramsReloadable() && "scene shader programs must be reloadable");
+    assert(scene.ShaderProgramPermutations.size() == scene.ShaderPrograms.size());
+
+    shaderHotReloader.Watch(*scene.FallbackShaderProgram, ShaderPermutation{FALLBACK_SHADER_FILENAMES, {}});
+
+    // Reloadable programs are only shared by equal permutations, which are watched once.
+    std::unordered_set<const StatefulShaderProgram *> watchedShaderPrograms;
+
+    for (size_t shaderProgramIdx = 0; shaderProgramIdx < scene.ShaderPrograms.size(); shaderProgramIdx++)
+    {
+        if (watchedShaderPrograms.insert(scene.ShaderPrograms[shaderProgramIdx]).second)
+            shaderHotReloader.Watch(*scene.ShaderPrograms[shaderProgramIdx], scene.ShaderProgramPermutations[shaderProgramIdx]);
+    }
+}
+
+void InitSceneMaterials(Scene & scene, const std::vector<SceneMaterialDescription> & materialDescriptions)
+{
+    assert(scene.Materials.empty() && "scene materials must only be initialized once");
+
+    // Ranges are bound separately, so each of them starts at an offset aligned for binding.
+    std::vector<std::byte> parameterData;
+    std::vector<GLintptr>  parameterOffsets;
+    parameterOffsets.reserve(materialDescriptions.size());
+
+    for (const SceneMaterialDescription & materialDescription : materialDescriptions)
+    {
+        const size_t parameterOffset = (parameterData.size() + MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT - 1)
+            / MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT * MAX_UNIFORM_BUFFER_OFFSET_ALIGNMENT;
+
+        parameterData.resize(parameterOffset + materialDescription.Parameters.size());
+        std::copy(materialDescription.Parameters.cbegin(), materialDescription.Parameters.cend(), parameterData.begin() + parameterOffset);
+
+        parameterOffsets.push_back(static_cast<GLintptr>(parameterOffset));
+    }
+
+    GLuint parameterBuffer = INVALID_OPENGL_BUFFER;
+
+    if (!parameterData.empty())
+    {
+        scene.MaterialParameterBuffer = UniqueBuffer::Create();
+        parameterBuffer               = *scene.MaterialParameterBuffer;
+
+        // Parameters never change, unlike the per-frame data of the streaming buffer.
+        glBindBuffer(GL_UNIFORM_BUFFER, parameterBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(parameterData.size()), parameterData.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, INVALID_OPENGL_BUFFER);
+    }
+
+    scene.Materials.reserve(materialDescriptions.size());
+
+    for (size_t materialIdx = 0; materialIdx < materialDescriptions.size(); materialIdx++)
+    {
+        const SceneMaterialDescription & materialDescription = materialDescriptions[materialIdx];
+        assert(materialDescription.ShaderProgramIdx < scene.ShaderPrograms.size());
+
+        StatefulShaderProgram & shaderProgram = *scene.ShaderPrograms[materialDescription.ShaderProgramIdx];
+
+        shaderProgram.Use();
+
+        std::vector<MaterialTexture> textures;
+        textures.reserve(materialDescription.SamplerTextureIdxs.size());
+
+        for (GLuint textureUnitIdx = 0; textureUnitIdx < materialDescription.SamplerTextureIdxs.size(); textureUnitIdx++)
+        {
+            const auto & [samplerName, textureIdx] = materialDescription.SamplerTextureIdxs[textureUnitIdx];
+            assert(textureIdx < scene.Textures.size());
+
+            shaderProgram.SetUniformValueByName(samplerName, static_cast<GLint>(textureUnitIdx));
+
+            textures.push_back(MaterialTexture{textureUnitIdx, scene.Textures[textureIdx]});
+        }
+
+        // Keyed by the first index of the program, so that materials of permutations sharing it sort together.
+        const size_t shaderProgramKey = static_cast<size_t>(
+            std::find(scene.ShaderPrograms.cbegin(), scene.ShaderPrograms.cend(), &shaderProgram) - scene.ShaderPrograms.cbegin()
+        );
+
+        const uint64_t sortId = (static_cast<uint64_t>(shaderProgramKey) << 32) | materialIdx;
+
+        scene.Materials.emplace_back(
+            sortId,
+            &shaderProgram,
+            parameterBuffer,
+            parameterOffsets[materialIdx],
+            static_cast<GLsizeiptr>(materialDescription.Parameters.size()),
+            std::move(textures)
+        );
+    }
+
+    glUseProgram(INVALID_OPENGL_SHADER);
+}
+
+void SortSceneObjects(Scene & scene)
+{
+    PROFILE_SCOPE("SortSceneObjects");
+
+    // Stable, so that the order is the same with every standard library.
+    std::stable_sort(
+        scene.Objects.begin(),
+        scene.Objects.end(),
+        [&scene] (const SceneObject & lhs, const SceneObject & rhs)
+        {
+            return std::make_tuple(scene.Materials[lhs.MaterialIdx].GetSortId(), lhs.MeshIdx)
+                < std::make_tuple(scene.Materials[rhs.MaterialIdx].GetSortId(), rhs.MeshIdx);
+        }
+    );
+}
+
+void WaitForSceneShaderPrograms(Scene & scene)
+{
+    PROFILE_SCOPE("WaitForSceneShaderPrograms");
+
+    for (StatefulShaderProgram * shaderProgram : scene.ShaderPrograms)
+        shaderProgram->WaitForPendingBuild();
+}
+
+void BuildRenderSnapshot(Scene & scene, const Camera & camera, RenderSnapshot & snapshot)
+{
+    snapshot.ClearRgba        = scene.ClearRgba;
+    snapshot.ViewMatrix       = camera.GetLookAtMatrix();
+    snapshot.ProjectionMatrix = camera.GetProjectionMatrix();
+
+    snapshot.DrawItems.clear();
+    for (const SceneObject & object : scene.Objects)
+    {
+        assert(object.MeshIdx < scene.Meshes.size());
+        assert(object.MaterialIdx < scene.Materials.size());
+
+        snapshot.DrawItems.push_back(DrawItem{
+            &scene.Meshes[object.MeshIdx],
+            &scene.Materials[object.MaterialIdx],
+            object.ModelMatrix
+        });
+    }
+}
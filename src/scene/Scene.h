@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include "gl/wrappers.h"
+#include "gl/StatefulShaderProgram.h"
+#include "gl/ShaderPermutationCache.h"
+#include "gl/ShaderHotReloader.h"
+#include "meshes/Mesh.h"
+#include "camera/Camera.h"
+#include "rendering/Material.h"
+#include "rendering/RenderSnapshot.h"
+
+//
+// Interface types
+//
+
+struct SceneObject final
+{
+    size_t    MeshIdx;
+    size_t    MaterialIdx;
+    glm::mat4 ModelMatrix;
+};
+
+struct SceneMaterialDescription final
+{
+    size_t                 ShaderProgramIdx;
+    // Mirror of the program's std140 MaterialBlock, see MakeMaterialParameters(), empty if it declares none
+    std::vector<std::byte> Parameters;
+    // Sampler uniforms and indices of the scene textures they sample, assigned texture units in this order
+    std::vector<std::pair<std::string, size_t>> SamplerTextureIdxs;
+};
+
+// GL resources are owned by the scene, so it must be destroyed while the GL context is current.
+// Resource collections must not be resized once render snapshots referencing them exist.
+struct Scene final
+{
+    std::vector<Mesh>                  Meshes;
+    // Drawn instead of shader programs whose builds are pending, owned separately to keep its address stable
+    std::unique_ptr<StatefulShaderProgram> FallbackShaderProgram;
+    // Owns the programs, built once per distinct preprocessed sources, or per permutation if reloadable
+    std::unique_ptr<ShaderPermutationCache> ShaderPermutations;
+    // Programs by the indices materials refer to them with, permutations sharing a program share its pointer
+    std::vector<StatefulShaderProgram *> ShaderPrograms;
+    // What each of the shader programs was built from
+    std::vector<ShaderPermutation>     ShaderProgramPermutations;
+    std::vector<UniqueTexture>         Textures;
+    std::vector<Material>              Materials;
+    // Parameters of all the materials, set if any material has parameters
+    std::optional<UniqueBuffer>        MaterialParameterBuffer;
+    std::vector<SceneObject>           Objects;
+    glm::vec4                          ClearRgba;
+
+    // Distance from the origin an overview camera should keep to see the whole scene
+    float OverviewRadius = 1.0f;
+};
+
+//
+// Utilities
+//
+
+// Built blocking, so that it's ready before any other program of the scene. Also sets up the scene's permutation
+// cache, which binds shared uniform blocks of every program it builds. Reloadable programs can be watched, at the
+// cost of tracking every uniform value set on them.
+StatefulShaderProgram & InitSceneFallbackShaderProgram(Scene & scene, const bool areShaderProgramsReloadable);
+
+// Submits builds of all the programs new to the scene's permutation cache as one batch, appending them to the
+// scene's programs, to be drawn with its fallback program until ready.
+void AddSceneShaderPrograms(Scene & scene, const std::vector<std::vector<std::string>> & shaderSourceFilenameLists);
+
+// Watches the scene's programs, its fallback program included, for reloading once their shader files change.
+// They must have been initialized reloadable.
+void WatchSceneShaderPrograms(Scene & scene, ShaderHotReloader & shaderHotReloader);
+
+// Uploads parameters of all the materials into a single uniform buffer and points sampler uniforms of their
+// programs at the texture units. Sort IDs follow the first index of the material's program, then description
+// order. Must only be called once.
+void InitSceneMaterials(Scene & scene, const std::vector<SceneMaterialDescription> & materialDescriptions);
+
+// Orders objects by material sort ID, then mesh, so that draws sharing state are adjacent.
+void SortSceneObjects(Scene & scene);
+
+// Blocks until builds of all the scene's programs complete, e.g. so that benchmarks never measure fallback draws.
+void WaitForSceneShaderPrograms(Scene & scene);
+
+// Reuses the snapshot's storage, so that steady state snapshot building does not allocate.
+void BuildRenderSnapshot(Scene & scene, const Camera & camera, RenderSnapshot & snapshot);
@@ -0,0 +1,143 @@
+#include "demo.h"
+
+#include <array>
+
+#include <glm/ext/matrix_transform.hpp>
+
+#include "gl/constants.h"
+#include "gl/shaders.h"
+#include "meshes/construction.h"
+#include "rendering/uniform_blocks.h"
+#include "textures/TextureLoader.h"
+
+//
+// Constants
+//
+
+static const glm::vec3 SUBJECT_POSITION     (0.0f);
+static const glm::vec3 LIGHT_SOURCE_POSITION(1.2f, 1.0f, 2.0f);
+
+static const glm::vec3 SUBJECT_RGB(0.6f, 0.2f, 0.8f);
+static const glm::vec3 LIGHT_RGB  (1.0f, 1.0f, 1.0f);
+
+static const float AMBIENT_LIGHT_STRENGTH = 0.1f;
+
+static const glm::vec4 CLEAR_RGBA(0.3f, 0.5f, 0.5f, 1.0f);
+
+static const float OVERVIEW_RADIUS = 1.5f;
+
+//
+// Forward declarations
+//
+
+static std::vector<UniqueTexture> CreateDemoTextures(TextureLoader & textureLoader);
+
+//
+// Utilities
+//
+
+Scene CreateDemoScene(TextureLoader & textureLoader, const bool areShaderProgramsReloadable)
+{
+    Scene scene;
+    scene.ClearRgba      = CLEAR_RGBA;
+    scene.OverviewRadius = OVERVIEW_RADIUS;
+
+    // SECTION: Mesh setup
+    // TODO: Refactor mesh creation interface to reduce the number of non-descriptive boolean parameters.
+    const size_t subjectMeshIdx = scene.Meshes.size();
+    scene.Meshes.push_back(CreateUnitCubeMesh(false, true, false, false));
+
+    const size_t lightSourceMeshIdx = scene.Meshes.size();
+    scene.Meshes.push_back(CreateUnitCubeMesh(true, true, false, true));
+    // END SECTION
+
+    // SECTION: Texture setup
+    scene.Textures = CreateDemoTextures(textureLoader);
+    // END SECTION
+
+    // SECTION: Shader setup
+    InitSceneFallbackShaderProgram(scene, areShaderProgramsReloadable);
+
+    // Both programs compile at once, settings made below are applied once they're ready.
+    const size_t subjectShaderProgramIdx     = scene.ShaderPrograms.size();
+    const size_t lightSourceShaderProgramIdx = subjectShaderProgramIdx + 1;
+
+    AddSceneShaderPrograms(scene, {
+        FindMatchingShaderFiles("lighting_basic"),
+        {"basic_mvp.vert", "lighting_trivial_light_source.frag"}
+    });
+    // END SECTION
+
+    // SECTION: Material setup
+    const size_t subjectMaterialIdx     = 0;
+    const size_t lightSourceMaterialIdx = 1;
+
+    InitSceneMaterials(scene, {
+        SceneMaterialDescription{
+            subjectShaderProgramIdx,
+            MakeMaterialParameters(LitMaterialUniformBlock{
+                SUBJECT_RGB,
+                AMBIENT_LIGHT_STRENGTH,
+                LIGHT_RGB,
+                0.0f,
+                LIGHT_SOURCE_POSITION,
+                0.0f
+            }),
+            {} // Demo textures aren't sampled, e.g. {{"tex", 0}, {"tex1", 1}} would bind them to GL_TEXTURE0, GL_TEXTURE1
+        },
+        SceneMaterialDescription{
+            lightSourceShaderProgramIdx,
+            MakeMaterialParameters(LightSourceMaterialUniformBlock{LIGHT_RGB, 0.0f}),
+            {}
+        }
+    });
+    // END SECTION
+
+    scene.Objects.push_back(SceneObject{
+        subjectMeshIdx,
+        subjectMaterialIdx,
+        glm::translate(glm::mat4(1.0f), SUBJECT_POSITION)
+    });
+
+    scene.Objects.push_back(SceneObject{
+        lightSourceMeshIdx,
+        lightSourceMaterialIdx,
+        glm::translate(glm::mat4(1.0f), LIGHT_SOURCE_POSITION)
+    });
+
+    return scene;
+}
+
+//
+// Service
+//
+
+static std::vector<UniqueTexture> CreateDemoTextures(TextureLoader & textureLoader)
+{
+    static const std::array TEXTURE_FILENAMES{
+        "rtwe_output_cropped.jpeg"/*,
+        "white_pawn.png"*/
+    };
+
+    std::vector<UniqueTexture> textures;
+    textures.reserve(TEXTURE_FILENAMES.size());
+
+    // Filled in by later TextureLoader::Update() calls, sampling parameters apply from the start regardless.
+    // They're color maps authored in sRGB, so their mipmaps are filtered in linear space and sampling returns
+    // linear values, matching how learnopengl_texturebake bakes them.
+    for (const char * const textureFilename : TEXTURE_FILENAMES)
+    {
+        textures.push_back(textureLoader.Load(textureFilename, TextureColorSpace::Srgb));
+
+        glBindTexture(GL_TEXTURE_2D, textures.back());
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, INVALID_OPENGL_TEXTURE);
+
+    return textures;
+}
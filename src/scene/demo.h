@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Scene.h"
+#include "textures/TextureLoader.h"
+
+//
+// Utilities
+//
+
+// Requires a current GL context. Textures are loaded by the loader, which must outlive the scene.
+// Shader programs must be reloadable to be watched, see WatchSceneShaderPrograms().
+Scene CreateDemoScene(TextureLoader & textureLoader, const bool areShaderProgramsReloadable = false);
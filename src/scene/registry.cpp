@@ -0,0 +1,160 @@
+#include "registry.h"
+
+#include <map>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <charconv>
+
+#include "utils/string_utils.h"
+
+#include "demo.h"
+#include "stress.h"
+
+//
+// Forward declarations
+//
+
+static const std::map<std::string, std::function<Scene(TextureLoader &)>> & GetSceneFactories();
+
+static std::optional<StressSceneSettings> ParseStressSceneName(const std::string & sceneName);
+
+template <typename T>
+static std::optional<T> ParseUnsigned(const std::string_view value);
+
+//
+// Utilities
+//
+
+Scene CreateNamedScene(const std::string & sceneName, TextureLoader & textureLoader)
+{
+    const auto & sceneFactories = GetSceneFactories();
+
+    const auto sceneFactoryIt = sceneFactories.find(sceneName);
+    if (sceneFactoryIt != sceneFactories.cend())
+        return sceneFactoryIt->second(textureLoader);
+
+    const std::optional<StressSceneSettings> stressSceneSettings = ParseStressSceneName(sceneName);
+    if (!stressSceneSettings.has_value())
+        throw UnknownSceneException(sceneName);
+
+    return CreateStressScene(*stressSceneSettings);
+}
+
+std::vector<std::string> GetSceneNames()
+{
+    std::vector<std::string> sceneNames;
+
+    for (const auto & [sceneName, sceneFactory] : GetSceneFactories())
+        sceneNames.push_back(sceneName);
+
+    for (const StressSceneLayout layout : {StressSceneLayout::Grid, StressSceneLayout::City})
+        sceneNames.push_back(std::string(StressSceneLayoutToCStr(layout)) + ":<object count>[:<seed>]");
+
+    sceneNames.push_back(
+        std::string(StressSceneLayoutToCStr(StressSceneLayout::Hierarchy)) + ":<object count>[:<seed>[:<branching factor>]]"
+    );
+
+    return sceneNames;
+}
+
+//
+// Exceptions
+//
+
+UnknownSceneException::UnknownSceneException(const std::string & sceneName):
+    std::runtime_error("Unknown scene " + sceneName + ", expected one of: " + MakeCommaSeparatedList(GetSceneNames()))
+{
+    // Empty
+}
+
+//
+// Service
+//
+
+static const std::map<std::string, std::function<Scene(TextureLoader &)>> & GetSceneFactories()
+{
+    static const std::map<std::string, std::function<Scene(TextureLoader &)>> SCENE_FACTORIES{
+        {"demo", [] (TextureLoader & textureLoader) { return CreateDemoScene(textureLoader); }}
+    };
+
+    return SCENE_FACTORIES;
+}
+
+// Parses "<layout>:<object count>[:<seed>[:<branching factor>]]", e.g. "city:100000:7" or "hierarchy:100000:1:1".
+// Only the hierarchy layout takes a branching factor.
+static std::optional<StressSceneSettings> ParseStressSceneName(const std::string & sceneName)
+{
+    const size_t countSeparatorPos = sceneName.find(':');
+    if (countSeparatorPos == std::string::npos)
+        return std::nullopt;
+
+    const size_t seedSeparatorPos      = sceneName.find(':', countSeparatorPos + 1);
+    const size_t branchingSeparatorPos = seedSeparatorPos != std::string::npos
+        ? sceneName.find(':', seedSeparatorPos + 1)
+        : std::string::npos;
+
+    const std::string_view name(sceneName);
+    const std::string_view layoutName = name.substr(0, countSeparatorPos);
+    const std::string_view countValue = name.substr(countSeparatorPos + 1, seedSeparatorPos - (countSeparatorPos + 1));
+
+    const std::optional<StressSceneLayout> layout      = ParseStressSceneLayout(layoutName);
+    const std::optional<size_t>            objectCount = ParseUnsigned<size_t>(countValue);
+
+    if (
+        !layout.has_value()
+            || !objectCount.has_value()
+            || *objectCount < MIN_STRESS_SCENE_OBJECT_COUNT
+            || *objectCount > MAX_STRESS_SCENE_OBJECT_COUNT
+    )
+    {
+        return std::nullopt;
+    }
+
+    StressSceneSettings settings;
+    settings.Layout      = *layout;
+    settings.ObjectCount = *objectCount;
+
+    if (seedSeparatorPos != std::string::npos)
+    {
+        const std::optional<uint32_t> seed = ParseUnsigned<uint32_t>(
+            name.substr(seedSeparatorPos + 1, branchingSeparatorPos - (seedSeparatorPos + 1))
+        );
+        if (!seed.has_value())
+            return std::nullopt;
+
+        settings.Seed = *seed;
+    }
+
+    if (branchingSeparatorPos != std::string::npos)
+    {
+        const std::optional<size_t> branchingFactor = ParseUnsigned<size_t>(name.substr(branchingSeparatorPos + 1));
+
+        if (
+            settings.Layout != StressSceneLayout::Hierarchy
+                || !branchingFactor.has_value()
+                || *branchingFactor < MIN_STRESS_SCENE_BRANCHING_FACTOR
+                || *branchingFactor > MAX_STRESS_SCENE_BRANCHING_FACTOR
+        )
+        {
+            return std::nullopt;
+        }
+
+        settings.BranchingFactor = *branchingFactor;
+    }
+
+    return settings;
+}
+
+template <typename T>
+static std::optional<T> ParseUnsigned(const std::string_view value)
+{
+    T result = 0;
+
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+
+    if (value.empty() || error != std::errc() || end != value.data() + value.size())
+        return std::nullopt;
+
+    return result;
+}
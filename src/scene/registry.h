@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "Scene.h"
+#include "textures/TextureLoader.h"
+
+//
+// Utilities
+//
+
+// Besides fixed scene names, accepts stress scenes as "<layout>:<object count>[:<seed>]", e.g. "grid:10000", and
+// hierarchy ones with an optional branching factor after the seed, e.g. "hierarchy:10000:1:1" for a single chain.
+// Requires a current GL context. Textures are loaded by the loader, which must outlive the scene.
+Scene CreateNamedScene(const std::string & sceneName, TextureLoader & textureLoader);
+
+std::vector<std::string> GetSceneNames();
+
+//
+// Exceptions
+//
+
+class UnknownSceneException final: public std::runtime_error
+{
+public: // Construction
+
+    explicit UnknownSceneException(const std::string & sceneName);
+};
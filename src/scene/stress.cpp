@@ -0,0 +1,435 @@
+#include "stress.h"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+#include <glm/ext/matrix_transform.hpp>
+
+#include "gl/constants.h"
+#include "gl/shaders.h"
+#include "meshes/construction.h"
+#include "rendering/uniform_blocks.h"
+
+//
+// Constants
+//
+
+static constexpr size_t LIGHT_COUNT              = 4;
+static constexpr size_t LIT_MATERIAL_COUNT       = 16;
+static constexpr size_t TEXTURED_MATERIAL_COUNT  = 4;
+static constexpr size_t TEXTURE_COUNT            = TEXTURED_MATERIAL_COUNT;
+static constexpr int    TEXTURE_SIZE             = 64;
+static constexpr int    TEXTURE_CHECKER_SIZE     = 8;
+static constexpr float  AMBIENT_LIGHT_STRENGTH   = 0.1f;
+static constexpr float  LIGHT_MARKER_SCALE       = 0.5f;
+
+static constexpr float GRID_SPACING = 2.0f;
+
+static constexpr size_t CITY_BUILDINGS_PER_DISTRICT = 2000;
+static constexpr float  CITY_BUILDING_SPACING       = 1.5f;
+static constexpr float  CITY_MAX_BUILDING_HEIGHT    = 12.0f;
+
+static constexpr float HIERARCHY_CHILD_OFFSET   = 1.5f;
+static constexpr float HIERARCHY_CHILD_SCALE    = 0.92f;
+// Deep hierarchies scale their children less, so that the deepest nodes don't shrink below this
+static constexpr float HIERARCHY_MIN_LEAF_SCALE = 0.2f;
+
+static const glm::vec3 WORLD_UP(0.0f, 1.0f, 0.0f);
+
+static const glm::vec4 CLEAR_RGBA(0.1f, 0.1f, 0.15f, 1.0f);
+
+//
+// Forward declarations
+//
+
+static float GenerateUnitFloat(std::mt19937 & generator);
+
+static size_t GenerateIndex(std::mt19937 & generator, const size_t count);
+
+static void AddMeshes(Scene & scene);
+
+static std::vector<UniqueTexture> CreateCheckerTextures(std::mt19937 & generator);
+
+static size_t AddMaterials(Scene & scene, const std::array<glm::vec3, LIGHT_COUNT> & lightPositions, std::mt19937 & generator);
+
+static float PlaceGridObjects(Scene & scene, const size_t objectCount, std::mt19937 & generator);
+
+static float PlaceCityObjects(Scene & scene, const size_t objectCount, std::mt19937 & generator);
+
+static float PlaceHierarchyObjects(Scene & scene, const size_t objectCount, const size_t branchingFactor, std::mt19937 & generator);
+
+static size_t GetHierarchyDepth(const size_t objectCount, const size_t branchingFactor);
+
+static void AssignRandomLooks(Scene & scene, const size_t materialCount, std::mt19937 & generator);
+
+//
+// Utilities
+//
+
+Scene CreateStressScene(const StressSceneSettings & settings)
+{
+    assert(settings.ObjectCount >= MIN_STRESS_SCENE_OBJECT_COUNT && settings.ObjectCount <= MAX_STRESS_SCENE_OBJECT_COUNT);
+    assert(
+        settings.BranchingFactor >= MIN_STRESS_SCENE_BRANCHING_FACTOR
+            && settings.BranchingFactor <= MAX_STRESS_SCENE_BRANCHING_FACTOR
+    );
+
+    // std::mt19937 output is fully specified by the standard, unlike the standard distributions.
+    std::mt19937 generator(settings.Seed);
+
+    Scene scene;
+    scene.ClearRgba = CLEAR_RGBA;
+    scene.Objects.reserve(settings.ObjectCount + LIGHT_COUNT);
+
+    AddMeshes(scene);
+    scene.Textures = CreateCheckerTextures(generator);
+
+    switch (settings.Layout)
+    {
+    case StressSceneLayout::Grid:
+        scene.OverviewRadius = PlaceGridObjects(scene, settings.ObjectCount, generator);
+        break;
+    case StressSceneLayout::City:
+        scene.OverviewRadius = PlaceCityObjects(scene, settings.ObjectCount, generator);
+        break;
+    case StressSceneLayout::Hierarchy:
+        scene.OverviewRadius = PlaceHierarchyObjects(scene, settings.ObjectCount, settings.BranchingFactor, generator);
+        break;
+    default:
+        assert(false && "unrecognized stress scene layout");
+        break;
+    }
+
+    std::array<glm::vec3, LIGHT_COUNT> lightPositions;
+    for (size_t lightIdx = 0; lightIdx < LIGHT_COUNT; lightIdx++)
+    {
+        const float angle = 2.0f*std::numbers::pi_v<float>*static_cast<float>(lightIdx) / static_cast<float>(LIGHT_COUNT);
+
+        lightPositions[lightIdx] = 0.5f*scene.OverviewRadius*glm::vec3(std::cos(angle), 0.6f, std::sin(angle));
+    }
+
+    const size_t materialCount = AddMaterials(scene, lightPositions, generator);
+
+    AssignRandomLooks(scene, materialCount, generator);
+
+    // The light source material comes right after the object ones.
+    const size_t lightSourceMeshIdx = 0;
+    for (const glm::vec3 & lightPosition : lightPositions)
+    {
+        scene.Objects.push_back(SceneObject{
+            lightSourceMeshIdx,
+            materialCount,
+            glm::scale(glm::translate(glm::mat4(1.0f), lightPosition), glm::vec3(LIGHT_MARKER_SCALE))
+        });
+    }
+
+    SortSceneObjects(scene);
+
+    return scene;
+}
+
+const char * StressSceneLayoutToCStr(const StressSceneLayout layout)
+{
+    switch (layout)
+    {
+    case StressSceneLayout::Grid:
+        return "grid";
+    case StressSceneLayout::City:
+        return "city";
+    case StressSceneLayout::Hierarchy:
+        return "hierarchy";
+    default:
+        assert(false && "unrecognized stress scene layout");
+        return "<UNKNOWN>";
+    }
+}
+
+std::optional<StressSceneLayout> ParseStressSceneLayout(const std::string_view value)
+{
+    for (const StressSceneLayout layout : {StressSceneLayout::Grid, StressSceneLayout::City, StressSceneLayout::Hierarchy})
+    {
+        if (value == StressSceneLayoutToCStr(layout))
+            return layout;
+    }
+
+    return std::nullopt;
+}
+
+//
+// Service
+//
+
+static float GenerateUnitFloat(std::mt19937 & generator)
+{
+    // Top 24 bits fit a float mantissa exactly, so the result is in [0, 1).
+    return static_cast<float>(generator() >> 8) / static_cast<float>(1 << 24);
+}
+
+static size_t GenerateIndex(std::mt19937 & generator, const size_t count)
+{
+    assert(count > 0);
+
+    // Modulo bias is negligible for the small counts used here.
+    return static_cast<size_t>(generator()) % count;
+}
+
+static void AddMeshes(Scene & scene)
+{
+    // Centered unit cube, plus unit footprint boxes of other proportions, all scaled per object
+    scene.Meshes.push_back(CreateUnitCubeMesh(false, true, false, false));
+    scene.Meshes.push_back(CreateUnitCubeMesh(true, true, false, true));
+    scene.Meshes.push_back(CreateAabbMesh(false, glm::vec3(-0.5f, -0.25f, -0.5f), glm::vec3(0.5f, 0.25f, 0.5f), false, false));
+    scene.Meshes.push_back(CreateAabbMesh(true, glm::vec3(-0.3f, -0.5f, -0.3f), glm::vec3(0.3f, 0.5f, 0.3f), false, true));
+}
+
+static std::vector<UniqueTexture> CreateCheckerTextures(std::mt19937 & generator)
+{
+    std::vector<UniqueTexture> textures = UniqueTexture::CreateMany(TEXTURE_COUNT);
+
+    std::vector<uint8_t> texels(TEXTURE_SIZE*TEXTURE_SIZE*4);
+
+    for (const UniqueTexture & texture : textures)
+    {
+        std::array<std::array<uint8_t, 4>, 2> checkerRgbas;
+        for (auto & rgba : checkerRgbas)
+        {
+            for (size_t channelIdx = 0; channelIdx < 3; channelIdx++)
+                rgba[channelIdx] = static_cast<uint8_t>(64 + GenerateIndex(generator, 192));
+
+            rgba[3] = 255;
+        }
+
+        for (int y = 0; y < TEXTURE_SIZE; y++)
+        {
+            for (int x = 0; x < TEXTURE_SIZE; x++)
+            {
+                const auto & rgba = checkerRgbas[(x / TEXTURE_CHECKER_SIZE + y / TEXTURE_CHECKER_SIZE) % 2];
+
+                std::copy(rgba.cbegin(), rgba.cend(), texels.begin() + 4*(y*TEXTURE_SIZE + x));
+            }
+        }
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TEXTURE_SIZE, TEXTURE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, INVALID_OPENGL_TEXTURE);
+
+    return textures;
+}
+
+static size_t AddMaterials(Scene & scene, const std::array<glm::vec3, LIGHT_COUNT> & lightPositions, std::mt19937 & generator)
+{
+    // Stress scenes are generated for benchmarking, not for iterating on shaders.
+    InitSceneFallbackShaderProgram(scene, false);
+
+    // Materials only differ in parameters and textures, so they share a program per kind.
+    const size_t litShaderProgramIdx         = scene.ShaderPrograms.size();
+    const size_t texturedShaderProgramIdx    = litShaderProgramIdx + 1;
+    const size_t lightSourceShaderProgramIdx = texturedShaderProgramIdx + 1;
+
+    // All programs are submitted at once, so that the driver compiles them in parallel if it can.
+    AddSceneShaderPrograms(scene, {
+        FindMatchingShaderFiles("lighting_basic"),
+        {"basic_mvp.vert", "basic_texture.frag"},
+        {"basic_mvp.vert", "lighting_trivial_light_source.frag"}
+    });
+
+    std::vector<SceneMaterialDescription> materialDescriptions;
+    materialDescriptions.reserve(LIT_MATERIAL_COUNT + TEXTURED_MATERIAL_COUNT + 1);
+
+    // The lighting shader only supports a single light, so lit materials are spread across the lights instead.
+    for (size_t materialIdx = 0; materialIdx < LIT_MATERIAL_COUNT; materialIdx++)
+    {
+        const glm::vec3 objectRgb(
+            0.2f + 0.8f*GenerateUnitFloat(generator),
+            0.2f + 0.8f*GenerateUnitFloat(generator),
+            0.2f + 0.8f*GenerateUnitFloat(generator)
+        );
+
+        materialDescriptions.push_back(SceneMaterialDescription{
+            litShaderProgramIdx,
+            MakeMaterialParameters(LitMaterialUniformBlock{
+                objectRgb,
+                AMBIENT_LIGHT_STRENGTH,
+                glm::vec3(1.0f),
+                0.0f,
+                lightPositions[materialIdx % LIGHT_COUNT],
+                0.0f
+            }),
+            {}
+        });
+    }
+
+    for (size_t materialIdx = 0; materialIdx < TEXTURED_MATERIAL_COUNT; materialIdx++)
+    {
+        materialDescriptions.push_back(SceneMaterialDescription{
+            texturedShaderProgramIdx,
+            {},
+            {{"tex", materialIdx % TEXTURE_COUNT}}
+        });
+    }
+
+    materialDescriptions.push_back(SceneMaterialDescription{
+        lightSourceShaderProgramIdx,
+        MakeMaterialParameters(LightSourceMaterialUniformBlock{glm::vec3(1.0f), 0.0f}),
+        {}
+    });
+
+    InitSceneMaterials(scene, materialDescriptions);
+
+    // Object materials are the ones preceding the light source one.
+    return LIT_MATERIAL_COUNT + TEXTURED_MATERIAL_COUNT;
+}
+
+static float PlaceGridObjects(Scene & scene, const size_t objectCount, std::mt19937 & generator)
+{
+    const size_t sideCount  = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(objectCount))));
+    const float  halfExtent = 0.5f*GRID_SPACING*static_cast<float>(sideCount - 1);
+
+    for (size_t objectIdx = 0; objectIdx < objectCount; objectIdx++)
+    {
+        const glm::vec3 position(
+            GRID_SPACING*static_cast<float>(objectIdx % sideCount) - halfExtent,
+            0.0f,
+            GRID_SPACING*static_cast<float>(objectIdx / sideCount) - halfExtent
+        );
+
+        const float yaw   = 2.0f*std::numbers::pi_v<float>*GenerateUnitFloat(generator);
+        const float scale = 0.5f + 0.5f*GenerateUnitFloat(generator);
+
+        glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), position);
+        modelMatrix           = glm::rotate(modelMatrix, yaw, WORLD_UP);
+        modelMatrix           = glm::scale(modelMatrix, glm::vec3(scale));
+
+        scene.Objects.push_back(SceneObject{0, 0, modelMatrix});
+    }
+
+    return std::max(halfExtent, GRID_SPACING)*std::numbers::sqrt2_v<float>;
+}
+
+static float PlaceCityObjects(Scene & scene, const size_t objectCount, std::mt19937 & generator)
+{
+    const size_t districtCount = std::max<size_t>(1, objectCount / CITY_BUILDINGS_PER_DISTRICT);
+
+    const float districtRadius = 0.5f*CITY_BUILDING_SPACING*std::sqrt(static_cast<float>(objectCount / districtCount));
+    const float cityRadius     = districtCount > 1 ? 1.5f*districtRadius*std::sqrt(static_cast<float>(districtCount)) : 0.0f;
+
+    std::vector<glm::vec3> districtCenters(districtCount);
+    for (glm::vec3 & districtCenter : districtCenters)
+    {
+        // Uniform over the disk, hence the square root
+        const float angle    = 2.0f*std::numbers::pi_v<float>*GenerateUnitFloat(generator);
+        const float distance = cityRadius*std::sqrt(GenerateUnitFloat(generator));
+
+        districtCenter = glm::vec3(distance*std::cos(angle), 0.0f, distance*std::sin(angle));
+    }
+
+    for (size_t objectIdx = 0; objectIdx < objectCount; objectIdx++)
+    {
+        const glm::vec3 & districtCenter = districtCenters[objectIdx % districtCount];
+
+        // Sums of uniform samples crowd buildings towards district centers, roughly normally.
+        const glm::vec3 offset(
+            districtRadius*(GenerateUnitFloat(generator) + GenerateUnitFloat(generator) + GenerateUnitFloat(generator) - 1.5f),
+            0.0f,
+            districtRadius*(GenerateUnitFloat(generator) + GenerateUnitFloat(generator) + GenerateUnitFloat(generator) - 1.5f)
+        );
+
+        // Cubed to make tall buildings rare
+        const float heightFactor = GenerateUnitFloat(generator);
+        const float height       = 1.0f + (CITY_MAX_BUILDING_HEIGHT - 1.0f)*heightFactor*heightFactor*heightFactor;
+        const float footprint    = 0.6f + 0.6f*GenerateUnitFloat(generator);
+        const float yaw          = 0.5f*std::numbers::pi_v<float>*static_cast<float>(GenerateIndex(generator, 4));
+
+        glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), districtCenter + offset + 0.5f*height*WORLD_UP);
+        modelMatrix           = glm::rotate(modelMatrix, yaw, WORLD_UP);
+        modelMatrix           = glm::scale(modelMatrix, glm::vec3(footprint, height, footprint));
+
+        scene.Objects.push_back(SceneObject{0, 0, modelMatrix});
+    }
+
+    return cityRadius + 2.0f*districtRadius + CITY_MAX_BUILDING_HEIGHT;
+}
+
+static float PlaceHierarchyObjects(Scene & scene, const size_t objectCount, const size_t branchingFactor, std::mt19937 & generator)
+{
+    const size_t depth      = GetHierarchyDepth(objectCount, branchingFactor);
+    const float  childScale = depth > 0
+        ? std::max(HIERARCHY_CHILD_SCALE, std::pow(HIERARCHY_MIN_LEAF_SCALE, 1.0f / static_cast<float>(depth)))
+        : HIERARCHY_CHILD_SCALE;
+
+    scene.Objects.push_back(SceneObject{0, 0, glm::mat4(1.0f)});
+
+    float radius = 0.0f;
+
+    // Parents precede their children, so every node's world transform is derived from an already placed one.
+    for (size_t objectIdx = 1; objectIdx < objectCount; objectIdx++)
+    {
+        const size_t parentIdx = (objectIdx - 1) / branchingFactor;
+
+        const glm::vec3 direction = glm::normalize(glm::vec3(
+            GenerateUnitFloat(generator) - 0.5f,
+            GenerateUnitFloat(generator),
+            GenerateUnitFloat(generator) - 0.5f
+        ) + 0.01f*WORLD_UP);
+
+        const glm::vec3 rotationAxis = glm::normalize(glm::vec3(
+            GenerateUnitFloat(generator) - 0.5f,
+            GenerateUnitFloat(generator) - 0.5f,
+            GenerateUnitFloat(generator) - 0.5f
+        ) + 0.01f*WORLD_UP);
+
+        const float rotationAngle = std::numbers::pi_v<float>*GenerateUnitFloat(generator);
+
+        glm::mat4 localMatrix = glm::translate(glm::mat4(1.0f), HIERARCHY_CHILD_OFFSET*direction);
+        localMatrix           = glm::rotate(localMatrix, rotationAngle, rotationAxis);
+        localMatrix           = glm::scale(localMatrix, glm::vec3(childScale));
+
+        scene.Objects.push_back(SceneObject{0, 0, scene.Objects[parentIdx].ModelMatrix * localMatrix});
+
+        radius = std::max(radius, glm::length(glm::vec3(scene.Objects.back().ModelMatrix[3])));
+    }
+
+    // Offsets of deep chains barely shrink, so the tree is bounded by where its nodes ended up rather than by the
+    // geometric series of the offsets.
+    return radius + HIERARCHY_CHILD_OFFSET;
+}
+
+static size_t GetHierarchyDepth(const size_t objectCount, const size_t branchingFactor)
+{
+    size_t depth       = 0;
+    size_t levelCount  = 1;
+    size_t placedCount = 1;
+
+    while (placedCount < objectCount)
+    {
+        levelCount  *= branchingFactor;
+        placedCount += levelCount;
+        depth++;
+    }
+
+    return depth;
+}
+
+static void AssignRandomLooks(Scene & scene, const size_t materialCount, std::mt19937 & generator)
+{
+    for (SceneObject & object : scene.Objects)
+    {
+        object.MeshIdx     = GenerateIndex(generator, scene.Meshes.size());
+        object.MaterialIdx = GenerateIndex(generator, materialCount);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "Scene.h"
+
+//
+// Constants
+//
+
+constexpr size_t MIN_STRESS_SCENE_OBJECT_COUNT = 1;
+constexpr size_t MAX_STRESS_SCENE_OBJECT_COUNT = 1'000'000;
+
+constexpr uint32_t DEFAULT_STRESS_SCENE_SEED = 1;
+
+// Children per node of the hierarchy layout, 1 makes a single chain as deep as the object count
+constexpr size_t MIN_STRESS_SCENE_BRANCHING_FACTOR     = 1;
+constexpr size_t MAX_STRESS_SCENE_BRANCHING_FACTOR     = 64;
+constexpr size_t DEFAULT_STRESS_SCENE_BRANCHING_FACTOR = 2;
+
+//
+// Interface types
+//
+
+enum class StressSceneLayout: uint8_t
+{
+    // Square grid of randomly rotated and scaled boxes on the ground plane
+    Grid,
+    // Districts of buildings with a few tall ones, scattered over a disk
+    City,
+    // Complete tree of nested transforms, each node drawn at its world transform. Its depth grows as the log of the
+    // object count to the branching factor, and linearly with a branching factor of 1.
+    Hierarchy
+};
+
+struct StressSceneSettings final
+{
+    StressSceneLayout Layout          = StressSceneLayout::Grid;
+    size_t            ObjectCount     = MIN_STRESS_SCENE_OBJECT_COUNT;
+    uint32_t          Seed            = DEFAULT_STRESS_SCENE_SEED;
+    size_t            BranchingFactor = DEFAULT_STRESS_SCENE_BRANCHING_FACTOR; // Hierarchy layout only
+};
+
+//
+// Utilities
+//
+
+// Places the given number of objects, plus a marker object per light, centered on the origin.
+// Meshes, materials and transforms only depend on the settings, on every platform.
+// Requires a current GL context.
+Scene CreateStressScene(const StressSceneSettings & settings);
+
+const char * StressSceneLayoutToCStr(const StressSceneLayout layout);
+
+std::optional<StressSceneLayout> ParseStressSceneLayout(const std::string_view value);
@@ -0,0 +1,58 @@
+#include "FixedTimestep.h"
+
+#include <cassert>
+#include <cmath>
+
+#include "logging.h"
+
+//
+// Construction
+//
+
+FixedTimestep::FixedTimestep(const Settings & settings):
+    m_Settings          (settings),
+    m_StepSeconds       (1.0 / static_cast<double>(settings.StepsPerSecond)),
+    m_AccumulatedSeconds(0.0)
+{
+    assert(m_Settings.StepsPerSecond > 0.0f);
+    assert(m_Settings.MaxCatchUpSteps > 0);
+}
+
+//
+// Interface
+//
+
+int FixedTimestep::Advance(const float frameDeltaSeconds)
+{
+    assert(frameDeltaSeconds >= 0.0f);
+
+    m_AccumulatedSeconds += frameDeltaSeconds;
+
+    const int requiredStepCount = static_cast<int>(m_AccumulatedSeconds / m_StepSeconds);
+
+    if (requiredStepCount > m_Settings.MaxCatchUpSteps)
+    {
+        LOG_DEBUG<< "Dropping " << requiredStepCount - m_Settings.MaxCatchUpSteps
+            << " simulation steps after a " << frameDeltaSeconds << "s frame";
+
+        m_AccumulatedSeconds = std::fmod(m_AccumulatedSeconds, m_StepSeconds);
+
+        return m_Settings.MaxCatchUpSteps;
+    }
+
+    m_AccumulatedSeconds -= requiredStepCount*m_StepSeconds;
+
+    return requiredStepCount;
+}
+
+float FixedTimestep::GetStepSeconds() const
+{
+    return static_cast<float>(m_StepSeconds);
+}
+
+float FixedTimestep::GetInterpolationAlpha() const
+{
+    assert(m_AccumulatedSeconds >= 0.0 && m_AccumulatedSeconds < m_StepSeconds + 1e-9);
+
+    return static_cast<float>(m_AccumulatedSeconds / m_StepSeconds);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+//
+// FixedTimestep
+//
+
+// Accumulates variable frame time and converts it into a number of fixed simulation steps.
+class FixedTimestep final
+{
+public: // Interface types
+
+    struct Settings final
+    {
+        float StepsPerSecond;
+        int   MaxCatchUpSteps;
+    };
+
+public: // Construction
+
+    explicit FixedTimestep(const Settings & settings);
+
+public: // Interface
+
+    // Returns the number of simulation steps to run this frame. Time which would require
+    // more than MaxCatchUpSteps steps is dropped, so that a hitch can't cascade into further ones.
+    int Advance(const float frameDeltaSeconds);
+
+    float GetStepSeconds() const;
+
+    // Fraction of a step accumulated but not yet simulated, for interpolation
+    // between the last two simulation states.
+    float GetInterpolationAlpha() const;
+
+private: // Members
+
+    Settings m_Settings;
+    double   m_StepSeconds;
+    double   m_AccumulatedSeconds;
+};
@@ -0,0 +1,311 @@
+#include "SystemScheduler.h"
+
+#include <cassert>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
+#include "logging.h"
+
+//
+// Forward declarations
+//
+
+static long long ToMicroseconds(const SystemScheduler::Clock::duration duration);
+
+//
+// Construction
+//
+
+SystemScheduler::SystemScheduler(ThreadPool * const threadPool):
+    m_ThreadPool    (threadPool),
+    m_Systems       (),
+    m_PhaseGraphs   (),
+    m_AreGraphsDirty(true),
+    m_LastFrameTrace()
+{
+    // Empty
+}
+
+//
+// Interface
+//
+
+SystemScheduler::SystemId SystemScheduler::AddSystem(SystemDescriptor descriptor)
+{
+    assert(descriptor.Update);
+    assert(descriptor.Phase < SystemPhase::Count);
+
+    const SystemId systemId = m_Systems.size();
+
+    LOG_DEBUG<< "Added system " << systemId << " \"" << descriptor.Name
+        << "\" to phase " << static_cast<int>(descriptor.Phase);
+
+    m_Systems.push_back(std::move(descriptor));
+    m_AreGraphsDirty = true;
+
+    return systemId;
+}
+
+void SystemScheduler::Update(const float deltaTimeSeconds)
+{
+    if (m_AreGraphsDirty)
+        RebuildGraphs();
+
+    assert(!m_AreGraphsDirty);
+
+    const Clock::time_point frameStartTime = Clock::now();
+
+    m_LastFrameTrace.Timings.resize(m_Systems.size());
+    m_LastFrameTrace.CriticalPath.clear();
+    m_LastFrameTrace.CriticalPathDuration = Clock::duration::zero();
+    m_LastFrameTrace.SerialDuration       = Clock::duration::zero();
+
+    // Phases act as barriers: a phase starts only after every system of the previous one has finished.
+    for (const PhaseGraph & graph : m_PhaseGraphs)
+    {
+        RunPhase(graph, deltaTimeSeconds);
+        AppendPhaseCriticalPath(graph);
+    }
+
+    m_LastFrameTrace.WallDuration = Clock::now() - frameStartTime;
+}
+
+const std::string & SystemScheduler::GetSystemName(const SystemId system) const
+{
+    assert(system < m_Systems.size());
+
+    return m_Systems[system].Name;
+}
+
+const SystemScheduler::FrameTrace & SystemScheduler::GetLastFrameTrace() const
+{
+    return m_LastFrameTrace;
+}
+
+void SystemScheduler::LogLastFrameTrace() const
+{
+    const auto makeCriticalPathDescription = [this] ()
+    {
+        std::string result;
+
+        for (const SystemId system : m_LastFrameTrace.CriticalPath)
+        {
+            if (!result.empty())
+                result += " -> ";
+
+            result += m_Systems[system].Name;
+        }
+
+        return result;
+    };
+
+    LOG_TRACE<< "Systems update took " << ToMicroseconds(m_LastFrameTrace.WallDuration) << "us (serial "
+        << ToMicroseconds(m_LastFrameTrace.SerialDuration) << "us), critical path "
+        << ToMicroseconds(m_LastFrameTrace.CriticalPathDuration) << "us: " << makeCriticalPathDescription();
+}
+
+//
+// Service
+//
+
+static long long ToMicroseconds(const SystemScheduler::Clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+void SystemScheduler::RebuildGraphs()
+{
+    m_PhaseGraphs.assign(static_cast<size_t>(SystemPhase::Count), PhaseGraph());
+
+    for (SystemId system = 0; system < m_Systems.size(); system++)
+        m_PhaseGraphs[static_cast<size_t>(m_Systems[system].Phase)].Systems.push_back(system);
+
+    // Registration order within a phase defines the serial semantics to preserve,
+    // so a system depends on every earlier system of the phase it conflicts with.
+    for (PhaseGraph & graph : m_PhaseGraphs)
+    {
+        const size_t nodeCount = graph.Systems.size();
+
+        graph.DependencyCounts.assign(nodeCount, 0);
+        graph.Dependents.assign(nodeCount, {});
+        graph.Dependencies.assign(nodeCount, {});
+
+        for (size_t laterNode = 0; laterNode < nodeCount; laterNode++)
+        {
+            const SystemDescriptor & later = m_Systems[graph.Systems[laterNode]];
+
+            for (size_t earlierNode = 0; earlierNode < laterNode; earlierNode++)
+            {
+                if (!AreConflicting(m_Systems[graph.Systems[earlierNode]], later))
+                    continue;
+
+                graph.Dependents[earlierNode].push_back(laterNode);
+                graph.Dependencies[laterNode].push_back(earlierNode);
+                graph.DependencyCounts[laterNode]++;
+            }
+        }
+    }
+
+    m_AreGraphsDirty = false;
+
+    LOG_DEBUG<< "Rebuilt system dependency graphs for " << m_Systems.size() << " systems";
+}
+
+void SystemScheduler::RunPhase(const PhaseGraph & graph, const float deltaTimeSeconds)
+{
+    const size_t nodeCount = graph.Systems.size();
+    if (nodeCount == 0)
+        return;
+
+    std::vector<std::atomic<size_t>> pendingDependencyCounts(nodeCount);
+    for (size_t node = 0; node < nodeCount; node++)
+        pendingDependencyCounts[node].store(graph.DependencyCounts[node], std::memory_order_relaxed);
+
+    std::mutex              mutex;
+    std::condition_variable condition;
+    std::deque<size_t>      mainThreadReadyNodes;
+    size_t                  completedNodeCount = 0;
+    std::exception_ptr      firstException;
+
+    std::function<void(size_t)> dispatchNode;
+
+    const auto runNode = [&] (const size_t node)
+    {
+        const SystemId           system     = graph.Systems[node];
+        const SystemDescriptor & descriptor = m_Systems[system];
+        SystemTiming &           timing     = m_LastFrameTrace.Timings[system];
+
+        timing.System    = system;
+        timing.StartTime = Clock::now();
+
+        try
+        {
+            descriptor.Update(deltaTimeSeconds);
+        }
+        catch (...)
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+
+            if (!firstException)
+                firstException = std::current_exception();
+        }
+
+        timing.EndTime = Clock::now();
+
+        for (const size_t dependentNode : graph.Dependents[node])
+        {
+            if (pendingDependencyCounts[dependentNode].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                dispatchNode(dependentNode);
+        }
+
+        // Notify under the lock, since the waiting thread owns (and destroys) the synchronization state.
+        const std::lock_guard<std::mutex> lock(mutex);
+
+        completedNodeCount++;
+        condition.notify_all();
+    };
+
+    dispatchNode = [&] (const size_t node)
+    {
+        const SystemDescriptor & descriptor = m_Systems[graph.Systems[node]];
+
+        if (m_ThreadPool == nullptr || descriptor.Affinity == SystemAffinity::MainThread)
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+
+            mainThreadReadyNodes.push_back(node);
+            condition.notify_all();
+
+            return;
+        }
+
+        m_ThreadPool->Submit([&runNode, node] { runNode(node); });
+    };
+
+    for (size_t node = 0; node < nodeCount; node++)
+    {
+        if (graph.DependencyCounts[node] == 0)
+            dispatchNode(node);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (completedNodeCount < nodeCount)
+        {
+            condition.wait(lock, [&] { return completedNodeCount == nodeCount || !mainThreadReadyNodes.empty(); });
+
+            while (!mainThreadReadyNodes.empty())
+            {
+                const size_t node = mainThreadReadyNodes.front();
+                mainThreadReadyNodes.pop_front();
+
+                lock.unlock();
+                runNode(node);
+                lock.lock();
+            }
+        }
+    }
+
+    if (firstException)
+        std::rethrow_exception(firstException);
+}
+
+void SystemScheduler::AppendPhaseCriticalPath(const PhaseGraph & graph)
+{
+    static constexpr size_t NO_PREDECESSOR = static_cast<size_t>(-1);
+
+    const size_t nodeCount = graph.Systems.size();
+    if (nodeCount == 0)
+        return;
+
+    std::vector<Clock::duration> finishDurations(nodeCount, Clock::duration::zero());
+    std::vector<size_t>          criticalPredecessors(nodeCount, NO_PREDECESSOR);
+
+    // Nodes are stored in registration order, which is a topological order of the phase graph.
+    for (size_t node = 0; node < nodeCount; node++)
+    {
+        const SystemTiming &  timing   = m_LastFrameTrace.Timings[graph.Systems[node]];
+        const Clock::duration duration = timing.EndTime - timing.StartTime;
+
+        m_LastFrameTrace.SerialDuration += duration;
+
+        for (const size_t dependencyNode : graph.Dependencies[node])
+        {
+            if (criticalPredecessors[node] == NO_PREDECESSOR
+                || finishDurations[dependencyNode] > finishDurations[criticalPredecessors[node]])
+            {
+                criticalPredecessors[node] = dependencyNode;
+            }
+        }
+
+        finishDurations[node] = duration + (
+            criticalPredecessors[node] != NO_PREDECESSOR
+                ? finishDurations[criticalPredecessors[node]]
+                : Clock::duration::zero()
+        );
+    }
+
+    const size_t lastNode = static_cast<size_t>(
+        std::max_element(finishDurations.cbegin(), finishDurations.cend()) - finishDurations.cbegin()
+    );
+
+    m_LastFrameTrace.CriticalPathDuration += finishDurations[lastNode];
+
+    const size_t phasePathStart = m_LastFrameTrace.CriticalPath.size();
+
+    for (size_t node = lastNode; node != NO_PREDECESSOR; node = criticalPredecessors[node])
+        m_LastFrameTrace.CriticalPath.push_back(graph.Systems[node]);
+
+    std::reverse(m_LastFrameTrace.CriticalPath.begin() + phasePathStart, m_LastFrameTrace.CriticalPath.end());
+}
+
+bool SystemScheduler::AreConflicting(const SystemDescriptor & earlier, const SystemDescriptor & later)
+{
+    return (earlier.WriteComponents & (later.ReadComponents | later.WriteComponents)).any()
+        || (earlier.ReadComponents & later.WriteComponents).any();
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+#include "threading/ThreadPool.h"
+
+#include "components.h"
+
+//
+// Interface types
+//
+
+enum class SystemPhase: uint8_t
+{
+    Input,
+    Simulation,
+    PostSimulation,
+    PreRender,
+
+    Count
+};
+
+enum class SystemAffinity: uint8_t
+{
+    AnyThread,
+    MainThread
+};
+
+struct SystemDescriptor final
+{
+    std::string                Name;
+    SystemPhase                Phase;
+    SystemAffinity             Affinity;
+    ComponentSet               ReadComponents;
+    ComponentSet               WriteComponents;
+    std::function<void(float)> Update;
+};
+
+//
+// SystemScheduler
+//
+
+class SystemScheduler final
+{
+public: // Interface types
+
+    using SystemId = size_t;
+    using Clock    = std::chrono::steady_clock;
+
+    struct SystemTiming final
+    {
+        SystemId          System;
+        Clock::time_point StartTime;
+        Clock::time_point EndTime;
+    };
+
+    struct FrameTrace final
+    {
+        std::vector<SystemTiming> Timings;
+        std::vector<SystemId>     CriticalPath;
+        Clock::duration           CriticalPathDuration;
+        Clock::duration           SerialDuration;
+        Clock::duration           WallDuration;
+    };
+
+public: // Construction
+
+    // Without a thread pool every system runs serially on the calling thread.
+    explicit SystemScheduler(ThreadPool * const threadPool);
+
+public: // Copy / Move
+
+    SystemScheduler(const SystemScheduler &) = delete;
+
+    SystemScheduler & operator=(const SystemScheduler &) = delete;
+
+public: // Interface
+
+    SystemId AddSystem(SystemDescriptor descriptor);
+
+    void Update(const float deltaTimeSeconds);
+
+    const std::string & GetSystemName(const SystemId system) const;
+
+    const FrameTrace & GetLastFrameTrace() const;
+
+    void LogLastFrameTrace() const;
+
+private: // Service types
+
+    struct PhaseGraph final
+    {
+        std::vector<SystemId>              Systems;
+        std::vector<size_t>                DependencyCounts;
+        std::vector<std::vector<size_t>>   Dependents;
+        std::vector<std::vector<size_t>>   Dependencies;
+    };
+
+private: // Service
+
+    void RebuildGraphs();
+
+    void RunPhase(const PhaseGraph & graph, const float deltaTimeSeconds);
+
+    void AppendPhaseCriticalPath(const PhaseGraph & graph);
+
+    static bool AreConflicting(const SystemDescriptor & earlier, const SystemDescriptor & later);
+
+private: // Members
+
+    ThreadPool * const m_ThreadPool;
+
+    std::vector<SystemDescriptor> m_Systems;
+    std::vector<PhaseGraph>       m_PhaseGraphs;
+    bool                          m_AreGraphsDirty;
+
+    FrameTrace m_LastFrameTrace;
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <bitset>
+#include <initializer_list>
+
+//
+// Interface types
+//
+
+enum class Component: uint8_t
+{
+    Input,
+    Camera,
+    Transforms,
+    Lights,
+    Visibility,
+
+    Count
+};
+
+using ComponentSet = std::bitset<static_cast<size_t>(Component::Count)>;
+
+//
+// Utilities
+//
+
+inline ComponentSet MakeComponentSet(const std::initializer_list<Component> components)
+{
+    ComponentSet result;
+
+    for (const Component component : components)
+        result.set(static_cast<size_t>(component));
+
+    return result;
+}
@@ -14,12 +14,30 @@
 
 using TextureByte = unsigned char;
 
+// How texel values are meant to be interpreted, e.g. color maps are authored in sRGB, data maps like normals aren't.
+enum class TextureColorSpace
+{
+    Linear,
+    Srgb
+};
+
+// Block compressed formats encode 4x4 texel blocks, BC1 and BC3 need EXT_texture_compression_s3tc, BC4 and BC5 are core.
+enum class TextureFormat
+{
+    Rgba8,
+    Bc1, // RGB, 8 bytes per block
+    Bc3, // RGBA, 16 bytes per block
+    Bc4, // R, 8 bytes per block
+    Bc5  // RG, 16 bytes per block
+};
+
 struct TextureMetadata final
 {
-    int         Width;
-    int         Height;
-    int         ChannelsCount;
-    std::string SourceName;
+    int               Width;
+    int               Height;
+    int               ChannelsCount;
+    TextureColorSpace ColorSpace = TextureColorSpace::Linear;
+    std::string       SourceName;
 };
 
 //
@@ -0,0 +1,625 @@
+#include "TextureLoader.h"
+
+#include <cassert>
+#include <cstring>
+#include <array>
+#include <algorithm>
+#include <utility>
+
+#include "gl/constants.h"
+#include "gl/utils.h"
+#include "profiling/profiling.h"
+#include "config.h"
+#include "logging.h"
+
+#include "loading.h"
+#include "block_compression.h"
+#include "texture_file.h"
+
+//
+// Constants
+//
+
+// Matches the fallback shader program, so that loading textures look like loading programs.
+static constexpr std::array<uint8_t, 4> PLACEHOLDER_RGBA{128, 128, 128, 255};
+
+static constexpr size_t TEXTURE_UPLOAD_CHANNELS_COUNT = 4;
+
+// Staging memory beyond this is freed once uploaded instead of pooled.
+static constexpr size_t MAX_FREE_STAGING_MEMORY_COUNT = 8;
+
+// EXT_texture_compression_s3tc and its EXT_texture_sRGB interactions, which the core profile loader lacks
+static constexpr GLenum GL_COMPRESSED_RGB_S3TC_DXT1_EXT        = 0x83F0;
+static constexpr GLenum GL_COMPRESSED_RGBA_S3TC_DXT5_EXT       = 0x83F3;
+static constexpr GLenum GL_COMPRESSED_SRGB_S3TC_DXT1_EXT       = 0x8C4C;
+static constexpr GLenum GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT = 0x8C4F;
+
+//
+// Forward declarations
+//
+
+static GLenum GetInternalFormat(const TextureFormat format, const TextureColorSpace colorSpace);
+
+//
+// Construction / Destruction
+//
+
+TextureLoader::TextureLoader(ThreadPool & threadPool):
+    m_ThreadPool               (threadPool),
+    m_IsS3tcSupported          (IsGlExtensionSupported("GL_EXT_texture_compression_s3tc")),
+    m_IsS3tcSrgbSupported      (m_IsS3tcSupported && IsGlExtensionSupported("GL_EXT_texture_sRGB")),
+    m_Mutex                    (),
+    m_DecodingFinishedCondition(),
+    m_DecodingCount            (0),
+    m_DecodedTextures          (),
+    m_FreeStagingMemory        (),
+    m_FailedCount              (0),
+    m_UnpackBuffer(
+        GL_PIXEL_UNPACK_BUFFER,
+        static_cast<GLsizeiptr>(TEXTURE_UPLOAD_BUDGET_PER_FRAME),
+        STREAMING_BUFFER_REGION_COUNT
+    ),
+    m_UploadQueue   (),
+    m_StreamedUpload(),
+    m_LoadedCount   (0),
+    m_BakedCount    (0),
+    m_UploadedBytes (0)
+{
+    if (!m_IsS3tcSupported)
+        LOG_INFO<< "GL_EXT_texture_compression_s3tc is unsupported, BC1 and BC3 textures are decoded to RGBA8";
+}
+
+TextureLoader::~TextureLoader()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    m_DecodingFinishedCondition.wait(lock, [this] { return m_DecodingCount == 0; });
+}
+
+//
+// Interface
+//
+
+UniqueTexture TextureLoader::Load(const std::string & textureFilename, const TextureColorSpace colorSpace)
+{
+    UniqueTexture texture = UniqueTexture::Create();
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        static_cast<GLint>(GetInternalFormat(TextureFormat::Rgba8, colorSpace)),
+        1,
+        1,
+        0,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        PLACEHOLDER_RGBA.data()
+    );
+    glBindTexture(GL_TEXTURE_2D, INVALID_OPENGL_TEXTURE);
+
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+
+        m_DecodingCount++;
+    }
+
+    const GLuint textureName = texture;
+
+    m_ThreadPool.Submit(
+        [this, textureName, textureFilename, colorSpace]
+        {
+            Decode(textureName, textureFilename, colorSpace);
+        }
+    );
+
+    return texture;
+}
+
+void TextureLoader::Update()
+{
+    PROFILE_SCOPE("TextureLoader::Update");
+
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+
+        for (DecodedTexture & decoded : m_DecodedTextures)
+            m_UploadQueue.push_back(std::move(decoded));
+
+        m_DecodedTextures.clear();
+    }
+
+    // Too large for the unpack buffer, so it takes the whole budget of as many frames as it needs
+    if (!m_StreamedUpload.has_value() && !m_UploadQueue.empty()
+        && m_UploadQueue.front().MipChain.Data.size() > TEXTURE_UPLOAD_BUDGET_PER_FRAME)
+    {
+        LOG_DEBUG<< "Texture " << m_UploadQueue.front().SourceName << " exceeds the upload budget of "
+            << TEXTURE_UPLOAD_BUDGET_PER_FRAME << " bytes, streaming it over several updates";
+
+        AllocateStreamedStorage(m_UploadQueue.front());
+
+        m_StreamedUpload = StreamedUpload{std::move(m_UploadQueue.front()), 0, 0};
+        m_UploadQueue.pop_front();
+    }
+
+    if (m_StreamedUpload.has_value())
+    {
+        if (UploadStreamed(*m_StreamedUpload))
+        {
+            ReleaseStagingMemory(std::move(m_StreamedUpload->Decoded.MipChain.Data));
+            m_StreamedUpload.reset();
+        }
+
+        return;
+    }
+
+    if (m_UploadQueue.empty())
+        return;
+
+    std::vector<StagedUpload> stagedUploads;
+    size_t                    stagedSize = 0;
+
+    m_UnpackBuffer.BeginFrame();
+
+    // Texels are RGBA and blocks are 8 or 16 bytes, so allocations are contiguous and the budget can be checked
+    // up front. The rest waits for the next frame's budget.
+    while (!m_UploadQueue.empty() && stagedSize + m_UploadQueue.front().MipChain.Data.size() <= TEXTURE_UPLOAD_BUDGET_PER_FRAME)
+    {
+        DecodedTexture & decoded = m_UploadQueue.front();
+
+        const std::optional<StreamingBuffer::Allocation> allocation = m_UnpackBuffer.Allocate(
+            static_cast<GLsizeiptr>(decoded.MipChain.Data.size()),
+            static_cast<GLsizeiptr>(TEXTURE_UPLOAD_CHANNELS_COUNT)
+        );
+
+        assert(allocation.has_value() && "budget must fit the unpack buffer region");
+
+        stagedSize += decoded.MipChain.Data.size();
+
+        std::memcpy(allocation->Data, decoded.MipChain.Data.data(), decoded.MipChain.Data.size());
+
+        stagedUploads.push_back(StagedUpload{std::move(decoded), allocation->Offset});
+        m_UploadQueue.pop_front();
+    }
+
+    m_UnpackBuffer.FinishWriting();
+
+    UploadStaged(stagedUploads);
+
+    m_UnpackBuffer.EndFrame();
+}
+
+void TextureLoader::WaitForPendingLoads()
+{
+    PROFILE_SCOPE("TextureLoader::WaitForPendingLoads");
+
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        m_DecodingFinishedCondition.wait(lock, [this] { return m_DecodingCount == 0; });
+    }
+
+    // Nothing gets queued anymore, so every call drains up to the budget.
+    do
+    {
+        Update();
+    }
+    while (!m_UploadQueue.empty() || m_StreamedUpload.has_value());
+}
+
+void TextureLoader::LogSummary() const
+{
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    LOG_INFO<< "Loaded " << m_LoadedCount << " textures, " << m_BakedCount << " of them baked, " << m_UploadedBytes
+        << " bytes, " << m_FailedCount << " failed to load";
+}
+
+//
+// Service
+//
+
+void TextureLoader::Decode(const GLuint texture, const std::string & textureFilename, const TextureColorSpace colorSpace)
+{
+    PROFILE_SCOPE("TextureLoader::Decode");
+
+    std::optional<DecodedTexture> decoded;
+
+    try
+    {
+        std::optional<TextureMipChain> bakedMipChain = DecodeBaked(textureFilename, colorSpace);
+
+        if (bakedMipChain.has_value())
+        {
+            decoded = DecodedTexture{texture, textureFilename, true, std::move(*bakedMipChain)};
+        }
+        else
+        {
+            TextureLoadingOptions options;
+            options.DesiredChannelsCount = static_cast<int>(TEXTURE_UPLOAD_CHANNELS_COUNT);
+            options.ColorSpace           = colorSpace;
+
+            const TextureData textureData = LoadTextureDataFromFile(textureFilename, options);
+
+            std::vector<std::byte> stagingMemory;
+
+            {
+                const std::lock_guard<std::mutex> lock(m_Mutex);
+
+                if (!m_FreeStagingMemory.empty())
+                {
+                    stagingMemory = std::move(m_FreeStagingMemory.back());
+                    m_FreeStagingMemory.pop_back();
+                }
+            }
+
+            TextureMipChain mipChain = GenerateMipChain(textureData, m_ThreadPool, MipChainOptions{}, std::move(stagingMemory));
+
+            decoded = DecodedTexture{texture, textureFilename, false, std::move(mipChain)};
+        }
+    }
+    catch (const TextureLoadingException & e)
+    {
+        LOG_ERROR<< e.what() << ", keeping the placeholder of texture " << texture;
+    }
+
+    // Notified under the lock, the destructor may return as soon as it sees the count drop, destroying the condition.
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (decoded.has_value())
+        m_DecodedTextures.push_back(std::move(*decoded));
+    else
+        m_FailedCount++;
+
+    m_DecodingCount--;
+
+    m_DecodingFinishedCondition.notify_all();
+}
+
+std::optional<TextureMipChain> TextureLoader::DecodeBaked(const std::string & textureFilename, const TextureColorSpace colorSpace) const
+{
+    // Edited textures are decoded until baked again.
+    const std::optional<FileStamp> sourceStamp = GetFileStamp(TEXTURES_DIR + textureFilename);
+    if (!sourceStamp.has_value())
+        return std::nullopt;
+
+    std::optional<TextureMipChain> mipChain = ReadTextureFile(GetBakedTexturePath(textureFilename), *sourceStamp);
+
+    if (!mipChain.has_value())
+        return std::nullopt;
+
+    // Mipmaps of sRGB textures are filtered differently, so the baked chain can't just be reinterpreted.
+    if (mipChain->ColorSpace != colorSpace)
+    {
+        LOG_WARNING<< "Ignoring baked " << textureFilename << " of a different color space than it's loaded with";
+
+        return std::nullopt;
+    }
+
+    if (!IsFormatSupported(mipChain->Format, colorSpace))
+        return DecompressMipChain(*mipChain);
+
+    return mipChain;
+}
+
+bool TextureLoader::IsFormatSupported(const TextureFormat format, const TextureColorSpace colorSpace) const
+{
+    const bool isSrgb = colorSpace == TextureColorSpace::Srgb;
+
+    switch (format)
+    {
+    case TextureFormat::Rgba8:
+        return true;
+    case TextureFormat::Bc1:
+    case TextureFormat::Bc3:
+        return isSrgb ? m_IsS3tcSrgbSupported : m_IsS3tcSupported;
+    case TextureFormat::Bc4:
+    case TextureFormat::Bc5:
+        return !isSrgb; // Core, but without sRGB variants
+    default:
+        assert(false && "unrecognized texture format");
+        return false;
+    }
+}
+
+void TextureLoader::UploadStaged(std::vector<StagedUpload> & stagedUploads)
+{
+    // Uncompressed storage is allocated without an unpack buffer bound, since a null pointer would be an offset into
+    // it otherwise. Compressed levels are specified along with their data below.
+    for (const StagedUpload & stagedUpload : stagedUploads)
+    {
+        const TextureMipChain & mipChain = stagedUpload.Decoded.MipChain;
+
+        if (IsBlockCompressedFormat(mipChain.Format))
+            continue;
+
+        glBindTexture(GL_TEXTURE_2D, stagedUpload.Decoded.Texture);
+
+        for (size_t levelIdx = 0; levelIdx < mipChain.Levels.size(); levelIdx++)
+        {
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                static_cast<GLint>(levelIdx),
+                static_cast<GLint>(GetInternalFormat(mipChain.Format, mipChain.ColorSpace)),
+                mipChain.Levels[levelIdx].Width,
+                mipChain.Levels[levelIdx].Height,
+                0,
+                GL_RGBA,
+                GL_UNSIGNED_BYTE,
+                nullptr
+            );
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_UnpackBuffer.Get());
+
+    for (const StagedUpload & stagedUpload : stagedUploads)
+    {
+        const TextureMipChain & mipChain = stagedUpload.Decoded.MipChain;
+
+        glBindTexture(GL_TEXTURE_2D, stagedUpload.Decoded.Texture);
+
+        for (size_t levelIdx = 0; levelIdx < mipChain.Levels.size(); levelIdx++)
+        {
+            const TextureMipLevel & level = mipChain.Levels[levelIdx];
+            const void * const      data  = reinterpret_cast<const void *>(
+                stagedUpload.UnpackBufferOffset + static_cast<GLintptr>(level.Offset)
+            );
+
+            if (IsBlockCompressedFormat(mipChain.Format))
+            {
+                glCompressedTexImage2D(
+                    GL_TEXTURE_2D,
+                    static_cast<GLint>(levelIdx),
+                    GetInternalFormat(mipChain.Format, mipChain.ColorSpace),
+                    level.Width,
+                    level.Height,
+                    0,
+                    static_cast<GLsizei>(level.Size),
+                    data
+                );
+            }
+            else
+            {
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    static_cast<GLint>(levelIdx),
+                    0,
+                    0,
+                    level.Width,
+                    level.Height,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    data
+                );
+            }
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, INVALID_OPENGL_BUFFER);
+
+    for (StagedUpload & stagedUpload : stagedUploads)
+    {
+        glBindTexture(GL_TEXTURE_2D, stagedUpload.Decoded.Texture);
+
+        FinishUpload(stagedUpload.Decoded);
+
+        ReleaseStagingMemory(std::move(stagedUpload.Decoded.MipChain.Data));
+    }
+
+    glBindTexture(GL_TEXTURE_2D, INVALID_OPENGL_TEXTURE);
+}
+
+// Storage is allocated without an unpack buffer bound, so that null pointers leave the levels' texels unspecified.
+void TextureLoader::AllocateStreamedStorage(const DecodedTexture & decoded)
+{
+    const TextureMipChain & mipChain = decoded.MipChain;
+
+    glBindTexture(GL_TEXTURE_2D, decoded.Texture);
+
+    for (size_t levelIdx = 0; levelIdx < mipChain.Levels.size(); levelIdx++)
+    {
+        const TextureMipLevel & level = mipChain.Levels[levelIdx];
+
+        if (IsBlockCompressedFormat(mipChain.Format))
+        {
+            glCompressedTexImage2D(
+                GL_TEXTURE_2D,
+                static_cast<GLint>(levelIdx),
+                GetInternalFormat(mipChain.Format, mipChain.ColorSpace),
+                level.Width,
+                level.Height,
+                0,
+                static_cast<GLsizei>(level.Size),
+                nullptr
+            );
+        }
+        else
+        {
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                static_cast<GLint>(levelIdx),
+                static_cast<GLint>(GetInternalFormat(mipChain.Format, mipChain.ColorSpace)),
+                level.Width,
+                level.Height,
+                0,
+                GL_RGBA,
+                GL_UNSIGNED_BYTE,
+                nullptr
+            );
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, INVALID_OPENGL_TEXTURE);
+}
+
+// Takes the whole unpack buffer region of the frame. Offsets of block compressed ranges are multiples of the block
+// size, and so are their heights short of the bottom edge, as the partial updates of these formats require.
+bool TextureLoader::UploadStreamed(StreamedUpload & streamedUpload)
+{
+    PROFILE_SCOPE("TextureLoader::UploadStreamed");
+
+    const TextureMipChain & mipChain      = streamedUpload.Decoded.MipChain;
+    const int               rowsPerStride = IsBlockCompressedFormat(mipChain.Format) ? TEXTURE_BLOCK_SIZE : 1;
+
+    std::vector<StreamedRowRange> rowRanges;
+    size_t                        rowRangesSize = 0;
+
+    while (streamedUpload.LevelIdx < mipChain.Levels.size())
+    {
+        const TextureMipLevel & level      = mipChain.Levels[streamedUpload.LevelIdx];
+        const size_t            strideSize = GetTextureLevelSize(mipChain.Format, level.Width, 1);
+
+        const size_t remainingStrideCount = static_cast<size_t>(
+            (level.Height - streamedUpload.RowIdx + rowsPerStride - 1) / rowsPerStride
+        );
+        const size_t strideCount = std::min(remainingStrideCount, (TEXTURE_UPLOAD_BUDGET_PER_FRAME - rowRangesSize) / strideSize);
+
+        if (strideCount == 0)
+            break;
+
+        const int rowCount = std::min(static_cast<int>(strideCount)*rowsPerStride, level.Height - streamedUpload.RowIdx);
+
+        rowRanges.push_back(StreamedRowRange{
+            streamedUpload.LevelIdx,
+            streamedUpload.RowIdx,
+            rowCount,
+            strideCount*strideSize,
+            0
+        });
+        rowRangesSize += strideCount*strideSize;
+
+        streamedUpload.RowIdx += rowCount;
+
+        if (streamedUpload.RowIdx == level.Height)
+        {
+            streamedUpload.LevelIdx++;
+            streamedUpload.RowIdx = 0;
+        }
+    }
+
+    assert(!rowRanges.empty() && "a row must fit the upload budget");
+
+    m_UnpackBuffer.BeginFrame();
+
+    // Ranges are copied one by one, levels of baked chains need not be contiguous.
+    for (StreamedRowRange & rowRange : rowRanges)
+    {
+        const TextureMipLevel & level = mipChain.Levels[rowRange.LevelIdx];
+
+        const std::optional<StreamingBuffer::Allocation> allocation = m_UnpackBuffer.Allocate(
+            static_cast<GLsizeiptr>(rowRange.Size),
+            static_cast<GLsizeiptr>(TEXTURE_UPLOAD_CHANNELS_COUNT)
+        );
+
+        assert(allocation.has_value() && "budget must fit the unpack buffer region");
+
+        const size_t dataOffset = level.Offset
+            + GetTextureLevelSize(mipChain.Format, level.Width, 1)*static_cast<size_t>(rowRange.RowIdx / rowsPerStride);
+
+        std::memcpy(allocation->Data, mipChain.Data.data() + dataOffset, rowRange.Size);
+
+        rowRange.UnpackBufferOffset = allocation->Offset;
+    }
+
+    m_UnpackBuffer.FinishWriting();
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_UnpackBuffer.Get());
+    glBindTexture(GL_TEXTURE_2D, streamedUpload.Decoded.Texture);
+
+    for (const StreamedRowRange & rowRange : rowRanges)
+    {
+        const TextureMipLevel & level = mipChain.Levels[rowRange.LevelIdx];
+        const void * const      data  = reinterpret_cast<const void *>(rowRange.UnpackBufferOffset);
+
+        if (IsBlockCompressedFormat(mipChain.Format))
+        {
+            glCompressedTexSubImage2D(
+                GL_TEXTURE_2D,
+                static_cast<GLint>(rowRange.LevelIdx),
+                0,
+                rowRange.RowIdx,
+                level.Width,
+                rowRange.RowCount,
+                GetInternalFormat(mipChain.Format, mipChain.ColorSpace),
+                static_cast<GLsizei>(rowRange.Size),
+                data
+            );
+        }
+        else
+        {
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                static_cast<GLint>(rowRange.LevelIdx),
+                0,
+                rowRange.RowIdx,
+                level.Width,
+                rowRange.RowCount,
+                GL_RGBA,
+                GL_UNSIGNED_BYTE,
+                data
+            );
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, INVALID_OPENGL_BUFFER);
+
+    m_UnpackBuffer.EndFrame();
+
+    const bool isDone = streamedUpload.LevelIdx == mipChain.Levels.size();
+
+    if (isDone)
+        FinishUpload(streamedUpload.Decoded);
+
+    glBindTexture(GL_TEXTURE_2D, INVALID_OPENGL_TEXTURE);
+
+    return isDone;
+}
+
+// Expects the texture to be bound.
+void TextureLoader::FinishUpload(const DecodedTexture & decoded)
+{
+    const TextureMipChain & mipChain = decoded.MipChain;
+
+    // Baked chains may stop short of 1x1, the texture would be incomplete otherwise.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipChain.Levels.size()) - 1);
+
+    LOG_DEBUG<< "Filled in texture " << decoded.Texture << " from " << (decoded.IsBaked ? "baked " : "") << decoded.SourceName;
+
+    m_LoadedCount++;
+    m_UploadedBytes += mipChain.Data.size();
+
+    if (decoded.IsBaked)
+        m_BakedCount++;
+}
+
+void TextureLoader::ReleaseStagingMemory(std::vector<std::byte> && texels)
+{
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_FreeStagingMemory.size() < MAX_FREE_STAGING_MEMORY_COUNT)
+        m_FreeStagingMemory.push_back(std::move(texels));
+}
+
+static GLenum GetInternalFormat(const TextureFormat format, const TextureColorSpace colorSpace)
+{
+    // Sampling sRGB textures returns linear values, framebuffer sRGB conversion is up to the renderer.
+    const bool isSrgb = colorSpace == TextureColorSpace::Srgb;
+
+    switch (format)
+    {
+    case TextureFormat::Rgba8:
+        return isSrgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+    case TextureFormat::Bc1:
+        return isSrgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case TextureFormat::Bc3:
+        return isSrgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case TextureFormat::Bc4:
+        return GL_COMPRESSED_RED_RGTC1;
+    case TextureFormat::Bc5:
+        return GL_COMPRESSED_RG_RGTC2;
+    default:
+        assert(false && "unrecognized texture format");
+        return GL_RGBA8;
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <optional>
+#include <mutex>
+#include <condition_variable>
+
+#include <glad/glad.h>
+
+#include "gl/wrappers.h"
+#include "gl/StreamingBuffer.h"
+#include "threading/ThreadPool.h"
+
+#include "TextureData.h"
+#include "mip_chain.h"
+
+//
+// TextureLoader
+//
+
+// Loads texture files without blocking the GL context thread: files are decoded and their mip chains generated on
+// the thread pool into pooled staging memory, and Update() copies them into a ring of pixel unpack buffers, from
+// which the textures are filled in. Uploads per Update() are capped by the ring's region size, a texture larger
+// than that is streamed through it over Update()s of its own, a range of rows at a time. Baked versions written by
+// learnopengl_texturebake are preferred to the texture files, their mip chains are uploaded as they are, block
+// compressed ones decoded to RGBA8 if the GL lacks their format. Textures sample a placeholder texel until filled in,
+// or for good if their files fail to load. Must be constructed and destroyed on the GL context thread.
+class TextureLoader final
+{
+public: // Construction / Destruction
+
+    explicit TextureLoader(ThreadPool & threadPool);
+
+    // Waits for decoding in progress, which would otherwise outlive the loader on the thread pool.
+    ~TextureLoader();
+
+public: // Copy / Move
+
+    TextureLoader(const TextureLoader &) = delete;
+
+    TextureLoader & operator=(const TextureLoader &) = delete;
+
+public: // Interface
+
+    // Creates the texture with the placeholder right away, leaving sampling parameters up to the caller, and
+    // queues the file for decoding. The texture must not be deleted before the Update() finishing filling it in.
+    // sRGB textures are stored as such, so that sampling them returns linear values.
+    UniqueTexture Load(const std::string & textureFilename, const TextureColorSpace colorSpace = TextureColorSpace::Linear);
+
+    // Fills in decoded textures with all their levels up to the upload budget. Must be called on the
+    // GL context thread in between frames, e.g. by the render thread before every frame.
+    void Update();
+
+    // Blocks until all the queued files are decoded and filled in, regardless of the upload budget,
+    // e.g. so that benchmarks never measure placeholders.
+    void WaitForPendingLoads();
+
+    void LogSummary() const;
+
+private: // Service types
+
+    // Uncompressed chains are always RGBA, so that rows meet the default unpack alignment
+    struct DecodedTexture final
+    {
+        GLuint          Texture;
+        std::string     SourceName;
+        bool            IsBaked;
+        TextureMipChain MipChain;
+    };
+
+    struct StagedUpload final
+    {
+        DecodedTexture Decoded;
+        GLintptr       UnpackBufferOffset;
+    };
+
+    // Rows are texel rows, advancing by whole blocks for block compressed chains
+    struct StreamedUpload final
+    {
+        DecodedTexture Decoded;
+        size_t         LevelIdx;
+        int            RowIdx;
+    };
+
+    struct StreamedRowRange final
+    {
+        size_t   LevelIdx;
+        int      RowIdx;
+        int      RowCount;
+        size_t   Size;
+        GLintptr UnpackBufferOffset;
+    };
+
+private: // Service
+
+    // Called on the thread pool
+    void Decode(const GLuint texture, const std::string & textureFilename, const TextureColorSpace colorSpace);
+
+    // Called on the thread pool, returns std::nullopt to fall back on the texture file.
+    std::optional<TextureMipChain> DecodeBaked(const std::string & textureFilename, const TextureColorSpace colorSpace) const;
+
+    bool IsFormatSupported(const TextureFormat format, const TextureColorSpace colorSpace) const;
+
+    // Fills in the staged textures from the unpack buffer, which the staging memory goes back to the pool after.
+    void UploadStaged(std::vector<StagedUpload> & stagedUploads);
+
+    // Allocates all the levels of a texture exceeding the unpack buffer region size, which get streamed into.
+    void AllocateStreamedStorage(const DecodedTexture & decoded);
+
+    // Fills in as many of the remaining rows as the unpack buffer region fits, returns whether the texture is done.
+    bool UploadStreamed(StreamedUpload & streamedUpload);
+
+    // Limits sampling to the uploaded levels, and counts the texture as loaded.
+    void FinishUpload(const DecodedTexture & decoded);
+
+    void ReleaseStagingMemory(std::vector<std::byte> && texels);
+
+private: // Members
+
+    ThreadPool & m_ThreadPool;
+
+    // Queried on construction, read-only afterwards
+    bool m_IsS3tcSupported;
+    bool m_IsS3tcSrgbSupported;
+
+    mutable std::mutex      m_Mutex;
+    std::condition_variable m_DecodingFinishedCondition;
+
+    // Guarded by the mutex
+    size_t                              m_DecodingCount;
+    std::vector<DecodedTexture>         m_DecodedTextures;
+    std::vector<std::vector<std::byte>> m_FreeStagingMemory;
+    uint64_t                            m_FailedCount;
+
+    // GL context thread state
+    StreamingBuffer               m_UnpackBuffer;
+    std::deque<DecodedTexture>    m_UploadQueue;
+    std::optional<StreamedUpload> m_StreamedUpload;
+    uint64_t                      m_LoadedCount;
+    uint64_t                      m_BakedCount;
+    uint64_t                      m_UploadedBytes;
+};
@@ -0,0 +1,560 @@
+#include "block_compression.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+#include "profiling/profiling.h"
+
+//
+// Constants
+//
+
+static constexpr size_t RGBA_CHANNELS_COUNT = 4;
+static constexpr size_t BLOCK_TEXEL_COUNT   = TEXTURE_BLOCK_SIZE*TEXTURE_BLOCK_SIZE;
+
+// BC1 color blocks and BC4 channel blocks, the other formats combine two of them
+static constexpr size_t HALF_BLOCK_BYTE_SIZE = 8;
+
+//
+// Service types
+//
+
+using Rgba = std::array<uint8_t, RGBA_CHANNELS_COUNT>;
+
+using RgbaBlock = std::array<Rgba, BLOCK_TEXEL_COUNT>;
+
+using Rgb565 = uint16_t;
+
+struct BlockRowTask final
+{
+    size_t LevelIdx;
+    int    BlockRowIdx;
+};
+
+//
+// Forward declarations
+//
+
+static size_t GetBlockByteSize(const TextureFormat format);
+
+static RgbaBlock FetchBlock(const std::byte * const level, const TextureMipLevel & mipLevel, const int blockX, const int blockY);
+
+static void StoreBlock(
+    const RgbaBlock &       block,
+    std::byte * const       level,
+    const TextureMipLevel & mipLevel,
+    const int               blockX,
+    const int               blockY
+);
+
+static void EncodeBlock(const TextureFormat format, const RgbaBlock & block, std::byte * const destination);
+
+static void DecodeBlock(const TextureFormat format, const std::byte * const source, RgbaBlock & block);
+
+static void EncodeColorBlock(const RgbaBlock & block, std::byte * const destination);
+
+static void DecodeColorBlock(const std::byte * const source, const bool mustUseFourColors, RgbaBlock & block);
+
+static void EncodeChannelBlock(const RgbaBlock & block, const size_t channelIdx, std::byte * const destination);
+
+static void DecodeChannelBlock(const std::byte * const source, const size_t channelIdx, RgbaBlock & block);
+
+static Rgb565 PackRgb565(const int red, const int green, const int blue);
+
+static Rgba UnpackRgb565(const Rgb565 color);
+
+static std::array<Rgba, 4> GetColorPalette(const Rgb565 color0, const Rgb565 color1, const bool isFourColor);
+
+static std::array<uint8_t, 8> GetChannelPalette(const uint8_t value0, const uint8_t value1);
+
+//
+// Utilities
+//
+
+bool IsBlockCompressedFormat(const TextureFormat format)
+{
+    return format != TextureFormat::Rgba8;
+}
+
+size_t GetTextureLevelSize(const TextureFormat format, const int width, const int height)
+{
+    assert(width > 0 && height > 0);
+
+    if (!IsBlockCompressedFormat(format))
+        return RGBA_CHANNELS_COUNT*static_cast<size_t>(width)*static_cast<size_t>(height);
+
+    const size_t blocksPerRow = static_cast<size_t>((width + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE);
+    const size_t blockRows    = static_cast<size_t>((height + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE);
+
+    return GetBlockByteSize(format)*blocksPerRow*blockRows;
+}
+
+TextureMipChain CompressMipChain(const TextureMipChain & rgbaMipChain, const TextureFormat format, ThreadPool & threadPool)
+{
+    PROFILE_SCOPE("CompressMipChain");
+
+    assert(rgbaMipChain.Format == TextureFormat::Rgba8 && "only RGBA8 chains can be compressed");
+    assert(IsBlockCompressedFormat(format));
+
+    TextureMipChain mipChain;
+    mipChain.Format     = format;
+    mipChain.ColorSpace = rgbaMipChain.ColorSpace;
+
+    std::vector<BlockRowTask> tasks;
+    size_t                    dataSize = 0;
+
+    for (size_t levelIdx = 0; levelIdx < rgbaMipChain.Levels.size(); levelIdx++)
+    {
+        const TextureMipLevel & rgbaLevel = rgbaMipChain.Levels[levelIdx];
+        const size_t            size      = GetTextureLevelSize(format, rgbaLevel.Width, rgbaLevel.Height);
+
+        mipChain.Levels.push_back(TextureMipLevel{rgbaLevel.Width, rgbaLevel.Height, dataSize, size});
+
+        dataSize += size;
+
+        for (int blockRowIdx = 0; blockRowIdx*TEXTURE_BLOCK_SIZE < rgbaLevel.Height; blockRowIdx++)
+            tasks.push_back(BlockRowTask{levelIdx, blockRowIdx});
+    }
+
+    mipChain.Data.resize(dataSize);
+
+    const size_t blockByteSize = GetBlockByteSize(format);
+
+    // Block rows are independent, and rows of all levels go into one batch, so that small levels don't serialize.
+    threadPool.RunParallel(
+        tasks.size(),
+        [&rgbaMipChain, &mipChain, &tasks, format, blockByteSize] (const size_t taskIdx)
+        {
+            const BlockRowTask &    task      = tasks[taskIdx];
+            const TextureMipLevel & rgbaLevel = rgbaMipChain.Levels[task.LevelIdx];
+            const TextureMipLevel & level     = mipChain.Levels[task.LevelIdx];
+
+            const int blocksPerRow = (rgbaLevel.Width + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE;
+
+            std::byte * const destination = mipChain.Data.data() + level.Offset
+                + blockByteSize*static_cast<size_t>(task.BlockRowIdx)*static_cast<size_t>(blocksPerRow);
+
+            for (int blockX = 0; blockX < blocksPerRow; blockX++)
+            {
+                EncodeBlock(
+                    format,
+                    FetchBlock(rgbaMipChain.Data.data() + rgbaLevel.Offset, rgbaLevel, blockX, task.BlockRowIdx),
+                    destination + blockByteSize*static_cast<size_t>(blockX)
+                );
+            }
+        }
+    );
+
+    return mipChain;
+}
+
+TextureMipChain DecompressMipChain(const TextureMipChain & mipChain)
+{
+    PROFILE_SCOPE("DecompressMipChain");
+
+    assert(IsBlockCompressedFormat(mipChain.Format));
+
+    TextureMipChain rgbaMipChain;
+    rgbaMipChain.Format     = TextureFormat::Rgba8;
+    rgbaMipChain.ColorSpace = mipChain.ColorSpace;
+
+    size_t dataSize = 0;
+
+    for (const TextureMipLevel & level : mipChain.Levels)
+    {
+        const size_t size = GetTextureLevelSize(TextureFormat::Rgba8, level.Width, level.Height);
+
+        rgbaMipChain.Levels.push_back(TextureMipLevel{level.Width, level.Height, dataSize, size});
+
+        dataSize += size;
+    }
+
+    rgbaMipChain.Data.resize(dataSize);
+
+    const size_t blockByteSize = GetBlockByteSize(mipChain.Format);
+
+    for (size_t levelIdx = 0; levelIdx < mipChain.Levels.size(); levelIdx++)
+    {
+        const TextureMipLevel & level     = mipChain.Levels[levelIdx];
+        const TextureMipLevel & rgbaLevel = rgbaMipChain.Levels[levelIdx];
+
+        const std::byte * source = mipChain.Data.data() + level.Offset;
+
+        for (int blockY = 0; blockY*TEXTURE_BLOCK_SIZE < level.Height; blockY++)
+        {
+            for (int blockX = 0; blockX*TEXTURE_BLOCK_SIZE < level.Width; blockX++)
+            {
+                RgbaBlock block;
+                block.fill(Rgba{0, 0, 0, std::numeric_limits<uint8_t>::max()});
+
+                DecodeBlock(mipChain.Format, source, block);
+                StoreBlock(block, rgbaMipChain.Data.data() + rgbaLevel.Offset, rgbaLevel, blockX, blockY);
+
+                source += blockByteSize;
+            }
+        }
+    }
+
+    return rgbaMipChain;
+}
+
+//
+// Service
+//
+
+static size_t GetBlockByteSize(const TextureFormat format)
+{
+    switch (format)
+    {
+    case TextureFormat::Bc1:
+    case TextureFormat::Bc4:
+        return HALF_BLOCK_BYTE_SIZE;
+    case TextureFormat::Bc3:
+    case TextureFormat::Bc5:
+        return 2*HALF_BLOCK_BYTE_SIZE;
+    default:
+        assert(false && "not a block compressed format");
+        return 0;
+    }
+}
+
+// Texels of partial blocks past the level's edges repeat the edge texels, which keeps them out of the endpoint fit.
+static RgbaBlock FetchBlock(const std::byte * const level, const TextureMipLevel & mipLevel, const int blockX, const int blockY)
+{
+    RgbaBlock block;
+
+    for (size_t texelIdx = 0; texelIdx < BLOCK_TEXEL_COUNT; texelIdx++)
+    {
+        const int x = std::min(blockX*TEXTURE_BLOCK_SIZE + static_cast<int>(texelIdx % TEXTURE_BLOCK_SIZE), mipLevel.Width - 1);
+        const int y = std::min(blockY*TEXTURE_BLOCK_SIZE + static_cast<int>(texelIdx / TEXTURE_BLOCK_SIZE), mipLevel.Height - 1);
+
+        const std::byte * const texel = level
+            + RGBA_CHANNELS_COUNT*(static_cast<size_t>(y)*static_cast<size_t>(mipLevel.Width) + static_cast<size_t>(x));
+
+        for (size_t channelIdx = 0; channelIdx < RGBA_CHANNELS_COUNT; channelIdx++)
+            block[texelIdx][channelIdx] = std::to_integer<uint8_t>(texel[channelIdx]);
+    }
+
+    return block;
+}
+
+static void StoreBlock(
+    const RgbaBlock &       block,
+    std::byte * const       level,
+    const TextureMipLevel & mipLevel,
+    const int               blockX,
+    const int               blockY
+)
+{
+    for (size_t texelIdx = 0; texelIdx < BLOCK_TEXEL_COUNT; texelIdx++)
+    {
+        const int x = blockX*TEXTURE_BLOCK_SIZE + static_cast<int>(texelIdx % TEXTURE_BLOCK_SIZE);
+        const int y = blockY*TEXTURE_BLOCK_SIZE + static_cast<int>(texelIdx / TEXTURE_BLOCK_SIZE);
+
+        if (x >= mipLevel.Width || y >= mipLevel.Height)
+            continue;
+
+        std::byte * const texel = level
+            + RGBA_CHANNELS_COUNT*(static_cast<size_t>(y)*static_cast<size_t>(mipLevel.Width) + static_cast<size_t>(x));
+
+        for (size_t channelIdx = 0; channelIdx < RGBA_CHANNELS_COUNT; channelIdx++)
+            texel[channelIdx] = static_cast<std::byte>(block[texelIdx][channelIdx]);
+    }
+}
+
+static void EncodeBlock(const TextureFormat format, const RgbaBlock & block, std::byte * const destination)
+{
+    switch (format)
+    {
+    case TextureFormat::Bc1:
+        EncodeColorBlock(block, destination);
+        break;
+    case TextureFormat::Bc3:
+        EncodeChannelBlock(block, 3, destination);
+        EncodeColorBlock(block, destination + HALF_BLOCK_BYTE_SIZE);
+        break;
+    case TextureFormat::Bc4:
+        EncodeChannelBlock(block, 0, destination);
+        break;
+    case TextureFormat::Bc5:
+        EncodeChannelBlock(block, 0, destination);
+        EncodeChannelBlock(block, 1, destination + HALF_BLOCK_BYTE_SIZE);
+        break;
+    default:
+        assert(false && "not a block compressed format");
+    }
+}
+
+static void DecodeBlock(const TextureFormat format, const std::byte * const source, RgbaBlock & block)
+{
+    switch (format)
+    {
+    case TextureFormat::Bc1:
+        DecodeColorBlock(source, false, block);
+        break;
+    case TextureFormat::Bc3:
+        DecodeColorBlock(source + HALF_BLOCK_BYTE_SIZE, true, block);
+        DecodeChannelBlock(source, 3, block);
+        break;
+    case TextureFormat::Bc4:
+        DecodeChannelBlock(source, 0, block);
+        break;
+    case TextureFormat::Bc5:
+        DecodeChannelBlock(source, 0, block);
+        DecodeChannelBlock(source + HALF_BLOCK_BYTE_SIZE, 1, block);
+        break;
+    default:
+        assert(false && "not a block compressed format");
+    }
+}
+
+// Fits the endpoints to the texels' bounding box, inset to account for the interpolated colors, and flips its
+// red and blue extents to follow the diagonal the texels correlate along. Always uses four color mode, since
+// punch-through alpha isn't supported, and BC3 requires it anyway.
+static void EncodeColorBlock(const RgbaBlock & block, std::byte * const destination)
+{
+    std::array<int, 3> minRgb{255, 255, 255};
+    std::array<int, 3> maxRgb{0, 0, 0};
+
+    for (const Rgba & texel : block)
+    {
+        for (size_t channelIdx = 0; channelIdx < minRgb.size(); channelIdx++)
+        {
+            minRgb[channelIdx] = std::min<int>(minRgb[channelIdx], texel[channelIdx]);
+            maxRgb[channelIdx] = std::max<int>(maxRgb[channelIdx], texel[channelIdx]);
+        }
+    }
+
+    std::array<int, 3> centerRgb;
+
+    for (size_t channelIdx = 0; channelIdx < minRgb.size(); channelIdx++)
+    {
+        const int inset = (maxRgb[channelIdx] - minRgb[channelIdx]) >> 4;
+
+        minRgb[channelIdx]   += inset;
+        maxRgb[channelIdx]   -= inset;
+        centerRgb[channelIdx] = (minRgb[channelIdx] + maxRgb[channelIdx]) / 2;
+    }
+
+    int redGreenCovariance  = 0;
+    int blueGreenCovariance = 0;
+
+    for (const Rgba & texel : block)
+    {
+        const int greenDelta = texel[1] - centerRgb[1];
+
+        redGreenCovariance  += (texel[0] - centerRgb[0])*greenDelta;
+        blueGreenCovariance += (texel[2] - centerRgb[2])*greenDelta;
+    }
+
+    if (redGreenCovariance < 0)
+        std::swap(minRgb[0], maxRgb[0]);
+
+    if (blueGreenCovariance < 0)
+        std::swap(minRgb[2], maxRgb[2]);
+
+    Rgb565 color0 = PackRgb565(maxRgb[0], maxRgb[1], maxRgb[2]);
+    Rgb565 color1 = PackRgb565(minRgb[0], minRgb[1], minRgb[2]);
+
+    // Four color mode is selected by color0 > color1
+    if (color0 < color1)
+        std::swap(color0, color1);
+
+    uint32_t indices = 0;
+
+    // Equal endpoints select three color mode, where index 0 still decodes as color0.
+    if (color0 != color1)
+    {
+        const std::array<Rgba, 4> palette = GetColorPalette(color0, color1, true);
+
+        for (size_t texelIdx = 0; texelIdx < BLOCK_TEXEL_COUNT; texelIdx++)
+        {
+            uint32_t bestIdx      = 0;
+            int      bestDistance = std::numeric_limits<int>::max();
+
+            for (uint32_t paletteIdx = 0; paletteIdx < palette.size(); paletteIdx++)
+            {
+                int distance = 0;
+
+                for (size_t channelIdx = 0; channelIdx < 3; channelIdx++)
+                {
+                    const int delta = block[texelIdx][channelIdx] - palette[paletteIdx][channelIdx];
+                    distance += delta*delta;
+                }
+
+                if (distance < bestDistance)
+                {
+                    bestIdx      = paletteIdx;
+                    bestDistance = distance;
+                }
+            }
+
+            indices |= bestIdx << (2*texelIdx);
+        }
+    }
+
+    // Little endian, as are all block fields
+    destination[0] = static_cast<std::byte>(color0 & 0xFF);
+    destination[1] = static_cast<std::byte>(color0 >> 8);
+    destination[2] = static_cast<std::byte>(color1 & 0xFF);
+    destination[3] = static_cast<std::byte>(color1 >> 8);
+
+    for (size_t byteIdx = 0; byteIdx < 4; byteIdx++)
+        destination[4 + byteIdx] = static_cast<std::byte>((indices >> (8*byteIdx)) & 0xFF);
+}
+
+static void DecodeColorBlock(const std::byte * const source, const bool mustUseFourColors, RgbaBlock & block)
+{
+    const Rgb565 color0 = static_cast<Rgb565>(std::to_integer<unsigned>(source[0]) | std::to_integer<unsigned>(source[1]) << 8);
+    const Rgb565 color1 = static_cast<Rgb565>(std::to_integer<unsigned>(source[2]) | std::to_integer<unsigned>(source[3]) << 8);
+
+    uint32_t indices = 0;
+
+    for (size_t byteIdx = 0; byteIdx < 4; byteIdx++)
+        indices |= std::to_integer<uint32_t>(source[4 + byteIdx]) << (8*byteIdx);
+
+    const std::array<Rgba, 4> palette = GetColorPalette(color0, color1, mustUseFourColors || color0 > color1);
+
+    for (size_t texelIdx = 0; texelIdx < BLOCK_TEXEL_COUNT; texelIdx++)
+        block[texelIdx] = palette[(indices >> (2*texelIdx)) & 0x3];
+}
+
+// Uses eight value mode, the six value one only helps blocks containing both 0 and 255 among other values.
+static void EncodeChannelBlock(const RgbaBlock & block, const size_t channelIdx, std::byte * const destination)
+{
+    uint8_t minValue = std::numeric_limits<uint8_t>::max();
+    uint8_t maxValue = 0;
+
+    for (const Rgba & texel : block)
+    {
+        minValue = std::min(minValue, texel[channelIdx]);
+        maxValue = std::max(maxValue, texel[channelIdx]);
+    }
+
+    uint64_t indices = 0;
+
+    // Eight value mode is selected by value0 > value1, equal values decode as value0 at index 0 either way.
+    if (minValue != maxValue)
+    {
+        const std::array<uint8_t, 8> palette = GetChannelPalette(maxValue, minValue);
+
+        for (size_t texelIdx = 0; texelIdx < BLOCK_TEXEL_COUNT; texelIdx++)
+        {
+            uint64_t bestIdx      = 0;
+            int      bestDistance = std::numeric_limits<int>::max();
+
+            for (uint64_t paletteIdx = 0; paletteIdx < palette.size(); paletteIdx++)
+            {
+                const int distance = std::abs(block[texelIdx][channelIdx] - palette[paletteIdx]);
+
+                if (distance < bestDistance)
+                {
+                    bestIdx      = paletteIdx;
+                    bestDistance = distance;
+                }
+            }
+
+            indices |= bestIdx << (3*texelIdx);
+        }
+    }
+
+    destination[0] = static_cast<std::byte>(maxValue);
+    destination[1] = static_cast<std::byte>(minValue);
+
+    for (size_t byteIdx = 0; byteIdx < 6; byteIdx++)
+        destination[2 + byteIdx] = static_cast<std::byte>((indices >> (8*byteIdx)) & 0xFF);
+}
+
+static void DecodeChannelBlock(const std::byte * const source, const size_t channelIdx, RgbaBlock & block)
+{
+    const std::array<uint8_t, 8> palette = GetChannelPalette(
+        std::to_integer<uint8_t>(source[0]),
+        std::to_integer<uint8_t>(source[1])
+    );
+
+    uint64_t indices = 0;
+
+    for (size_t byteIdx = 0; byteIdx < 6; byteIdx++)
+        indices |= std::to_integer<uint64_t>(source[2 + byteIdx]) << (8*byteIdx);
+
+    for (size_t texelIdx = 0; texelIdx < BLOCK_TEXEL_COUNT; texelIdx++)
+        block[texelIdx][channelIdx] = palette[(indices >> (3*texelIdx)) & 0x7];
+}
+
+static Rgb565 PackRgb565(const int red, const int green, const int blue)
+{
+    const int red5   = (red*31 + 127) / 255;
+    const int green6 = (green*63 + 127) / 255;
+    const int blue5  = (blue*31 + 127) / 255;
+
+    return static_cast<Rgb565>(red5 << 11 | green6 << 5 | blue5);
+}
+
+static Rgba UnpackRgb565(const Rgb565 color)
+{
+    const int red5   = color >> 11 & 0x1F;
+    const int green6 = color >> 5 & 0x3F;
+    const int blue5  = color & 0x1F;
+
+    return Rgba{
+        static_cast<uint8_t>(red5 << 3 | red5 >> 2),
+        static_cast<uint8_t>(green6 << 2 | green6 >> 4),
+        static_cast<uint8_t>(blue5 << 3 | blue5 >> 2),
+        std::numeric_limits<uint8_t>::max()
+    };
+}
+
+// Three color mode has a transparent black fourth color.
+static std::array<Rgba, 4> GetColorPalette(const Rgb565 color0, const Rgb565 color1, const bool isFourColor)
+{
+    std::array<Rgba, 4> palette{UnpackRgb565(color0), UnpackRgb565(color1), Rgba{}, Rgba{}};
+
+    for (size_t channelIdx = 0; channelIdx < 3; channelIdx++)
+    {
+        const int value0 = palette[0][channelIdx];
+        const int value1 = palette[1][channelIdx];
+
+        if (isFourColor)
+        {
+            palette[2][channelIdx] = static_cast<uint8_t>((2*value0 + value1 + 1) / 3);
+            palette[3][channelIdx] = static_cast<uint8_t>((value0 + 2*value1 + 1) / 3);
+        }
+        else
+        {
+            palette[2][channelIdx] = static_cast<uint8_t>((value0 + value1 + 1) / 2);
+        }
+    }
+
+    palette[2][3] = std::numeric_limits<uint8_t>::max();
+    palette[3][3] = isFourColor ? std::numeric_limits<uint8_t>::max() : 0;
+
+    return palette;
+}
+
+// Eight value mode interpolates six values, six value mode interpolates four and adds 0 and 255.
+static std::array<uint8_t, 8> GetChannelPalette(const uint8_t value0, const uint8_t value1)
+{
+    std::array<uint8_t, 8> palette{value0, value1};
+
+    if (value0 > value1)
+    {
+        for (int step = 1; step <= 6; step++)
+            palette[1 + step] = static_cast<uint8_t>(((7 - step)*value0 + step*value1 + 3) / 7);
+    }
+    else
+    {
+        for (int step = 1; step <= 4; step++)
+            palette[1 + step] = static_cast<uint8_t>(((5 - step)*value0 + step*value1 + 2) / 5);
+
+        palette[6] = 0;
+        palette[7] = std::numeric_limits<uint8_t>::max();
+    }
+
+    return palette;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+#include "threading/ThreadPool.h"
+
+#include "TextureData.h"
+#include "mip_chain.h"
+
+//
+// Constants
+//
+
+// Width and height of the texel blocks block compressed formats encode
+constexpr int TEXTURE_BLOCK_SIZE = 4;
+
+//
+// Utilities
+//
+
+bool IsBlockCompressedFormat(const TextureFormat format);
+
+// Partial blocks at the right and bottom edges take up whole blocks.
+size_t GetTextureLevelSize(const TextureFormat format, const int width, const int height);
+
+// Encodes every level of an RGBA8 chain, blocks are spread across the thread pool and the calling thread. BC4 and BC5
+// keep the red and red-green channels respectively.
+TextureMipChain CompressMipChain(const TextureMipChain & rgbaMipChain, const TextureFormat format, ThreadPool & threadPool);
+
+// Decodes a block compressed chain into RGBA8, e.g. to fall back on when the GL lacks the format. Channels missing
+// from the format decode as GL samples them, i.e. 0 for color and 255 for alpha.
+TextureMipChain DecompressMipChain(const TextureMipChain & mipChain);
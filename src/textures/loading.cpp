@@ -1,41 +1,71 @@
 #include "loading.h"
 
 #include <cassert>
+#include <cstring>
+#include <array>
+#include <algorithm>
 
 #include "stb_image.h"
 
+#include "profiling/profiling.h"
 #include "config.h"
 #include "logging.h"
 
+//
+// Constants
+//
+
+// Rows are swapped through a stack buffer in chunks of this size, memcpy handles the vectorization.
+static constexpr size_t ROW_SWAP_CHUNK_SIZE = 4096;
+
 //
 // Forward declarations
 //
 
 static std::string GetFullTexturePath(const std::string & textureFilename);
 
+static void FlipRowsVertically(TextureByte * const data, const size_t rowSize, const size_t rowCount);
+
 //
 // Utilities
 //
 
-TextureData LoadTextureDataFromFile(const std::string & textureFilename)
+TextureData LoadTextureDataFromFile(const std::string & textureFilename, const TextureLoadingOptions & options)
 {
-    stbi_set_flip_vertically_on_load(true);
+    PROFILE_SCOPE("LoadTextureDataFromFile");
+
+    assert(options.DesiredChannelsCount >= 0 && options.DesiredChannelsCount <= 4);
 
     TextureMetadata metadata;
+    metadata.ColorSpace = options.ColorSpace;
     metadata.SourceName = textureFilename;
 
+    // stb_image's flip flag is never set, so it stays off for every thread.
     TextureByte * const data = stbi_load(
         GetFullTexturePath(textureFilename).c_str(),
         &metadata.Width,
         &metadata.Height,
         &metadata.ChannelsCount,
-        0
+        options.DesiredChannelsCount
     );
 
     if (data == nullptr)
         throw TextureLoadingException(textureFilename);
 
-    BOOST_LOG_TRIVIAL(debug)<< "Loaded texture data from " << textureFilename;
+    // Reports the file's channels otherwise
+    if (options.DesiredChannelsCount != 0)
+        metadata.ChannelsCount = options.DesiredChannelsCount;
+
+    if (options.MustFlipVertically)
+    {
+        FlipRowsVertically(
+            data,
+            static_cast<size_t>(metadata.Width)*static_cast<size_t>(metadata.ChannelsCount),
+            static_cast<size_t>(metadata.Height)
+        );
+    }
+
+    LOG_DEBUG<< "Loaded texture data from " << textureFilename;
 
     return TextureData::CreateFromStbImage(data, std::move(metadata));
 }
@@ -52,6 +82,29 @@ static std::string GetFullTexturePath(const std::string & textureFilename)
     return TEXTURES_DIR + textureFilename;
 }
 
+// Rows of 8-bit texels are tightly packed, as returned by stb_image.
+static void FlipRowsVertically(TextureByte * const data, const size_t rowSize, const size_t rowCount)
+{
+    PROFILE_SCOPE("FlipRowsVertically");
+
+    std::array<TextureByte, ROW_SWAP_CHUNK_SIZE> chunk;
+
+    for (size_t topRowIdx = 0; topRowIdx < rowCount / 2; topRowIdx++)
+    {
+        TextureByte * const topRow    = data + topRowIdx*rowSize;
+        TextureByte * const bottomRow = data + (rowCount - 1 - topRowIdx)*rowSize;
+
+        for (size_t chunkOffset = 0; chunkOffset < rowSize; chunkOffset += chunk.size())
+        {
+            const size_t chunkSize = std::min(chunk.size(), rowSize - chunkOffset);
+
+            std::memcpy(chunk.data(), topRow + chunkOffset, chunkSize);
+            std::memcpy(topRow + chunkOffset, bottomRow + chunkOffset, chunkSize);
+            std::memcpy(bottomRow + chunkOffset, chunk.data(), chunkSize);
+        }
+    }
+}
+
 //
 // Exceptions
 //
@@ -4,11 +4,28 @@
 
 #include "TextureData.h"
 
+//
+// Interface types
+//
+
+struct TextureLoadingOptions final
+{
+    // Puts the first row at the bottom, as GL expects texture data
+    bool MustFlipVertically = true;
+
+    // Converts to this many channels, e.g. 4 to always get RGBA, 0 keeps the file's channels
+    int DesiredChannelsCount = 0;
+
+    // Recorded in the metadata for whoever creates the texture, texels are left as they are.
+    TextureColorSpace ColorSpace = TextureColorSpace::Linear;
+};
+
 //
 // Utilities
 //
 
-TextureData LoadTextureDataFromFile(const std::string & textureFilename);
+// Safe to call concurrently, e.g. on the thread pool, since options are per call instead of stb_image's global state.
+TextureData LoadTextureDataFromFile(const std::string & textureFilename, const TextureLoadingOptions & options = {});
 
 //
 // Exceptions
@@ -0,0 +1,449 @@
+#include "mip_chain.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <numbers>
+#include <algorithm>
+#include <utility>
+
+#include "profiling/profiling.h"
+
+//
+// Constants
+//
+
+static constexpr size_t RGBA_CHANNELS_COUNT = 4;
+static constexpr size_t ALPHA_CHANNEL_IDX   = 3;
+
+// Half width of the filter in destination texels and the Kaiser window's shape, sharper than a box or tent filter
+// without ringing noticeably.
+static constexpr float KAISER_FILTER_RADIUS = 3.0f;
+static constexpr float KAISER_FILTER_ALPHA  = 4.0f;
+
+// Alpha scales searched for a level to match the base level's alpha coverage
+static constexpr float MAX_ALPHA_COVERAGE_SCALE    = 4.0f;
+static constexpr int   ALPHA_COVERAGE_SEARCH_STEPS = 10;
+
+//
+// Service types
+//
+
+// Source texels and their weights contributing to every destination texel along an axis, TapsPerTexel of each.
+// Indices are clamped to the edge.
+struct AxisFilter final
+{
+    size_t             TapsPerTexel;
+    std::vector<int>   TapIndices;
+    std::vector<float> TapWeights;
+};
+
+// Linear RGBA, 4 floats per texel
+struct LinearLevel final
+{
+    int                Width;
+    int                Height;
+    std::vector<float> Channels;
+};
+
+//
+// Forward declarations
+//
+
+static AxisFilter CreateAxisFilter(const int sourceSize, const int destinationSize);
+
+static float EvaluateKaiserFilter(const float x);
+
+static float EvaluateBesselI0(const float x);
+
+static LinearLevel ConvertToLinear(const std::byte * const texels, const TextureMipLevel & level, const TextureColorSpace colorSpace, ThreadPool & threadPool);
+
+static LinearLevel DownsampleLevel(const LinearLevel & sourceLevel, const int width, const int height, ThreadPool & threadPool);
+
+static float FindAlphaCoverageScale(const LinearLevel & level, const float cutoff, const float coverage);
+
+static float GetAlphaCoverage(const LinearLevel & level, const float cutoff, const float scale);
+
+static void ConvertFromLinear(
+    const LinearLevel &     level,
+    const TextureColorSpace colorSpace,
+    const float             alphaScale,
+    std::byte * const       texels,
+    ThreadPool &            threadPool
+);
+
+static uint8_t EncodeSrgb(const float value);
+
+static double DecodeSrgb(const double encoded);
+
+static const std::array<float, 256> & GetSrgbDecodingTable();
+
+//
+// Utilities
+//
+
+int GetMipLevelCount(const int width, const int height)
+{
+    assert(width > 0 && height > 0);
+
+    int levelCount = 1;
+
+    for (int size = std::max(width, height); size > 1; size /= 2)
+        levelCount++;
+
+    return levelCount;
+}
+
+TextureMipChain GenerateMipChain(
+    const TextureData &     rgbaTextureData,
+    ThreadPool &            threadPool,
+    const MipChainOptions & options,
+    std::vector<std::byte>  storage
+)
+{
+    PROFILE_SCOPE("GenerateMipChain");
+
+    const TextureMetadata & metadata = rgbaTextureData.GetMetadata();
+
+    assert(metadata.ChannelsCount == RGBA_CHANNELS_COUNT && "texture data must be RGBA");
+
+    TextureMipChain mipChain;
+    mipChain.Format     = TextureFormat::Rgba8;
+    mipChain.ColorSpace = metadata.ColorSpace;
+
+    const int levelCount = GetMipLevelCount(metadata.Width, metadata.Height);
+
+    size_t dataSize = 0;
+
+    for (int levelIdx = 0; levelIdx < levelCount; levelIdx++)
+    {
+        const int    width  = std::max(metadata.Width >> levelIdx, 1);
+        const int    height = std::max(metadata.Height >> levelIdx, 1);
+        const size_t size   = RGBA_CHANNELS_COUNT*static_cast<size_t>(width)*static_cast<size_t>(height);
+
+        mipChain.Levels.push_back(TextureMipLevel{width, height, dataSize, size});
+
+        dataSize += size;
+    }
+
+    mipChain.Data = std::move(storage);
+    mipChain.Data.resize(dataSize);
+
+    std::memcpy(mipChain.Data.data(), rgbaTextureData.GetData(), mipChain.Levels.front().Size);
+
+    if (levelCount == 1)
+        return mipChain;
+
+    LinearLevel linearLevel = ConvertToLinear(mipChain.Data.data(), mipChain.Levels.front(), mipChain.ColorSpace, threadPool);
+
+    const float baseAlphaCoverage = options.AlphaCoverageCutoff.has_value()
+        ? GetAlphaCoverage(linearLevel, *options.AlphaCoverageCutoff, 1.0f)
+        : 0.0f;
+
+    for (size_t levelIdx = 1; levelIdx < mipChain.Levels.size(); levelIdx++)
+    {
+        const TextureMipLevel & level = mipChain.Levels[levelIdx];
+
+        // Downsampled from the unscaled alpha of the previous level, each level is scaled towards the base coverage.
+        linearLevel = DownsampleLevel(linearLevel, level.Width, level.Height, threadPool);
+
+        const float alphaScale = options.AlphaCoverageCutoff.has_value()
+            ? FindAlphaCoverageScale(linearLevel, *options.AlphaCoverageCutoff, baseAlphaCoverage)
+            : 1.0f;
+
+        ConvertFromLinear(linearLevel, mipChain.ColorSpace, alphaScale, mipChain.Data.data() + level.Offset, threadPool);
+    }
+
+    return mipChain;
+}
+
+//
+// Service
+//
+
+static AxisFilter CreateAxisFilter(const int sourceSize, const int destinationSize)
+{
+    assert(sourceSize >= destinationSize);
+
+    // Levels of non-square textures keep their size along an axis once it reaches 1, which the filter reduces to a
+    // copy along, as the sinc is 0 at every other texel center.
+    const float scale  = static_cast<float>(sourceSize) / static_cast<float>(destinationSize);
+    const float radius = KAISER_FILTER_RADIUS*scale;
+
+    AxisFilter filter;
+    filter.TapsPerTexel = static_cast<size_t>(std::ceil(2.0f*radius)) + 1;
+    filter.TapIndices.resize(filter.TapsPerTexel*static_cast<size_t>(destinationSize));
+    filter.TapWeights.resize(filter.TapsPerTexel*static_cast<size_t>(destinationSize));
+
+    for (int destinationIdx = 0; destinationIdx < destinationSize; destinationIdx++)
+    {
+        const float center   = (static_cast<float>(destinationIdx) + 0.5f)*scale;
+        const int   firstTap = static_cast<int>(std::floor(center - radius));
+
+        int   * const tapIndices = filter.TapIndices.data() + filter.TapsPerTexel*static_cast<size_t>(destinationIdx);
+        float * const tapWeights = filter.TapWeights.data() + filter.TapsPerTexel*static_cast<size_t>(destinationIdx);
+
+        float weightSum = 0.0f;
+
+        for (size_t tapIdx = 0; tapIdx < filter.TapsPerTexel; tapIdx++)
+        {
+            const int sourceIdx = firstTap + static_cast<int>(tapIdx);
+
+            tapIndices[tapIdx] = std::clamp(sourceIdx, 0, sourceSize - 1);
+            tapWeights[tapIdx] = EvaluateKaiserFilter((static_cast<float>(sourceIdx) + 0.5f - center) / scale);
+
+            weightSum += tapWeights[tapIdx];
+        }
+
+        for (size_t tapIdx = 0; tapIdx < filter.TapsPerTexel; tapIdx++)
+            tapWeights[tapIdx] /= weightSum;
+    }
+
+    return filter;
+}
+
+// Sinc windowed by a Kaiser window, x is in destination texels.
+static float EvaluateKaiserFilter(const float x)
+{
+    if (std::abs(x) >= KAISER_FILTER_RADIUS)
+        return 0.0f;
+
+    const float relativeX = x / KAISER_FILTER_RADIUS;
+    const float window    = EvaluateBesselI0(KAISER_FILTER_ALPHA*std::sqrt(1.0f - relativeX*relativeX))
+        / EvaluateBesselI0(KAISER_FILTER_ALPHA);
+
+    if (std::abs(x) < 1e-5f)
+        return window;
+
+    const float piX = std::numbers::pi_v<float>*x;
+
+    return std::sin(piX) / piX*window;
+}
+
+// Zeroth order modified Bessel function of the first kind, by its power series.
+static float EvaluateBesselI0(const float x)
+{
+    float sum  = 1.0f;
+    float term = 1.0f;
+
+    for (int termIdx = 1; term > sum*1e-7f; termIdx++)
+    {
+        const float factor = x / (2.0f*static_cast<float>(termIdx));
+
+        term *= factor*factor;
+        sum  += term;
+    }
+
+    return sum;
+}
+
+static LinearLevel ConvertToLinear(const std::byte * const texels, const TextureMipLevel & level, const TextureColorSpace colorSpace, ThreadPool & threadPool)
+{
+    PROFILE_SCOPE("ConvertToLinear");
+
+    const std::array<float, 256> & srgbDecodingTable = GetSrgbDecodingTable();
+
+    const size_t rowChannelCount = RGBA_CHANNELS_COUNT*static_cast<size_t>(level.Width);
+
+    LinearLevel linearLevel{level.Width, level.Height, std::vector<float>(rowChannelCount*static_cast<size_t>(level.Height))};
+
+    threadPool.RunParallel(
+        static_cast<size_t>(level.Height),
+        [texels, colorSpace, &srgbDecodingTable, rowChannelCount, &linearLevel] (const size_t rowIdx)
+        {
+            const std::byte * const sourceRow      = texels + rowChannelCount*rowIdx;
+            float * const           destinationRow = linearLevel.Channels.data() + rowChannelCount*rowIdx;
+
+            for (size_t channelIdx = 0; channelIdx < rowChannelCount; channelIdx++)
+            {
+                const uint8_t value = std::to_integer<uint8_t>(sourceRow[channelIdx]);
+
+                const bool isColor = channelIdx % RGBA_CHANNELS_COUNT != ALPHA_CHANNEL_IDX;
+
+                destinationRow[channelIdx] = colorSpace == TextureColorSpace::Srgb && isColor
+                    ? srgbDecodingTable[value]
+                    : static_cast<float>(value) / 255.0f;
+            }
+        }
+    );
+
+    return linearLevel;
+}
+
+// Filters rows into an intermediate level of the destination width, then its columns. Inner loops run over
+// contiguous floats of a row, so that the compiler vectorizes them.
+static LinearLevel DownsampleLevel(const LinearLevel & sourceLevel, const int width, const int height, ThreadPool & threadPool)
+{
+    PROFILE_SCOPE("DownsampleLevel");
+
+    const AxisFilter horizontalFilter = CreateAxisFilter(sourceLevel.Width, width);
+    const AxisFilter verticalFilter   = CreateAxisFilter(sourceLevel.Height, height);
+
+    const size_t sourceRowChannelCount      = RGBA_CHANNELS_COUNT*static_cast<size_t>(sourceLevel.Width);
+    const size_t destinationRowChannelCount = RGBA_CHANNELS_COUNT*static_cast<size_t>(width);
+
+    std::vector<float> rows(destinationRowChannelCount*static_cast<size_t>(sourceLevel.Height));
+
+    threadPool.RunParallel(
+        static_cast<size_t>(sourceLevel.Height),
+        [&sourceLevel, &horizontalFilter, &rows, sourceRowChannelCount, destinationRowChannelCount, width] (const size_t rowIdx)
+        {
+            const float * const sourceRow      = sourceLevel.Channels.data() + sourceRowChannelCount*rowIdx;
+            float * const       destinationRow = rows.data() + destinationRowChannelCount*rowIdx;
+
+            for (size_t texelIdx = 0; texelIdx < static_cast<size_t>(width); texelIdx++)
+            {
+                const int   * const tapIndices = horizontalFilter.TapIndices.data() + horizontalFilter.TapsPerTexel*texelIdx;
+                const float * const tapWeights = horizontalFilter.TapWeights.data() + horizontalFilter.TapsPerTexel*texelIdx;
+
+                float texel[RGBA_CHANNELS_COUNT]{};
+
+                for (size_t tapIdx = 0; tapIdx < horizontalFilter.TapsPerTexel; tapIdx++)
+                {
+                    const float * const sourceTexel = sourceRow + RGBA_CHANNELS_COUNT*static_cast<size_t>(tapIndices[tapIdx]);
+
+                    for (size_t channelIdx = 0; channelIdx < RGBA_CHANNELS_COUNT; channelIdx++)
+                        texel[channelIdx] += tapWeights[tapIdx]*sourceTexel[channelIdx];
+                }
+
+                std::memcpy(destinationRow + RGBA_CHANNELS_COUNT*texelIdx, texel, sizeof(texel));
+            }
+        }
+    );
+
+    LinearLevel destinationLevel{width, height, std::vector<float>(destinationRowChannelCount*static_cast<size_t>(height))};
+
+    threadPool.RunParallel(
+        static_cast<size_t>(height),
+        [&verticalFilter, &rows, &destinationLevel, destinationRowChannelCount] (const size_t rowIdx)
+        {
+            const int   * const tapIndices = verticalFilter.TapIndices.data() + verticalFilter.TapsPerTexel*rowIdx;
+            const float * const tapWeights = verticalFilter.TapWeights.data() + verticalFilter.TapsPerTexel*rowIdx;
+
+            float * const destinationRow = destinationLevel.Channels.data() + destinationRowChannelCount*rowIdx;
+
+            for (size_t tapIdx = 0; tapIdx < verticalFilter.TapsPerTexel; tapIdx++)
+            {
+                const float * const sourceRow = rows.data() + destinationRowChannelCount*static_cast<size_t>(tapIndices[tapIdx]);
+                const float         weight    = tapWeights[tapIdx];
+
+                for (size_t channelIdx = 0; channelIdx < destinationRowChannelCount; channelIdx++)
+                    destinationRow[channelIdx] += weight*sourceRow[channelIdx];
+            }
+        }
+    );
+
+    return destinationLevel;
+}
+
+// Coverage only grows with the scale, so it's found by bisection.
+static float FindAlphaCoverageScale(const LinearLevel & level, const float cutoff, const float coverage)
+{
+    float minScale = 0.0f;
+    float maxScale = MAX_ALPHA_COVERAGE_SCALE;
+
+    for (int stepIdx = 0; stepIdx < ALPHA_COVERAGE_SEARCH_STEPS; stepIdx++)
+    {
+        const float scale = 0.5f*(minScale + maxScale);
+
+        if (GetAlphaCoverage(level, cutoff, scale) < coverage)
+            minScale = scale;
+        else
+            maxScale = scale;
+    }
+
+    return 0.5f*(minScale + maxScale);
+}
+
+// Fraction of texels whose scaled alpha passes the test.
+static float GetAlphaCoverage(const LinearLevel & level, const float cutoff, const float scale)
+{
+    size_t coveredCount = 0;
+
+    for (size_t channelIdx = ALPHA_CHANNEL_IDX; channelIdx < level.Channels.size(); channelIdx += RGBA_CHANNELS_COUNT)
+    {
+        if (level.Channels[channelIdx]*scale > cutoff)
+            coveredCount++;
+    }
+
+    return static_cast<float>(coveredCount) / static_cast<float>(level.Channels.size() / RGBA_CHANNELS_COUNT);
+}
+
+// Clamps values the filter's negative lobes overshoot by.
+static void ConvertFromLinear(
+    const LinearLevel &     level,
+    const TextureColorSpace colorSpace,
+    const float             alphaScale,
+    std::byte * const       texels,
+    ThreadPool &            threadPool
+)
+{
+    PROFILE_SCOPE("ConvertFromLinear");
+
+    const size_t rowChannelCount = RGBA_CHANNELS_COUNT*static_cast<size_t>(level.Width);
+
+    threadPool.RunParallel(
+        static_cast<size_t>(level.Height),
+        [&level, colorSpace, alphaScale, texels, rowChannelCount] (const size_t rowIdx)
+        {
+            const float * const sourceRow      = level.Channels.data() + rowChannelCount*rowIdx;
+            std::byte * const   destinationRow = texels + rowChannelCount*rowIdx;
+
+            for (size_t channelIdx = 0; channelIdx < rowChannelCount; channelIdx++)
+            {
+                const bool isAlpha = channelIdx % RGBA_CHANNELS_COUNT == ALPHA_CHANNEL_IDX;
+
+                const float value = std::clamp(isAlpha ? sourceRow[channelIdx]*alphaScale : sourceRow[channelIdx], 0.0f, 1.0f);
+
+                destinationRow[channelIdx] = colorSpace == TextureColorSpace::Srgb && !isAlpha
+                    ? static_cast<std::byte>(EncodeSrgb(value))
+                    : static_cast<std::byte>(std::lround(value*255.0f));
+            }
+        }
+    );
+}
+
+// Rounds to the nearest encoded value by searching the midpoints between decoded ones, which matches encoding
+// with the sRGB transfer function exactly, without evaluating it per texel.
+static uint8_t EncodeSrgb(const float value)
+{
+    static const std::array<float, 255> s_Midpoints = []
+    {
+        const std::array<float, 256> & srgbDecodingTable = GetSrgbDecodingTable();
+
+        std::array<float, 255> midpoints;
+
+        for (size_t valueIdx = 0; valueIdx < midpoints.size(); valueIdx++)
+        {
+            midpoints[valueIdx] = static_cast<float>(DecodeSrgb((static_cast<double>(valueIdx) + 0.5) / 255.0));
+
+            assert(midpoints[valueIdx] > srgbDecodingTable[valueIdx] && midpoints[valueIdx] < srgbDecodingTable[valueIdx + 1]);
+        }
+
+        return midpoints;
+    }();
+
+    return static_cast<uint8_t>(std::upper_bound(s_Midpoints.begin(), s_Midpoints.end(), value) - s_Midpoints.begin());
+}
+
+static const std::array<float, 256> & GetSrgbDecodingTable()
+{
+    static const std::array<float, 256> s_Table = []
+    {
+        std::array<float, 256> table;
+
+        for (size_t valueIdx = 0; valueIdx < table.size(); valueIdx++)
+            table[valueIdx] = static_cast<float>(DecodeSrgb(static_cast<double>(valueIdx) / 255.0));
+
+        return table;
+    }();
+
+    return s_Table;
+}
+
+static double DecodeSrgb(const double encoded)
+{
+    return encoded <= 0.04045 ? encoded / 12.92 : std::pow((encoded + 0.055) / 1.055, 2.4);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "threading/ThreadPool.h"
+
+#include "TextureData.h"
+
+//
+// Interface types
+//
+
+struct TextureMipLevel final
+{
+    int    Width;
+    int    Height;
+    size_t Offset; // Into TextureMipChain::Data
+    size_t Size;
+};
+
+// Levels are ordered from the base level down and tightly packed into Data.
+struct TextureMipChain final
+{
+    TextureFormat                Format;
+    TextureColorSpace            ColorSpace;
+    std::vector<TextureMipLevel> Levels;
+    std::vector<std::byte>       Data;
+};
+
+struct MipChainOptions final
+{
+    // Alpha value alpha tested textures are cut out at. If set, alpha of every level is scaled so that the same
+    // fraction of texels passes the test as in the base level, instead of cutouts thinning out with distance.
+    std::optional<float> AlphaCoverageCutoff;
+};
+
+//
+// Utilities
+//
+
+// Levels of a full chain down to 1x1, as glGenerateMipmap would produce.
+int GetMipLevelCount(const int width, const int height);
+
+// Builds the full RGBA8 chain of an RGBA texture. Levels are downsampled from the previous one with a separable
+// Kaiser windowed sinc filter, in linear space for sRGB textures, and kept in float in between so that rounding
+// errors don't add up down the chain. Rows are spread across the thread pool and the calling thread, which may
+// be one of its workers. Data reuses the storage passed in, e.g. pooled staging memory.
+TextureMipChain GenerateMipChain(
+    const TextureData &     rgbaTextureData,
+    ThreadPool &            threadPool,
+    const MipChainOptions & options = {},
+    std::vector<std::byte>  storage = {}
+);
@@ -0,0 +1,204 @@
+#include "texture_file.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+#include "utils/file_utils.h"
+#include "profiling/profiling.h"
+#include "config.h"
+#include "logging.h"
+
+#include "block_compression.h"
+
+//
+// Constants
+//
+
+static constexpr std::array<char, 8> TEXTURE_FILE_MAGIC{'L', 'O', 'G', 'L', 'T', 'E', 'X', 'R'};
+
+// Bumping it invalidates all baked textures, e.g. when encoders or mipmap filters change.
+static constexpr uint32_t TEXTURE_FILE_VERSION = 3;
+
+static const std::string BAKED_TEXTURE_EXTENSION = ".gltex";
+
+//
+// Service types
+//
+
+// Laid out like KTX2 without supercompression: the header, an index of levels from the base level down,
+// then the levels' data.
+struct TextureFileHeader final
+{
+    std::array<char, 8> Magic;
+    uint32_t            Version;
+    uint32_t            Format;
+    uint32_t            ColorSpace;
+    uint32_t            Width;
+    uint32_t            Height;
+    uint32_t            LevelCount;
+    uint64_t            SourceSize;
+    int64_t             SourceModificationTime;
+};
+
+// Offsets are relative to the data following the index.
+struct TextureFileLevelEntry final
+{
+    uint64_t Offset;
+    uint64_t Size;
+};
+
+//
+// Forward declarations
+//
+
+static bool IsKnownFormat(const uint32_t format);
+
+static bool IsKnownColorSpace(const uint32_t colorSpace);
+
+//
+// Utilities
+//
+
+std::string GetBakedTexturePath(const std::string & textureFilename)
+{
+    return BAKED_TEXTURES_DIR + textureFilename + BAKED_TEXTURE_EXTENSION;
+}
+
+std::optional<TextureMipChain> ReadTextureFile(const std::string & path, const FileStamp & sourceStamp)
+{
+    PROFILE_SCOPE("ReadTextureFile");
+
+    std::vector<std::byte> content;
+
+    try
+    {
+        content = ReadBinaryFileContent(path);
+    }
+    catch (const FileException &)
+    {
+        return std::nullopt;
+    }
+
+    TextureFileHeader header{};
+
+    if (content.size() >= sizeof(header))
+        std::memcpy(&header, content.data(), sizeof(header));
+
+    const size_t indexSize = sizeof(TextureFileLevelEntry)*header.LevelCount;
+
+    const bool isHeaderValid = content.size() >= sizeof(header)
+        && header.Magic == TEXTURE_FILE_MAGIC
+        && header.Version == TEXTURE_FILE_VERSION
+        && IsKnownFormat(header.Format)
+        && IsKnownColorSpace(header.ColorSpace)
+        && header.Width > 0
+        && header.Height > 0
+        && header.Width <= static_cast<uint32_t>(std::numeric_limits<int>::max())
+        && header.Height <= static_cast<uint32_t>(std::numeric_limits<int>::max())
+        && header.LevelCount > 0
+        && header.LevelCount <= static_cast<uint32_t>(GetMipLevelCount(static_cast<int>(header.Width), static_cast<int>(header.Height)))
+        && content.size() - sizeof(header) >= indexSize;
+
+    if (!isHeaderValid)
+    {
+        LOG_WARNING<< "Ignoring malformed or outdated texture file " << path;
+
+        return std::nullopt;
+    }
+
+    if (FileStamp{header.SourceSize, header.SourceModificationTime} != sourceStamp)
+    {
+        LOG_WARNING<< "Ignoring texture file " << path << ", its source changed since it was baked";
+
+        return std::nullopt;
+    }
+
+    TextureMipChain mipChain;
+    mipChain.Format     = static_cast<TextureFormat>(header.Format);
+    mipChain.ColorSpace = static_cast<TextureColorSpace>(header.ColorSpace);
+
+    const size_t dataOffset = sizeof(header) + indexSize;
+    const size_t dataSize   = content.size() - dataOffset;
+
+    for (uint32_t levelIdx = 0; levelIdx < header.LevelCount; levelIdx++)
+    {
+        TextureFileLevelEntry entry{};
+        std::memcpy(&entry, content.data() + sizeof(header) + levelIdx*sizeof(entry), sizeof(entry));
+
+        const int width  = std::max(static_cast<int>(header.Width >> levelIdx), 1);
+        const int height = std::max(static_cast<int>(header.Height >> levelIdx), 1);
+
+        // Sizes are implied by the format, so that uploads never read past the data.
+        const bool isEntryValid = entry.Offset <= dataSize
+            && entry.Size <= dataSize - entry.Offset
+            && entry.Size == GetTextureLevelSize(mipChain.Format, width, height);
+
+        if (!isEntryValid)
+        {
+            LOG_WARNING<< "Ignoring texture file " << path << " with malformed level " << levelIdx;
+
+            return std::nullopt;
+        }
+
+        mipChain.Levels.push_back(TextureMipLevel{width, height, entry.Offset, entry.Size});
+    }
+
+    // Levels keep their offsets, the index just gets dropped.
+    content.erase(content.begin(), content.begin() + static_cast<std::ptrdiff_t>(dataOffset));
+    mipChain.Data = std::move(content);
+
+    return mipChain;
+}
+
+void WriteTextureFile(const std::string & path, const TextureMipChain & mipChain, const FileStamp & sourceStamp)
+{
+    assert(!mipChain.Levels.empty());
+
+    const TextureFileHeader header{
+        TEXTURE_FILE_MAGIC,
+        TEXTURE_FILE_VERSION,
+        static_cast<uint32_t>(mipChain.Format),
+        static_cast<uint32_t>(mipChain.ColorSpace),
+        static_cast<uint32_t>(mipChain.Levels.front().Width),
+        static_cast<uint32_t>(mipChain.Levels.front().Height),
+        static_cast<uint32_t>(mipChain.Levels.size()),
+        sourceStamp.Size,
+        sourceStamp.ModificationTime
+    };
+
+    std::vector<TextureFileLevelEntry> index;
+    index.reserve(mipChain.Levels.size());
+
+    for (const TextureMipLevel & level : mipChain.Levels)
+        index.push_back(TextureFileLevelEntry{level.Offset, level.Size});
+
+    std::string content(sizeof(header) + sizeof(TextureFileLevelEntry)*index.size(), '\0');
+
+    std::memcpy(content.data(), &header, sizeof(header));
+    std::memcpy(content.data() + sizeof(header), index.data(), sizeof(TextureFileLevelEntry)*index.size());
+
+    content.append(reinterpret_cast<const char *>(mipChain.Data.data()), mipChain.Data.size());
+
+    WriteFileContentAtomically(path, content);
+}
+
+//
+// Service
+//
+
+static bool IsKnownFormat(const uint32_t format)
+{
+    return format <= static_cast<uint32_t>(TextureFormat::Bc5);
+}
+
+static bool IsKnownColorSpace(const uint32_t colorSpace)
+{
+    return colorSpace <= static_cast<uint32_t>(TextureColorSpace::Srgb);
+}
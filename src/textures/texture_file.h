@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <optional>
+
+#include "utils/file_utils.h"
+
+#include "mip_chain.h"
+
+//
+// Utilities
+//
+
+// Where learnopengl_texturebake puts the baked version of a texture file in TEXTURES_DIR.
+std::string GetBakedTexturePath(const std::string & textureFilename);
+
+// Reads a mip chain written by WriteTextureFile. Returns std::nullopt if the file is missing, malformed, outdated
+// or baked from a source file other than the one of sourceStamp, all but the first are logged.
+std::optional<TextureMipChain> ReadTextureFile(const std::string & path, const FileStamp & sourceStamp);
+
+// The stamp of the source file the chain was baked from is stored along, see ReadTextureFile().
+// Throws FileException if the file can't be written.
+void WriteTextureFile(const std::string & path, const TextureMipChain & mipChain, const FileStamp & sourceStamp);
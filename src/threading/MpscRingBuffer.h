@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+
+//
+// MpscRingBuffer
+//
+
+// Bounded lock-free multiple producer single consumer queue, after Dmitry Vyukov's bounded queue.
+// Every slot carries a sequence number telling producers and the consumer whose turn it is,
+// so that producers only contend on claiming a slot, never on filling it. Pushing into a full
+// buffer fails instead of blocking or overwriting. All slots are allocated up front.
+template <typename Value>
+class MpscRingBuffer final
+{
+public: // Construction
+
+    // Capacity must be a power of two.
+    explicit MpscRingBuffer(const size_t capacity);
+
+public: // Copy / Move
+
+    MpscRingBuffer(const MpscRingBuffer &) = delete;
+
+    MpscRingBuffer & operator=(const MpscRingBuffer &) = delete;
+
+public: // Interface
+
+    // May be called by any thread.
+    bool TryPush(const Value & value);
+
+    // May be called by any thread. Fills the claimed slot in place with writer(Value &),
+    // which saves a copy of large values.
+    template <typename Writer>
+    bool TryPushWith(Writer && writer);
+
+    // May only be called by the consumer thread. Returns the number of values consumed.
+    template <typename Consumer>
+    size_t PopAll(Consumer && consumer);
+
+    size_t GetCapacity() const;
+
+private: // Service types
+
+    // Keeps producer and consumer indices on separate cache lines to avoid false sharing.
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot final
+    {
+        std::atomic<size_t> Sequence;
+        Value               Data;
+    };
+
+private: // Members
+
+    std::unique_ptr<Slot[]> m_Slots;
+    size_t                  m_Capacity;
+    size_t                  m_IndexMask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_WriteIdx;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_ReadIdx;
+};
+
+//
+// Construction
+//
+
+template <typename Value>
+MpscRingBuffer<Value>::MpscRingBuffer(const size_t capacity):
+    m_Slots    (std::make_unique<Slot[]>(capacity)),
+    m_Capacity (capacity),
+    m_IndexMask(capacity - 1),
+    m_WriteIdx (0),
+    m_ReadIdx  (0)
+{
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0 && "ring buffer capacity must be a power of two");
+
+    for (size_t slotIdx = 0; slotIdx < capacity; slotIdx++)
+        m_Slots[slotIdx].Sequence.store(slotIdx, std::memory_order_relaxed);
+}
+
+//
+// Interface
+//
+
+template <typename Value>
+bool MpscRingBuffer<Value>::TryPush(const Value & value)
+{
+    return TryPushWith([&value] (Value & slotValue) { slotValue = value; });
+}
+
+template <typename Value>
+template <typename Writer>
+bool MpscRingBuffer<Value>::TryPushWith(Writer && writer)
+{
+    size_t writeIdx = m_WriteIdx.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Slot & slot = m_Slots[writeIdx & m_IndexMask];
+
+        const size_t   sequence   = slot.Sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(writeIdx);
+
+        if (difference == 0)
+        {
+            // The slot is free for this lap, claim it unless another producer was faster.
+            if (m_WriteIdx.compare_exchange_weak(writeIdx, writeIdx + 1, std::memory_order_relaxed))
+            {
+                writer(slot.Data);
+
+                slot.Sequence.store(writeIdx + 1, std::memory_order_release);
+
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The slot still holds a value of the previous lap, not consumed yet.
+            return false;
+        }
+        else
+        {
+            writeIdx = m_WriteIdx.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename Value>
+template <typename Consumer>
+size_t MpscRingBuffer<Value>::PopAll(Consumer && consumer)
+{
+    size_t readIdx          = m_ReadIdx.load(std::memory_order_relaxed);
+    size_t poppedValueCount = 0;
+
+    while (true)
+    {
+        Slot & slot = m_Slots[readIdx & m_IndexMask];
+
+        // Slots claimed but not filled yet stop consumption, they are picked up by the next call.
+        if (slot.Sequence.load(std::memory_order_acquire) != readIdx + 1)
+            break;
+
+        consumer(slot.Data);
+
+        slot.Sequence.store(readIdx + m_Capacity, std::memory_order_release);
+
+        readIdx++;
+        poppedValueCount++;
+    }
+
+    m_ReadIdx.store(readIdx, std::memory_order_relaxed);
+
+    return poppedValueCount;
+}
+
+template <typename Value>
+size_t MpscRingBuffer<Value>::GetCapacity() const
+{
+    return m_Capacity;
+}
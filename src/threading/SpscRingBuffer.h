@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <atomic>
+#include <vector>
+#include <optional>
+
+//
+// SpscRingBuffer
+//
+
+// Bounded lock-free single producer single consumer queue. Pushing into a full buffer fails
+// instead of blocking or overwriting, so that the producer never waits on the consumer.
+template <typename Value>
+class SpscRingBuffer final
+{
+public: // Construction
+
+    // Capacity must be a power of two.
+    explicit SpscRingBuffer(const size_t capacity);
+
+public: // Copy / Move
+
+    SpscRingBuffer(const SpscRingBuffer &) = delete;
+
+    SpscRingBuffer & operator=(const SpscRingBuffer &) = delete;
+
+public: // Interface
+
+    // May only be called by the producer thread.
+    bool TryPush(const Value & value);
+
+    // May only be called by the consumer thread.
+    std::optional<Value> TryPop();
+
+    // May only be called by the consumer thread. Returns the number of values consumed.
+    template <typename Consumer>
+    size_t PopAll(Consumer && consumer);
+
+    size_t GetCapacity() const;
+
+private: // Service types
+
+    // Keeps producer and consumer indices on separate cache lines to avoid false sharing.
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+private: // Members
+
+    std::vector<Value> m_Values;
+    size_t             m_IndexMask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_WriteIdx;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_ReadIdx;
+};
+
+//
+// Construction
+//
+
+template <typename Value>
+SpscRingBuffer<Value>::SpscRingBuffer(const size_t capacity):
+    m_Values   (capacity),
+    m_IndexMask(capacity - 1),
+    m_WriteIdx (0),
+    m_ReadIdx  (0)
+{
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0 && "ring buffer capacity must be a power of two");
+}
+
+//
+// Interface
+//
+
+template <typename Value>
+bool SpscRingBuffer<Value>::TryPush(const Value & value)
+{
+    const size_t writeIdx = m_WriteIdx.load(std::memory_order_relaxed);
+
+    if (writeIdx - m_ReadIdx.load(std::memory_order_acquire) == m_Values.size())
+        return false;
+
+    m_Values[writeIdx & m_IndexMask] = value;
+
+    m_WriteIdx.store(writeIdx + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename Value>
+std::optional<Value> SpscRingBuffer<Value>::TryPop()
+{
+    const size_t readIdx = m_ReadIdx.load(std::memory_order_relaxed);
+
+    if (readIdx == m_WriteIdx.load(std::memory_order_acquire))
+        return std::nullopt;
+
+    Value value = m_Values[readIdx & m_IndexMask];
+
+    m_ReadIdx.store(readIdx + 1, std::memory_order_release);
+
+    return value;
+}
+
+template <typename Value>
+template <typename Consumer>
+size_t SpscRingBuffer<Value>::PopAll(Consumer && consumer)
+{
+    const size_t readIdx  = m_ReadIdx.load(std::memory_order_relaxed);
+    const size_t writeIdx = m_WriteIdx.load(std::memory_order_acquire);
+
+    for (size_t valueIdx = readIdx; valueIdx != writeIdx; valueIdx++)
+        consumer(m_Values[valueIdx & m_IndexMask]);
+
+    // Slots are released all at once, so the producer may not reuse them while they are being consumed.
+    m_ReadIdx.store(writeIdx, std::memory_order_release);
+
+    return writeIdx - readIdx;
+}
+
+template <typename Value>
+size_t SpscRingBuffer<Value>::GetCapacity() const
+{
+    return m_Values.size();
+}
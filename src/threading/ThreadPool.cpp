@@ -0,0 +1,174 @@
+#include "ThreadPool.h"
+
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <exception>
+
+#include "profiling/profiling.h"
+#include "logging.h"
+
+//
+// Construction / Destruction
+//
+
+ThreadPool::ThreadPool(const size_t threadCount):
+    m_Mutex                 (),
+    m_TaskAvailableCondition(),
+    m_Tasks                 (),
+    m_IsStopping            (false),
+    m_Workers               ()
+{
+    assert(threadCount > 0);
+
+    m_Workers.reserve(threadCount);
+
+    for (size_t i = 0; i < threadCount; i++)
+        m_Workers.emplace_back(&ThreadPool::RunWorker, this);
+
+    LOG_INFO<< "Started thread pool with " << threadCount << " worker threads";
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+
+        m_IsStopping = true;
+    }
+
+    m_TaskAvailableCondition.notify_all();
+
+    for (std::thread & worker : m_Workers)
+        worker.join();
+
+    LOG_INFO<< "Stopped thread pool";
+}
+
+//
+// Interface
+//
+
+void ThreadPool::Submit(Task task)
+{
+    assert(task);
+
+    {
+        const std::lock_guard<std::mutex> lock(m_Mutex);
+        assert(!m_IsStopping && "tasks must not be submitted to a stopping thread pool");
+
+        m_Tasks.push_back(std::move(task));
+    }
+
+    m_TaskAvailableCondition.notify_one();
+}
+
+void ThreadPool::RunParallel(const size_t taskCount, const IndexedTask & task)
+{
+    struct SharedState final
+    {
+        const IndexedTask *     Task;
+        size_t                  TaskCount;
+        std::atomic<size_t>     NextTaskIdx;
+        std::mutex              Mutex;
+        std::condition_variable CompletionCondition;
+        size_t                  CompletedTaskCount;
+        std::exception_ptr      FirstException;
+    };
+
+    if (taskCount == 0)
+        return;
+
+    // Helpers may only get to run after all tasks have been completed, so they must not reference the caller's stack.
+    const auto state = std::make_shared<SharedState>();
+    state->Task               = &task;
+    state->TaskCount          = taskCount;
+    state->NextTaskIdx        = 0;
+    state->CompletedTaskCount = 0;
+
+    const auto runTasks = [] (SharedState & sharedState)
+    {
+        while (true)
+        {
+            const size_t taskIdx = sharedState.NextTaskIdx.fetch_add(1, std::memory_order_relaxed);
+            if (taskIdx >= sharedState.TaskCount)
+                return;
+
+            std::exception_ptr exception;
+
+            try
+            {
+                (*sharedState.Task)(taskIdx);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            const std::lock_guard<std::mutex> lock(sharedState.Mutex);
+
+            if (exception && !sharedState.FirstException)
+                sharedState.FirstException = exception;
+
+            sharedState.CompletedTaskCount++;
+            sharedState.CompletionCondition.notify_all();
+        }
+    };
+
+    const size_t helperCount = std::min(taskCount - 1, GetThreadCount());
+
+    for (size_t helperIdx = 0; helperIdx < helperCount; helperIdx++)
+        Submit([state, runTasks] { runTasks(*state); });
+
+    runTasks(*state);
+
+    std::unique_lock<std::mutex> lock(state->Mutex);
+
+    state->CompletionCondition.wait(lock, [&state] { return state->CompletedTaskCount == state->TaskCount; });
+
+    if (state->FirstException)
+        std::rethrow_exception(state->FirstException);
+}
+
+size_t ThreadPool::GetThreadCount() const
+{
+    return m_Workers.size();
+}
+
+size_t ThreadPool::GetDefaultThreadCount()
+{
+    // Leave one hardware thread to the main thread, which also participates in scheduled work.
+    const size_t hardwareThreadCount = std::thread::hardware_concurrency();
+
+    return std::max<size_t>(hardwareThreadCount, 2) - 1;
+}
+
+//
+// Service
+//
+
+void ThreadPool::RunWorker()
+{
+    PROFILE_THREAD_NAME("Worker");
+
+    while (true)
+    {
+        Task task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            m_TaskAvailableCondition.wait(lock, [this] { return m_IsStopping || !m_Tasks.empty(); });
+
+            // Pending tasks are still drained on stop, so that nobody waits forever on their completion.
+            if (m_Tasks.empty())
+                return;
+
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+        }
+
+        task();
+    }
+}
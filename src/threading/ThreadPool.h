@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+//
+// ThreadPool
+//
+
+class ThreadPool final
+{
+public: // Interface types
+
+    using Task = std::function<void()>;
+
+    using IndexedTask = std::function<void(size_t)>;
+
+public: // Construction / Destruction
+
+    explicit ThreadPool(const size_t threadCount);
+
+    ~ThreadPool();
+
+public: // Copy / Move
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool(ThreadPool &&) = delete;
+
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    ThreadPool & operator=(ThreadPool &&) = delete;
+
+public: // Interface
+
+    void Submit(Task task);
+
+    // Runs task for every index in [0, taskCount) on the workers and the calling thread,
+    // returning once all of them have completed. The first exception thrown by a task is rethrown.
+    void RunParallel(const size_t taskCount, const IndexedTask & task);
+
+    size_t GetThreadCount() const;
+
+    static size_t GetDefaultThreadCount();
+
+private: // Service
+
+    void RunWorker();
+
+private: // Members
+
+    std::mutex              m_Mutex;
+    std::condition_variable m_TaskAvailableCondition;
+    std::deque<Task>        m_Tasks;
+    bool                    m_IsStopping;
+
+    std::vector<std::thread> m_Workers;
+};
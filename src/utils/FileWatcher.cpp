@@ -0,0 +1,264 @@
+#include "FileWatcher.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include <exception>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#endif
+
+#include "profiling/profiling.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+#ifdef __linux__
+// Files are reported once written and closed or moved in, not on creation, which is followed by writes.
+static constexpr uint32_t WATCHED_EVENT_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE;
+#endif
+
+//
+// Forward declarations
+//
+
+static std::string JoinRelativePath(const std::string & relativeDirPath, const char * const name);
+
+//
+// Construction / Destruction
+//
+
+FileWatcher::FileWatcher(const std::string & dirPath, const std::chrono::milliseconds debounceInterval, ChangeCallback callback):
+    m_DirPath                (dirPath),
+    m_DebounceInterval       (debounceInterval),
+    m_Callback               (std::move(callback)),
+    m_InotifyFd              (-1),
+    m_StopEventFd            (-1),
+    m_RelativeDirPathsByWatch(),
+    m_Thread                 ()
+{
+    assert(m_Callback);
+
+#ifdef __linux__
+    m_InotifyFd   = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_StopEventFd = eventfd(0, EFD_CLOEXEC);
+
+    if (m_InotifyFd < 0 || m_StopEventFd < 0)
+    {
+        LOG_ERROR<< "Failed to watch " << m_DirPath << ": " << std::strerror(errno);
+
+        return;
+    }
+
+    AddWatches("");
+
+    if (m_RelativeDirPathsByWatch.empty())
+        return;
+
+    m_Thread = std::thread(&FileWatcher::Run, this);
+
+    LOG_INFO<< "Watching " << m_RelativeDirPathsByWatch.size() << " directories under " << m_DirPath << " for changes";
+#else
+    LOG_WARNING<< "Watching " << m_DirPath << " for changes is only supported on Linux";
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (m_Thread.joinable())
+    {
+        const uint64_t stopSignal = 1;
+
+        if (write(m_StopEventFd, &stopSignal, sizeof(stopSignal)) != sizeof(stopSignal))
+            LOG_ERROR<< "Failed to signal watcher of " << m_DirPath << " to stop: " << std::strerror(errno);
+
+        m_Thread.join();
+    }
+
+    if (m_InotifyFd >= 0)
+        close(m_InotifyFd);
+
+    if (m_StopEventFd >= 0)
+        close(m_StopEventFd);
+#endif
+}
+
+//
+// Interface
+//
+
+bool FileWatcher::IsWatching() const
+{
+    return m_Thread.joinable();
+}
+
+//
+// Service
+//
+
+void FileWatcher::Run()
+{
+#ifdef __linux__
+    PROFILE_THREAD_NAME("FileWatcher");
+
+    std::vector<std::string> changedPaths;
+
+    while (true)
+    {
+        pollfd pollFds[2] = {
+            {m_InotifyFd,   POLLIN, 0},
+            {m_StopEventFd, POLLIN, 0}
+        };
+
+        // Waits indefinitely while there is nothing to report.
+        const int timeoutMs = changedPaths.empty() ? -1 : static_cast<int>(m_DebounceInterval.count());
+
+        const int readyFdCount = poll(pollFds, 2, timeoutMs);
+
+        if (readyFdCount < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            LOG_ERROR<< "Stopped watching " << m_DirPath << ", polling failed: " << std::strerror(errno);
+
+            return;
+        }
+
+        if ((pollFds[1].revents & POLLIN) != 0)
+            return;
+
+        if ((pollFds[0].revents & POLLIN) != 0)
+        {
+            ReadEvents(changedPaths);
+
+            continue;
+        }
+
+        // Nothing changed for the debounce interval
+        std::sort(changedPaths.begin(), changedPaths.end());
+        changedPaths.erase(std::unique(changedPaths.begin(), changedPaths.end()), changedPaths.end());
+
+        try
+        {
+            m_Callback(changedPaths);
+        }
+        catch (const std::exception & e)
+        {
+            LOG_ERROR<< "Failed to handle changes under " << m_DirPath << ": " << e.what();
+        }
+
+        changedPaths.clear();
+    }
+#endif
+}
+
+void FileWatcher::ReadEvents(std::vector<std::string> & changedPaths)
+{
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+
+    while (true)
+    {
+        const ssize_t readSize = read(m_InotifyFd, buffer, sizeof(buffer));
+
+        if (readSize <= 0)
+        {
+            if (readSize < 0 && errno != EAGAIN && errno != EINTR)
+                LOG_ERROR<< "Failed to read changes under " << m_DirPath << ": " << std::strerror(errno);
+
+            return;
+        }
+
+        for (ssize_t offset = 0; offset < readSize; )
+        {
+            const inotify_event * const event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0)
+            {
+                LOG_WARNING<< "Lost track of changes under " << m_DirPath << ", too many were made at once";
+
+                changedPaths.emplace_back();
+
+                continue;
+            }
+
+            const auto relativeDirPathIt = m_RelativeDirPathsByWatch.find(event->wd);
+
+            if (relativeDirPathIt == m_RelativeDirPathsByWatch.cend())
+                continue;
+
+            // Removed along with its directory
+            if ((event->mask & IN_IGNORED) != 0)
+            {
+                m_RelativeDirPathsByWatch.erase(relativeDirPathIt);
+
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            const std::string relativePath = JoinRelativePath(relativeDirPathIt->second, event->name);
+
+            if ((event->mask & IN_ISDIR) != 0)
+            {
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+                    AddWatches(relativePath);
+
+                continue;
+            }
+
+            if ((event->mask & IN_CREATE) == 0)
+                changedPaths.push_back(relativePath);
+        }
+    }
+#else
+    (void)changedPaths;
+#endif
+}
+
+void FileWatcher::AddWatches(const std::string & relativeDirPath)
+{
+#ifdef __linux__
+    const std::filesystem::path dirPath = std::filesystem::path(m_DirPath) / relativeDirPath;
+
+    const int watch = inotify_add_watch(m_InotifyFd, dirPath.c_str(), WATCHED_EVENT_MASK);
+
+    if (watch < 0)
+    {
+        LOG_ERROR<< "Failed to watch " << dirPath.string() << ": " << std::strerror(errno);
+
+        return;
+    }
+
+    m_RelativeDirPathsByWatch[watch] = relativeDirPath;
+
+    std::error_code errorCode;
+
+    for (const std::filesystem::directory_entry & entry : std::filesystem::directory_iterator(dirPath, errorCode))
+    {
+        if (entry.is_directory(errorCode))
+            AddWatches(JoinRelativePath(relativeDirPath, entry.path().filename().c_str()));
+    }
+#else
+    (void)relativeDirPath;
+#endif
+}
+
+static std::string JoinRelativePath(const std::string & relativeDirPath, const char * const name)
+{
+    return relativeDirPath.empty() ? std::string(name) : relativeDirPath + '/' + name;
+}
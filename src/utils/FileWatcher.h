@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <chrono>
+#include <functional>
+
+//
+// FileWatcher
+//
+
+// Reports changes of files anywhere under a directory, subdirectories created later included, on a thread
+// of its own. Changes are batched until none have been made for the debounce interval, since editors tend
+// to save in several steps, e.g. by writing a temporary file and renaming it over the original.
+// Only supported on Linux, through inotify, elsewhere nothing is ever reported.
+class FileWatcher final
+{
+public: // Interface types
+
+    // Called on the watcher's thread with paths relative to the watched directory. An empty path
+    // stands for changes which weren't reported individually, e.g. when the event queue overflowed.
+    using ChangeCallback = std::function<void(const std::vector<std::string> & changedPaths)>;
+
+public: // Construction / Destruction
+
+    FileWatcher(const std::string & dirPath, const std::chrono::milliseconds debounceInterval, ChangeCallback callback);
+
+    ~FileWatcher();
+
+public: // Copy / Move
+
+    FileWatcher(const FileWatcher &) = delete;
+
+    FileWatcher(FileWatcher &&) = delete;
+
+    FileWatcher & operator=(const FileWatcher &) = delete;
+
+    FileWatcher & operator=(FileWatcher &&) = delete;
+
+public: // Interface
+
+    // False if watching isn't supported or failed to start.
+    bool IsWatching() const;
+
+private: // Service
+
+    void Run();
+
+    void ReadEvents(std::vector<std::string> & changedPaths);
+
+    // Watches relativeDirPath and all its subdirectories.
+    void AddWatches(const std::string & relativeDirPath);
+
+private: // Members
+
+    const std::string               m_DirPath;
+    const std::chrono::milliseconds m_DebounceInterval;
+    const ChangeCallback            m_Callback;
+
+    int m_InotifyFd;
+    // Signaled to stop the thread
+    int m_StopEventFd;
+
+    // Relative paths of watched directories, only accessed by the watcher's thread once it's started
+    std::unordered_map<int, std::string> m_RelativeDirPathsByWatch;
+
+    std::thread m_Thread;
+};
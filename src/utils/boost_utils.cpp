@@ -10,5 +10,5 @@ void LogBoostVersion()
     const int minor = BOOST_VERSION / 100 % 1000;
     const int patch = BOOST_VERSION % 100;
 
-    BOOST_LOG_TRIVIAL(info)<< "Using Boost version " << major << '.' << minor << '.' << patch;
+    LOG_INFO<< "Using Boost version " << major << '.' << minor << '.' << patch;
 }
@@ -3,6 +3,7 @@
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <random>
 
 //
 // Utilities
@@ -20,6 +21,53 @@ std::string ReadFileContent(const std::string & path)
     return sout.str();
 }
 
+std::vector<std::byte> ReadBinaryFileContent(const std::string & path)
+{
+    std::ifstream fin(path, std::ios::binary | std::ios::ate);
+    if (fin.fail())
+        throw FileException(path);
+
+    std::vector<std::byte> content(static_cast<size_t>(fin.tellg()));
+
+    fin.seekg(0);
+    fin.read(reinterpret_cast<char *>(content.data()), static_cast<std::streamsize>(content.size()));
+
+    if (fin.fail())
+        throw FileException(path);
+
+    return content;
+}
+
+void WriteFileContentAtomically(const std::string & path, const std::string_view content)
+{
+    // Concurrent writers of the same path each get their own temporary file.
+    const std::string temporaryPath = path + ".tmp" + std::to_string(std::random_device()());
+
+    {
+        std::ofstream fout(temporaryPath, std::ios::binary | std::ios::trunc);
+        fout.write(content.data(), static_cast<std::streamsize>(content.size()));
+        fout.close();
+
+        if (fout.fail())
+        {
+            std::error_code errorCode;
+            std::filesystem::remove(temporaryPath, errorCode);
+
+            throw FileException(temporaryPath);
+        }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPath, path, errorCode);
+
+    if (errorCode)
+    {
+        std::filesystem::remove(temporaryPath, errorCode);
+
+        throw FileException(path);
+    }
+}
+
 std::string GetFileExtension(const std::string & path)
 {
     const size_t lastDotIdx = path.rfind('.');
@@ -34,6 +82,21 @@ bool DoesFileExist(const std::string & path)
     return std::filesystem::exists(path);
 }
 
+std::optional<FileStamp> GetFileStamp(const std::string & path)
+{
+    std::error_code errorCode;
+
+    const uintmax_t                       size             = std::filesystem::file_size(path, errorCode);
+    const std::filesystem::file_time_type modificationTime = !errorCode
+        ? std::filesystem::last_write_time(path, errorCode)
+        : std::filesystem::file_time_type();
+
+    if (errorCode)
+        return std::nullopt;
+
+    return FileStamp{static_cast<uint64_t>(size), static_cast<int64_t>(modificationTime.time_since_epoch().count())};
+}
+
 //
 // Exceptions
 //
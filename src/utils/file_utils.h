@@ -1,18 +1,46 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <stdexcept>
 
+//
+// Interface types
+//
+
+// Changes whenever the file gets written, short of clock adjustments, without reading it.
+struct FileStamp final
+{
+    uint64_t Size;
+    // In ticks of the file system clock, only comparable on the same platform
+    int64_t  ModificationTime;
+
+    bool operator==(const FileStamp &) const = default;
+};
+
 //
 // Utilities
 //
 
 std::string ReadFileContent(const std::string & path);
 
+std::vector<std::byte> ReadBinaryFileContent(const std::string & path);
+
+// Writes into a temporary file next to path first and renames it over path, so that readers,
+// other processes included, either see the previous content or the complete new one.
+void WriteFileContentAtomically(const std::string & path, const std::string_view content);
+
 std::string GetFileExtension(const std::string & path);
 
 bool DoesFileExist(const std::string & path);
 
+// Returns std::nullopt if the file doesn't exist or can't be queried.
+std::optional<FileStamp> GetFileStamp(const std::string & path);
+
 //
 // Exceptions
 //
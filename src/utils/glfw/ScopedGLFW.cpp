@@ -1,7 +1,8 @@
 #include "ScopedGLFW.h"
 
 #include <GLFW/glfw3.h>
-#include <boost/log/trivial.hpp>
+
+#include "logging.h"
 
 //
 // Construction / Destruction
@@ -11,7 +12,7 @@ ScopedGLFW::ScopedGLFW()
 {
     if (glfwInit())
     {
-        BOOST_LOG_TRIVIAL(info)<< "Initialized GLFW";
+        LOG_INFO<< "Initialized GLFW";
 
         return;
     }
@@ -26,5 +27,5 @@ ScopedGLFW::~ScopedGLFW()
 {
     glfwTerminate();
 
-    BOOST_LOG_TRIVIAL(info)<< "Terminated GLFW";
+    LOG_INFO<< "Terminated GLFW";
 }
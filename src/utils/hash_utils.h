@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//
+// Constants
+//
+
+constexpr uint64_t FNV1A_64_OFFSET_BASIS = 0xCBF29CE484222325ull;
+constexpr uint64_t FNV1A_64_PRIME        = 0x100000001B3ull;
+
+//
+// Utilities
+//
+
+// Stable across runs and platforms, unlike std::hash, so suitable for keys persisted on disk.
+// Pass the previous result as hash to hash several pieces of data as one.
+inline uint64_t HashFnv1a64(const void * const data, const size_t size, uint64_t hash = FNV1A_64_OFFSET_BASIS)
+{
+    const auto * const bytes = static_cast<const unsigned char *>(data);
+
+    for (size_t byteIdx = 0; byteIdx < size; byteIdx++)
+    {
+        hash ^= bytes[byteIdx];
+        hash *= FNV1A_64_PRIME;
+    }
+
+    return hash;
+}
+
+inline uint64_t HashFnv1a64(const std::string_view string, const uint64_t hash = FNV1A_64_OFFSET_BASIS)
+{
+    // The length goes first, so that the boundaries of consecutively hashed strings matter.
+    const uint64_t length = string.size();
+
+    return HashFnv1a64(string.data(), string.size(), HashFnv1a64(&length, sizeof(length), hash));
+}
@@ -0,0 +1,286 @@
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+
+#include "app/options.h"
+#include "threading/ThreadPool.h"
+#include "textures/loading.h"
+#include "textures/mip_chain.h"
+#include "textures/block_compression.h"
+#include "textures/texture_file.h"
+#include "utils/boost_utils.h"
+#include "utils/file_utils.h"
+#include "config.h"
+#include "logging.h"
+
+//
+// Constants
+//
+
+static constexpr int TEXTUREBAKE_ERR_NONE         = 0;
+static constexpr int TEXTUREBAKE_ERR_UNKNOWN      = -1;
+static constexpr int TEXTUREBAKE_ERR_INVALID_ARGS = -3;
+
+// Extensions of the texture files in TEXTURES_DIR that get baked
+static const std::set<std::string> SOURCE_TEXTURE_EXTENSIONS{"png", "jpg", "jpeg"};
+
+//
+// Service types
+//
+
+struct TextureBakeArguments final
+{
+    // Picks BC3 for textures with any translucent texel and BC1 otherwise if unset
+    std::optional<TextureFormat> Format;
+    TextureColorSpace            ColorSpace = TextureColorSpace::Linear;
+    MipChainOptions              MipChain;
+};
+
+//
+// Forward declarations
+//
+
+static TextureBakeArguments ParseTextureBakeArguments(const int argc, const char * const * const argv);
+
+static std::string GetTextureBakeUsage(const std::string & executableName);
+
+static float ParseAlphaCutoff(const std::string_view value);
+
+static std::vector<std::string> FindSourceTextureFiles();
+
+static bool IsOpaque(const TextureData & rgbaTextureData);
+
+//
+// Main
+//
+
+// Bakes every texture file in TEXTURES_DIR into BAKED_TEXTURES_DIR: decodes it, generates its mip chain and block
+// compresses the chain, so that TextureLoader uploads it as it is instead of decoding the file at startup, as long as
+// the file is unchanged since. Textures failing to decode, e.g. Git LFS pointers of a clone without the actual files,
+// are skipped with a warning rather than failing the build, TextureLoader reports them once it decodes them itself.
+int main(int argc, char * argv[])
+{
+    InitLogger();
+    LogBoostVersion();
+
+    TextureBakeArguments arguments;
+
+    try
+    {
+        arguments = ParseTextureBakeArguments(argc, argv);
+    }
+    catch (const AppOptionsException & e)
+    {
+        LOG_FATAL<< e.what() << '\n' << GetTextureBakeUsage(argv[0]);
+
+        return TEXTUREBAKE_ERR_INVALID_ARGS;
+    }
+
+    try
+    {
+        ThreadPool threadPool(ThreadPool::GetDefaultThreadCount());
+
+        std::filesystem::create_directories(BAKED_TEXTURES_DIR);
+
+        size_t sourceSize   = 0;
+        size_t bakedSize    = 0;
+        size_t bakedCount   = 0;
+        size_t skippedCount = 0;
+
+        // Rows and blocks of a texture are spread across the thread pool, textures are baked one after another.
+        for (const std::string & textureFilename : FindSourceTextureFiles())
+        {
+            // Taken before decoding, a texture changing meanwhile is decoded at runtime until baked again.
+            const std::optional<FileStamp> sourceStamp = GetFileStamp(TEXTURES_DIR + textureFilename);
+            if (!sourceStamp.has_value())
+                throw FileException(TEXTURES_DIR + textureFilename);
+
+            try
+            {
+                TextureLoadingOptions options;
+                options.DesiredChannelsCount = 4;
+                options.ColorSpace           = arguments.ColorSpace;
+
+                const TextureData rgbaTextureData = LoadTextureDataFromFile(textureFilename, options);
+
+                const TextureFormat format = arguments.Format.value_or(
+                    IsOpaque(rgbaTextureData) ? TextureFormat::Bc1 : TextureFormat::Bc3
+                );
+
+                TextureMipChain mipChain = GenerateMipChain(rgbaTextureData, threadPool, arguments.MipChain);
+
+                if (IsBlockCompressedFormat(format))
+                    mipChain = CompressMipChain(mipChain, format, threadPool);
+
+                WriteTextureFile(GetBakedTexturePath(textureFilename), mipChain, *sourceStamp);
+
+                sourceSize += rgbaTextureData.GetDataSize();
+                bakedSize  += mipChain.Data.size();
+                bakedCount++;
+
+                LOG_INFO<< "Baked " << textureFilename << " into " << mipChain.Levels.size() << " levels, "
+                    << mipChain.Data.size() << " bytes";
+            }
+            catch (const TextureLoadingException & e)
+            {
+                LOG_WARNING<< "Skipping " << textureFilename << ", which failed to decode: " << e.what();
+
+                skippedCount++;
+            }
+        }
+
+        LOG_INFO<< "Baked " << bakedCount << " textures, from " << sourceSize << " bytes of RGBA8 base levels to "
+            << bakedSize << " bytes of mip chains, skipped " << skippedCount;
+    }
+    catch (const std::exception & e)
+    {
+        LOG_FATAL<< "Fatal error: " << e.what();
+
+        return TEXTUREBAKE_ERR_UNKNOWN;
+    }
+    catch (...)
+    {
+        LOG_FATAL<< "Unknown error";
+
+        return TEXTUREBAKE_ERR_UNKNOWN;
+    }
+
+    return TEXTUREBAKE_ERR_NONE;
+}
+
+//
+// Service
+//
+
+static TextureBakeArguments ParseTextureBakeArguments(const int argc, const char * const * const argv)
+{
+    TextureBakeArguments arguments;
+
+    const auto getValue = [argc, argv] (int & argIdx) -> std::string_view
+    {
+        if (argIdx + 1 >= argc)
+            throw AppOptionsException("Missing value for argument " + std::string(argv[argIdx]));
+
+        return argv[++argIdx];
+    };
+
+    for (int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        const std::string_view arg(argv[argIdx]);
+
+        if (arg == "--format")
+        {
+            const std::string_view value = getValue(argIdx);
+
+            if (value == "auto")
+                arguments.Format = std::nullopt;
+            else if (value == "rgba8")
+                arguments.Format = TextureFormat::Rgba8;
+            else if (value == "bc1")
+                arguments.Format = TextureFormat::Bc1;
+            else if (value == "bc3")
+                arguments.Format = TextureFormat::Bc3;
+            else if (value == "bc4")
+                arguments.Format = TextureFormat::Bc4;
+            else if (value == "bc5")
+                arguments.Format = TextureFormat::Bc5;
+            else
+                throw AppOptionsException("Unrecognized texture format " + std::string(value));
+        }
+        else if (arg == "--color-space")
+        {
+            const std::string_view value = getValue(argIdx);
+
+            if (value == "linear")
+                arguments.ColorSpace = TextureColorSpace::Linear;
+            else if (value == "srgb")
+                arguments.ColorSpace = TextureColorSpace::Srgb;
+            else
+                throw AppOptionsException("Unrecognized color space " + std::string(value));
+        }
+        else if (arg == "--alpha-cutoff")
+        {
+            arguments.MipChain.AlphaCoverageCutoff = ParseAlphaCutoff(getValue(argIdx));
+        }
+        else
+        {
+            throw AppOptionsException("Unrecognized argument " + std::string(arg));
+        }
+    }
+
+    const bool isSingleChannelFormat = arguments.Format == TextureFormat::Bc4 || arguments.Format == TextureFormat::Bc5;
+
+    if (isSingleChannelFormat && arguments.ColorSpace == TextureColorSpace::Srgb)
+        throw AppOptionsException("BC4 and BC5 have no sRGB variants");
+
+    return arguments;
+}
+
+static std::string GetTextureBakeUsage(const std::string & executableName)
+{
+    return "Usage: " + executableName + " [--format auto|rgba8|bc1|bc3|bc4|bc5] [--color-space linear|srgb] [--alpha-cutoff <value>]\n"
+        "    --format       format of the baked mip chains, auto picks BC1 for opaque textures and BC3 otherwise\n"
+        "    --color-space  color space textures are loaded with, linear by default, baked textures of another one are ignored\n"
+        "    --alpha-cutoff alpha value textures are alpha tested at, preserves the fraction of texels passing the test at every level";
+}
+
+static float ParseAlphaCutoff(const std::string_view value)
+{
+    // std::from_chars for floating point types is missing from some standard libraries still.
+    const std::string valueString(value);
+
+    size_t parsedLength = 0;
+    float  result       = 0.0f;
+
+    try
+    {
+        result = std::stof(valueString, &parsedLength);
+    }
+    catch (const std::logic_error &)
+    {
+        throw AppOptionsException("Invalid alpha cutoff " + valueString);
+    }
+
+    if (parsedLength != valueString.size() || !std::isfinite(result) || result <= 0.0f || result >= 1.0f)
+        throw AppOptionsException("Invalid alpha cutoff " + valueString);
+
+    return result;
+}
+
+static std::vector<std::string> FindSourceTextureFiles()
+{
+    std::vector<std::string> textureFilenames;
+
+    for (const std::filesystem::directory_entry & entry : std::filesystem::directory_iterator(TEXTURES_DIR))
+    {
+        const std::string textureFilename = entry.path().filename().string();
+
+        if (entry.is_regular_file() && SOURCE_TEXTURE_EXTENSIONS.contains(GetFileExtension(textureFilename)))
+            textureFilenames.push_back(textureFilename);
+    }
+
+    std::sort(textureFilenames.begin(), textureFilenames.end());
+
+    return textureFilenames;
+}
+
+static bool IsOpaque(const TextureData & rgbaTextureData)
+{
+    const TextureByte * const data = rgbaTextureData.GetData();
+
+    for (size_t alphaIdx = 3; alphaIdx < rgbaTextureData.GetDataSize(); alphaIdx += 4)
+    {
+        if (data[alphaIdx] != 255)
+            return false;
+    }
+
+    return true;
+}